@@ -1,8 +1,6 @@
 #COMPUTE
 #version 450 core
 
-#define MAX_POINT_LIGHTS 1000
-#define MAX_SPOT_LIGHTS 800
 #define MAX_CASCADES 10
 #define PI 3.14159265359
 
@@ -18,6 +16,7 @@ struct PointLight
 	float Intensity;
 	vec3 Color;
 	vec3 Position;
+	float Range;
 };
 
 struct SpotLight
@@ -28,6 +27,15 @@ struct SpotLight
 	vec3 Direction;
 	float HalfAngle;
 	float FallOff;
+	float Range;
+};
+
+struct LightCluster
+{
+	uint Offset;
+	uint PointLightCount;
+	uint SpotLightCount;
+	uint Padding;
 };
 
 struct CameraData
@@ -37,11 +45,17 @@ struct CameraData
 	mat4 Proj;
 	vec3 Pos;
 	vec3 ViewDir;
+	mat4 InvViewProj;
+};
+
+// Render extent, the G-buffer and color buffer may be larger
+layout(push_constant) uniform LightingConstant {
+	uvec2 RenderSize;
 };
 
 layout(set = 0, binding = 0, rgba32f) uniform writeonly image2D ColorBuffer;
 layout(set = 0, binding = 1) uniform sampler2D gAlbedo;
-layout(set = 0, binding = 2) uniform sampler2D gPosition;
+layout(set = 0, binding = 2) uniform sampler2D gDepth;
 layout(set = 0, binding = 3) uniform sampler2D gNormal;
 layout(set = 0, binding = 4) uniform sampler2D gPBR;
 
@@ -49,14 +63,28 @@ layout(set = 1, binding = 0) uniform DirectionalLightBuffer {
 	DirectionalLight DLight;
 };
 
-layout(set = 1, binding = 1) uniform PointLightBuffer {
-	uint PointLightCount;
-	PointLight PointLights[MAX_POINT_LIGHTS];
+layout(std430, set = 1, binding = 1) readonly buffer PointLightBuffer {
+	PointLight PointLights[];
 };
 
-layout(set = 1, binding = 2) uniform SpotLightBuffer {
-	uint SpotLightCount;
-	SpotLight SpotLights[MAX_SPOT_LIGHTS];
+layout(std430, set = 1, binding = 2) readonly buffer SpotLightBuffer {
+	SpotLight SpotLights[];
+};
+
+layout(set = 1, binding = 3) uniform LightClusterInfo {
+	uvec4 ClusterGridSize;
+	float ClusterNear;
+	float ClusterFar;
+	float ClusterSliceScale;
+	float ClusterSliceBias;
+};
+
+layout(std430, set = 1, binding = 4) readonly buffer LightClusterBuffer {
+	LightCluster Clusters[];
+};
+
+layout(std430, set = 1, binding = 5) readonly buffer LightIndexBuffer {
+	uint LightIndices[];
 };
 
 layout(set = 2, binding = 0) uniform CameraBuffer {
@@ -70,6 +98,7 @@ layout(set = 3, binding = 1) uniform Cascades {
     vec4 cascadeSplits[MAX_CASCADES];
     uint cascadeCount;
 };
+layout(set = 3, binding = 2) uniform sampler2DArray staticShadowMap;
 
 layout(set = 4, binding = 0) uniform samplerCube diffuseIBL;
 layout(set = 4, binding = 1) uniform samplerCube prefilterIBL;
@@ -104,6 +133,40 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
 	return ggx1 * ggx2;
 }
 
+// Smoothly reaches zero at the lights range so lights culled from a cluster contribute nothing
+float GetRangeAttenuation(float distance, float range)
+{
+	float ratio = distance / range;
+	float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+	return (window * window) / max(distance * distance, 0.0001);
+}
+
+vec3 DecodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
+
+// Views are drawn with a flipped viewport so the first row of pixels is the top of NDC
+vec3 ReconstructWorldPosition(ivec2 pixel, float depth)
+{
+	vec2 ndc = (vec2(pixel) + 0.5) / vec2(RenderSize) * 2.0 - 1.0;
+	vec4 world = Camera.InvViewProj * vec4(ndc.x, -ndc.y, depth, 1.0);
+	return world.xyz / world.w;
+}
+
+uint GetClusterIndex(ivec2 pixel, ivec2 size, vec3 worldPos)
+{
+	float depth = -(Camera.View * vec4(worldPos, 1.0)).z;
+	uint slice = uint(clamp(log(max(depth, ClusterNear)) * ClusterSliceScale - ClusterSliceBias, 0.0, float(ClusterGridSize.z - 1)));
+
+	uvec2 tile = min(uvec2(vec2(pixel) / vec2(size) * vec2(ClusterGridSize.xy)), ClusterGridSize.xy - 1);
+
+	return tile.x + tile.y * ClusterGridSize.x + slice * ClusterGridSize.x * ClusterGridSize.y;
+}
+
 const mat4 biasMatrix = mat4( 
 	0.5, 0.0, 0.0, 0.0,
 	0.0, -0.5, 0.0, 0.0,
@@ -111,18 +174,21 @@ const mat4 biasMatrix = mat4(
 	0.5, 0.5, 0.0, 1.0 
 );
 
+// Cascades are fitted to every view of the world together and shared by all of them, so the cascade is picked by where the
+// position lands in light space rather than by its depth in this view. Cascades are ordered from the smallest, cascadeCount
+// means the position is outside all of them
 uint GetCascadeIndex(vec3 worldPos)
 {
-	float depthValue = (Camera.View * vec4(worldPos, 1.0)).z;
+	for(uint i = 0; i < cascadeCount; ++i) {
+		vec4 lightSpace = cascadeViewProj[i] * vec4(worldPos, 1.0);
+		vec3 ndc = lightSpace.xyz / lightSpace.w;
 
-    uint cascadeIndex = 0;
-	for(uint i = 0; i < cascadeCount - 1; ++i) {
-		if(depthValue < cascadeSplits[i].x) {	
-			cascadeIndex = i + 1;
+		if(all(lessThanEqual(abs(ndc.xy), vec2(1.0))) && ndc.z >= 0.0 && ndc.z <= 1.0) {
+			return i;
 		}
 	}
 
-	return cascadeIndex;
+	return cascadeCount;
 }
 
 
@@ -130,6 +196,10 @@ float GetShadow(vec3 worldPos, vec3 normal, vec3 lightDir)
 {
     uint layer = GetCascadeIndex(worldPos);
 
+    // No cascade covers it, sampling the last one would clamp to its edge texels
+    if (layer == cascadeCount)
+        return 1.0;
+
     // Transform to light space
     vec4 shadowCoord = (biasMatrix * cascadeViewProj[layer]) * vec4(worldPos, 1.0);
     shadowCoord /= shadowCoord.w;
@@ -151,7 +221,8 @@ float GetShadow(vec3 worldPos, vec3 normal, vec3 lightDir)
             vec2 sampleUV = shadowCoord.xy + offset;
 
 
-            float closestDepth = texture(shadowMap, vec3(sampleUV, layer)).r;
+            // Static casters are cached in their own layers, the closest of both occludes
+            float closestDepth = min(texture(shadowMap, vec3(sampleUV, layer)).r, texture(staticShadowMap, vec3(sampleUV, layer)).r);
             if (closestDepth < shadowCoord.z - bias)
             {
                 shadow += 1.0;
@@ -166,20 +237,28 @@ float GetShadow(vec3 worldPos, vec3 normal, vec3 lightDir)
 layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
 void main()
 {
-	// ivec2 size = textureSize(ColorBuffer, 0).xy;
 	ivec2 uv = ivec2(gl_GlobalInvocationID.xy);
 
-	//if(uv.x > size.x || uv.y > size.y)
-	//	return;
+	if (any(greaterThanEqual(uvec2(uv), RenderSize)))
+		return;
+
+	// Nothing was drawn here, the skybox fills it in later
+	float depth = texelFetch(gDepth, uv, 0).r;
+	if (depth >= 1.0)
+	{
+		imageStore(ColorBuffer, uv, vec4(0.0, 0.0, 0.0, 1.0));
+		return;
+	}
 
 	vec3 albedo = texelFetch(gAlbedo, uv, 0).rgb;
-	vec3 worldPos = texelFetch(gPosition, uv, 0).rgb;
-	vec3 normal = normalize(texelFetch(gNormal, uv, 0).rgb);
-	vec3 pbr = texelFetch(gPBR, uv, 0).rgb;
+	vec3 worldPos = ReconstructWorldPosition(uv, depth);
+	vec3 normal = DecodeOctahedral(texelFetch(gNormal, uv, 0).rg);
+	vec4 pbr = texelFetch(gPBR, uv, 0);
 
 	float metallic = pbr.r;
 	float roughness = pbr.g;
 	float ao = pbr.b;
+	float emissive = pbr.a; // Only a mask is packed, emissive surfaces glow in their albedo
 
 	vec3 N = normalize(normal);
 	vec3 V = normalize(Camera.Pos - worldPos);
@@ -210,13 +289,15 @@ void main()
 		Lo += (kD * albedo / PI + specular) * radiance * NdotL * GetShadow(worldPos, N, L);
 	}
 
+	LightCluster cluster = Clusters[GetClusterIndex(uv, ivec2(RenderSize), worldPos)];
+
 	// Point Lights
-	for (uint i = 0; i < PointLightCount; ++i) {
-		PointLight light = PointLights[i];
+	for (uint i = 0; i < cluster.PointLightCount; ++i) {
+		PointLight light = PointLights[LightIndices[cluster.Offset + i]];
 		vec3 L = normalize(light.Position - worldPos);
 		vec3 H = normalize(V + L);
 		float distance = length(light.Position - worldPos);
-		float attenuation = 1.0 / (distance * distance);
+		float attenuation = GetRangeAttenuation(distance, light.Range);
 		vec3 radiance = light.Intensity * light.Color * attenuation;
 
 		float NDF = DistributionGGX(N, H, roughness);
@@ -235,12 +316,12 @@ void main()
 	}
 
 	// Spot Lights
-	for (uint i = 0; i < SpotLightCount; ++i) {
-		SpotLight light = SpotLights[i];
+	for (uint i = 0; i < cluster.SpotLightCount; ++i) {
+		SpotLight light = SpotLights[LightIndices[cluster.Offset + cluster.PointLightCount + i]];
 		vec3 L = normalize(light.Position - worldPos);
 		vec3 H = normalize(V + L);
 		float distance = length(light.Position - worldPos);
-		float attenuation = 1.0 / (distance * distance);
+		float attenuation = GetRangeAttenuation(distance, light.Range);
 
 		float spotAngle = dot(normalize(-L), normalize(light.Direction));
 		float cutoff = cos(light.HalfAngle);
@@ -288,7 +369,7 @@ void main()
 	// Ambient
 	vec3 ambient = vec3(0.03) * albedo * ao;
 
-	vec3 color = ambient + Lo;
+	vec3 color = ambient + Lo + albedo * emissive;
 
 	// Apply optional tonemapping and gamma correction (if needed)
 	color = color / (color + vec3(1.0));
@@ -0,0 +1,37 @@
+#COMPUTE
+#version 450 core
+
+// Reduces the depth buffer to the Hi-Z base level, every output texel keeps the farthest depth of all the texels it overlaps.
+// Mirrors DownsampleDepth in HiZ.cpp
+
+layout(push_constant) uniform HiZConstant {
+	uvec2 HiZSize;
+	uvec2 DepthSize; // Render extent, the depth buffer may be larger
+};
+
+layout(set = 0, binding = 0) uniform sampler2D depthBuffer;
+
+layout(std430, set = 0, binding = 1) writeonly buffer HiZBuffer {
+	float HiZ[];
+};
+
+layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+void main()
+{
+	uvec2 texel = gl_GlobalInvocationID.xy;
+	if (texel.x >= HiZSize.x || texel.y >= HiZSize.y)
+		return;
+
+	uvec2 begin = texel * DepthSize / HiZSize;
+	uvec2 end = max(((texel + 1) * DepthSize + HiZSize - 1) / HiZSize, begin + 1);
+	end = min(end, DepthSize);
+
+	float maxDepth = 0.0;
+	for (uint y = begin.y; y < end.y; y++)
+	{
+		for (uint x = begin.x; x < end.x; x++)
+			maxDepth = max(maxDepth, texelFetch(depthBuffer, ivec2(x, y), 0).r);
+	}
+
+	HiZ[texel.y * HiZSize.x + texel.x] = maxDepth;
+}
@@ -0,0 +1,28 @@
+#COMPUTE
+#version 450 core
+
+// Stretches the render extent of the main output over the display extent with bilinear filtering
+
+layout(push_constant) uniform UpscaleConstant {
+	uvec2 DisplaySize;
+	uvec2 RenderSize;
+};
+
+layout(set = 0, binding = 0, rgba32f) uniform writeonly image2D Output;
+layout(set = 0, binding = 1) uniform sampler2D Source;
+
+layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+void main()
+{
+	uvec2 texel = gl_GlobalInvocationID.xy;
+	if (texel.x >= DisplaySize.x || texel.y >= DisplaySize.y)
+		return;
+
+	// Both images sit in the top left corner of larger textures, samples are kept half a texel inside the rendered
+	// region so filtering never reads past it
+	vec2 sourceSize = vec2(textureSize(Source, 0));
+	vec2 position = (vec2(texel) + 0.5) / vec2(DisplaySize) * vec2(RenderSize);
+	position = clamp(position, vec2(0.5), vec2(RenderSize) - 0.5);
+
+	imageStore(Output, ivec2(texel), texture(Source, position / sourceSize));
+}
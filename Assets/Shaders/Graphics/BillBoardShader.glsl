@@ -57,7 +57,7 @@ void main()
 layout(location = 0) out vec4 color;
 layout(location = 0) in vec2 uv;
 
-layout(set = 1, binding = 0) uniform sampler2D[4096] textures;
+layout(set = 1, binding = 0) uniform sampler2D textures[];
 
 layout(push_constant) uniform PC2 {
     layout(offset = 32) uint index;  
@@ -8,9 +8,9 @@ layout(location = 3) in vec2 uv;
 layout(location = 4) in vec4 color;
 
 layout(location = 0) out vec2 _uv;
-layout(location = 1) out vec3 _fragPos;
 layout(location = 2) out mat3 _tbn;
 layout(location = 5) out vec3 _normal;
+layout(location = 6) flat out uint _materialIndex;
 
 struct CameraData
 {
@@ -24,19 +24,36 @@ layout(set = 0, binding = 0) uniform CameraBuffer {
     CameraData Camera;
 };
 
-layout(push_constant) uniform PushConstantBlock {
-    mat4 transform;
+struct ObjectData
+{
+	mat4 Transform;
+	vec4 BoundingSphere;
+	uint MaterialIndex;
+};
+
+layout(std430, set = 3, binding = 0) readonly buffer ObjectBuffer {
+	ObjectData objects[];
 };
 
+layout(std430, set = 4, binding = 0) readonly buffer InstanceBuffer {
+	uint instanceObjectIndices[];
+};
+
+// Must match DepthPrePassShader.glsl exactly when the depth pre-pass runs
+invariant gl_Position;
+
 void main()
 {
+	ObjectData object = objects[instanceObjectIndices[gl_InstanceIndex]];
+	mat4 transform = object.Transform;
+
+	_materialIndex = object.MaterialIndex;
 	vec3 T = normalize(vec3(transform * vec4(tangent.xyz, 0.0)));
 	vec3 N = normalize(vec3(transform * vec4(normal, 0.0)));
 	vec3 B = normalize(cross(N, T));
 	_tbn = mat3(T, B, N);
 	_uv = uv;
 	_normal = N;
-	_fragPos = (transform * vec4(position, 1.0)).xyz;
 	gl_Position = Camera.ViewProj * transform * vec4(position, 1);
 }
 
@@ -44,19 +61,16 @@ void main()
 #version 460 core
 #extension GL_EXT_nonuniform_qualifier : enable
 
-#define MAX_MATERIALS 800
-
 #define UINT32_MAX 0xFFFFFFFF
 
 layout(location = 0) in vec2 uv;
-layout(location = 1) in vec3 FragPos;
 layout(location = 2) in mat3 TBN;
 layout(location = 5) in vec3 normal;
+layout(location = 6) flat in uint MaterialIndex;
 
-layout(location = 0) out vec4 Albedo;
-layout(location = 1) out vec4 Position;
-layout(location = 2) out vec4 OutNormal;
-layout(location = 3) out vec4 PBRFactors; // Metallic, Roughness, AO, Emissive
+layout(location = 0) out vec4 Albedo; // sRGB target
+layout(location = 1) out vec4 OutNormal; // Octahedral encoded in xy, the target only has two channels
+layout(location = 2) out vec4 PBRFactors; // Metallic, Roughness, AO, Emissive
 
 struct Material 
 {
@@ -76,17 +90,21 @@ struct Material
 };
 
 // Bindless Texture Descriptor Set
-layout(set = 1, binding = 0) uniform sampler2D textures[4096];
+layout(set = 1, binding = 0) uniform sampler2D textures[];
 
 // Bindless Material Descriptor Set
-layout(set = 2, binding = 0) uniform MaterialBuffer {
-    Material materials[MAX_MATERIALS];
-};
-
-layout(push_constant) uniform PushConstantBlock {
-    layout(offset = 64) uint MaterialIndex;
+layout(std430, set = 2, binding = 0) readonly buffer MaterialBuffer {
+    Material materials[];
 };
 
+// Folds the unit sphere onto the [-1, 1] square, DeferredLightingPass.glsl has the matching decode and
+// Graphics/OctahedralNormal.h a CPU copy of both
+vec2 EncodeOctahedral(vec3 n)
+{
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	vec2 signs = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return n.z >= 0.0 ? n.xy : (1.0 - abs(n.yx)) * signs;
+}
 
 void main()
 {
@@ -95,24 +113,22 @@ void main()
 	vec2 scaledUV = uv * material.TextureScale;
 
 	// Albedo
-	Albedo = vec4(material.AlbedoColor.rgb * texture(textures[material.AlbedoIndex], scaledUV).rgb, 1);
+	Albedo = vec4(material.AlbedoColor.rgb * texture(textures[nonuniformEXT(material.AlbedoIndex)], scaledUV).rgb, 1);
 
 	// Normal
-	vec3 normalTS = texture(textures[material.NormalIndex], scaledUV).xyz * 2.0 - 1.0;
-	OutNormal = vec4(normalize(TBN * normalTS), 1);
-
-	// World Position
-	Position = vec4(FragPos, 1);
+	vec3 normalTS = texture(textures[nonuniformEXT(material.NormalIndex)], scaledUV).xyz * 2.0 - 1.0;
+	OutNormal = vec4(EncodeOctahedral(normalize(TBN * normalTS)), 0, 0);
 
 	// Metallic Factor
-    PBRFactors.r = texture(textures[material.MetalnessIndex], scaledUV).r * material.MetalnessFactor;
+    PBRFactors.r = texture(textures[nonuniformEXT(material.MetalnessIndex)], scaledUV).r * material.MetalnessFactor;
 
 	// Roughness Factor
-    PBRFactors.g = clamp(texture(textures[material.RoughnessIndex], scaledUV).r * material.RoughnessFactor, 0.005, 0.999);
+    PBRFactors.g = clamp(texture(textures[nonuniformEXT(material.RoughnessIndex)], scaledUV).r * material.RoughnessFactor, 0.005, 0.999);
 
 	// Ambient Occlusion
-    PBRFactors.b = texture(textures[material.AOIndex], scaledUV).r * material.AOFactor;
+    PBRFactors.b = texture(textures[nonuniformEXT(material.AOIndex)], scaledUV).r * material.AOFactor;
 
-	PBRFactors.a = texture(textures[material.EmissiveIndex], scaledUV).r;
+	// Emissive, a mask the lighting pass scales the albedo by
+	PBRFactors.a = texture(textures[nonuniformEXT(material.EmissiveIndex)], scaledUV).r;
 }
 
@@ -0,0 +1,50 @@
+#VERTEX
+#version 460 core
+
+// Only the position of the interleaved vertex is fetched, see the DepthPrePass pipeline
+layout(location = 0) in vec3 position;
+
+struct CameraData
+{
+    mat4 ViewProj;
+    mat4 View;
+	mat4 Proj;
+	vec3 Pos;
+	vec3 ViewDir;
+};
+
+layout(set = 0, binding = 0) uniform CameraBuffer {
+    CameraData Camera;
+};
+
+struct ObjectData
+{
+	mat4 Transform;
+	vec4 BoundingSphere;
+	uint MaterialIndex;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer ObjectBuffer {
+	ObjectData objects[];
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer InstanceBuffer {
+	uint instanceObjectIndices[];
+};
+
+// The G-buffer pass tests for equal depth, so both have to compute the position the same way
+invariant gl_Position;
+
+void main()
+{
+	mat4 transform = objects[instanceObjectIndices[gl_InstanceIndex]].Transform;
+	gl_Position = Camera.ViewProj * transform * vec4(position, 1);
+}
+
+#FRAGMENT
+#version 460 core
+
+void main()
+{
+    // Depth is written automatically from gl_FragCoord.z
+}
@@ -0,0 +1,49 @@
+#VERTEX
+#version 460 core
+#extension GL_ARB_shader_viewport_layer_array : require
+
+#define MAX_CASCADES 10
+
+// Only the position of the interleaved vertex is fetched
+layout(location = 0) in vec3 position;
+
+layout(set = 0, binding = 0) uniform Cascades {
+    mat4 cascadeViewProj[MAX_CASCADES];
+    vec4 cascadeSplits[MAX_CASCADES];
+    uint cascadeCount;
+} ubo;
+
+struct ObjectData
+{
+	mat4 Transform;
+	vec4 BoundingSphere;
+	uint MaterialIndex;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer ObjectBuffer {
+	ObjectData objects[];
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer InstanceBuffer {
+	uint instanceObjectIndices[];
+};
+
+// Draws are culled per cascade on the CPU so each one only targets a single layer
+layout(push_constant) uniform CascadeConstant {
+    uint cascade;
+} pc;
+
+void main()
+{
+	mat4 transform = objects[instanceObjectIndices[gl_InstanceIndex]].Transform;
+	gl_Position = ubo.cascadeViewProj[pc.cascade] * transform * vec4(position, 1);
+	gl_Layer = int(pc.cascade);
+}
+
+#FRAGMENT
+#version 460 core
+
+void main()
+{
+    // Depth is written automatically from gl_FragCoord.z
+}
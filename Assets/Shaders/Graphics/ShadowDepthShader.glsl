@@ -8,15 +8,27 @@ layout(location = 2) in vec3 tangent;
 layout(location = 3) in vec2 uv;
 layout(location = 4) in vec4 color;
 
-layout(push_constant) uniform PushConstantBlock {
-    mat4 transform;
-} pc;
+struct ObjectData
+{
+	mat4 Transform;
+	vec4 BoundingSphere;
+	uint MaterialIndex;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer ObjectBuffer {
+	ObjectData objects[];
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer InstanceBuffer {
+	uint instanceObjectIndices[];
+};
 
 layout(location = 0) out vec3 vWorldPos;
 
 void main()
 {
-	vec4 worldPos = pc.transform * vec4(position, 1);
+	mat4 transform = objects[instanceObjectIndices[gl_InstanceIndex]].Transform;
+	vec4 worldPos = transform * vec4(position, 1);
     gl_Position = worldPos;
 }
 
@@ -26,7 +38,7 @@ void main()
 #define MAX_CASCADES 10
 
 layout(triangles) in;
-layout(triangle_strip, max_vertices = 3 * MAX_CASCADES) out;
+layout(triangle_strip, max_vertices = 3) out;
 
 layout(set = 0, binding = 0) uniform Cascades {
     mat4 cascadeViewProj[MAX_CASCADES];
@@ -34,15 +46,18 @@ layout(set = 0, binding = 0) uniform Cascades {
     uint cascadeCount;
 } ubo;
 
+// Draws are culled per cascade on the CPU so each one only targets a single layer
+layout(push_constant) uniform CascadeConstant {
+    uint cascade;
+} pc;
+
 void main() {
-    for (int layer = 0; layer < ubo.cascadeCount; ++layer) {
-        for (int i = 0; i < 3; ++i) {
-            gl_Position = ubo.cascadeViewProj[layer] * gl_in[i].gl_Position;
-            gl_Layer = layer;
-            EmitVertex();
-        }
-        EndPrimitive();
+    for (int i = 0; i < 3; ++i) {
+        gl_Position = ubo.cascadeViewProj[pc.cascade] * gl_in[i].gl_Position;
+        gl_Layer = int(pc.cascade);
+        EmitVertex();
     }
+    EndPrimitive();
 }
 
 #FRAGMENT
@@ -36,6 +36,7 @@ EditorLayer::EditorLayer(Ref<Mule::EngineContext> context)
 	mSceneRendererSettingsPanel.SetContext(mEditorState, context);
 	mPrimitiveObjectPanel.SetContext(mEditorState, context);
 	mPerformancePanel.SetContext(mEditorState, context);
+	mRenderGraphPanel.SetContext(mEditorState, context);
 	mEnvironmentMapGeneratorPanel.SetContext(mEditorState, context);
 
 	mSceneHierarchyPanel.OnAttach();
@@ -48,6 +49,7 @@ EditorLayer::EditorLayer(Ref<Mule::EngineContext> context)
 	mSceneRendererSettingsPanel.OnAttach();
 	mPrimitiveObjectPanel.OnAttach();
 	mPerformancePanel.OnAttach();
+	mRenderGraphPanel.OnAttach();
 	mEnvironmentMapGeneratorPanel.OnAttach();
 
 	mAssetManagerPanel.Close();
@@ -96,6 +98,7 @@ void EditorLayer::OnEvent(Ref<Mule::Event> event)
 	mSceneRendererSettingsPanel.OnEngineEvent(event);
 	mPrimitiveObjectPanel.OnEngineEvent(event);
 	mPerformancePanel.OnEngineEvent(event);
+	mRenderGraphPanel.OnEngineEvent(event);
 }
 
 void EditorLayer::OnAttach()
@@ -189,6 +192,7 @@ void EditorLayer::OnUIRender(float dt)
 			ImGui::MenuItem("Components", "", mComponentPanel.OpenPtr());
 			ImGui::MenuItem("Material Editor", "", mMaterialEditorPanel.OpenPtr());
 			ImGui::MenuItem("Performance", "", mPerformancePanel.OpenPtr());
+			ImGui::MenuItem("Render Graph", "", mRenderGraphPanel.OpenPtr());
 			ImGui::MenuItem("Scene Hierarchy", "", mSceneHierarchyPanel.OpenPtr());
 			ImGui::MenuItem("Scene View", "", mSceneViewPanel.OpenPtr());
 			ImGui::MenuItem("Texture Viewer", "", mTextureViewerPanel.OpenPtr());
@@ -236,6 +240,7 @@ void EditorLayer::OnUIRender(float dt)
 		mSceneRendererSettingsPanel.OnEditorEvent(event);
 		mPrimitiveObjectPanel.OnEditorEvent(event);
 		mPerformancePanel.OnEditorEvent(event);
+		mRenderGraphPanel.OnEditorEvent(event);
 		mEnvironmentMapGeneratorPanel.OnEditorEvent(event);
 	}
 
@@ -252,6 +257,7 @@ void EditorLayer::OnUIRender(float dt)
 	mSceneRendererSettingsPanel.OnUIRender(dt);
 	mPrimitiveObjectPanel.OnUIRender(dt);
 	mPerformancePanel.OnUIRender(dt);
+	mRenderGraphPanel.OnUIRender(dt);
 	mEnvironmentMapGeneratorPanel.OnUIRender(dt);
 
 	NewItemPopup(mNewScenePopup, "Scene", ".scene", mEditorState->GetAssetsPath(), [&](const fs::path& filepath) {
@@ -14,6 +14,7 @@
 #include "Panel/SceneRendererSettingsPanel.h"
 #include "Panel/PrimitiveObjectPanel.h"
 #include "Panel/PerformancePanel.h"
+#include "Panel/RenderGraphPanel.h"
 #include "Panel/EnvironmentMapGeneratorPanel.h"
 
 
@@ -47,6 +48,7 @@ private:
 	SceneRendererSettingsPanel mSceneRendererSettingsPanel;
 	PrimitiveObjectPanel mPrimitiveObjectPanel;
 	PerformancePanel mPerformancePanel;
+	RenderGraphPanel mRenderGraphPanel;
 	EnvironmentMapGeneratorPanel mEnvironmentMapGeneratorPanel;
 
 	bool mShowDemoWindow = false;
@@ -41,14 +41,19 @@ void ComponentPanel::OnUIRender(float dt)
 			DisplayRow("ID");
 			ImGui::Separator();
 
+			bool transformModified = false;
 			DisplayRow("Translation");
-			entityModified |= ImGuiExtension::Vec3("Translation", transform.Translation);
+			transformModified |= ImGuiExtension::Vec3("Translation", transform.Translation);
 		
 			DisplayRow("Rotation");
-			entityModified |= ImGuiExtension::Vec3("Rotation", transform.Rotation);
+			transformModified |= ImGuiExtension::Vec3("Rotation", transform.Rotation);
 		
 			DisplayRow("Scale");
-			entityModified |= ImGuiExtension::Vec3("Scale", transform.Scale, glm::vec3(1.f));
+			transformModified |= ImGuiExtension::Vec3("Scale", transform.Scale, glm::vec3(1.f));
+
+			if (transformModified)
+				e.MarkChanged<Mule::TransformComponent>();
+			entityModified |= transformModified;
 		
 			ImGui::EndTable();
 		}
@@ -168,7 +173,14 @@ void ComponentPanel::OnUIRender(float dt)
 			const std::string null = "";
 
 			DisplayRow("Visible");
-			entityModified |= ImGui::Checkbox("##MeshVisible", &mesh.Visible);
+			if (ImGui::Checkbox("##MeshVisible", &mesh.Visible))
+			{
+				e.MarkChanged<Mule::MeshComponent>();
+				entityModified = true;
+			}
+
+			DisplayRow("Static");
+			entityModified |= ImGui::Checkbox("##MeshStatic", &mesh.Static);
 
 			ImGui::BeginDisabled();
 			DisplayRow("Mesh");
@@ -190,6 +202,7 @@ void ComponentPanel::OnUIRender(float dt)
 				if (ddf.AssetType == Mule::AssetType::Material)
 				{
 					mesh.MaterialHandle = ddf.AssetHandle;
+					e.MarkChanged<Mule::MeshComponent>();
 				}
 			}
 
@@ -203,6 +216,9 @@ void ComponentPanel::OnUIRender(float dt)
 			DisplayRow("Radiance");
 			entityModified |= ImGui::DragFloat("##Radiance", &light.Radiance, 1.f, 0.f, FLT_MAX, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 
+			DisplayRow("Range");
+			entityModified |= ImGui::DragFloat("##Range", &light.Range, 0.1f, 0.f, FLT_MAX, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+
 			DisplayRow("Color");
 			entityModified |= ImGui::ColorEdit3("##Color", &light.Color[0], ImGuiColorEditFlags_NoLabel | ImGuiColorEditFlags_NoInputs);
 			});
@@ -220,6 +236,9 @@ void ComponentPanel::OnUIRender(float dt)
 			DisplayRow("Fall Off");
 			entityModified |= ImGui::DragFloat("##FallOff", &light.FallOff, 0.01f, 0.f, 180.f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 
+			DisplayRow("Range");
+			entityModified |= ImGui::DragFloat("##Range", &light.Range, 0.1f, 0.f, FLT_MAX, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+
 			DisplayRow("Color");
 			entityModified |= ImGui::ColorEdit3("##Color", &light.Color[0], ImGuiColorEditFlags_NoLabel | ImGuiColorEditFlags_NoInputs);
 			});
@@ -23,23 +23,54 @@ void PerformancePanel::OnUIRender(float dt)
 		ImGui::Text("Frame Time: %.3fms", ms);
 		ImGui::Text("FPS: %.f", 1.f / dt);
 
-		/*
-		auto stats = sceneRenderer->GetRenderStats();
+		const Mule::RenderStats& stats = Mule::Renderer::Get().GetStats();
 
 		ImGui::Text("Data Prep Time: %.3fms", stats.CPUPrepareTime * 1e3f);
 		ImGui::Text("Execution Time: %.3fms", stats.CPUExecutionTime * 1e3f);
+		ImGui::Text("GPU Wait Time: %.3fms (%u frames in flight)", stats.CPUWaitTime * 1e3f, stats.FramesInFlight);
+		ImGui::Text("Views: %u", stats.ViewCount);
+		ImGui::Text("Draws: %u", stats.DrawCount);
+		ImGui::Text("Triangles: %llu", (unsigned long long)stats.TriangleCount);
+		ImGui::Text("Descriptor Updates: %u", stats.DescriptorUpdates);
+		ImGui::Text("Uploads: %u (%.1fKB)", stats.Uploads, stats.UploadBytes / 1024.f);
+		ImGui::Text("Barriers: %u (%u images)", stats.Barriers, stats.ImageBarriers);
+		ImGui::Text("Queue Submits: %u", stats.QueueSubmits);
+		ImGui::Text("Culled Passes: %u", stats.CulledPasses);
+		ImGui::Text("Aliased Memory Saved: %.1fMB", stats.AliasedMemorySaved / (1024.f * 1024.f));
+		ImGui::Text("Render Scale: %.2f", stats.RenderScale);
+
+		if (ImGui::TreeNode("Dynamic Resolution"))
+		{
+			Mule::DynamicResolutionSettings settings = Mule::Renderer::Get().GetDynamicResolution();
+			float targetMs = settings.TargetGPUTime * 1e3f;
+
+			bool changed = ImGui::Checkbox("Enabled", &settings.Enabled);
+			changed |= ImGui::DragFloat("GPU Budget (ms)", &targetMs, 0.1f, 1.f, 100.f);
+			changed |= ImGui::SliderFloat("Min Scale", &settings.MinScale, 0.25f, 1.f);
+
+			if (changed)
+			{
+				settings.TargetGPUTime = targetMs * 1e-3;
+				Mule::Renderer::Get().SetDynamicResolution(settings);
+			}
+
+			ImGui::TreePop();
+		}
+
+		bool vertexShadowLayers = Mule::Renderer::Get().GetVertexShadowLayers();
+		if (ImGui::Checkbox("Vertex Shadow Layers", &vertexShadowLayers))
+			Mule::Renderer::Get().SetVertexShadowLayers(vertexShadowLayers);
 
 		for (const auto& renderPassStats : stats.RenderPassStats)
 		{
 			if (ImGui::TreeNode(renderPassStats.Name.c_str()))
 			{
-				ImGui::Text("CPU Record Time: %.3f", renderPassStats.CPUExecutionTime * 1e3f);
-				ImGui::Text("GPU Execution Time: %.3f", renderPassStats.GPUExecutionTime * 1e3f);
+				ImGui::Text("CPU Record Time: %.3fms", renderPassStats.CPUExecutionTime * 1e3f);
+				ImGui::Text("GPU Execution Time: %.3fms", renderPassStats.GPUExecutionTime * 1e3f);
 				
 				ImGui::TreePop();
 			}
 		}
-		*/
 	}
 	ImGui::End();
 }
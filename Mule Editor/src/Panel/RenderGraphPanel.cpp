@@ -0,0 +1,197 @@
+#include "RenderGraphPanel.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+RenderGraphPanel::RenderGraphPanel()
+	:
+	IPanel("Render Graph")
+{
+}
+
+RenderGraphPanel::~RenderGraphPanel()
+{
+}
+
+void RenderGraphPanel::OnAttach()
+{
+}
+
+void RenderGraphPanel::OnUIRender(float dt)
+{
+	if (!mIsOpen) return;
+	if (ImGui::Begin(mName.c_str(), &mIsOpen))
+	{
+		if (mLive || ImGui::Button("Capture"))
+			mDump = Mule::Renderer::Get().DumpRenderGraph();
+
+		if (!mLive)
+			ImGui::SameLine();
+
+		ImGui::Checkbox("Live", &mLive);
+
+		ImGui::SameLine();
+		if (ImGui::Button("Save Graphviz"))
+			Save("RenderGraph.dot", Mule::ToGraphviz(mDump));
+
+		ImGui::SameLine();
+		if (ImGui::Button("Save JSON"))
+			Save("RenderGraph.json", Mule::ToJson(mDump));
+
+		if (ImGui::CollapsingHeader("Passes", ImGuiTreeNodeFlags_DefaultOpen))
+			DrawPasses();
+
+		if (ImGui::CollapsingHeader("Resources", ImGuiTreeNodeFlags_DefaultOpen))
+			DrawResources();
+	}
+	ImGui::End();
+}
+
+void RenderGraphPanel::OnEditorEvent(Ref<IEditorEvent> event)
+{
+}
+
+void RenderGraphPanel::DrawPasses()
+{
+	if (!ImGui::BeginTable("Passes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
+		return;
+
+	ImGui::TableSetupColumn("Pass");
+	ImGui::TableSetupColumn("Queue");
+	ImGui::TableSetupColumn("State");
+	ImGui::TableSetupColumn("CPU");
+	ImGui::TableSetupColumn("GPU");
+	ImGui::TableHeadersRow();
+
+	for (uint32_t i = 0; i < mDump.Passes.size(); i++)
+	{
+		const Mule::DumpPass& pass = mDump.Passes[i];
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		ImGui::PushID(i);
+		bool open = ImGui::TreeNodeEx(pass.Name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+		ImGui::PopID();
+
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(pass.Queue.c_str());
+
+		ImGui::TableNextColumn();
+		if (!pass.Enabled)
+			ImGui::TextDisabled("Disabled");
+		else if (!pass.Running)
+			ImGui::TextDisabled(pass.Shared ? "Shared" : "Culled");
+		else
+			ImGui::TextUnformatted("Running");
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3fms", pass.CPUTime * 1e3f);
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3fms", pass.GPUTime * 1e3f);
+
+		if (!open)
+			continue;
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+
+		if (pass.WaitPass != UINT32_MAX)
+			ImGui::Text("Waits on %s", mDump.Passes[pass.WaitPass].Name.c_str());
+
+		for (const auto& edge : mDump.Edges)
+		{
+			if (edge.To != i)
+				continue;
+
+			if (edge.Resource.empty())
+				ImGui::Text("After %s", mDump.Passes[edge.From].Name.c_str());
+			else
+				ImGui::Text("%s from %s", edge.Resource.c_str(), mDump.Passes[edge.From].Name.c_str());
+		}
+
+		for (const auto& resource : pass.Resources)
+			ImGui::BulletText("%s %s", resource.Write ? "Writes" : "Reads", resource.Name.c_str());
+
+		for (const auto& barrier : pass.Barriers)
+		{
+			ImGui::BulletText("%s barrier: %s -> %s%s%s%s", barrier.AfterDraw ? "Post" : "Pre", barrier.Resource.c_str(), barrier.Layout.c_str(),
+				barrier.Discard ? " (discard)" : "", barrier.Ownership.empty() ? "" : " ", barrier.Ownership.c_str());
+		}
+
+		for (const auto& clear : pass.Clears)
+			ImGui::BulletText("Clears %s", clear.c_str());
+
+		ImGui::TreePop();
+	}
+
+	ImGui::EndTable();
+}
+
+void RenderGraphPanel::DrawResources()
+{
+	if (!ImGui::BeginTable("Resources", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
+		return;
+
+	ImGui::TableSetupColumn("Resource");
+	ImGui::TableSetupColumn("Lifetime", ImGuiTableColumnFlags_None, 2.f);
+	ImGui::TableSetupColumn("Alias Group");
+	ImGui::TableSetupColumn("Size");
+	ImGui::TableHeadersRow();
+
+	float passCount = static_cast<float>(std::max<size_t>(mDump.Passes.size(), 1));
+
+	for (const auto& resource : mDump.Resources)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(resource.Name.c_str());
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("%s", resource.Type.c_str());
+
+		// Spans the passes using the resource, resources sharing memory get the same color
+		ImGui::TableNextColumn();
+		ImVec2 min = ImGui::GetCursorScreenPos();
+		float width = ImGui::GetContentRegionAvail().x;
+		float height = ImGui::GetTextLineHeight();
+
+		ImU32 color = resource.AliasGroup == UINT32_MAX
+			? ImGui::GetColorU32(ImGuiCol_PlotHistogram)
+			: static_cast<ImU32>(ImColor::HSV(std::fmod(resource.AliasGroup * 0.17f, 1.f), 0.6f, 0.9f));
+
+		float begin = min.x + width * resource.FirstPass / passCount;
+		float end = min.x + width * (resource.LastPass + 1) / passCount;
+		ImGui::GetWindowDrawList()->AddRectFilled({ begin, min.y }, { end, min.y + height }, color);
+		ImGui::Dummy({ width, height });
+
+		if (ImGui::IsItemHovered() && resource.LastPass < mDump.Passes.size())
+			ImGui::SetTooltip("%s to %s", mDump.Passes[resource.FirstPass].Name.c_str(), mDump.Passes[resource.LastPass].Name.c_str());
+
+		ImGui::TableNextColumn();
+		if (resource.AliasGroup != UINT32_MAX)
+			ImGui::Text("%u", resource.AliasGroup);
+
+		ImGui::TableNextColumn();
+		if (resource.Size > 0)
+			ImGui::Text("%.1fMB", resource.Size / (1024.f * 1024.f));
+	}
+
+	ImGui::EndTable();
+}
+
+void RenderGraphPanel::Save(const std::string& filename, const std::string& contents)
+{
+	fs::path path = mEditorContext->GetProjectPath() / filename;
+
+	std::ofstream file(path);
+	if (!file)
+	{
+		SPDLOG_ERROR("Failed to write {}", path.string());
+		return;
+	}
+
+	file << contents;
+	SPDLOG_INFO("Render graph saved to {}", path.string());
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "IPanel.h"
+
+#include "Graphics/Renderer/RenderGraph/RenderGraphDump.h"
+
+class RenderGraphPanel : public IPanel
+{
+public:
+	RenderGraphPanel();
+	virtual ~RenderGraphPanel();
+
+	// Inherited via IPanel
+	void OnAttach() override;
+
+	void OnUIRender(float dt) override;
+
+	void OnEditorEvent(Ref<IEditorEvent> event) override;
+	virtual void OnEngineEvent(Ref<Mule::Event> event) override {}
+
+private:
+	void DrawPasses();
+	void DrawResources();
+	void Save(const std::string& filename, const std::string& contents);
+
+	Mule::RenderGraphDump mDump;
+	bool mLive = true;
+};
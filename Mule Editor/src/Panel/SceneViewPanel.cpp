@@ -108,6 +108,9 @@ void SceneViewPanel::OnUIRender(float dt)
 					if (ImGui::SliderFloat("Near Plane", &nearPlane, 0.1f, farPlane - 1.f)) mEditorContext->GetEditorCamera().SetNearPlane(nearPlane);
 					if (ImGui::SliderFloat("Far Plane", &farPlane, nearPlane + 1.f, 10000.f)) mEditorContext->GetEditorCamera().SetFarPlane(farPlane);
 
+					bool depthPrePass = mEditorContext->GetEditorCamera().GetDepthPrePass();
+					if (ImGui::Checkbox("Depth Pre-Pass", &depthPrePass)) mEditorContext->GetEditorCamera().SetDepthPrePass(depthPrePass);
+
 					ImGui::SeparatorText("Gizmos");
 					ImGui::Text("Translation Snap");
 					ImGui::DragFloat3("##TranslationSnap", &mTranslationSnap[0], 1.f, 0.f, FLT_MAX, "%.2f", ImGuiSliderFlags_AlwaysClamp);
@@ -140,6 +143,7 @@ void SceneViewPanel::OnUIRender(float dt)
 		ImVec2 cursorPos = ImGui::GetCursorScreenPos();
 		region = ImGui::GetContentRegionAvail();
 		ImTextureID texId = mBlackImage->GetImGuiID();
+		glm::vec2 uv = glm::vec2(1.f);
 		if (scene)
 		{			
 			if (region.x != mWidth || region.y != mHeight)
@@ -157,10 +161,11 @@ void SceneViewPanel::OnUIRender(float dt)
 			if (view)
 			{
 				texId = view->GetImGuiID();
+				uv = editorCamera->GetColorOutputUV();
 			}
 		}
 
-		ImGui::Image(texId, region);
+		ImGui::Image(texId, region, ImVec2(0.f, 0.f), ImVec2(uv.x, uv.y));
 
 		HandleDragDrop();
 		UpdateCamera(dt);
@@ -346,6 +351,7 @@ void SceneViewPanel::UpdateGizmos(ImVec2 cursorPos)
 				mGizmoSnap))
 			{
 				ImGuizmo::DecomposeMatrixToComponents(&transformMatrix[0][0], &transform.Translation[0], &transform.Rotation[0], &transform.Scale[0]);
+				mEditorContext->GetSelectedEntity().MarkChanged<Mule::TransformComponent>();
 			}
 		}
 	}
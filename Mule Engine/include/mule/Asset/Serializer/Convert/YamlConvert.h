@@ -293,6 +293,7 @@ namespace YAML {
             node["Visible"] = mesh.Visible;
             node["MeshHandle"] = mesh.MeshHandle;
             node["MaterialHandle"] = mesh.MaterialHandle;
+            node["Static"] = mesh.Static;
 
             return node;
         }
@@ -302,6 +303,8 @@ namespace YAML {
             mesh.Visible = node["Visible"].as<bool>();
             mesh.MeshHandle = node["MeshHandle"].as<Mule::AssetHandle>();
             mesh.MaterialHandle = node["MaterialHandle"].as<Mule::AssetHandle>();
+            if (node["Static"])
+                mesh.Static = node["Static"].as<bool>();
 
             return true;
         }
@@ -337,6 +340,7 @@ namespace YAML {
             node["Active"] = light.Active;
             node["Color"] = light.Color;
             node["Radiance"] = light.Radiance;
+            node["Range"] = light.Range;
 
             return node;
         }
@@ -346,6 +350,8 @@ namespace YAML {
             light.Active = node["Active"].as<bool>();
             light.Color = node["Color"].as<glm::vec3>();
             light.Radiance = node["Radiance"].as<float>();
+            if (node["Range"])
+                light.Range = node["Range"].as<float>();
 
             return true;
         }
@@ -361,6 +367,7 @@ namespace YAML {
             node["Radiance"] = light.Radiance;
             node["Angle"] = light.Angle;
             node["FallOff"] = light.FallOff;
+            node["Range"] = light.Range;
 
             return node;
         }
@@ -372,6 +379,8 @@ namespace YAML {
             light.Radiance = node["Radiance"].as<float>();
             light.Angle = node["Angle"].as<float>();
             light.FallOff = node["FallOff"].as<float>();
+            if (node["Range"])
+                light.Range = node["Range"].as<float>();
 
             return true;
         }
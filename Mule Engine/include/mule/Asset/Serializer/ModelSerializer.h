@@ -53,6 +53,11 @@ namespace Mule
 			glm::vec3 Max;
 		};
 
+		// Level of detail chain generated for every imported mesh
+		static constexpr uint32_t sMaxLodLevels = 5;
+		static constexpr float sLodReduction = 0.5f;
+		static constexpr uint32_t sMinLodTriangles = 64;
+
 		void RecurseNodes(const aiNode* ainode, ModelNode& node, LoadInfo& info);
 		Ref<Mesh> LoadMesh(const aiMesh* mesh, LoadInfo& info);
 		Ref<Material> LoadMaterial(const aiMaterial* material, LoadInfo& info);
@@ -102,6 +102,7 @@ namespace Mule
 
 		bool Active = true;
 		float Radiance = 1.f;
+		float Range = 10.f;
 		glm::vec3 Color = glm::vec3(1.f);
 	};
 
@@ -114,6 +115,7 @@ namespace Mule
 		float Radiance = 1.f;
 		float Angle = 45.f;
 		float FallOff = 5.f;
+		float Range = 10.f;
 		glm::vec3 Color = glm::vec3(1.f);
 	};
 
@@ -136,6 +138,7 @@ namespace Mule
 		AssetHandle MeshHandle;
 		AssetHandle MaterialHandle;
 		bool CastsShadows = true;
+		bool Static = false; // Never moves, its shadow is cached and only drawn again when it does change
 
 		// Internal
 		uint32_t MaterialIndex = 0;
@@ -81,6 +81,18 @@ namespace Mule
 			mScene->RemoveComponent<T>(mId);
 		}
 
+		// Call after writing the component in place, see Scene::MarkChanged
+		template<typename T>
+		void MarkChanged()
+		{
+			mScene->MarkChanged<T>(mId);
+		}
+
+		void TrackScriptWrites()
+		{
+			mScene->TrackScriptWrites(mId);
+		}
+
 		bool operator==(Entity& other)
 		{
 			return mId == other.mId && mScene == other.mScene;
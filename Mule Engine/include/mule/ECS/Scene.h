@@ -15,6 +15,8 @@
 
 #include <string>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 namespace Mule
 {
@@ -63,6 +65,18 @@ namespace Mule
 			mRegistry.remove<T>(id);
 		}
 
+		// Reports a component that was written in place, the renderer only updates the objects of entities whose transform
+		// or mesh component was added or reported
+		template<typename T>
+		void MarkChanged(entt::entity id)
+		{
+			mRegistry.patch<T>(id);
+		}
+
+		// Scripts keep the component pointers they are handed and write through them at any time, the entity is reported as
+		// changed on every update from then on
+		void TrackScriptWrites(entt::entity id) { mScriptWrittenObjects.insert(id); }
+
 		template<typename T>
 		bool HasComponent(entt::entity id) const
 		{
@@ -104,7 +118,12 @@ namespace Mule
 		entt::registry mRegistry;
 		std::unordered_map<Guid, entt::entity> mEntityLookup;
 		bool mModified;
-		CommandList mCommandList;
+
+		// Entities whose object data changed since the last submitted render request, changed entities that are hidden or
+		// whose assets are still loading stay in the set until they are drawn
+		std::unordered_set<entt::entity> mChangedObjects;
+		std::vector<entt::entity> mPendingObjects;
+		std::unordered_set<entt::entity> mScriptWrittenObjects;
 
 		template<typename T>
 		static void CopyComponent(Entity dst, Entity src);
@@ -113,10 +132,12 @@ namespace Mule
 
 		// Component Sinks
 		void OnCameraComponentConstruct(entt::registry& registry, entt::entity id);
+		void OnObjectChanged(entt::registry& registry, entt::entity id);
 
 		// Command Lists
-		void RecordRuntimeDrawCommands();
-		void RecordEditorDrawCommands();
+		void RecordRuntimeDrawCommands(CommandList& commandList);
+		void RecordEditorDrawCommands(CommandList& commandList);
+		void ClearChangedObjects();
 	};
 
 }
@@ -20,6 +20,7 @@ namespace Mule
 	{
 		std::string WindowName;
 		fs::path ProjectPath;
+		uint32_t FramesInFlight = 2;
 	};
 
 	class ScriptContext;
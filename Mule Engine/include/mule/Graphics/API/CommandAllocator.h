@@ -8,12 +8,14 @@ namespace Mule
 	class CommandAllocator
 	{
 	public:
-		static Ref<CommandAllocator> Create();
+		// Command buffers can only be submitted to queues of the type their allocator was created for
+		static Ref<CommandAllocator> Create(QueueType type = QueueType::Graphics);
 		virtual ~CommandAllocator() = default;
 
 		virtual void Reset() = 0;
 
 		virtual Ref<CommandBuffer> CreateCommandBuffer() = 0;
+		virtual Ref<CommandBuffer> CreateSecondaryCommandBuffer() = 0;
 
 	private:
 	};
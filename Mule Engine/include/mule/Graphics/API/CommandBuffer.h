@@ -7,6 +7,8 @@
 #include "Graphics/API/ComputePipeline.h"
 #include "Graphics/API/StagingBuffer.h"
 #include "Graphics/API/ShaderResourceGroup.h"
+#include "Graphics/API/StorageBuffer.h"
+#include "Graphics/API/TimestampQueryPool.h"
 
 namespace Mule
 {
@@ -26,6 +28,19 @@ namespace Mule
 		uint32_t DstMipLevel = 0;
 	};
 
+	struct TextureTransition
+	{
+		WeakRef<Texture> Texture = nullptr;
+		ImageLayout NewLayout = ImageLayout::Undefined;
+		bool Discard = false; // Transition from an undefined layout, the current contents are lost
+
+		// Ownership transfers between queue families record OldLayout explicitly, both halves must match
+		QueueOwnership Ownership = QueueOwnership::None;
+		QueueType SrcQueue = QueueType::Graphics;
+		QueueType DstQueue = QueueType::Graphics;
+		ImageLayout OldLayout = ImageLayout::Undefined;
+	};
+
 	struct BeginRenderingAttachment
 	{
 		Ref<Texture2D> Attachment = nullptr;
@@ -50,12 +65,18 @@ namespace Mule
 		virtual void ClearTexture(WeakRef<Texture2D> texture) = 0;
 		virtual void EndRendering() = 0;
 
-		// New API
-		virtual void BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment) = 0;
+		// New API, a non zero render area limits rendering to the top left corner of the attachments
+		virtual void BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, bool secondaryContents = false, glm::uvec2 renderArea = glm::uvec2(0)) = 0;
 		virtual void BindPipeline(WeakRef<GraphicsPipeline> pipeline, const std::vector<WeakRef<ShaderResourceGroup>>& groups = {}) = 0;
+
+		// Clears one layer of the depth attachment inside the current rendering scope, the rest of it keeps its contents
+		virtual void ClearDepthAttachmentLayer(uint32_t layer, uint32_t width, uint32_t height) = 0;
 		
 		// Texture
 		virtual void TranistionImageLayout(WeakRef<Texture> texture, ImageLayout newLayout) = 0;
+
+		// Records every transition in one barrier, textures already in their new layout are skipped
+		virtual void TransitionImageLayouts(const std::vector<TextureTransition>& transitions) = 0;
 		virtual void CopyTexture(WeakRef<Texture> src, WeakRef<Texture> dst, const TextureCopyInfo& copyInfo) const = 0;
 		virtual void ReadTexture(WeakRef<Texture> texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, WeakRef<StagingBuffer> buffer) const = 0;
 
@@ -67,14 +88,29 @@ namespace Mule
 		virtual void SetPushConstants(WeakRef<ComputePipeline> shader, void* data, uint32_t size) = 0;
 		virtual void Execute(uint32_t workGroupsX, uint32_t workGroupsY, uint32_t workGroupsZ) = 0;
 
+		// Makes compute shader writes to buffer visible to the host once the submission has completed
+		virtual void ReadbackBarrier(WeakRef<StorageBuffer> buffer) = 0;
+
 		// Mesh
 		virtual void BindMesh(WeakRef<Mesh> mesh) = 0;
 		virtual void DrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount = 1) = 0;
 		virtual void BindAndDrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount) = 0;
 
+		// Draws the mesh that is currently bound using drawCount indexed indirect commands read from argumentBuffer starting at offset bytes
+		virtual void DrawMeshIndirect(WeakRef<StorageBuffer> argumentBuffer, uint32_t offset, uint32_t drawCount) = 0;
+
 		virtual void SetViewport(uint32_t x, uint32_t width, uint32_t y, uint32_t height) = 0;
 		virtual void SetScissor(uint32_t x, uint32_t width, uint32_t y, uint32_t height) = 0;
 
+		// Secondary command buffers, begun inside a rendering scope with these attachments and replayed by a primary
+		virtual void BeginSecondary(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, glm::uvec2 renderArea = glm::uvec2(0)) = 0;
+		virtual void ExecuteSecondary(const std::vector<Ref<CommandBuffer>>& commandBuffers) = 0;
+
+		// Queries must be reset outside of a rendering scope before they are written again. A timestamp is written once
+		// every command submitted before it has finished, so two timestamps bracket the GPU time of the work between them
+		virtual void ResetQueries(WeakRef<TimestampQueryPool> queryPool) = 0;
+		virtual void WriteTimestamp(WeakRef<TimestampQueryPool> queryPool, uint32_t query) = 0;
+
 	protected:
 		CommandBuffer() = default;
 	};
@@ -12,6 +12,9 @@ namespace Mule
 		virtual void Wait() = 0;
 		virtual void Reset() = 0;
 
+		// Non blocking check of whether the work guarded by the fence has finished
+		virtual bool IsSignaled() const = 0;
+
 	protected:
 		Fence() = default;
 	};
@@ -19,6 +19,12 @@ namespace Mule
 		void ResizeSwapchain(uint32_t width, uint32_t height);
 		void AwaitIdle();
 
+		// True when compute queues run on their own queue family alongside the graphics queue
+		bool SupportsAsyncCompute() const;
+
+		// True when vertex shaders can write gl_Layer
+		bool SupportsVertexLayerOutput() const;
+
 		inline GraphicsAPI GetAPI() const { return mAPI; }
 
 	private:
@@ -26,6 +26,12 @@ namespace Mule
 		StorageImage		= 1 << 6,
 	};
 
+	enum class BufferFlags
+	{
+		None				= 0,
+		SharedQueues		= 1 << 0, // Used by the graphics and the compute queue without ownership transfers
+	};
+
 	enum class TextureType
 	{
 		TextureType_2D,
@@ -48,6 +54,7 @@ namespace Mule
 		BGRA_8U,
 		RGBA_8U,
 		RGB_8U,
+		RGBA_8U_SRGB,
 		RGB_32F,
 
 		R_32UI,
@@ -56,6 +63,7 @@ namespace Mule
 		D_32F,
 		D_24S8,
 
+		RG_16SN,
 		RGBA_16F,
 
 		R_32F,
@@ -79,11 +87,26 @@ namespace Mule
 		General				= 1 << 6
 	};
 
+	enum class QueueType : uint32_t
+	{
+		Graphics,
+		Compute
+	};
+
+	// Queue family ownership transfers are a release barrier on the source queue followed by a matching acquire on the destination queue
+	enum class QueueOwnership
+	{
+		None,
+		Release,
+		Acquire
+	};
+
 	enum class DescriptorType
 	{
 		Texture,
 		UniformBuffer,
-		StorageImage
+		StorageImage,
+		StorageBuffer
 	};
 
 	enum class ShaderStage
@@ -122,7 +145,8 @@ namespace Mule
 	{
 		UniformBuffer,
 		Sampler,
-		StorageImage
+		StorageImage,
+		StorageBuffer
 	};
 
 	enum class SamplerFilterMode
@@ -151,6 +175,7 @@ namespace Mule
 	};
 
 	MULE_ENUM_OPERATORS(TextureFlags);
+	MULE_ENUM_OPERATORS(BufferFlags);
 	MULE_ENUM_OPERATORS(ShaderStage);
 	
 	static std::string GetTextureFormatName(TextureFormat format)
@@ -161,8 +186,10 @@ namespace Mule
 		case TextureFormat::BGRA_8U: return "BGRA8U";
 		case TextureFormat::RGBA_8U: return "RGBA8U";
 		case TextureFormat::RGB_8U: return "RGB8U";
+		case TextureFormat::RGBA_8U_SRGB: return "RGBA8U sRGB";
 		case TextureFormat::D_32F: return "Depth32F";
 		case TextureFormat::D_24S8: return "D24S8";
+		case TextureFormat::RG_16SN: return "RG16SN";
 		case TextureFormat::RGBA_16F: return "RGBA16F";
 		case TextureFormat::RGBA_32F: return "RGBA32F";
 		case TextureFormat::RGBA_32S: return "RGBA32S";
@@ -182,6 +209,8 @@ namespace Mule
 			return 3;
 		case TextureFormat::BGRA_8U:
 		case TextureFormat::RGBA_8U:
+		case TextureFormat::RGBA_8U_SRGB:
+		case TextureFormat::RG_16SN:
 		case TextureFormat::D_32F:
 		case TextureFormat::D_24S8:
 			return 4;
@@ -206,10 +235,12 @@ namespace Mule
 		case Mule::TextureFormat::BGRA_8U: return "BGRA_8U";
 		case Mule::TextureFormat::RGBA_8U: return "RGBA_8U";
 		case Mule::TextureFormat::RGB_8U: return "RGB_8U";
+		case Mule::TextureFormat::RGBA_8U_SRGB: return "RGBA_8U_SRGB";
 		case Mule::TextureFormat::R_32UI: return "R_32UI";
 		case Mule::TextureFormat::RG_32UI: return "RG_32UI";
 		case Mule::TextureFormat::D_32F: return "D_32F";
 		case Mule::TextureFormat::D_24S8: return "D_24S8";
+		case Mule::TextureFormat::RG_16SN: return "RG_16SN";
 		case Mule::TextureFormat::RGBA_16F: return "RGBA_16F";
 		case Mule::TextureFormat::R_32F: return "R_32F";
 		case Mule::TextureFormat::RGBA_32F: return "RGBA_32F";
@@ -228,10 +259,12 @@ namespace Mule
 		if (formatName == "BGRA_8U")      return Mule::TextureFormat::BGRA_8U;
 		if (formatName == "RGBA_8U")      return Mule::TextureFormat::RGBA_8U;
 		if (formatName == "RGB_8U")       return Mule::TextureFormat::RGB_8U;
+		if (formatName == "RGBA_8U_SRGB") return Mule::TextureFormat::RGBA_8U_SRGB;
 		if (formatName == "R_32UI")       return Mule::TextureFormat::R_32UI;
 		if (formatName == "RG_32UI")      return Mule::TextureFormat::RG_32UI;
 		if (formatName == "D_32F")        return Mule::TextureFormat::D_32F;
 		if (formatName == "D_24S8")       return Mule::TextureFormat::D_24S8;
+		if (formatName == "RG_16SN")      return Mule::TextureFormat::RG_16SN;
 		if (formatName == "RGBA_16F")     return Mule::TextureFormat::RGBA_16F;
 		if (formatName == "R_32F")        return Mule::TextureFormat::R_32F;
 		if (formatName == "RGBA_32F")     return Mule::TextureFormat::RGBA_32F;
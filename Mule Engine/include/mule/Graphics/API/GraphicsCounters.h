@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Mule
+{
+	struct GraphicsCounterValues
+	{
+		uint32_t DescriptorUpdates = 0;
+		uint32_t Uploads = 0;
+		uint64_t UploadBytes = 0;
+		uint32_t Barriers = 0;
+		uint32_t ImageBarriers = 0;
+		uint32_t QueueSubmits = 0;
+	};
+
+	// Running totals of the work the API wrappers hand to the driver, safe to bump from any thread
+	class GraphicsCounters
+	{
+	public:
+		static void AddDescriptorUpdate();
+		static void AddUpload(uint64_t size);
+
+		// One pipeline barrier call holding imageBarriers image barriers
+		static void AddBarrier(uint32_t imageBarriers);
+		static void AddQueueSubmit();
+
+		// Returns the totals since the previous flush and starts counting from zero again
+		static GraphicsCounterValues Flush();
+
+	private:
+		static std::atomic<uint32_t> sDescriptorUpdates;
+		static std::atomic<uint32_t> sUploads;
+		static std::atomic<uint64_t> sUploadBytes;
+		static std::atomic<uint32_t> sBarriers;
+		static std::atomic<uint32_t> sImageBarriers;
+		static std::atomic<uint32_t> sQueueSubmits;
+	};
+}
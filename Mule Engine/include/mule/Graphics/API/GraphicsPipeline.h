@@ -27,6 +27,9 @@ namespace Mule
 		float LineWidth = 1.f;
 		bool EnableBlending = false;
 		DepthFunc DepthFunc = DepthFunc::Less;
+
+		// Format of the color output at each location, reflection only sees the shader side type so packed targets have to be named here
+		std::vector<TextureFormat> ColorFormats;
 	};
 
 	class GraphicsPipeline
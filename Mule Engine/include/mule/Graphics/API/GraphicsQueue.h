@@ -7,13 +7,29 @@
 #include "CommandBuffer.h"
 #include "TimelineSemaphore.h"
 
+#include <vector>
+
 namespace Mule
 {
+	struct TimelineValue
+	{
+		Ref<TimelineSemaphore> Semaphore = nullptr;
+		uint64_t Value = 0;
+	};
+
+	// One entry of a batched submit, the command buffer starts once every wait is reached and signals Signal when done
+	struct QueueSubmission
+	{
+		Ref<Mule::CommandBuffer> CommandBuffer = nullptr;
+		std::vector<TimelineValue> Waits;
+		TimelineValue Signal;
+	};
 
 	class GraphicsQueue
 	{
 	public:
-		static Ref<GraphicsQueue> Create();
+		// Compute queues fall back to the graphics queue family when the device has no async compute
+		static Ref<GraphicsQueue> Create(QueueType type = QueueType::Graphics);
 
 		virtual ~GraphicsQueue() = default;
 
@@ -21,7 +37,14 @@ namespace Mule
 		virtual void Submit(Ref<CommandBuffer> commandBuffer, Ref<TimelineSemaphore> semaphore, uint64_t waitValue, uint64_t signalValue, Ref<Fence> fence = nullptr) = 0;
 		virtual void Submit(Ref<CommandBuffer> commandBuffer, Ref<TimelineSemaphore> waitSemaphore, uint64_t waitValue, Ref<TimelineSemaphore> signalSemaphore, uint64_t signalValue, Ref<Fence> fence = nullptr) = 0;
 
+		// Hands every submission to the driver in a single call, they start in order and the fence signals once all have finished
+		virtual void Submit(const std::vector<QueueSubmission>& submissions, Ref<Fence> fence = nullptr) = 0;
+
+		QueueType GetType() const { return mType; }
+
 	protected:
-		GraphicsQueue() = default;
+		GraphicsQueue(QueueType type) : mType(type) {}
+
+		QueueType mType;
 	};
 }
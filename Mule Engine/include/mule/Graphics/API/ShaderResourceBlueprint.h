@@ -10,18 +10,23 @@ namespace Mule
 	struct ShaderResourceDescription
 	{
 		ShaderResourceDescription() = default;
-		ShaderResourceDescription(uint32_t binding, ShaderResourceType type, ShaderStage stages, uint32_t arrayCount = 1)
+		ShaderResourceDescription(uint32_t binding, ShaderResourceType type, ShaderStage stages, uint32_t arrayCount = 1, bool unbounded = false)
 			:
 			Binding(binding),
 			Type(type),
 			Stages(stages),
-			ArrayCount(arrayCount)
+			ArrayCount(arrayCount),
+			Unbounded(unbounded)
 		{ }
 
 		uint32_t Binding;
 		ShaderResourceType Type;
 		ShaderStage Stages;
 		uint32_t ArrayCount = 1;
+
+		// Variable sized, partially bound array. The layout is sized to the device limit and ArrayCount is only
+		// the initial number of descriptors allocated, must be the last binding in its group
+		bool Unbounded = false;
 	};
 
 	class ShaderResourceBlueprint
@@ -4,6 +4,7 @@
 
 #include "Graphics/API/Texture.h"
 #include "Graphics/API/UniformBuffer.h"
+#include "Graphics/API/StorageBuffer.h"
 #include "Graphics/API/TextureView.h"
 #include "Graphics/API/Sampler.h"
 
@@ -25,6 +26,16 @@ namespace Mule
 		// Binds a Uniform buffer to a resource binding
 		virtual void Update(uint32_t binding, WeakRef<UniformBuffer> buffer, uint32_t arrayIndex = 0) = 0;
 
+		// Binds a Storage buffer to a resource binding
+		virtual void Update(uint32_t binding, WeakRef<StorageBuffer> buffer, uint32_t arrayIndex = 0) = 0;
+
+		// Grows the unbounded binding to hold at least arrayCount descriptors, returns true if the group was reallocated.
+		// Every descriptor in the group must be written again after a reallocation
+		virtual bool Reserve(uint32_t arrayCount) = 0;
+
+		// Number of descriptors allocated for the unbounded binding
+		virtual uint32_t GetArrayCapacity() const = 0;
+
 		virtual ~ShaderResourceGroup() = default;
 
 		Ref<ShaderResourceBlueprint> GetBlueprint() const { return mBlueprint; }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Ref.h"
+#include "Buffer.h"
+#include "Graphics/API/GraphicsCore.h"
+
+namespace Mule
+{
+	class StorageBuffer
+	{
+	public:
+		static Ref<StorageBuffer> Create(uint32_t size, BufferFlags flags = BufferFlags::None);
+
+		virtual ~StorageBuffer() = default;
+
+		// Writes buffer into the storage buffer starting at offset bytes
+		virtual void SetData(const Buffer& buffer, uint32_t offset = 0) = 0;
+
+		// Copies buffer.GetSize() bytes starting at offset bytes into buffer, GPU writes must have completed and been made host visible
+		virtual void ReadData(const Buffer& buffer, uint32_t offset = 0) const = 0;
+
+		// Grows the buffer so it can hold at least size bytes, returns true if the underlying buffer was recreated.
+		// Contents are not preserved and any shader resource groups referencing the buffer must be updated
+		virtual bool Reserve(uint32_t size) = 0;
+
+		uint32_t GetSize() const { return mSize; }
+
+	protected:
+		StorageBuffer(uint32_t size);
+
+		uint32_t mSize;
+	};
+}
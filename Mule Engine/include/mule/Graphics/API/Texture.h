@@ -28,6 +28,13 @@ namespace Mule
 		virtual void TransitionImageLayoutImmediate(ImageLayout newLayout) = 0;
 		virtual Buffer ReadTextureData(uint32_t mipLevel = 0) = 0;
 		virtual void WriteMipLevel(uint32_t mipLevel, const Buffer& data) = 0;
+
+		// Size of the device memory the texture needs, 0 if it can not alias
+		virtual uint64_t GetMemorySize() const { return 0; }
+
+		// Rebinds the texture to the memory of owner, the contents of both become undefined and must be written before they are read again.
+		// Returns false and keeps separate memory if the texture does not fit, a null owner gives the texture its own memory back
+		virtual bool AliasMemory(WeakRef<Texture> owner) { return false; }
 		
 		TextureFormat GetFormat() const { return mFormat; }
 		TextureFlags GetFlags() const { return mFlags; }
@@ -10,5 +10,8 @@ namespace Mule
 		static Ref<TimelineSemaphore> Create();
 
 		virtual uint64_t GetValue() const = 0;
+
+		// Blocks until the semaphore reaches value, the signal for it must already be submitted
+		virtual void Wait(uint64_t value) const = 0;
 	};
 }
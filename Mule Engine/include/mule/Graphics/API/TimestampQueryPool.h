@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Ref.h"
+#include "Graphics/API/GraphicsCore.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace Mule
+{
+	// GPU timestamps written by command buffers, results are read once the submission that wrote them has completed
+	class TimestampQueryPool
+	{
+	public:
+		// The queue the timestamps are written on, queue families can differ in how many bits of a timestamp are valid
+		static Ref<TimestampQueryPool> Create(uint32_t count, QueueType queue = QueueType::Graphics);
+
+		virtual ~TimestampQueryPool() = default;
+
+		// Timestamps in seconds, returns false if the queries have never been written or their results are not available yet
+		virtual bool GetResults(std::vector<double>& seconds) const = 0;
+
+		uint32_t GetCount() const { return mCount; }
+
+	protected:
+		TimestampQueryPool(uint32_t count);
+
+		uint32_t mCount;
+	};
+}
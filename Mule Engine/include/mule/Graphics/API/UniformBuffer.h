@@ -2,14 +2,15 @@
 
 #include "Ref.h"
 #include "Buffer.h"
+#include "Graphics/API/GraphicsCore.h"
 
 namespace Mule
 {
 	class UniformBuffer
 	{
 	public:
-		static Ref<UniformBuffer> Create(const Buffer& buffer);
-		static Ref<UniformBuffer> Create(uint32_t size);
+		static Ref<UniformBuffer> Create(const Buffer& buffer, BufferFlags flags = BufferFlags::None);
+		static Ref<UniformBuffer> Create(uint32_t size, BufferFlags flags = BufferFlags::None);
 
 		virtual ~UniformBuffer() = default;
 
@@ -7,7 +7,8 @@ namespace Mule::Vulkan
 	class IVulkanBuffer
 	{
 	public:
-		IVulkanBuffer(uint32_t size, VkBufferUsageFlags usageFlags, VkQueueFlagBits requestedQueueType, VkMemoryPropertyFlags memoryProperties);
+		// Shared queue buffers are concurrent between the graphics and compute queue families, others belong to the graphics family
+		IVulkanBuffer(uint32_t size, VkBufferUsageFlags usageFlags, VkQueueFlagBits requestedQueueType, VkMemoryPropertyFlags memoryProperties, bool sharedQueues = false);
 		virtual ~IVulkanBuffer();
 
 		void* GetMappedPtr() const;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Graphics/API/StorageBuffer.h"
+
+#include "Graphics/API/Vulkan/Buffer/IVulkanBuffer.h"
+
+#include <memory>
+
+namespace Mule::Vulkan
+{
+	// Host visible storage buffer, also usable as the source of indirect draw arguments
+	class VulkanStorageBuffer : public StorageBuffer
+	{
+	public:
+		VulkanStorageBuffer(uint32_t size, BufferFlags flags);
+		virtual ~VulkanStorageBuffer() = default;
+
+		void SetData(const Buffer& buffer, uint32_t offset = 0) override;
+		void ReadData(const Buffer& buffer, uint32_t offset = 0) const override;
+		bool Reserve(uint32_t size) override;
+
+		VkBuffer GetBuffer() const { return mBuffer->GetBuffer(); }
+
+	private:
+		std::unique_ptr<IVulkanBuffer> mBuffer;
+		BufferFlags mFlags;
+
+		static std::unique_ptr<IVulkanBuffer> CreateBuffer(uint32_t size, BufferFlags flags);
+	};
+}
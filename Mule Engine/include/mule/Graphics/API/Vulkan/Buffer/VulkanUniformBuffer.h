@@ -9,8 +9,8 @@ namespace Mule::Vulkan
 	class VulkanUniformBuffer : public UniformBuffer, public IVulkanBuffer
 	{
 	public:
-		VulkanUniformBuffer(const Buffer& buffer);
-		VulkanUniformBuffer(uint32_t size);
+		VulkanUniformBuffer(const Buffer& buffer, BufferFlags flags);
+		VulkanUniformBuffer(uint32_t size, BufferFlags flags);
 		virtual ~VulkanUniformBuffer() = default;
 
 		void SetData(const Buffer& buffer, uint32_t offset = 0) override;
@@ -13,7 +13,7 @@ namespace Mule::Vulkan
 	class VulkanCommandBuffer : public CommandBuffer
 	{
 	public:
-		VulkanCommandBuffer(VkCommandPool cmd);
+		VulkanCommandBuffer(VkCommandPool cmd, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, QueueType queueType = QueueType::Graphics);
 		~VulkanCommandBuffer();
 		
 		void Reset() override;
@@ -29,12 +29,14 @@ namespace Mule::Vulkan
 		void EndRendering() override;
 
 		// New API
-		void BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment) override;
+		void BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, bool secondaryContents = false, glm::uvec2 renderArea = glm::uvec2(0)) override;
 		void BindPipeline(WeakRef<GraphicsPipeline> pipeline, const std::vector<WeakRef<ShaderResourceGroup>>& groups = {}) override;
+		void ClearDepthAttachmentLayer(uint32_t layer, uint32_t width, uint32_t height) override;
 
 		// WARNING, the following commands only work with 2d textures
 		// Texture 2D
 		void TranistionImageLayout(WeakRef<Texture> texture, ImageLayout newLayout) override;
+		void TransitionImageLayouts(const std::vector<TextureTransition>& transitions) override;
 		void CopyTexture(WeakRef<Texture> src, WeakRef<Texture> dst, const TextureCopyInfo& copyInfo) const override;
 		void ReadTexture(WeakRef<Texture> texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, WeakRef<StagingBuffer> buffer) const override;
 
@@ -45,19 +47,30 @@ namespace Mule::Vulkan
 		void BindComputePipeline(WeakRef<ComputePipeline> shader, const std::vector<WeakRef<ShaderResourceGroup>>& groups = {}) override;
 		void SetPushConstants(WeakRef<ComputePipeline> shader, void* data, uint32_t size) override;
 		void Execute(uint32_t workGroupsX, uint32_t workGroupsY, uint32_t workGroupsZ) override;
+		void ReadbackBarrier(WeakRef<StorageBuffer> buffer) override;
 
 		// Mesh
 		void BindMesh(WeakRef<Mesh> mesh) override;
 		void DrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount = 1) override;
 		void BindAndDrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount) override;
+		void DrawMeshIndirect(WeakRef<StorageBuffer> argumentBuffer, uint32_t offset, uint32_t drawCount) override;
 		
 		void SetViewport(uint32_t x, uint32_t width, uint32_t y, uint32_t height) override;
 		void SetScissor(uint32_t x, uint32_t width, uint32_t y, uint32_t height) override;
 
+		void BeginSecondary(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, glm::uvec2 renderArea = glm::uvec2(0)) override;
+		void ExecuteSecondary(const std::vector<Ref<CommandBuffer>>& commandBuffers) override;
+
+		void ResetQueries(WeakRef<TimestampQueryPool> queryPool) override;
+		void WriteTimestamp(WeakRef<TimestampQueryPool> queryPool, uint32_t query) override;
+
 		VkCommandBuffer GetHandle() const { return mCommandBuffer; }
 
 	private:
+		void SetRenderArea(uint32_t width, uint32_t height);
+
 		VkCommandPool mCommandPool;
 		VkCommandBuffer mCommandBuffer;
+		QueueType mQueueType;
 	};
 }
@@ -9,15 +9,17 @@ namespace Mule::Vulkan
 	class VulkanCommandPool : public CommandAllocator
 	{
 	public:
-		VulkanCommandPool();
+		VulkanCommandPool(QueueType type = QueueType::Graphics);
 		~VulkanCommandPool();
 
 		void Reset() override;
 		Ref<CommandBuffer> CreateCommandBuffer() override;
+		Ref<CommandBuffer> CreateSecondaryCommandBuffer() override;
 
 		VkCommandPool GetHandle() const { return mCommandPool; }
 
 	private:
 		VkCommandPool mCommandPool;
+		QueueType mQueueType;
 	};
 }
\ No newline at end of file
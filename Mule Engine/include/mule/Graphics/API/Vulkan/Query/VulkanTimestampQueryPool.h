@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Graphics/API/TimestampQueryPool.h"
+
+#include <Volk/volk.h>
+
+namespace Mule::Vulkan
+{
+	class VulkanTimestampQueryPool : public TimestampQueryPool
+	{
+	public:
+		VulkanTimestampQueryPool(uint32_t count, QueueType queue);
+		virtual ~VulkanTimestampQueryPool();
+
+		bool GetResults(std::vector<double>& seconds) const override;
+
+		// Called when a command buffer resets the pool, until then the queries hold no results that can be read
+		void SetRecorded() { mRecorded = true; }
+
+		VkQueryPool GetHandle() const { return mQueryPool; }
+
+	private:
+		VkQueryPool mQueryPool;
+		double mTimestampPeriod;
+		uint64_t mValidBitsMask;
+		bool mRecorded;
+	};
+}
@@ -14,6 +14,7 @@ namespace Mule::Vulkan
 
 		void Reset() override;
 		void Wait() override;
+		bool IsSignaled() const override;
 
 		VkFence GetHandle() const { return mFence; }
 
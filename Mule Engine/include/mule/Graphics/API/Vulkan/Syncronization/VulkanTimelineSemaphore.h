@@ -13,6 +13,7 @@ namespace Mule::Vulkan
 		~VulkanTimelineSemaphore();
 
 		uint64_t GetValue() const override;
+		void Wait(uint64_t value) const override;
 		VkSemaphore GetSemaphore() const { return mSemaphore; }
 
 	private:
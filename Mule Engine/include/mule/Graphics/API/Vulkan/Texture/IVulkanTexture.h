@@ -4,6 +4,7 @@
 #include "WeakRef.h"
 #include "VulkanImage.h"
 #include "VulkanTextureView.h"
+#include "VulkanDeviceMemory.h"
 
 #include <vector>
 
@@ -28,6 +29,9 @@ namespace Mule::Vulkan
 
 		bool GetIsDepthTexture() const { return mIsDepthTexture; }
 
+		// Size the image needs, not the size of the allocation it is bound to
+		VkDeviceSize GetImageMemorySize() const { return mMemorySize; }
+
 		WeakRef<VulkanTextureView> GetTextureView(uint32_t mipLevel, uint32_t arrayLayer) const;
 
 	protected:
@@ -45,12 +49,30 @@ namespace Mule::Vulkan
 
 		void ReleaseViews();
 
+		// Destroys the image and its views, the memory is only freed once no other image is bound to it
+		void ReleaseImage();
+
+		// Recreates the image bound to the allocation of owner, contents and layout become undefined.
+		// Falls back to its own allocation if the image does not fit, a null owner always gives the image its own memory
+		bool AliasImageMemory(const IVulkanTexture* owner);
+
 	private:
 		bool CreateImage(VkImageType type, VkFormat format, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, uint32_t arrayLayers, VkImageUsageFlags usageFlags);
 		bool CreateCubeImage(VkImageType type, VkFormat format, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, uint32_t arrayLayers, VkImageUsageFlags usageFlags);
 		bool AllocateMemory();
+		bool CreateViews(VkFormat format, VkImageAspectFlags aspect, VkImageViewType viewType);
 		VulkanImage mVulkanImage;
 		VkImageAspectFlags mImageAspect;
+
+		Ref<VulkanDeviceMemory> mMemory;
+		VkDeviceSize mMemorySize = 0;
+		bool mIsAliased = false;
+
+		// Kept so the image can be recreated when it is aliased
+		VkImageType mImageType = VK_IMAGE_TYPE_2D;
+		VkFormat mImageFormat = VK_FORMAT_UNDEFINED;
+		VkImageUsageFlags mUsageFlags = 0;
+		VkImageViewType mViewType = VK_IMAGE_VIEW_TYPE_2D;
 		
 		std::vector<std::vector<Ref<VulkanTextureView>>> mTextureViews;
 		
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Volk/volk.h>
+
+namespace Mule::Vulkan
+{
+	// Device local allocation that images can share, freed once the last image bound to it lets go
+	class VulkanDeviceMemory
+	{
+	public:
+		VulkanDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex);
+		~VulkanDeviceMemory();
+
+		VkDeviceMemory GetMemory() const { return mMemory; }
+		VkDeviceSize GetSize() const { return mSize; }
+		uint32_t GetMemoryTypeIndex() const { return mMemoryTypeIndex; }
+
+	private:
+		VkDeviceMemory mMemory;
+		VkDeviceSize mSize;
+		uint32_t mMemoryTypeIndex;
+	};
+}
@@ -25,6 +25,8 @@ namespace Mule::Vulkan
 		void TransitionImageLayoutImmediate(ImageLayout newLayout) override;
 		Buffer ReadTextureData(uint32_t mipLevel = 0) override;
 		void WriteMipLevel(uint32_t mipLevel, const Buffer& data) override;
+		uint64_t GetMemorySize() const override;
+		bool AliasMemory(WeakRef<Texture> owner) override;
 
 	private:
 		bool mHasMips;
@@ -41,10 +41,15 @@ namespace Mule::Vulkan
 		uint32_t GetMemoryTypeIndex(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 		VkPhysicalDeviceMemoryProperties GetMemoryProperties() const { return mMemoryProperties; }
 		VkSampler GetLinearSampler() const { return mLinearSampler; }
+		uint32_t GetMaxBindlessDescriptors() const { return mMaxBindlessDescriptors; }
 		VkFormat GetSurfaceFormat() const { return mSurfaceFormat.format; }
 		
-		uint32_t GetQueueFamilyIndex() const;
-		VkQueue CreateQueue();
+		// Compute queues come from a dedicated compute family when the device has one, otherwise from the graphics family
+		uint32_t GetQueueFamilyIndex(QueueType type = QueueType::Graphics) const;
+		std::vector<uint32_t> GetQueueFamilyIndices() const;
+		bool HasAsyncCompute() const { return mComputeQueueFamilyIndex != mQueueFamilyIndex; }
+		bool HasVertexLayerOutput() const { return mVertexLayerOutput; } // VK_EXT_shader_viewport_index_layer is enabled
+		VkQueue CreateQueue(QueueType type = QueueType::Graphics);
 		void ReleaseQueue(VkQueue queue);
 		
 		Ref<VulkanCommandBuffer> BeginSingleTimeCommandBuffer();
@@ -80,6 +85,7 @@ namespace Mule::Vulkan
 		VkSurfaceFormatKHR mSurfaceFormat;
 		VkCompositeAlphaFlagBitsKHR mCompositeAlphaFlags;
 		VkPhysicalDeviceMemoryProperties mMemoryProperties;
+		uint32_t mMaxBindlessDescriptors;
 		
 		std::mutex mQueueMutex;
 		std::mutex mCommandPoolMutex;
@@ -93,8 +99,11 @@ namespace Mule::Vulkan
 
 		VkQueueFamilyProperties mQueueFamilyProperties;
 		std::stack<uint32_t> mFreeQueueIndices;
-		std::unordered_map<VkQueue, uint32_t> mAllocatedQueueIndices;
+		std::stack<uint32_t> mFreeComputeQueueIndices;
+		std::unordered_map<VkQueue, std::pair<QueueType, uint32_t>> mAllocatedQueueIndices;
 		uint32_t mQueueFamilyIndex;
+		uint32_t mComputeQueueFamilyIndex;
+		bool mVertexLayerOutput = false;
 
 		VkSampler mLinearSampler;
 
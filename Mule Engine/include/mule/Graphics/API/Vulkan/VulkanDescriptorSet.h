@@ -16,10 +16,17 @@ namespace Mule::Vulkan
 		void Update(uint32_t binding, DescriptorType type, ImageLayout layout, WeakRef<Texture> texture, uint32_t arrayIndex = 0, Ref<Sampler> sampler = nullptr) override;
 		void Update(uint32_t binding, DescriptorType type, ImageLayout layout, WeakRef<TextureView> texture, uint32_t arrayIndex = 0, Ref<Sampler> sampler = nullptr) override;
 		void Update(uint32_t binding, WeakRef<UniformBuffer> buffer, uint32_t arrayIndex = 0) override;
+		void Update(uint32_t binding, WeakRef<StorageBuffer> buffer, uint32_t arrayIndex = 0) override;
+
+		bool Reserve(uint32_t arrayCount) override;
+		uint32_t GetArrayCapacity() const override { return mVariableCount; }
 
 		VkDescriptorSet GetDescriptorSet() const { return mDescriptorSet; }
 	private:
 		VkDescriptorPool mDescriptorPool;
 		VkDescriptorSet mDescriptorSet;
+		uint32_t mVariableCount;
+
+		VkDescriptorSet Allocate(uint32_t variableCount);
 	};
 }
\ No newline at end of file
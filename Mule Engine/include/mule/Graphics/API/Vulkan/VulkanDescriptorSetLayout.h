@@ -13,8 +13,13 @@ namespace Mule::Vulkan
 		~VulkanDescriptorSetLayout();
 
 		VkDescriptorSetLayout GetLayout() const { return mLayout; }
+		const std::vector<ShaderResourceDescription>& GetResources() const { return mResources; }
+
+		// Initial descriptor count of the unbounded binding, 0 if the layout has none
+		uint32_t GetVariableCount() const;
 
 	private:
 		VkDescriptorSetLayout mLayout;
+		std::vector<ShaderResourceDescription> mResources;
 	};
 }
@@ -16,10 +16,12 @@ namespace Mule::Vulkan
 		case TextureFormat::BGRA_8U:	return VK_FORMAT_B8G8R8A8_UNORM;
 		case TextureFormat::RGBA_8U:	return VK_FORMAT_R8G8B8A8_UNORM;
 		case TextureFormat::RGB_8U:	return VK_FORMAT_R8G8B8_UNORM;
+		case TextureFormat::RGBA_8U_SRGB:	return VK_FORMAT_R8G8B8A8_SRGB;
 		case TextureFormat::R_32UI:	return VK_FORMAT_R32_UINT;
 		case TextureFormat::RG_32UI:	return VK_FORMAT_R32G32_UINT;
 		case TextureFormat::D_32F:	return VK_FORMAT_D32_SFLOAT;
 		case TextureFormat::D_24S8:	return VK_FORMAT_D24_UNORM_S8_UINT;
+		case TextureFormat::RG_16SN:	return VK_FORMAT_R16G16_SNORM;
 		case TextureFormat::RGBA_16F:	return VK_FORMAT_R16G16B16A16_SFLOAT;
 		case TextureFormat::R_32F:	return VK_FORMAT_R32_SFLOAT;
 		case TextureFormat::RGBA_32F:	return VK_FORMAT_R32G32B32A32_SFLOAT;
@@ -117,6 +119,7 @@ namespace Mule::Vulkan
 		case Mule::ShaderResourceType::UniformBuffer:	return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 		case Mule::ShaderResourceType::Sampler:			return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		case Mule::ShaderResourceType::StorageImage:	return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		case Mule::ShaderResourceType::StorageBuffer:	return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 		}
 	}
 
@@ -161,6 +164,7 @@ namespace Mule::Vulkan
 		case Mule::DescriptorType::Texture: return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		case Mule::DescriptorType::UniformBuffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 		case Mule::DescriptorType::StorageImage: return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		case Mule::DescriptorType::StorageBuffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 		default:
 			assert(false && "Invalid vulkan descriptor type");
 			break;
@@ -7,6 +7,8 @@
 
 namespace Mule
 {
+	struct RenderView;
+
 	class Camera
 	{
 	public:
@@ -50,6 +52,10 @@ namespace Mule
 		void SetResourceRegistry(Ref<ResourceRegistry> registry) { mResourceRegistry = registry; }
 		Ref<ResourceRegistry> GetRegistry() const { return mResourceRegistry; }
 
+		// Lays down depth before the G-buffer so only visible surfaces are shaded, pays off in scenes with a lot of overdraw
+		void SetDepthPrePass(bool enabled) { mDepthPrePass = enabled; }
+		bool GetDepthPrePass() const { return mDepthPrePass; }
+
 		struct CascadeSplits
 		{
 			std::vector<glm::mat4> LightSpaceMatrices;
@@ -57,9 +63,12 @@ namespace Mule
 			uint32_t Count;
 		};
 
-		CascadeSplits GenerateLightSpaceCascades(uint32_t count, const glm::vec3& direction) const;
+		// Every cascade covers its depth slice of all views, so views of the same world can share one shadow map.
+		// Resolution is the width of the square shadow map the cascades are rendered into, cascades snap to its texels
+		static CascadeSplits GenerateLightSpaceCascades(const std::vector<const RenderView*>& views, uint32_t count, const glm::vec3& direction, uint32_t resolution);
 
 		WeakRef<TextureView> GetColorOutput() const;
+		glm::vec2 GetColorOutputUV() const; // The image only fills the top left corner of the color output
 
 	private:
 		glm::mat4 mView, mProj, mVP;
@@ -68,5 +77,6 @@ namespace Mule
 		float mFOVDeg, mNearPlane, mFarPlane, mAspectRatio, mYaw, mPitch;
 
 		Ref<ResourceRegistry> mResourceRegistry;
+		bool mDepthPrePass = false;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Mule
+{
+	// Clip space planes of a view projection matrix, normals point inwards. Assumes a [0, 1] depth range
+	struct Frustum
+	{
+		Frustum() = default;
+		explicit Frustum(const glm::mat4& viewProjection);
+
+		bool IntersectsSphere(const glm::vec4& sphere) const;
+
+		glm::vec4 Planes[6];
+	};
+
+	// Moves a mesh space bounding sphere (xyz center, w radius) into the space of transform,
+	// the radius is scaled by the largest axis scale so the result stays conservative
+	glm::vec4 TransformBoundingSphere(const glm::mat4& transform, const glm::vec4& sphere);
+}
@@ -11,6 +11,7 @@ namespace Mule::GPU
 		alignas(16) glm::mat4 Proj;
 		alignas(16) glm::vec3 Position;
 		alignas(16) glm::vec3 ViewDirection;
+		alignas(16) glm::mat4 InverseViewProjection;
 	};
 
 	struct Material
@@ -42,12 +43,7 @@ namespace Mule::GPU
 		alignas(4)  float Intensity = 0.f;
 		alignas(16) glm::vec3 Color = glm::vec3(0.f);
 		alignas(16) glm::vec3 Position;
-	};
-
-	struct PointLightArray
-	{
-		alignas(4) uint32_t Count;
-		PointLight Lights[1000];
+		alignas(4) float Range = 0.f;
 	};
 
 	struct SpotLight
@@ -58,12 +54,24 @@ namespace Mule::GPU
 		alignas(16) glm::vec3 Direction;
 		alignas(4) float HalfAngle;
 		alignas(4) float FallOff;
+		alignas(4) float Range = 0.f;
 	};
 
-	struct SpotLightArray
+	struct LightCluster
 	{
-		alignas(4) uint32_t Count;
-		SpotLight Lights[800];
+		alignas(4) uint32_t Offset = 0; // First entry in the light index list
+		alignas(4) uint32_t PointLightCount = 0;
+		alignas(4) uint32_t SpotLightCount = 0;
+		alignas(4) uint32_t Padding = 0;
+	};
+
+	struct LightClusterInfo
+	{
+		alignas(16) glm::uvec4 GridSize; // xyz: clusters per axis, w: total cluster count
+		alignas(4) float NearPlane;
+		alignas(4) float FarPlane;
+		alignas(4) float SliceScale;
+		alignas(4) float SliceBias;
 	};
 
 	struct CascadedShadowLightMatrices
@@ -72,4 +80,23 @@ namespace Mule::GPU
 		alignas(16) glm::vec4 CascadeSplits[10];
 		alignas(4) uint32_t CascadeCount;
 	};
+
+	struct ObjectData
+	{
+		alignas(16) glm::mat4 Transform;
+		alignas(16) glm::vec4 BoundingSphere; // xyz: mesh space center, w: radius
+		alignas(4) uint32_t MaterialIndex;
+	};
+
+	// Matches VkDrawIndexedIndirectCommand
+	struct DrawIndexedIndirectCommand
+	{
+		uint32_t IndexCount;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t VertexOffset;
+		uint32_t FirstInstance;
+	};
+
+	static_assert(sizeof(DrawIndexedIndirectCommand) == 20, "DrawIndexedIndirectCommand must match the layout the GPU expects");
 }
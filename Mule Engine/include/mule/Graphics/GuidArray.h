@@ -92,6 +92,9 @@ namespace Mule
 
 		const std::vector<T>& GetArray() const { return mArray; }
 
+		// Live handles only, freed slots are still present in the array
+		const std::unordered_map<AssetHandle, uint32_t>& GetIndices() const { return mIndices; }
+
 	private:
 		std::unordered_map<AssetHandle, uint32_t> mIndices;
 		std::vector<T> mArray;
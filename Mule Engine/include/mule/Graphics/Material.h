@@ -30,6 +30,6 @@ namespace Mule
 		AssetHandle EmissiveMap = AssetHandle::Null();
 		AssetHandle OpacityMap = AssetHandle::Null();
 
-		uint32_t GlobalIndex;
+		uint32_t GlobalIndex = UINT32_MAX; // Assigned by the renderer once the material was added
 	};
 }
\ No newline at end of file
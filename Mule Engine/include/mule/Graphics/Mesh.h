@@ -6,12 +6,14 @@
 #include "Asset/Asset.h"
 #include "API/VertexBuffer.h"
 #include "API/IndexBuffer.h"
+#include "Graphics/MeshSimplifier.h"
 
 // Submodules
 #include <glm/glm.hpp>
 
 // STD
 #include <string>
+#include <vector>
 
 namespace Mule
 {
@@ -27,16 +29,34 @@ namespace Mule
 		AssetHandle GetDefaultMaterialHandle() const { return mDefaultMaterialHandle; }
 
 		uint32_t GetVertexCount() const { return mVertexBuffer->GetVertexCount(); }
-		uint32_t GetTriangleCount() const { return mIndexBuffer->GetTraingleCount(); }
+		uint32_t GetTriangleCount() const { return mLods[0].IndexCount / 3; }
 
 		const WeakRef<IndexBuffer>& GetIndexBuffer() const { return mIndexBuffer; }
 		const WeakRef<VertexBuffer>& GetVertexBuffer() const { return mVertexBuffer; }
 
+		void SetBounds(const glm::vec3& min, const glm::vec3& max);
+		const glm::vec3& GetBoundsMin() const { return mBoundsMin; }
+		const glm::vec3& GetBoundsMax() const { return mBoundsMax; }
+
+		// xyz: center, w: radius, in mesh space
+		const glm::vec4& GetBoundingSphere() const { return mBoundingSphere; }
+
+		// Level 0 is the full mesh, all levels live in the one index buffer
+		void SetLods(const std::vector<MeshLod>& lods);
+		const MeshLod& GetLod(uint32_t lod) const { return mLods[lod < mLods.size() ? lod : mLods.size() - 1]; }
+		uint32_t GetLodCount() const { return static_cast<uint32_t>(mLods.size()); }
+
 	private:
 		Mesh(const std::string& name, Ref<VertexBuffer> vertexBuffer, Ref<IndexBuffer> indexBuffer, AssetHandle defaultMaterialHandle);
 		Ref<VertexBuffer> mVertexBuffer;
 		Ref<IndexBuffer> mIndexBuffer;
 
 		AssetHandle mDefaultMaterialHandle;
+
+		glm::vec3 mBoundsMin = glm::vec3(0.f);
+		glm::vec3 mBoundsMax = glm::vec3(0.f);
+		glm::vec4 mBoundingSphere = glm::vec4(0.f);
+
+		std::vector<MeshLod> mLods;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace Mule
+{
+	// A level of detail is a range of the meshes index buffer, every level indexes the same vertices
+	struct MeshLod
+	{
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+	};
+
+	// Quadric error metric edge collapse (Garland and Heckbert). Edges collapse onto one of their endpoints so the result
+	// still indexes into positions, open edges (borders and uv seams) are heavily weighted so they stay in place
+	std::vector<uint32_t> SimplifyMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, uint32_t targetIndexCount);
+
+	// Level 0 is indices itself, every following level targets reduction times the index count of the one before it.
+	// Stops early when a level would drop below minTriangleCount or the simplifier can no longer make meaningful progress
+	void BuildLodChain(
+		const std::vector<glm::vec3>& positions,
+		const std::vector<uint32_t>& indices,
+		uint32_t maxLevels,
+		float reduction,
+		uint32_t minTriangleCount,
+		std::vector<uint32_t>& outIndices,
+		std::vector<MeshLod>& outLods
+	);
+}
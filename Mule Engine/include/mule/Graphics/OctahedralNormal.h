@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Mule
+{
+	// CPU side of the G-buffer normal encoding, EncodeOctahedral mirrors DefaultGeometryShader.glsl and DecodeOctahedral
+	// mirrors DeferredLightingPass.glsl. Keep them in sync
+
+	// Folds the unit sphere onto the [-1, 1] square
+	inline glm::vec2 EncodeOctahedral(const glm::vec3& normal)
+	{
+		glm::vec3 n = normal / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+		if (n.z >= 0.f)
+			return glm::vec2(n.x, n.y);
+
+		return glm::vec2(
+			(1.f - std::abs(n.y)) * (n.x >= 0.f ? 1.f : -1.f),
+			(1.f - std::abs(n.x)) * (n.y >= 0.f ? 1.f : -1.f));
+	}
+
+	inline glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+	{
+		glm::vec3 n(encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y));
+		float t = std::max(-n.z, 0.f);
+		n.x += n.x >= 0.f ? -t : t;
+		n.y += n.y >= 0.f ? -t : t;
+		return glm::normalize(n);
+	}
+
+	// Signed normalized conversion the way the GPU stores a bits wide snorm channel, rounded to the nearest step
+	inline int32_t PackSnorm(float value, uint32_t bits)
+	{
+		float scale = static_cast<float>((1 << (bits - 1)) - 1);
+		return static_cast<int32_t>(std::round(std::clamp(value, -1.f, 1.f) * scale));
+	}
+
+	inline float UnpackSnorm(int32_t value, uint32_t bits)
+	{
+		float scale = static_cast<float>((1 << (bits - 1)) - 1);
+		return std::max(static_cast<float>(value) / scale, -1.f);
+	}
+
+	// Texel of an RG_16SN target, x in the low 16 bits
+	inline uint32_t PackOctahedral16(const glm::vec3& normal)
+	{
+		glm::vec2 encoded = EncodeOctahedral(normal);
+		uint32_t x = static_cast<uint16_t>(PackSnorm(encoded.x, 16));
+		uint32_t y = static_cast<uint16_t>(PackSnorm(encoded.y, 16));
+		return x | (y << 16);
+	}
+
+	inline glm::vec3 UnpackOctahedral16(uint32_t packed)
+	{
+		int16_t x = static_cast<int16_t>(packed & 0xFFFF);
+		int16_t y = static_cast<int16_t>(packed >> 16);
+		return DecodeOctahedral(glm::vec2(UnpackSnorm(x, 16), UnpackSnorm(y, 16)));
+	}
+
+	// Texel of an RG_8SN target, x in the low 8 bits
+	inline uint16_t PackOctahedral8(const glm::vec3& normal)
+	{
+		glm::vec2 encoded = EncodeOctahedral(normal);
+		uint32_t x = static_cast<uint8_t>(PackSnorm(encoded.x, 8));
+		uint32_t y = static_cast<uint8_t>(PackSnorm(encoded.y, 8));
+		return static_cast<uint16_t>(x | (y << 8));
+	}
+
+	inline glm::vec3 UnpackOctahedral8(uint16_t packed)
+	{
+		int8_t x = static_cast<int8_t>(packed & 0xFF);
+		int8_t y = static_cast<int8_t>(packed >> 8);
+		return DecodeOctahedral(glm::vec2(UnpackSnorm(x, 8), UnpackSnorm(y, 8)));
+	}
+}
@@ -2,10 +2,15 @@
 
 #include "Ref.h"
 #include "Graphics/API/CommandBuffer.h"
-#include "Graphics/Renderer/CommandList.h"
+#include "Graphics/Renderer/RenderCommand.h"
 #include "Graphics/Renderer/RenderGraph/ResourceRegistry.h"
 
+#include <vector>
+
 namespace Mule::CommandExecutor
 {
-	void Execute(Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex);
+	void Execute(Ref<CommandBuffer> cmd, const std::vector<RenderCommand>& commands, const ResourceRegistry& registry, uint32_t frameIndex);
+
+	// Begins a secondary command buffer that continues the rendering scope opened by a BeginRendering command
+	void BeginSecondary(Ref<CommandBuffer> cmd, const RenderCommand& beginRendering, const ResourceRegistry& registry, uint32_t frameIndex);
 }
@@ -2,10 +2,12 @@
 
 #include "RenderCommand.h"
 
+#include <array>
 #include <vector>
 
 namespace Mule
 {
+	// Commands are bucketed by type as they are recorded so each pass only walks the commands it consumes
 	class CommandList
 	{
 	public:
@@ -14,17 +16,21 @@ namespace Mule
 
 		void AddCommand(const RenderCommand& command)
 		{
-			mCommands.emplace_back(command);
+			mCommands[static_cast<uint32_t>(command.GetType())].emplace_back(command);
 		}
 
+		// Keeps the capacity of every bucket so lists that are reused each frame stop allocating
 		void Flush()
 		{
-			mCommands.clear();
+			for (auto& bucket : mCommands)
+				bucket.clear();
 		}
 
-		const std::vector<RenderCommand>& GetCommands() const { return mCommands; }
+		const std::vector<RenderCommand>& GetCommands(RenderCommandType type) const { return mCommands[static_cast<uint32_t>(type)]; }
+
+		bool IsEmpty(RenderCommandType type) const { return mCommands[static_cast<uint32_t>(type)].empty(); }
 
 	private:
-		std::vector<RenderCommand> mCommands;
+		std::array<std::vector<RenderCommand>, static_cast<uint32_t>(RenderCommandType::Count)> mCommands;
 	};
 }
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Mule
+{
+	struct DynamicResolutionSettings
+	{
+		bool Enabled = false;
+		double TargetGPUTime = 1.0 / 60.0; // Seconds
+		float MinScale = 0.5f;
+		float MaxScale = 1.f;
+	};
+
+	// Picks the render scale from GPU frame times. GPU time is taken to grow with the rendered pixel count, so with the
+	// square of the scale, and the scale only moves once the smoothed time leaves a band below the target
+	class DynamicResolution
+	{
+	public:
+		void SetSettings(const DynamicResolutionSettings& settings);
+		const DynamicResolutionSettings& GetSettings() const { return mSettings; }
+
+		// Takes the GPU time of the latest frame with timings, returns the scale to render the next frame at
+		float Update(double gpuTime);
+		float GetScale() const { return mScale; }
+
+	private:
+		DynamicResolutionSettings mSettings;
+		float mScale = 1.f;
+		double mSmoothedTime = 0.0;
+	};
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace Mule
+{
+	// Resolution of the Hi-Z base level, the depth buffer is reduced to this size on the GPU before it is read back
+	constexpr uint32_t HIZ_WIDTH = 256;
+	constexpr uint32_t HIZ_HEIGHT = 128;
+
+	// Max depth pyramid, every texel holds the farthest depth of the texels it covers in the level below.
+	// Level sizes round up so the parent of texel x is always x / 2
+	struct HiZPyramid
+	{
+		std::vector<glm::uvec2> Sizes;
+		std::vector<uint32_t> Offsets;
+		std::vector<float> Depth;
+
+		uint32_t GetLevelCount() const { return static_cast<uint32_t>(Sizes.size()); }
+		float Load(uint32_t level, uint32_t x, uint32_t y) const { return Depth[Offsets[level] + y * Sizes[level].x + x]; }
+	};
+
+	// Reduces a depth image to width x height, each output texel covers every input texel it overlaps.
+	// CPU reference of HiZDownsample.glsl
+	void DownsampleDepth(const float* depth, uint32_t depthWidth, uint32_t depthHeight, uint32_t width, uint32_t height, float* out);
+
+	// Level 0 is baseDepth itself, levels are halved down to 1x1
+	void BuildHiZPyramid(const float* baseDepth, uint32_t width, uint32_t height, HiZPyramid& pyramid);
+
+	// True if a world space bounding sphere is behind the depth in the pyramid, viewProjection is the matrix the depth was rendered with.
+	// Bounds crossing the near plane or leaving the screen are never occluded since the pyramid has no depth for them
+	bool IsOccluded(const HiZPyramid& pyramid, const glm::mat4& viewProjection, const glm::vec4& worldSphere);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "WeakRef.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/GPUObjects.h"
+
+#include <vector>
+
+namespace Mule
+{
+	struct IndirectDrawItem
+	{
+		WeakRef<Mesh> Mesh = nullptr;
+		uint32_t IndexCount = 0;
+		uint32_t ObjectIndex = 0;
+		uint32_t FirstIndex = 0; // Start of the selected level of detail in the meshes index buffer
+	};
+
+	// Visible objects grouped by mesh and level of detail, each group becomes one indexed indirect command whose instances
+	// index into InstanceObjectIndices through gl_InstanceIndex
+	struct IndirectDrawList
+	{
+		std::vector<GPU::DrawIndexedIndirectCommand> Commands;
+		std::vector<WeakRef<Mesh>> Meshes; // Mesh to bind for each command
+		std::vector<uint32_t> InstanceObjectIndices;
+
+		void Clear()
+		{
+			Commands.clear();
+			Meshes.clear();
+			InstanceObjectIndices.clear();
+		}
+	};
+
+	// Builds the indirect commands for items, items is sorted in place so draws of the same mesh and level are adjacent.
+	// Only reads the mesh pointer for grouping so it can run without a graphics context
+	void BuildIndirectDrawList(std::vector<IndirectDrawItem>& items, IndirectDrawList& drawList);
+
+	// Same as BuildIndirectDrawList but keeps the existing commands, appended commands never merge with earlier ones
+	void AppendIndirectDrawList(std::vector<IndirectDrawItem>& items, IndirectDrawList& drawList);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Graphics/GPUObjects.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Mule
+{
+	// Froxel grid dimensions, depth slices are distributed exponentially between the near and far plane
+	constexpr uint32_t LIGHT_CLUSTER_X = 16;
+	constexpr uint32_t LIGHT_CLUSTER_Y = 9;
+	constexpr uint32_t LIGHT_CLUSTER_Z = 24;
+	constexpr uint32_t LIGHT_CLUSTER_COUNT = LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z;
+
+	// Per view cluster data, each cluster references its point lights followed by its spot lights in LightIndices
+	struct LightClusterList
+	{
+		GPU::LightClusterInfo Info;
+		std::vector<GPU::LightCluster> Clusters;
+		std::vector<uint32_t> LightIndices;
+
+		// Scratch storage reused between builds
+		std::vector<glm::uvec3> PointLightMin, PointLightMax;
+		std::vector<glm::uvec3> SpotLightMin, SpotLightMax;
+	};
+
+	// Assigns every light to the clusters its range overlaps, lights outside of the view are dropped.
+	// Pure CPU work so it can run without a graphics context
+	void BuildLightClusters(const glm::mat4& view, const glm::mat4& proj, float nearPlane, float farPlane,
+		const std::vector<GPU::PointLight>& pointLights,
+		const std::vector<GPU::SpotLight>& spotLights,
+		LightClusterList& clusterList);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace Mule
+{
+	// Level lod is preferred once an object covers less than this fraction of the viewport height, halves with every level
+	float GetLodScreenSize(uint32_t lod);
+
+	// Fraction of the viewport height covered by a world space bounding sphere, projectionScale is proj[1][1]
+	float ComputeScreenSize(const glm::vec4& worldSphere, const glm::vec3& cameraPosition, float projectionScale);
+
+	// Walks from previousLod towards the level preferred for screenSize, a level boundary is only crossed once the size is
+	// more than hysteresis (relative) past it so objects sitting on a boundary dont flicker. Pass UINT32_MAX as
+	// previousLod for objects without a history
+	uint32_t SelectLod(float screenSize, uint32_t lodCount, uint32_t previousLod, float hysteresis = 0.1f);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Graphics/GPUObjects.h"
+
+#include <unordered_map>
+#include <vector>
+#include <queue>
+
+namespace Mule
+{
+	// CPU mirror of the per object storage buffer. Slots are persistent so only objects whose data changed
+	// need to be uploaded, pending uploads are tracked separately for every frame in flight
+	class ObjectTable
+	{
+	public:
+		explicit ObjectTable(uint32_t framesInFlight);
+		~ObjectTable() = default;
+
+		// Object ids are only unique within a world, a copy of a scene keeps the ids of the entities it was copied from.
+		// Inserts or updates the object, returns its slot index
+		uint32_t Update(const void* world, uint64_t objectId, const GPU::ObjectData& data);
+		void Remove(const void* world, uint64_t objectId);
+
+		// Frees the slots of every object in the world
+		void RemoveWorld(const void* world);
+
+		uint32_t QueryIndex(const void* world, uint64_t objectId) const;
+
+		// Number of slots in use including freed slots, this is the size the GPU buffer needs to cover
+		uint32_t GetSlotCount() const { return static_cast<uint32_t>(mObjects.size()); }
+		const std::vector<GPU::ObjectData>& GetObjects() const { return mObjects; }
+
+		const std::vector<uint32_t>& GetPendingUploads(uint32_t frameIndex) const { return mPendingUploads[frameIndex]; }
+		void ClearPendingUploads(uint32_t frameIndex);
+
+		// Marks every slot as pending for frameIndex, used when the GPU buffer had to be recreated
+		void InvalidateFrame(uint32_t frameIndex);
+
+	private:
+		void MarkPending(uint32_t index);
+
+		uint32_t mFramesInFlight;
+
+		std::unordered_map<const void*, std::unordered_map<uint64_t, uint32_t>> mIndices;
+		std::vector<GPU::ObjectData> mObjects;
+		std::queue<uint32_t> mFreeIndices;
+
+		// Bit i is set when the slot is already queued for frame i
+		std::vector<uint8_t> mPendingMask;
+		std::vector<std::vector<uint32_t>> mPendingUploads;
+	};
+}
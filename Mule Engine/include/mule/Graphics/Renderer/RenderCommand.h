@@ -32,7 +32,9 @@ namespace Mule
 		DrawPointLight,
 		DrawSpotLight,
 		DrawSkyBox,
-		ClearRenderTarget
+		ClearRenderTarget,
+
+		Count
 	};
 
 	struct BaseCommand
@@ -46,13 +48,17 @@ namespace Mule
 	struct DrawCommand : BaseCommand
 	{
 		DrawCommand() : BaseCommand(RenderCommandType::Draw) {}
-		DrawCommand(const WeakRef<Mesh>& mesh, const WeakRef<Material>& material, const glm::mat4& modelMatrix)
-			: BaseCommand(RenderCommandType::Draw), Mesh(mesh), Material(material), ModelMatrix(modelMatrix) {
+		DrawCommand(const WeakRef<Mesh>& mesh, const WeakRef<Material>& material, const glm::mat4& modelMatrix, uint64_t objectId, bool castsShadows = true, bool isStatic = false)
+			: BaseCommand(RenderCommandType::Draw), Mesh(mesh), Material(material), ModelMatrix(modelMatrix), ObjectId(objectId), CastsShadows(castsShadows), Static(isStatic) {
 		}
 
 		WeakRef<Mesh> Mesh = nullptr;
 		WeakRef<Material> Material = nullptr;
 		glm::mat4 ModelMatrix = glm::mat4(1.0f);
+		uint64_t ObjectId = 0; // Must be stable across frames and unique per drawn object, keys the per object storage buffer
+		bool CastsShadows = true;
+		bool Static = false; // Drawn into the cached static shadow layers, which are only redrawn when something in them changes
+		bool Changed = true; // Cleared by worlds that track changes, the object keeps its slot data from an earlier frame
 	};
 
 	struct DrawInstancedCommand : BaseCommand
@@ -93,19 +99,33 @@ namespace Mule
 		ResourceHandle FramebufferHandle;
 	};
 
+	struct LayoutTransition
+	{
+		ResourceHandle TextureHandle;
+		ImageLayout NewLayout;
+
+		// Transitions from an undefined layout, used on the first write of a transient since its memory may have been aliased
+		bool Discard = false;
+
+		// Set on both halves of a texture handed between the graphics and compute queue
+		QueueOwnership Ownership = QueueOwnership::None;
+		QueueType SrcQueue = QueueType::Graphics;
+		QueueType DstQueue = QueueType::Graphics;
+		ImageLayout OldLayout = ImageLayout::Undefined;
+	};
+
+	// All transitions are recorded as a single barrier
 	struct TransitionLayoutCommand : BaseCommand
 	{
 		TransitionLayoutCommand() : BaseCommand(RenderCommandType::TransitionLayout) {}	
 		
-		TransitionLayoutCommand(ResourceHandle textureHandle, ImageLayout newLayout)
+		TransitionLayoutCommand(const std::vector<LayoutTransition>& transitions)
 			:
 			BaseCommand(RenderCommandType::TransitionLayout),
-			TextureHandle(textureHandle),
-			NewLayout(newLayout)
+			Transitions(transitions)
 		{}
 
-		ResourceHandle TextureHandle;
-		ImageLayout NewLayout;
+		std::vector<LayoutTransition> Transitions;
 	};
 
 	struct BeginRenderingCommandAttachment
@@ -118,15 +138,19 @@ namespace Mule
 	struct BeginRenderingCommand : BaseCommand
 	{
 		BeginRenderingCommand() : BaseCommand(RenderCommandType::BeginRendering) {}
-		BeginRenderingCommand(const std::vector<BeginRenderingCommandAttachment>& colorAttachments, BeginRenderingCommandAttachment depthAttachment)
+		BeginRenderingCommand(const std::vector<BeginRenderingCommandAttachment>& colorAttachments, BeginRenderingCommandAttachment depthAttachment, bool secondaryContents = false)
 			:
 			BaseCommand(RenderCommandType::BeginRendering),
 			ColorAttachments(colorAttachments),
-			DepthAttachment(depthAttachment)
+			DepthAttachment(depthAttachment),
+			SecondaryContents(secondaryContents)
 		{}
 
 		std::vector<BeginRenderingCommandAttachment> ColorAttachments;
 		BeginRenderingCommandAttachment DepthAttachment;
+
+		// Draws are recorded into secondary command buffers and replayed inside the rendering scope
+		bool SecondaryContents = false;
 	};
 
 	struct EndRenderingCommand : BaseCommand
@@ -182,24 +206,25 @@ namespace Mule
 	struct DrawPointLightCommand : BaseCommand
 	{
 		DrawPointLightCommand() : BaseCommand(RenderCommandType::DrawPointLight) {}
-		DrawPointLightCommand(const glm::vec3& position, const glm::vec3& color, float intensity)
+		DrawPointLightCommand(const glm::vec3& position, const glm::vec3& color, float intensity, float range)
 			:
 			BaseCommand(RenderCommandType::DrawPointLight),
 			Position(position),
 			Color(color),
-			Intensity(intensity)
-
+			Intensity(intensity),
+			Range(range)
 		{}
 
 		glm::vec3 Position;
 		glm::vec3 Color;
 		float Intensity;
+		float Range;
 	};
 
 	struct DrawSpotLightCommand : BaseCommand
 	{
 		DrawSpotLightCommand() : BaseCommand(RenderCommandType::DrawSpotLight) {}
-		DrawSpotLightCommand(const glm::vec3& position, const glm::vec3& direction, const glm::vec3& color, float intensity, float halfAngle, float fallOff)
+		DrawSpotLightCommand(const glm::vec3& position, const glm::vec3& direction, const glm::vec3& color, float intensity, float halfAngle, float fallOff, float range)
 			:
 			BaseCommand(RenderCommandType::DrawSpotLight),
 			Position(position),
@@ -207,7 +232,8 @@ namespace Mule
 			Color(color),
 			Intensity(intensity),
 			HalfAngle(halfAngle),
-			FallOff(fallOff)
+			FallOff(fallOff),
+			Range(range)
 		{}
 
 		glm::vec3 Position;
@@ -216,6 +242,7 @@ namespace Mule
 		float Intensity;
 		float HalfAngle;
 		float FallOff;
+		float Range;
 	};
 
 	struct DrawSkyboxCommand : BaseCommand
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Graphics/Renderer/RenderGraph/RenderPass.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Mule
+{
+	// What a pass declares, as far as sorting and culling are concerned
+	struct PassDeclaration
+	{
+		std::unordered_map<ResourceHandle, ResourceUsage> Usage;
+		std::vector<uint32_t> Dependencies; // Explicit dependencies as indices into the same list
+		bool SideEffects = false;
+	};
+
+	// Execution order of passes, every writer of a resource runs before its readers and dependencies run before their dependents.
+	// Each resource is a node between its writers and readers, so the graph has one edge per resource use instead of one per
+	// writer/reader pair. Ties keep the order the passes are given in, an empty order means there is a cycle
+	std::vector<uint32_t> SortPasses(const std::vector<PassDeclaration>& passes);
+
+	// A pass is live if it writes outputHandle, has side effects or writes something a live pass uses. Dependencies of live passes
+	// are live as well. Whatever is left can never affect the output and is removed from the graph
+	std::vector<bool> FindLivePasses(const std::vector<PassDeclaration>& passes, ResourceHandle outputHandle);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Graphics/Renderer/RenderGraph/RenderPass.h"
+
+#include "Graphics/API/GraphicsQueue.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Mule
+{
+	// What AssignQueues and ScheduleQueues need to know about a pass, given in execution order
+	struct QueueSchedulePass
+	{
+		PassType Type = PassType::Graphics;
+		QueueType Queue = QueueType::Graphics; // Only read by ScheduleQueues
+		bool Shared = false; // Only read by AssignQueues
+		std::unordered_map<ResourceHandle, ResourceUsage> Usage;
+		std::vector<uint32_t> Dependencies; // Explicit dependencies as indices into the execution order
+	};
+
+	struct PassQueue
+	{
+		QueueType Queue = QueueType::Graphics;
+
+		// Latest pass on the other queue that must finish before this one starts, UINT32_MAX if there is none.
+		// Waiting on it covers every earlier pass of that queue as well
+		uint32_t WaitPass = UINT32_MAX;
+	};
+
+	// Texture used by passes on different queues, released at the end of ReleasePass and acquired at the start of AcquirePass
+	struct QueueTransfer
+	{
+		ResourceHandle Handle;
+		uint32_t ReleasePass = 0;
+		uint32_t AcquirePass = 0;
+	};
+
+	struct QueueSchedule
+	{
+		std::vector<PassQueue> Passes;
+		std::vector<QueueTransfer> Transfers; // Sorted by acquiring pass
+	};
+
+	// Moves compute passes onto the compute queue when asyncCompute is set. A compute pass stays on the graphics queue if it writes
+	// a depth attachment, which only graphics queues can clear, uses a texture that is read before it is written, since that texture
+	// carries over from the previous frame, or uses outputHandle, which is presented from the graphics queue and may be left to any
+	// pass using it once idle passes are culled. Shared passes and passes using what they write stay on the graphics queue too,
+	// other registries only reach them through graphics queue submission order. A pass only moves if a graphics pass that is not
+	// shared can run before the graphics queue has to wait for it, otherwise the queue would sit idle through the transfers.
+	// In the renderer's own graph no pass qualifies: lighting reads the shared shadow maps and Hi-Z is followed by lighting,
+	// which reads the same depth, so both stay on the graphics queue
+	std::vector<QueueType> AssignQueues(const std::vector<QueueSchedulePass>& passes, ResourceHandle outputHandle, bool asyncCompute);
+
+	// Waits and ownership transfers between passes on different queues, the queue of every pass is already set
+	QueueSchedule ScheduleQueues(const std::vector<QueueSchedulePass>& passes);
+
+	// Semaphores of both queues indexed by QueueType and the last value submitted to each, PassValues holds the value
+	// every submitted pass signals and needs one entry per pass of the schedule
+	struct QueueTimeline
+	{
+		Ref<TimelineSemaphore> Semaphores[2];
+		uint64_t Values[2] = { 0, 0 };
+		std::vector<uint64_t> PassValues;
+	};
+
+	// Submission of pass passIndex of the schedule. Each pass waits on the one before it on its queue and on its wait pass
+	// on the other queue, then signals the next value of its queue
+	QueueSubmission BuildQueueSubmission(const QueueSchedule& schedule, uint32_t passIndex, Ref<CommandBuffer> commandBuffer, QueueTimeline& timeline);
+}
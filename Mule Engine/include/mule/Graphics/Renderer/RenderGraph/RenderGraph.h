@@ -11,10 +11,18 @@
 
 #include "Graphics/Renderer/RenderGraph/RenderPass.h"
 #include "Graphics/Renderer/RenderGraph/ResourceBuilder.h"
+#include "Graphics/Renderer/RenderGraph/ResourceLifetime.h"
+#include "Graphics/Renderer/RenderGraph/QueueSchedule.h"
+#include "Graphics/Renderer/RenderGraph/RenderGraphDump.h"
+#include "Graphics/Renderer/RenderStats.h"
 
-#include "Graphics/Camera.h"
+#include "Graphics/Renderer/RenderView.h"
+
+#include "JobSystem/JobSystem.h"
 
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Mule
 {
@@ -26,22 +34,128 @@ namespace Mule
 
 		void InitializeRegistry(ResourceRegistry& registry);
 
+		// Passes whose writes never reach the output are removed, passes that consume commands are also culled on frames
+		// where they have none. Rebaking only sorts again when passes were created since the last bake
 		void Bake();
-		void Execute(const CommandList& commands, const Camera& camera, uint32_t frameIndex);
+		// Timings are added onto stats when given so several views can accumulate into the same frame
+		// Passes are only queued for submission, nothing reaches the GPU until Flush
+		void Execute(const CommandList& commands, const RenderView& view, uint32_t frameIndex, RenderStats* stats = nullptr);
+		// Submits the passes of every Execute since the last flush in one queue submission
+		void Flush();
+
+		// Shared passes only run on the first Execute after this, later views of the world read what they wrote.
+		// Frame pacing already waited for the last use of the shared resources of the frame index
+		void BeginFrame();
+		// Starts the next world of the frame, its shared passes wait on the GPU for the views of the last world to be done
+		// with the shared resources
+		void BeginWorld();
 
 		WeakRef<RenderPass> CreatePass(const std::string& name, PassType type);
+
+		// Disabled passes are treated as culled, the graph rebakes before the next Execute without sorting again
+		void SetPassEnabled(WeakRef<RenderPass> pass, bool enabled);
 		
-		void SetPreExecutionCallback(std::function<void(const Camera&, const CommandList&, uint32_t)> callback) { mPreExecutionCallback = callback; }
-		void SetResizeCallback(std::function<void(const Camera&, uint32_t, uint32_t, uint32_t)> callback) { mResizeCallback = callback; }
+		// The last argument tells whether the shared passes run for this view
+		void SetPreExecutionCallback(std::function<void(const RenderView&, const CommandList&, uint32_t, bool)> callback) { mPreExecutionCallback = callback; }
+		// Called with the size textures sized to the view are allocated at, only when a view outgrows them
+		void SetResizeCallback(std::function<void(const RenderView&, uint32_t, uint32_t, uint32_t)> callback) { mResizeCallback = callback; }
+		// Also called after every resize since aliasing recreates transient textures
 		void SetRegistrySetupCallback(std::function<void(const ResourceRegistry&, uint32_t frameIndex)> callback) { mSetupCallback = callback; }
 
+		// Texture the registries present, it is left shader read only once the last pass using it is done. Must be set before Bake
+		void SetOutputHandle(ResourceHandle handle) { mOutputHandle = handle; }
+
+		// Textures whose contents carry over from one Execute to the next, like a cache. They are never aliased or cleared,
+		// writers load what is there and are culled on frames they have nothing to draw. Must be set before Bake
+		void SetPersistent(ResourceHandle handle) { mPersistentResources.insert(handle); }
+
+		// Draw ranges are recorded on the job system when one is set, otherwise on the calling thread
+		void SetJobSystem(WeakRef<JobSystem> jobSystem) { mJobSystem = jobSystem; }
+
+		const std::vector<ResourceLifetime>& GetResourceLifetimes() const { return mResourceLifetimes; }
+
+		// Plan the last Execute ran with, including its barriers and clears. Pass timings come from stats, alias groups and
+		// texture sizes from the frame index of registry, each is left out when not given
+		RenderGraphDump Dump(const RenderStats* stats = nullptr, const ResourceRegistry* registry = nullptr, uint32_t frameIndex = 0) const;
+
 	private:
+		// Passes that run for one combination of culled passes, with the barriers, clears and queue waits baked for exactly those
+		struct ExecutionPlan
+		{
+			std::vector<uint32_t> Passes; // Indices into mPasses in execution order
+			std::vector<PassCommands> Commands;
+			QueueSchedule Schedule;
+		};
+
+		// Which passes with a cull bit are idle, and whether the shared passes already ran for an earlier view this frame
+		struct PlanKey
+		{
+			std::vector<bool> Culled;
+			bool SkipShared = false;
+
+			bool operator==(const PlanKey& other) const = default;
+		};
+
+		struct PlanKeyHash
+		{
+			size_t operator()(const PlanKey& key) const noexcept
+			{
+				return std::hash<std::vector<bool>>{}(key.Culled) ^ (key.SkipShared ? 0x9e3779b97f4a7c15ull : 0);
+			}
+		};
+
+		struct CachedPlan
+		{
+			ExecutionPlan Plan;
+			uint64_t LastUse = 0;
+		};
+
+		// Every combination of idle passes can come up, the least recently used plan is dropped beyond this many
+		static constexpr uint32_t sMaxCachedPlans = 64;
+
+		static constexpr uint32_t sResizeGranularity = 256;
+
+		// Culled[i] culls the pass with cull bit i, passes that other running passes still need are kept
+		ExecutionPlan BuildPlan(const PlanKey& key) const;
+		const ExecutionPlan& FindOrBuildPlan(const PlanKey& key);
+		bool CanCullPass(uint32_t passIndex, const std::vector<bool>& running) const;
+
+		// Textures written before they are read, other than the output, share memory when their lifetimes do not overlap.
+		// Textures used on the compute queue keep their own memory since the other queue could still be using it
+		void AliasTransientResources(ResourceRegistry& registry, uint32_t frameIndex);
+
 		bool mIsBaked = false;
+		bool mNeedsRebake = false;
+		bool mRunSharedPasses = true;
+		uint32_t mSortedPassCount = 0;
 		Ref<GraphicsQueue> mQueue;
+		Ref<GraphicsQueue> mComputeQueue; // Null without async compute
 		std::vector<Ref<RenderPass>> mPasses;
+		std::vector<ResourceLifetime> mResourceLifetimes;
+		std::vector<std::vector<uint32_t>> mDependencies; // Explicit dependencies as indices into mPasses
+		std::vector<uint32_t> mCullBits; // UINT32_MAX for passes that always run
+		uint32_t mCullBitCount = 0;
+		std::vector<bool> mRunnable; // Enabled and live
+		std::unordered_map<ResourceHandle, uint32_t> mLifetimeIndices;
+		std::unordered_map<PlanKey, CachedPlan, PlanKeyHash> mPlans;
+		uint64_t mPlanUseCount = 0;
+		PlanKey mLastPlanKey;
+		ResourceHandle mOutputHandle;
+		std::unordered_set<ResourceHandle> mPersistentResources;
+		WeakRef<JobSystem> mJobSystem;
+
+		// Textures written by shared passes, every registry holds the same ones so they are never aliased
+		std::unordered_set<ResourceHandle> mSharedResources;
+		// Values submitted by the views of the current world, and those the shared passes of the next world wait on
+		std::vector<TimelineValue> mSharedResourceUsers;
+		std::vector<TimelineValue> mSharedResourceWaits;
+
+		std::vector<QueueSubmission> mPendingSubmissions;
+		std::vector<QueueSubmission> mPendingComputeSubmissions;
+		std::vector<const ResourceRegistry*> mPendingRegistries;
 
-		std::function<void(const Camera&, const CommandList&, uint32_t)> mPreExecutionCallback;
-		std::function<void(const Camera&, uint32_t, uint32_t, uint32_t)> mResizeCallback;
+		std::function<void(const RenderView&, const CommandList&, uint32_t, bool)> mPreExecutionCallback;
+		std::function<void(const RenderView&, uint32_t, uint32_t, uint32_t)> mResizeCallback;
 		std::function<void(const ResourceRegistry&, uint32_t frameIndex)> mSetupCallback;
 
 	};
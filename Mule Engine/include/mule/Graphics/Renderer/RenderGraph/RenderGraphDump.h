@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Mule
+{
+	// Snapshot of a baked render graph for tools, enums are stored by name so it can be shown or written out as is
+
+	struct DumpBarrier
+	{
+		std::string Resource;
+		std::string Layout;
+		std::string Ownership; // Empty, "Release" or "Acquire"
+		bool Discard = false;
+		bool AfterDraw = false; // Recorded once the pass has drawn instead of before it
+	};
+
+	struct DumpPassResource
+	{
+		std::string Name;
+		bool Write = false;
+	};
+
+	struct DumpPass
+	{
+		std::string Name;
+		std::string Type;
+		std::string Queue;
+		bool Enabled = true;
+		bool Shared = false;
+		bool Running = false; // Part of the plan the last Execute used
+
+		std::vector<DumpPassResource> Resources; // Sorted by name
+		std::vector<DumpBarrier> Barriers;
+		std::vector<std::string> Clears;
+
+		// Pass on the other queue this one waits for, UINT32_MAX if there is none
+		uint32_t WaitPass = UINT32_MAX;
+
+		// Seconds, from the stats the dump was made with
+		double CPUTime = 0.0;
+		double GPUTime = 0.0;
+	};
+
+	struct DumpResource
+	{
+		std::string Name;
+		std::string Type;
+		uint32_t FirstPass = 0;
+		uint32_t LastPass = 0;
+		bool WrittenFirst = false;
+
+		// Resources with the same group share memory, UINT32_MAX for resources that own theirs
+		uint32_t AliasGroup = UINT32_MAX;
+		uint64_t Size = 0; // Only known for textures
+	};
+
+	// Pass From must finish before pass To, Resource is empty for explicit dependencies
+	struct DumpEdge
+	{
+		uint32_t From = 0;
+		uint32_t To = 0;
+		std::string Resource;
+	};
+
+	struct RenderGraphDump
+	{
+		std::vector<DumpPass> Passes; // Execution order, passes not running are included
+		std::vector<DumpResource> Resources; // Sorted by first use
+		std::vector<DumpEdge> Edges; // Between running passes only
+	};
+
+	std::string ToGraphviz(const RenderGraphDump& dump);
+	std::string ToJson(const RenderGraphDump& dump);
+}
@@ -21,7 +21,8 @@ namespace Mule
 	enum class ResourceAccess
 	{
 		Read,
-		Write
+		Write,
+		DepthTest // Bound as the depth attachment but never written, ordered and scheduled like a read
 	};
 
 	struct ResourceUsage
@@ -36,6 +37,26 @@ namespace Mule
 		Graphics
 	};
 
+	struct DrawRange
+	{
+		uint32_t First = 0;
+		uint32_t Count = 0;
+	};
+
+	// Commands the graph generates around a pass, they depend on which other passes run in the same frame
+	struct PassCommands
+	{
+		// Must execute in the order they were added
+		std::vector<RenderCommand> PreDraw;
+		std::vector<RenderCommand> PostDraw;
+
+		// Replayed at the start of every secondary command buffer since bound state is not inherited from the primary
+		std::vector<RenderCommand> Range;
+	};
+
+	// Splits drawCount draws into at most maxRanges contiguous ranges of at least minDrawsPerRange draws each
+	std::vector<DrawRange> SplitDrawRange(uint32_t drawCount, uint32_t minDrawsPerRange, uint32_t maxRanges);
+
 	class RenderPass
 	{
 	public:
@@ -44,47 +65,91 @@ namespace Mule
 
 		void InitRegistry(ResourceRegistry& registry);
 
-		void AddPreDrawCommand(const RenderCommand& command);
-		void AddPostDrawCommand(const RenderCommand& command);
 		void AddDependency(const std::string& passDependency);
 
+		// Passes with effects outside the graph, like a buffer the CPU reads back, are never culled
+		void SetHasSideEffects(bool sideEffects) { mSideEffects = sideEffects; }
+		bool HasSideEffects() const { return mSideEffects; }
+
+		// Shared passes run once per world rather than once per view, everything they write must be shared by the registries.
+		// See RenderGraph::BeginFrame
+		void SetShared(bool shared) { mShared = shared; }
+		bool IsShared() const { return mShared; }
+
+		// Toggled through RenderGraph::SetPassEnabled so the graph knows to rebake
+		void SetEnabled(bool enabled) { mEnabled = enabled; }
+		bool IsEnabled() const { return mEnabled; }
+
 		PassType GetPassType() const { return mPassType; }
+
+		// Set by the render graph when it is baked, before any registry is initialized
+		void SetQueue(QueueType queue) { mQueue = queue; }
+		QueueType GetQueue() const { return mQueue; }
 		const std::string& GetName() const { return mName; }
 		const std::unordered_map<ResourceHandle, ResourceUsage>& GetResourceUsage() const { return mResourceUsage; }
-		Ref<Fence> GetFence(const ResourceRegistry& registry, uint32_t frameIndex);
+
+		// GPU time in seconds of the last submission for frameIndex, the registry must have finished that frame
+		double GetGPUTime(const ResourceRegistry& registry, uint32_t frameIndex) const;
 		WeakRef<GraphicsPipeline> GetGraphicsPipeline() const { return mGraphicsPipeline; }
 		WeakRef<ComputePipeline> GetComputePipeline() const { return mComputePipeline; }
 		const std::vector<std::string>& GetDependencies() const { return mDependencies; }
+		const std::unordered_set<RenderCommandType>& GetCommandTypes() const { return mCommandTypes; }
+
+		// Registry resources the pass records into, InitRegistry adds them. The range buffers are only added for ranged passes
+		ResourceHandle GetCommandBufferHandle() const { return mCommandBufferHandle; }
+		ResourceHandle GetTimestampHandle() const { return mTimestampHandle; }
+		const std::vector<ResourceHandle>& GetRangeCommandBufferHandles() const { return mSecondaryCommandBufferHandles; }
 
-		Ref<CommandBuffer> Execute(const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex);
+		// Ranged passes record their draws into secondary command buffers with RecordRange first, Execute then replays rangeCount of them
+		Ref<CommandBuffer> Execute(const CommandList& commandList, const PassCommands& commands, const ResourceRegistry& registry, uint32_t frameIndex, uint32_t rangeCount = 0);
+		void RecordRange(const CommandList& commandList, const PassCommands& commands, const ResourceRegistry& registry, uint32_t frameIndex, uint32_t slot, DrawRange range);
+		std::vector<DrawRange> GetDrawRanges(const CommandList& commandList) const;
+		bool IsRecordedInRanges() const { return mRangeCallback != nullptr; }
+
+		// Passes that consume commands can be culled on frames where they have none
+		bool ConsumesCommands() const { return !mCommandTypes.empty(); }
+		bool HasCommandsToRecord(const CommandList& commandList) const;
 
 		void AddResource(ResourceHandle handle, ResourceAccess access, uint32_t index = 0);
 		void AddCommandType(RenderCommandType type);
 
 		void SetExecutionCallback(std::function<void(Ref<CommandBuffer>, const CommandList&, const ResourceRegistry&, uint32_t)> callback);
+		void SetRangeExecutionCallback(std::function<uint32_t(const CommandList&)> drawCount, std::function<void(Ref<CommandBuffer>, const CommandList&, const ResourceRegistry&, uint32_t, DrawRange)> callback);
 		void SetPipeline(WeakRef<GraphicsPipeline> pipeline);
 		void SetPipeline(WeakRef<ComputePipeline> pipeline);
 
+		// Bound instead of the pipeline when an earlier pass in the plan already wrote the depth attachment, like a depth pre-pass
+		void SetPrimedDepthPipeline(WeakRef<GraphicsPipeline> pipeline) { mPrimedDepthPipeline = pipeline; }
+		WeakRef<GraphicsPipeline> GetPrimedDepthPipeline() const { return mPrimedDepthPipeline; }
+
 
 	private:
 		const std::string mName;
-		std::string mFenceName;
 		std::string mCmdName;
+		std::string mTimestampName;
 
 		std::unordered_map<ResourceHandle, ResourceUsage> mResourceUsage;
 		std::unordered_set<RenderCommandType> mCommandTypes;
 		PassType mPassType;
+		QueueType mQueue = QueueType::Graphics;
+		bool mSideEffects = false;
+		bool mShared = false;
+		bool mEnabled = true;
 
 		std::function<void(Ref<CommandBuffer>, const CommandList&, const ResourceRegistry&, uint32_t)> mExecutionCallback;
+		std::function<uint32_t(const CommandList&)> mDrawCountCallback;
+		std::function<void(Ref<CommandBuffer>, const CommandList&, const ResourceRegistry&, uint32_t, DrawRange)> mRangeCallback;
 
-		ResourceHandle mFenceHandle;
-		ResourceHandle mCommandBufferHandle;
+		static constexpr uint32_t sMaxDrawRanges = 8;
+		static constexpr uint32_t sMinDrawsPerRange = 64;
 
-		CommandList mPreDrawCommandList;
-		CommandList mPostDrawCommandList;
+		ResourceHandle mCommandBufferHandle;
+		ResourceHandle mTimestampHandle;
+		std::vector<ResourceHandle> mSecondaryCommandBufferHandles;
 
 		WeakRef<ComputePipeline> mComputePipeline;
 		WeakRef<GraphicsPipeline> mGraphicsPipeline;
+		WeakRef<GraphicsPipeline> mPrimedDepthPipeline;
 
 		std::vector<std::string> mDependencies;
 	};
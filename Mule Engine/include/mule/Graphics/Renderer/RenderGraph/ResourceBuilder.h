@@ -22,18 +22,22 @@ namespace Mule
 
 		ResourceHandle CreateSampler(const std::string& name, const SamplerDescription& description);
 		ResourceHandle CreateUniformBuffer(const std::string& name, uint32_t bufferSize);
-		ResourceHandle CreateTexture2D(const std::string& name, TextureFormat format, TextureFlags flags);
-		ResourceHandle CreateTexture2DArray(const std::string& name, uint32_t layers, TextureFormat format, TextureFlags flags);
+		ResourceHandle CreateStorageBuffer(const std::string& name, uint32_t bufferSize);
+		// Sized to the view, rendered at the registry's render extent unless displaySized, see ResourceRegistry::GetExtent
+		ResourceHandle CreateTexture2D(const std::string& name, TextureFormat format, TextureFlags flags, bool displaySized = false);
+		ResourceHandle CreateTexture2DArray(const std::string& name, uint32_t width, uint32_t height, uint32_t layers, TextureFormat format, TextureFlags flags);
 		ResourceHandle CreateSRG(const std::string& name, const std::vector<ShaderResourceDescription>& resources);
 
 		struct SamplerBlueprint { SamplerDescription Description; };
 		struct UniformBufferBlueprint { uint32_t Size; };
+		struct StorageBufferBlueprint { uint32_t Size; };
 		struct SRGBlueprint { std::vector<ShaderResourceDescription> Descriptions; };
-		struct Texture2DBlueprint { TextureFormat format; TextureFlags flags; ResourceType Type; };
-		struct Texture2DArrayBlueprint { uint32_t Layers; TextureFormat Format; TextureFlags Flags; ResourceType Type; };
+		struct Texture2DBlueprint { TextureFormat format; TextureFlags flags; ResourceType Type; bool DisplaySized; };
+		struct Texture2DArrayBlueprint { uint32_t Width; uint32_t Height; uint32_t Layers; TextureFormat Format; TextureFlags Flags; ResourceType Type; };
 
 		const std::unordered_map<std::string, SamplerBlueprint>& GetSamplerBlueprints() const { return mSamplerBlueprints; }
 		const std::unordered_map<std::string, UniformBufferBlueprint>& GetUniformBufferBlueprints() const { return mUniformBufferBlueprints; }
+		const std::unordered_map<std::string, StorageBufferBlueprint>& GetStorageBufferBlueprints() const { return mStorageBufferBlueprints; }
 		const std::unordered_map<std::string, SRGBlueprint>& GetSRGBlueprints() const { return mSRGBlueprints; }
 		const std::unordered_map<std::string, Texture2DBlueprint>& GetTextureBlueprints() const { return mTexture2DBlueprints; }
 		const std::unordered_map<std::string, Texture2DArrayBlueprint>& GetTexture2DArrayBlueprints() const { return mTexture2DArrayBlueprints; }
@@ -44,6 +48,7 @@ namespace Mule
 
 		ResourceBlueprintMap<SamplerBlueprint> mSamplerBlueprints;
 		ResourceBlueprintMap<UniformBufferBlueprint> mUniformBufferBlueprints;
+		ResourceBlueprintMap<StorageBufferBlueprint> mStorageBufferBlueprints;
 		ResourceBlueprintMap<SRGBlueprint> mSRGBlueprints;
 		ResourceBlueprintMap<Texture2DBlueprint> mTexture2DBlueprints;
 		ResourceBlueprintMap<Texture2DArrayBlueprint> mTexture2DArrayBlueprints;
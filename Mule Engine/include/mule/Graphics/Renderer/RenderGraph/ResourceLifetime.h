@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Graphics/Renderer/RenderGraph/RenderPass.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Mule
+{
+	// Range of passes, as indices into the execution order, that touch a resource
+	struct ResourceLifetime
+	{
+		ResourceHandle Handle;
+		uint32_t FirstPass = 0;
+		uint32_t LastPass = 0;
+
+		// The first pass writes the resource, so nothing from before FirstPass is ever read
+		bool WrittenFirst = false;
+	};
+
+	// Resources that share one allocation, the first member is the largest and owns it
+	struct AliasSlot
+	{
+		uint64_t Size = 0;
+		std::vector<uint32_t> Members;
+	};
+
+	// passUsage is the resource usage of every pass in execution order, lifetimes are sorted by first use
+	std::vector<ResourceLifetime> ComputeResourceLifetimes(const std::vector<std::unordered_map<ResourceHandle, ResourceUsage>>& passUsage);
+
+	// Resources used by the same pass are always considered alive together
+	bool LifetimesOverlap(const ResourceLifetime& lhs, const ResourceLifetime& rhs);
+
+	// Packs resources largest first into the first slot where no member is alive at the same time, sizes[i] belongs to lifetimes[i]
+	std::vector<AliasSlot> AssignAliasSlots(const std::vector<ResourceLifetime>& lifetimes, const std::vector<uint64_t>& sizes);
+}
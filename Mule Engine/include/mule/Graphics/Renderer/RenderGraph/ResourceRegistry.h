@@ -8,6 +8,7 @@
 // Resources
 #include "Graphics/API/Texture.h"
 #include "Graphics/API/UniformBuffer.h"
+#include "Graphics/API/StorageBuffer.h"
 #include "Graphics/API/Framebuffer.h"
 #include "Graphics/API/Semaphore.h"
 #include "Graphics/API/ShaderResourceGroup.h"
@@ -16,15 +17,22 @@
 #include "Graphics/API/CommandBuffer.h"
 #include "Graphics/API/TimelineSemaphore.h"
 #include "Graphics/API/Texture2DArray.h"
+#include "Graphics/API/TimestampQueryPool.h"
+
+#include <glm/glm.hpp>
 
 #include <vector>
 #include <variant>
+#include <array>
+#include <unordered_map>
 
 namespace Mule
 {
 	enum class RegistryVariable : uint32_t {
 		Width,
 		Height,
+		RenderWidth,
+		RenderHeight,
 
 		MAX
 	};
@@ -43,29 +51,68 @@ namespace Mule
 		void InsertResources(ResourceHandle handle, const std::vector<Ref<T>>& resources);
 
 		ResourceHandle AddFence(const std::string& name);
-		ResourceHandle AddCommandBuffer(const std::string& name);
+		ResourceHandle AddCommandBuffer(const std::string& name, QueueType queue = QueueType::Graphics);
+
+		// Secondary command buffers get their own allocator so they can be recorded on any thread
+		ResourceHandle AddSecondaryCommandBuffer(const std::string& name);
+
+		ResourceHandle AddTimestampQueryPool(const std::string& name, uint32_t count, QueueType queue = QueueType::Graphics);
 
 		template<class T>
 		Ref<T> GetResource(ResourceHandle handle, uint32_t frameIndex) const;
 
 		WeakRef<TextureView> GetColorOutput() const;
+		glm::vec2 GetColorOutputUV() const; // Bottom right corner of the image in the color output
 		ResourceHandle GetColorOutputHandle() const { return mOutputHandle; }
 		uint32_t GetFramesInFlight() const { return mFramesInFlight; }
 
+		// Unique for the lifetime of the process, unlike the registry's address it is never reused once it is destroyed
+		uint64_t GetId() const { return mId; }
+
 		void SetOutputHandle(ResourceHandle outputHandle, uint32_t layer = 0);
-		void CopyRegistryResources(ResourceRegistry& registry);
-		void WaitForFences(uint32_t frameIndex);
+		// Shares every resource registry was built with or given, its command allocator and semaphores stay its own
+		void CopyRegistryResources(const ResourceRegistry& registry);
+
+		// Work of a frame index is done once the timeline semaphore of each queue reaches the last value the render graph submitted for it
+		void WaitForFrame(uint32_t frameIndex);
+		bool IsFrameComplete(uint32_t frameIndex) const;
+		uint64_t GetSubmittedValue(uint32_t frameIndex, QueueType queue = QueueType::Graphics) const { return mSubmittedValues[frameIndex][static_cast<uint32_t>(queue)]; }
+		void SetSubmittedValue(uint32_t frameIndex, QueueType queue, uint64_t value) { mSubmittedValues[frameIndex][static_cast<uint32_t>(queue)] = value; }
 
+		// Textures sized to the view only ever grow, a smaller view renders into their top left corner so resizing is cheap
 		void Resize(uint32_t width, uint32_t height);
 		bool IsResizeRequested(uint32_t frameIndex);
 		void SetResizeHandled(uint32_t frameIndex);
 		std::pair<uint32_t, uint32_t> GetResizeDimensions(uint32_t frameIndex);
+		std::pair<uint32_t, uint32_t> GetAllocatedDimensions(uint32_t frameIndex) const;
+		void SetAllocatedDimensions(uint32_t frameIndex, uint32_t width, uint32_t height);
+
+		// Fraction of the display extent rendered in each dimension, a frame index picks it up in UpdateRenderExtent
+		void SetRenderScale(float scale);
+		float GetRenderScale() const { return mRenderScale; }
+		void UpdateRenderExtent(uint32_t frameIndex);
 
-		Ref<TimelineSemaphore> GetSemaphore(uint32_t frameIndex) const;
+		Ref<TimelineSemaphore> GetSemaphore(uint32_t frameIndex, QueueType queue = QueueType::Graphics) const;
 
+		// Bytes the render graph saved by aliasing transient textures, summed over every frame in flight
+		void SetAliasedMemorySaved(uint32_t frameIndex, uint64_t bytes);
+		uint64_t GetAliasedMemorySaved() const;
+
+		// Transient textures sharing memory in a frame index, mapped to the index of their group
+		void SetAliasGroups(uint32_t frameIndex, std::unordered_map<ResourceHandle, uint32_t> groups) { mAliasGroups[frameIndex] = std::move(groups); }
+		const std::unordered_map<ResourceHandle, uint32_t>& GetAliasGroups(uint32_t frameIndex) const { return mAliasGroups[frameIndex]; }
+
+		// Display extent, what the view is shown at
 		uint32_t GetWidth(uint32_t frameIndex) const;
 		uint32_t GetHeight(uint32_t frameIndex) const;
 
+		// Render extent, what the scene is rendered at before it is upscaled to the display extent
+		uint32_t GetRenderWidth(uint32_t frameIndex) const;
+		uint32_t GetRenderHeight(uint32_t frameIndex) const;
+
+		// Region of the texture written this frame, the whole texture for textures not sized to the view
+		std::pair<uint32_t, uint32_t> GetExtent(ResourceHandle handle, uint32_t frameIndex) const;
+
 		void SetFrameIndex(uint32_t frameIndex) { mFrameIndex = frameIndex; }
 
 		const std::vector<ResourceHandle>& GetResourceHandles() const { return mResourceHandles; }
@@ -74,6 +121,7 @@ namespace Mule
 		T GetVariable(RegistryVariable var, uint32_t frameIndex = 0) const;
 
 	private:
+		uint64_t mId;
 		uint32_t mFramesInFlight;
 		uint32_t mFrameIndex;
 
@@ -85,17 +133,20 @@ namespace Mule
 		uint32_t mOutputHandleLayer;
 		ResourceHandle mCommandAllocatorHandle;
 		ResourceHandle mTimelineSemaphoreHandle;
+		ResourceHandle mComputeTimelineSemaphoreHandle;
 
 		using ResourceVariant = std::variant<
 			Ref<Texture>,
 			Ref<UniformBuffer>,
+			Ref<StorageBuffer>,
 			Ref<Framebuffer>,
 			Ref<ShaderResourceGroup>,
 			Ref<Fence>,
 			Ref<CommandAllocator>,
 			Ref<CommandBuffer>,
 			Ref<TimelineSemaphore>,
-			Ref<Sampler>
+			Ref<Sampler>,
+			Ref<TimestampQueryPool>
 			>;
 
 		struct InFlightResource
@@ -114,6 +165,7 @@ namespace Mule
 
 		ResourceMap mResources;
 		std::vector<InFlightResource> mFences;
+		std::vector<std::array<uint64_t, 2>> mSubmittedValues; // Graphics and compute
 		
 		struct ResizeRequest {
 			bool Handled = true;
@@ -121,9 +173,19 @@ namespace Mule
 			uint32_t ResizeHeight = 0;
 			uint32_t Width = 0;
 			uint32_t Height = 0;
+			uint32_t RenderWidth = 0;
+			uint32_t RenderHeight = 0;
+			uint32_t AllocatedWidth = 0;
+			uint32_t AllocatedHeight = 0;
 		};
 
 		std::vector<ResizeRequest> mResizeRequests;
+		float mRenderScale = 1.f;
+
+		// Textures sized to the view, true for those at the display extent
+		std::unordered_map<ResourceHandle, bool> mViewTextures;
+		std::vector<uint64_t> mAliasedMemorySaved;
+		std::vector<std::unordered_map<ResourceHandle, uint32_t>> mAliasGroups;
 	};
 }
 
@@ -51,6 +51,8 @@ namespace Mule
 		{
 		case Mule::RegistryVariable::Width: return mResizeRequests[frameIndex].Width;
 		case Mule::RegistryVariable::Height: return mResizeRequests[frameIndex].Height;
+		case Mule::RegistryVariable::RenderWidth: return mResizeRequests[frameIndex].RenderWidth;
+		case Mule::RegistryVariable::RenderHeight: return mResizeRequests[frameIndex].RenderHeight;
 		case Mule::RegistryVariable::MAX:
 		default:
 			assert(false && "Invalid registry variable");
@@ -4,6 +4,7 @@ namespace Mule
 {
 	enum class ResourceType {
 		UniformBuffer,
+		StorageBuffer,
 		ShaderResourceGroup,
 		Texture,
 		CommandBuffer,
@@ -12,6 +13,7 @@ namespace Mule
 		CommandAllocator,
 		RenderTarget,
 		DepthAttachment,
-		Sampler
+		Sampler,
+		TimestampQueryPool
 	};
 }
\ No newline at end of file
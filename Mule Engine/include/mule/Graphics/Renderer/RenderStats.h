@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Mule
+{
+	// Times are in seconds and summed over every view rendered in the frame
+	struct PassStats
+	{
+		std::string Name;
+		double CPUExecutionTime = 0.0;
+
+		// Read from timestamp queries once the pass has finished on the GPU, so it trails the CPU time by the frames in flight.
+		// Async compute passes overlap the graphics passes, so the GPU times of the two queues do not add up to the frame
+		double GPUExecutionTime = 0.0;
+		bool AsyncCompute = false;
+	};
+
+	struct RenderStats
+	{
+		double CPUPrepareTime = 0.0;
+		double CPUExecutionTime = 0.0;
+		double CPUWaitTime = 0.0; // Blocked on the GPU finishing the frame that last used this frame index
+
+		uint32_t FramesInFlight = 0;
+		float RenderScale = 1.f; // Picked by dynamic resolution, 1 while it is disabled
+
+		uint32_t ViewCount = 0;
+		uint32_t DrawCount = 0;
+		uint64_t TriangleCount = 0;
+		uint32_t DescriptorUpdates = 0;
+		uint32_t Uploads = 0;
+		uint64_t UploadBytes = 0;
+		uint32_t Barriers = 0;
+		uint32_t ImageBarriers = 0;
+		uint32_t QueueSubmits = 0;
+		uint32_t CulledPasses = 0; // Skipped for having no commands or for being shared with an earlier view, summed over views
+
+		// Bytes of transient textures sharing memory in the registries of the rendered views
+		uint64_t AliasedMemorySaved = 0;
+
+		std::vector<PassStats> RenderPassStats;
+	};
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Ref.h"
+
+#include "Graphics/Camera.h"
+#include "Graphics/Renderer/RenderGraph/ResourceRegistry.h"
+
+#include <glm/glm.hpp>
+
+namespace Mule
+{
+	// What the render graph reads of a camera, taken at submit so the camera can keep moving while the frame renders.
+	// The registry is held so it outlives the request even if the camera is destroyed first
+	struct RenderView
+	{
+		RenderView() = default;
+		explicit RenderView(const Camera& camera)
+			:
+			View(camera.GetView()),
+			Proj(camera.GetProj()),
+			ViewProj(camera.GetViewProj()),
+			Position(camera.GetPosition()),
+			ForwardDir(camera.GetForwardDir()),
+			NearPlane(camera.GetNearPlane()),
+			FarPlane(camera.GetFarPlane()),
+			DepthPrePass(camera.GetDepthPrePass()),
+			Registry(camera.GetRegistry())
+		{
+		}
+
+		glm::mat4 View = glm::mat4(1.f);
+		glm::mat4 Proj = glm::mat4(1.f);
+		glm::mat4 ViewProj = glm::mat4(1.f);
+		glm::vec3 Position = glm::vec3(0.f);
+		glm::vec3 ForwardDir = glm::vec3(0.f, 0.f, -1.f);
+		float NearPlane = 0.f;
+		float FarPlane = 0.f;
+		bool DepthPrePass = false;
+
+		Ref<ResourceRegistry> Registry = nullptr;
+	};
+}
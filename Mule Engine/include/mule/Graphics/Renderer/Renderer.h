@@ -1,31 +1,62 @@
 #pragma once
 
 #include "Ref.h"
+#include "WeakRef.h"
 
 #include "Graphics/Renderer/RenderGraph/RenderGraph.h"
 #include "Graphics/Renderer/RenderGraph/ResourceBuilder.h"
 #include "Graphics/Renderer/CommandList.h"
+#include "Graphics/Renderer/ObjectTable.h"
+#include "Graphics/Renderer/IndirectDrawList.h"
+#include "Graphics/Renderer/LightClusters.h"
+#include "Graphics/Renderer/HiZ.h"
+#include "Graphics/Renderer/RenderStats.h"
+#include "Graphics/Renderer/DynamicResolution.h"
+#include "Graphics/Renderer/StaticShadowCache.h"
+#include "Graphics/Renderer/RenderView.h"
 #include "Graphics/Camera.h"
 #include "Graphics/GuidArray.h"
 #include "Graphics/GPUObjects.h"
 
+#include "JobSystem/JobSystem.h"
+
 #include <vector>
 #include <mutex>
+#include <unordered_map>
 
 namespace Mule
 {
+	// Identifies a render request slot owned by the renderer, scenes record directly into the slots command list.
+	// Only valid until the next call to Render, the slot is handed out again once its buffer comes around
+	struct RenderRequestHandle
+	{
+		uint32_t Buffer = UINT32_MAX;
+		uint32_t Index = UINT32_MAX;
+		uint64_t Generation = 0;
+
+		operator bool() const { return Buffer != UINT32_MAX && Index != UINT32_MAX; }
+	};
+
 	class Renderer
 	{
 	public:
 		~Renderer() = default;
 
-		static void Init();
+		// Views record their draw ranges on the job system workers when one is given. More frames in flight let the CPU run
+		// further ahead of the GPU at the cost of latency, clamped to [1, sMaxFramesInFlight]
+		static void Init(WeakRef<JobSystem> jobSystem = nullptr, uint32_t framesInFlight = 2);
 		static void Shutdown();
 		static Renderer& Get();
+		static bool IsInitialized() { return sRenderer != nullptr; }
 
-		// TODO: we need to keep a weak reference to all resource registrys so we can properly wait on them when updating global resources like bindless textures
 		Ref<ResourceRegistry> CreateResourceRegistry();
-		void Submit(const Camera& camera, const CommandList& commandList);
+
+		// Requests given the same world draw the same objects and lights, view independent work like shadows is done for
+		// the first of them each frame and shared with the rest. A request has to be recorded and submitted before the next
+		// call to Render, later submits are dropped. Submit returns false if the request won't be rendered
+		RenderRequestHandle BeginRequest(WeakRef<Camera> camera, const void* world = nullptr);
+		CommandList& GetCommandList(RenderRequestHandle handle);
+		bool Submit(RenderRequestHandle handle);
 
 		void Render();
 
@@ -36,11 +67,36 @@ namespace Mule
 		void UpdateMaterial(WeakRef<Material> material);
 		void RemoveMaterial(WeakRef<Material> material);
 
+		// Releases the per object storage buffer slot used by draw commands with this object id in the world
+		void RemoveObject(const void* world, uint64_t objectId);
+
+		// Releases everything the renderer keeps for a world, called when the world is destroyed. Requests the world already
+		// submitted are dropped
+		void RemoveWorld(const void* world);
+
 		uint32_t GetFramesInFlight() const { return mFramesInFlight; }
 		uint32_t GetFrameIndex() const { return mFrameIndex; }
 
+		// Scales the render extent of every view to keep the GPU time of a frame under the target, views keep the render
+		// scale of their registry while it is disabled
+		void SetDynamicResolution(const DynamicResolutionSettings& settings) { mDynamicResolution.SetSettings(settings); }
+		const DynamicResolutionSettings& GetDynamicResolution() const { return mDynamicResolution.GetSettings(); }
+
+		// Shadow draws reach their cascade layer through the vertex shader instead of a geometry shader. Devices without
+		// VK_EXT_shader_viewport_index_layer always use the geometry shader, takes effect on the next call to Render
+		void SetVertexShadowLayers(bool enabled) { mVertexShadowLayers = enabled && mShadowVertexLayerPass; }
+		bool GetVertexShadowLayers() const { return mVertexShadowLayers; }
+
+		// Statistics of the last call to Render
+		const RenderStats& GetStats() const { return mStats; }
+
+		// Render graph as the last call to Render ran it, aliasing and texture sizes are those of one of the views it rendered
+		RenderGraphDump DumpRenderGraph() const;
+
+		static constexpr uint32_t sMaxFramesInFlight = 4;
+
 	private:
-		Renderer();
+		Renderer(uint32_t framesInFlight);
 		void BuildGraph();
 		void UpdateBindlessResources();
 		bool BindlessResourcesNeedUpdate();
@@ -49,26 +105,61 @@ namespace Mule
 
 		struct RenderRequest
 		{
-			Camera Camera;
+			WeakRef<Camera> SourceCamera = nullptr;
+			RenderView View; // Taken from the source camera at submit, moving the camera afterwards doesn't race the render thread
+			const void* World = nullptr;
 			CommandList Commands;
+			bool Recording = false;
+			bool Submitted = false;
+		};
+
+		// Requests are never erased, slots and their command list storage are reused every time the buffer comes around again.
+		// The generation counts the calls to Render that took the buffer, handles of an older generation are stale
+		struct RenderRequestBuffer
+		{
+			std::vector<Ref<RenderRequest>> Requests;
+			uint32_t Count = 0;
+			uint64_t Generation = 0;
 		};
 
+		static constexpr uint32_t sRequestBufferCount = 2;
+
+		static constexpr uint32_t sShadowMapSize = 2048;
+		static constexpr uint32_t sShadowCascadeCount = 4;
+
+		void UpdateObjects(const std::vector<Ref<RenderRequest>>& requests);
+
 		std::mutex mMutex;
 		std::mutex mResourceMutex;
-		std::vector<RenderRequest> mRenderRequests;
+		RenderRequestBuffer mRequestBuffers[sRequestBufferCount];
+		uint32_t mRecordBufferIndex;
+		std::vector<Ref<RenderRequest>> mRenderRequests; // Requests taken by the running call to Render
 		Ref<RenderGraph> mRenderGraph;
 		uint32_t mFramesInFlight;
 		uint32_t mFrameIndex;
+		uint64_t mFrameNumber = 0; // Frames rendered so far, unlike the frame index it never wraps
 
 		ResourceBuilder mResourceBuilder;
 
+		// Textures written by the shared passes, one set for every registry
+		ResourceBuilder mSharedResourceBuilder;
+		Ref<ResourceRegistry> mSharedRegistry;
+
+		RenderStats mStats;
+		RenderStats mFrameStats;
+		DynamicResolution mDynamicResolution;
+
+		bool mVertexShadowLayers = false;
+		WeakRef<RenderPass> mShadowGeometryLayerPass;
+		WeakRef<RenderPass> mShadowVertexLayerPass;
+
 		ResourceHandle mBindlessTextureSRGHandle;
 		ResourceHandle mBindlessMaterialBufferHandle;
 		ResourceHandle mBindlessMaterialSRGHandle;
 
 		std::vector<Ref<ShaderResourceGroup>> mBindlessTextureSRG;
 		std::vector<Ref<ShaderResourceGroup>> mBindlessMaterialSRG;
-		std::vector<Ref<UniformBuffer>> mBindlessMaterialBuffer;
+		std::vector<Ref<StorageBuffer>> mBindlessMaterialBuffer;
 
 		Ref<Texture2D> mBlackTex;
 		Ref<Texture2D> mWhiteTex;
@@ -89,6 +180,74 @@ namespace Mule
 			std::vector<WeakRef<Material>> RemoveMaterials;
 		};
 
-		std::vector<BindlessResourceUpdate> mResourceUpdates;
+		BindlessResourceUpdate mResourceUpdates;
+
+		// Table slots changed since each frame index last wrote its own copy of the tables
+		std::vector<std::vector<uint32_t>> mPendingTextureWrites;
+		std::vector<std::vector<uint32_t>> mPendingMaterialWrites;
+
+		// Registries that may still have work in flight for each frame index, dropped once their frame completes
+		std::vector<std::vector<Ref<ResourceRegistry>>> mFrameRegistries;
+
+		// Per object data, shared by every view and only touched on the render thread
+		ObjectTable mObjectTable;
+		std::vector<std::pair<const void*, uint64_t>> mObjectRemovals;
+		std::vector<const void*> mWorldRemovals;
+		const void* mExecutingWorld = nullptr; // World of the view the render graph is executing
+
+		ResourceHandle mObjectBufferHandle;
+		ResourceHandle mObjectSRGHandle;
+
+		std::vector<Ref<StorageBuffer>> mObjectBuffers;
+		std::vector<Ref<ShaderResourceGroup>> mObjectSRG;
+
+		// Rebuilt for each view before its passes execute
+		std::vector<IndirectDrawItem> mGBufferDrawItems;
+		std::vector<IndirectDrawItem> mShadowDrawItems;
+		std::vector<IndirectDrawItem> mShadowCasters;
+		std::vector<IndirectDrawItem> mStaticShadowCasters;
+		std::vector<glm::vec4> mShadowCasterSpheres;
+		std::vector<glm::vec4> mStaticShadowCasterSpheres;
+		std::vector<uint32_t> mShadowCommandCascades; // Cascade layer of each command in mShadowDrawList
+		std::vector<uint32_t> mStaticShadowCommandCascades;
+		std::vector<uint32_t> mStaleStaticCascades; // Static layers drawn again this frame, cleared before their draws
+		std::vector<uint64_t> mStaticCasterHashes; // Of the static casters inside the cascade being culled
+
+		// Level of detail each object was drawn with last time, per view registry id, so selection can apply hysteresis.
+		// Views that were not rendered in a frame are dropped at the end of it
+		struct LodHistory
+		{
+			std::unordered_map<uint64_t, uint32_t> Levels;
+			uint64_t LastFrame = 0;
+		};
+
+		std::unordered_map<uint64_t, LodHistory> mLodHistory;
+		IndirectDrawList mGBufferDrawList;
+		bool mDepthPrePass = false; // The G-buffer draws are laid down in depth first for the view being rendered
+		IndirectDrawList mShadowDrawList;
+		IndirectDrawList mStaticShadowDrawList;
+		StaticShadowCache mStaticShadowCache;
+		GPU::CascadedShadowLightMatrices mShadowLightCameras{}; // Fitted to every view of the world being rendered
+		std::vector<const RenderView*> mWorldViews; // Views of the world being rendered, the shared cascades cover all of them
+		std::vector<GPU::PointLight> mPointLights;
+		std::vector<GPU::SpotLight> mSpotLights;
+		LightClusterList mLightClusters;
+
+		// Depth pyramid of each view by registry id, read back from the Hi-Z pass once the frame index that rendered it
+		// comes around again. Views that were not rendered in a frame are dropped at the end of it
+		struct HiZView
+		{
+			HiZPyramid Pyramid;
+			glm::mat4 ViewProjection = glm::mat4(1.f);
+			bool Valid = false;
+			uint64_t LastFrame = 0;
+
+			// What each frame index's Hi-Z buffer was rendered with, false until something has been rendered into it
+			std::vector<glm::mat4> FrameViewProjections;
+			std::vector<bool> FrameRendered;
+		};
+
+		std::unordered_map<uint64_t, HiZView> mHiZViews;
+		std::vector<float> mHiZReadback;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Graphics/Renderer/IndirectDrawList.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace Mule
+{
+	// What the static shadow layers of every frame in flight were last rendered with. A layer only has to be rendered
+	// again once its light space matrix or the static casters inside it change, or another world rendered into it
+	class StaticShadowCache
+	{
+	public:
+		StaticShadowCache(uint32_t framesInFlight, uint32_t cascadeCount);
+
+		// Returns true when the layer is stale, it is then recorded as holding the new state
+		bool Update(const void* world, uint32_t frameIndex, uint32_t cascade, const glm::mat4& lightSpaceMatrix, uint64_t casterHash);
+
+		// Layers holding the world are stale from now on, a world created later at the same address must not match them
+		void RemoveWorld(const void* world);
+
+	private:
+		struct Layer
+		{
+			const void* World = nullptr;
+			glm::mat4 LightSpaceMatrix = glm::mat4(1.f);
+			uint64_t CasterHash = 0;
+			bool Valid = false;
+		};
+
+		uint32_t mCascadeCount;
+		std::vector<Layer> mLayers; // Indexed by frameIndex * mCascadeCount + cascade
+	};
+
+	// Covers everything that changes what a caster draws into a shadow map
+	uint64_t HashShadowCaster(const IndirectDrawItem& item, const glm::mat4& transform);
+
+	// Hash of every caster in a layer. The caster hashes are sorted first so the order they are drawn in does not matter,
+	// then mixed one by one so different sets of casters do not cancel out the way a sum can
+	uint64_t CombineShadowCasterHashes(std::vector<uint64_t>& hashes);
+}
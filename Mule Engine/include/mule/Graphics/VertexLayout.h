@@ -66,6 +66,13 @@ namespace Mule
 			return *this;
 		}
 
+		// Skips bytes at the end of each vertex, so a pipeline can read a prefix of a larger interleaved vertex
+		VertexLayout& AddPadding(uint32_t size)
+		{
+			mVertexSize += size;
+			return *this;
+		}
+
 		const std::vector<AttributeType>& GetAttributes() const { return mTypes; }
 
 		uint32_t GetVertexSize() const
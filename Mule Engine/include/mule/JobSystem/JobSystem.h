@@ -3,7 +3,11 @@
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <atomic>
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <type_traits>
 
 namespace Mule
 {
@@ -16,11 +20,65 @@ namespace Mule
 		template<typename F, typename... Args>
 		void PushJob(F&& func, Args&&... args)
 		{
+			std::lock_guard<std::mutex> lock(mMutex);
 			mJobs.push([func, args...]() {
 				func(std::forward<Args>(args)...);
 				});
 		}
 
+		// Calls func(i) for every i in [0, count) on the workers and the calling thread, returns once every call has finished.
+		// Helpers are queued behind whatever jobs are already pending, the calling thread never waits for them to start and
+		// does the work itself if no worker is free
+		template<typename F>
+		void ParallelFor(uint32_t count, F&& func)
+		{
+			if (count == 0)
+				return;
+
+			// Outlives this call so helpers that only start after the last index was claimed can still look at it
+			struct State
+			{
+				std::atomic<uint32_t> Next = 0;
+				std::atomic<uint32_t> ActiveHelpers = 0;
+				uint32_t Count = 0;
+				std::remove_reference_t<F>* Func = nullptr;
+			};
+
+			auto state = std::make_shared<State>();
+			state->Count = count;
+			state->Func = &func;
+
+			uint32_t jobCount = std::min(count - 1, GetWorkerCount());
+			for (uint32_t i = 0; i < jobCount; i++)
+			{
+				PushJob([state]() {
+					// Registered before claiming, so the caller either waits for this helper or it finds nothing left to claim
+					// and returns without touching func
+					state->ActiveHelpers++;
+					for (uint32_t index = state->Next++; index < state->Count; index = state->Next++)
+					{
+						(*state->Func)(index);
+					}
+
+					if (--state->ActiveHelpers == 0)
+						state->ActiveHelpers.notify_all();
+					});
+			}
+
+			for (uint32_t index = state->Next++; index < count; index = state->Next++)
+			{
+				func(index);
+			}
+
+			// Every index is claimed, only helpers still inside a call can be running func
+			for (uint32_t active = state->ActiveHelpers; active > 0; active = state->ActiveHelpers)
+			{
+				state->ActiveHelpers.wait(active);
+			}
+		}
+
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(mThreads.size()); }
+
 	private:
 		bool mRunning;
 		std::mutex mMutex;
@@ -30,4 +88,4 @@ namespace Mule
 		std::vector<std::thread> mThreads;
 		std::queue<std::function<void()>> mJobs;
 	};
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <atomic>
 
 template<class T>
 class Ref
@@ -9,7 +10,7 @@ public:
     explicit Ref(T* ptr)
     {
         mPtr = ptr;
-        mRefCount = new size_t(1);
+        mRefCount = new std::atomic<size_t>(1);
     }
 
     explicit Ref()
@@ -81,7 +82,7 @@ public:
         if (mPtr != ptr) {
             Release();
             mPtr = ptr;
-            mRefCount = new size_t(ptr ? 1 : 0);
+            mRefCount = new std::atomic<size_t>(ptr ? 1 : 0);
         }
         return *this;
     }
@@ -131,13 +132,13 @@ public:
     }
 
     size_t UseCount() const {
-        return (mRefCount != nullptr) ? *mRefCount : 0;
+        return (mRefCount != nullptr) ? mRefCount->load() : 0;
     }
 
-    size_t* RefCountPtr() const { return mRefCount; }
+    std::atomic<size_t>* RefCountPtr() const { return mRefCount; }
 
 private:
-    Ref(T* ptr, size_t* refCount)
+    Ref(T* ptr, std::atomic<size_t>* refCount)
         :
         mPtr(ptr),
         mRefCount(refCount)
@@ -145,7 +146,9 @@ private:
     }
 
     T* mPtr;
-    size_t* mRefCount;
+
+    // Atomic so refs to shared resources can be copied from job system workers
+    std::atomic<size_t>* mRefCount;
 };
 
 template <class T, typename... Args>
@@ -2,6 +2,8 @@
 
 #include "Ref.h"
 
+#include <type_traits>
+
 template<typename T>
 class WeakRef
 {
@@ -30,17 +32,18 @@ public:
     {
     }
 
+    // Constrained rather than static_assert'd so overloads taking WeakRefs of unrelated types stay unambiguous
     template<typename Derived>
+        requires (std::is_base_of<T, Derived>::value || std::is_base_of<Derived, T>::value)
     WeakRef(const Ref<Derived>& other)
     {
-		static_assert(std::is_base_of<T, Derived>::value || std::is_base_of<Derived, T>::value, "WeakRef can only be constructed from Ref of a derived type");
         mPtr = (T*)other.Get();
     }
 
     template<typename Derived>
+        requires (std::is_base_of<T, Derived>::value || std::is_base_of<Derived, T>::value)
     WeakRef(const WeakRef<Derived>& other)
     {
-        static_assert(std::is_base_of<T, Derived>::value || std::is_base_of<Derived, T>::value, "WeakRef can only be constructed from WeakRef of a derived type");
         mPtr = (T*)other.Get();
     }
 
@@ -27,8 +27,10 @@ namespace Mule
 		Ref<ShaderResourceGroup> diffuseIBLSRG = ShaderResourceGroup::Create(diffuseIBLShader->GetBlueprintIndex(0));
 		Ref<ShaderResourceGroup> prefilterIBLSRG = ShaderResourceGroup::Create(prefilterIBLShader->GetBlueprintIndex(0));
 
-		Ref<GraphicsQueue> queue = GraphicsQueue::Create();
-		Ref<CommandAllocator> commandAllocator = CommandAllocator::Create();
+		// Only dispatches are recorded, on the async compute queue they do not stall frames rendering on the graphics queue.
+		// The storage cube maps are shared by both queue families so no ownership transfer is needed
+		Ref<GraphicsQueue> queue = GraphicsQueue::Create(QueueType::Compute);
+		Ref<CommandAllocator> commandAllocator = CommandAllocator::Create(QueueType::Compute);
 		Ref<CommandBuffer> commandBuffer = commandAllocator->CreateCommandBuffer();
 		Ref<Fence> fence = Fence::Create();
 		fence->Reset();
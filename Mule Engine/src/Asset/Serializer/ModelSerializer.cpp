@@ -4,6 +4,7 @@
 #include "Asset/Serializer/Convert/YamlConvert.h"
 
 #include "Graphics/Vertex.h"
+#include "Graphics/MeshSimplifier.h"
 #include "ScopedBuffer.h"
 #include "Engine Context/EngineContext.h"
 
@@ -102,6 +103,9 @@ namespace Mule
 		ScopedBuffer vertices(sizeof(StaticVertex) * mesh->mNumVertices);		
 		StaticVertex* verticePtr = vertices.As<StaticVertex>();
 
+		glm::vec3 meshMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 meshMax = glm::vec3(std::numeric_limits<float>::lowest());
+
 		for (int i = 0; i < mesh->mNumVertices; i++)
 		{
 			StaticVertex v;
@@ -122,34 +126,51 @@ namespace Mule
 			info.Max.y = glm::max(info.Max.y, pos.y);
 			info.Max.z = glm::max(info.Max.z, pos.z);
 
+			meshMin = glm::min(meshMin, pos);
+			meshMax = glm::max(meshMax, pos);
 
 			verticePtr[i] = v;
 		}
 
+		std::vector<glm::vec3> positions(mesh->mNumVertices);
+		for (uint32_t i = 0; i < mesh->mNumVertices; i++)
+			positions[i] = verticePtr[i].Position;
+
+		std::vector<uint32_t> sourceIndices;
+		sourceIndices.reserve(mesh->mNumFaces * 3);
+		for (int i = 0; i < mesh->mNumFaces; i++)
+		{
+			// Points and lines are left out, they cant be drawn with the triangle list pipelines anyway
+			if (mesh->mFaces[i].mNumIndices != 3)
+				continue;
+
+			sourceIndices.push_back(mesh->mFaces[i].mIndices[0]);
+			sourceIndices.push_back(mesh->mFaces[i].mIndices[1]);
+			sourceIndices.push_back(mesh->mFaces[i].mIndices[2]);
+		}
+
+		// Every level shares the vertex buffer and is appended to the index buffer
+		std::vector<uint32_t> lodIndices;
+		std::vector<MeshLod> lods;
+		BuildLodChain(positions, sourceIndices, sMaxLodLevels, sLodReduction, sMinLodTriangles, lodIndices, lods);
+
+		// The index type only depends on the largest vertex index, not on how many indices there are
 		IndexType indexType;
 		ScopedBuffer indices;
-		if (mesh->mNumFaces * 3 > UINT16_MAX)
+		if (mesh->mNumVertices > UINT16_MAX)
 		{
-			indices.Allocate(sizeof(uint32_t) * mesh->mNumFaces * 3);
-			uint32_t* indexPtr = indices.As<uint32_t>();
+			indices.Allocate(sizeof(uint32_t) * lodIndices.size());
 			indexType = IndexType::Size_32Bit;
-			for (int i = 0; i < mesh->mNumFaces; i++)
-			{
-				indexPtr[i * 3 + 0] = mesh->mFaces[i].mIndices[0];
-				indexPtr[i * 3 + 1] = mesh->mFaces[i].mIndices[1];
-				indexPtr[i * 3 + 2] = mesh->mFaces[i].mIndices[2];
-			}
+			memcpy(indices.GetData(), lodIndices.data(), sizeof(uint32_t) * lodIndices.size());
 		}
 		else
 		{
-			indices.Allocate(sizeof(uint16_t) * mesh->mNumFaces * 3);
+			indices.Allocate(sizeof(uint16_t) * lodIndices.size());
 			indexType = IndexType::Size_16Bit;
 			uint16_t* indexPtr = indices.As<uint16_t>();
-			for (int i = 0; i < mesh->mNumFaces; i++)
+			for (size_t i = 0; i < lodIndices.size(); i++)
 			{
-				indexPtr[i * 3 + 0] = mesh->mFaces[i].mIndices[0];
-				indexPtr[i * 3 + 1] = mesh->mFaces[i].mIndices[1];
-				indexPtr[i * 3 + 2] = mesh->mFaces[i].mIndices[2];
+				indexPtr[i] = static_cast<uint16_t>(lodIndices[i]);
 			}
 		}
 
@@ -171,6 +192,11 @@ namespace Mule
 
 		if (muleMesh)
 		{
+			if (mesh->mNumVertices > 0)
+				muleMesh->SetBounds(meshMin, meshMax);
+
+			muleMesh->SetLods(lods);
+
 			auto iter = info.Meshes.find(meshName);
 			if (iter != info.Meshes.end())
 			{
@@ -28,10 +28,17 @@ namespace Mule
 		mServiceManager(serviceManager)
 	{
 		mRegistry.on_construct<CameraComponent>().connect<&Scene::OnCameraComponentConstruct>(this);
+
+		mRegistry.on_construct<TransformComponent>().connect<&Scene::OnObjectChanged>(this);
+		mRegistry.on_update<TransformComponent>().connect<&Scene::OnObjectChanged>(this);
+		mRegistry.on_construct<MeshComponent>().connect<&Scene::OnObjectChanged>(this);
+		mRegistry.on_update<MeshComponent>().connect<&Scene::OnObjectChanged>(this);
 	}
 
 	Scene::~Scene()
 	{
+		if (Renderer::IsInitialized())
+			Renderer::Get().RemoveWorld(this);
 	}
 
 	Entity Scene::CreateEntity(const std::string& name, const Guid& guid)
@@ -117,7 +124,12 @@ namespace Mule
 			return;
 		}
 
+		if (e.HasComponent<MeshComponent>())
+			Renderer::Get().RemoveObject(this, e.Guid());
+
 		mEntityLookup.erase(e.Guid());
+		mChangedObjects.erase(e.mId);
+		mScriptWrittenObjects.erase(e.mId);
 		mModified = true;
 		mRegistry.destroy(e.mId);
 	}
@@ -252,6 +264,7 @@ namespace Mule
 
 			transform.Translation = mPhysicsContext.GetPosition(metaComponent.Guid);
 			transform.Rotation = mPhysicsContext.GetRotation(metaComponent.Guid);
+			MarkChanged<TransformComponent>(entity);
 		}
 
 		for (auto entity : mRegistry.view<CameraComponent>())
@@ -281,26 +294,37 @@ namespace Mule
 				mPhysicsContext.SetPosition(metaComponent.Guid, transform.Translation);
 			}
 		}
+
+		for (auto entity : mScriptWrittenObjects)
+			mChangedObjects.insert(entity);
 	}
 
 	void Scene::OnEditorRender(WeakRef<Camera> editorCamera)
 	{
-		RecordRuntimeDrawCommands();
-		RecordEditorDrawCommands();
+		Renderer& renderer = Renderer::Get();
+		RenderRequestHandle request = renderer.BeginRequest(editorCamera, this);
+		CommandList& commandList = renderer.GetCommandList(request);
 
-		Renderer::Get().Submit(*editorCamera, mCommandList);
+		RecordRuntimeDrawCommands(commandList);
+		RecordEditorDrawCommands(commandList);
 
-		mCommandList.Flush();
+		if (renderer.Submit(request))
+			ClearChangedObjects();
 	}
 
 	void Scene::OnRender()
 	{
 		Ref<Camera> camera = GetMainCamera();
-		RecordRuntimeDrawCommands();
+		if (!camera)
+			return;
+
+		Renderer& renderer = Renderer::Get();
+		RenderRequestHandle request = renderer.BeginRequest(camera, this);
 		
-		Renderer::Get().Submit(*camera, mCommandList);
+		RecordRuntimeDrawCommands(renderer.GetCommandList(request));
 
-		mCommandList.Flush();
+		if (renderer.Submit(request))
+			ClearChangedObjects();
 	}
 
 	Ref<Camera> Scene::GetMainCamera() const
@@ -350,21 +374,45 @@ namespace Mule
 		registry.get<CameraComponent>(id).Camera = MakeRef<Camera>();
 	}
 
-	void Scene::RecordRuntimeDrawCommands()
+	void Scene::OnObjectChanged(entt::registry& registry, entt::entity id)
+	{
+		mChangedObjects.insert(id);
+	}
+
+	void Scene::ClearChangedObjects()
+	{
+		// The renderer has the data of every drawn object now, changes of hidden objects or objects still loading are kept
+		mChangedObjects.clear();
+		mChangedObjects.insert(mPendingObjects.begin(), mPendingObjects.end());
+	}
+
+	void Scene::RecordRuntimeDrawCommands(CommandList& commandList)
 	{
 		auto assetManager = mServiceManager->Get<AssetManager>();
 
+		mPendingObjects.clear();
 		for (auto entity : mRegistry.view<MeshComponent>())
 		{
 			const auto& meshComponent = GetComponent<MeshComponent>(entity);
 			const auto& transformComponent = GetComponent<TransformComponent>(entity);
+			const auto& metaComponent = GetComponent<MetaComponent>(entity);
 
+			bool changed = mChangedObjects.contains(entity);
 			if (!meshComponent.Visible)
+			{
+				if (changed)
+					mPendingObjects.push_back(entity);
 				continue;
+			}
 
 			auto mesh = assetManager->Get<Mesh>(meshComponent.MeshHandle);
 			auto material = assetManager->Get<Material>(meshComponent.MaterialHandle);
 
+			// Assets load asynchronously, the material index is only assigned once the renderer added the material
+			bool materialPending = meshComponent.MaterialHandle && (!material || material->GlobalIndex == UINT32_MAX);
+			if (changed && (!mesh || materialPending))
+				mPendingObjects.push_back(entity);
+
 			if (!mesh)
 				continue;
 
@@ -372,9 +420,13 @@ namespace Mule
 				mesh,
 				material,
 				transformComponent.TRS(),
+				metaComponent.Guid,
+				meshComponent.CastsShadows,
+				meshComponent.Static
 			};
+			drawCommand.Changed = changed;
 
-			mCommandList.AddCommand(drawCommand);
+			commandList.AddCommand(drawCommand);
 		}
 
 		for (auto entity : mRegistry.view<DirectionalLightComponent>())
@@ -396,7 +448,7 @@ namespace Mule
 				directionalLightComponent.Intensity
 			};
 
-			mCommandList.AddCommand(directionalLightCommand);
+			commandList.AddCommand(directionalLightCommand);
 		}
 
 		for (auto entity : mRegistry.view<PointLightComponent>())
@@ -413,10 +465,11 @@ namespace Mule
 			DrawPointLightCommand pointLightCommand {
 				position,
 				pointLightComponent.Color,
-				pointLightComponent.Radiance
+				pointLightComponent.Radiance,
+				pointLightComponent.Range
 			};
 
-			mCommandList.AddCommand(pointLightCommand);
+			commandList.AddCommand(pointLightCommand);
 		}
 
 		for (auto entity : mRegistry.view<SpotLightComponent>())
@@ -441,10 +494,11 @@ namespace Mule
 				spotLightComponent.Color,
 				spotLightComponent.Radiance,
 				glm::radians(spotLightComponent.Angle) * 0.5f,
-				glm::radians(spotLightComponent.FallOff)
+				glm::radians(spotLightComponent.FallOff),
+				spotLightComponent.Range
 			};
 
-			mCommandList.AddCommand(spotLightCommand);
+			commandList.AddCommand(spotLightCommand);
 		}
 
 		for (auto entity : mRegistry.view<EnvironmentMapComponent>())
@@ -480,14 +534,14 @@ namespace Mule
 				brdfLut
 			};
 
-			mCommandList.AddCommand(skyboxCommand);
+			commandList.AddCommand(skyboxCommand);
 
 			// We only take one sky box command for now
 			break;
 		}
 	}
 
-	void Scene::RecordEditorDrawCommands()
+	void Scene::RecordEditorDrawCommands(CommandList& commandList)
 	{
 	}
 }
\ No newline at end of file
@@ -36,11 +36,11 @@ namespace Mule
 		auto assetManager = mServiceManager->Register<AssetManager>();
 		mServiceManager->Register<ImGuiContext>(mWindow);
 		mServiceManager->Register<ScriptContext>(this);
-		mServiceManager->Register<JobSystem>();
+		auto jobSystem = mServiceManager->Register<JobSystem>();
 		mServiceManager->Register<EnvironmentMapGenerator>(mServiceManager);
 
 		// Needs to be called after imgui init
-		Renderer::Init();
+		Renderer::Init(jobSystem, description.FramesInFlight);
 
 		assetManager->LoadRegistry(mFilePath / "Registry.mrz");
 		assetManager->RegisterLoader<SceneSerializer>(mServiceManager);
@@ -8,14 +8,14 @@
 namespace Mule
 
 {
-	Ref<CommandAllocator> CommandAllocator::Create()
+	Ref<CommandAllocator> CommandAllocator::Create(QueueType type)
 	{
 		GraphicsAPI API = GraphicsContext::Get().GetAPI();
 
 		switch (API)
 		{
 		case Mule::GraphicsAPI::None: return nullptr;
-		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanCommandPool>();
+		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanCommandPool>(type);
 		}
 
 		return nullptr;
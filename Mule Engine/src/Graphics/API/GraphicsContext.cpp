@@ -105,4 +105,28 @@ namespace Mule
 			break;
 		}
 	}
+
+	bool GraphicsContext::SupportsAsyncCompute() const
+	{
+		switch (mAPI)
+		{
+		case Mule::GraphicsAPI::Vulkan:
+			return Vulkan::VulkanContext::Get().HasAsyncCompute();
+		case Mule::GraphicsAPI::None:
+		default:
+			return false;
+		}
+	}
+
+	bool GraphicsContext::SupportsVertexLayerOutput() const
+	{
+		switch (mAPI)
+		{
+		case Mule::GraphicsAPI::Vulkan:
+			return Vulkan::VulkanContext::Get().HasVertexLayerOutput();
+		case Mule::GraphicsAPI::None:
+		default:
+			return false;
+		}
+	}
 }
\ No newline at end of file
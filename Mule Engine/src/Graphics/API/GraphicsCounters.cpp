@@ -0,0 +1,45 @@
+#include "Graphics/API/GraphicsCounters.h"
+
+namespace Mule
+{
+	std::atomic<uint32_t> GraphicsCounters::sDescriptorUpdates = 0;
+	std::atomic<uint32_t> GraphicsCounters::sUploads = 0;
+	std::atomic<uint64_t> GraphicsCounters::sUploadBytes = 0;
+	std::atomic<uint32_t> GraphicsCounters::sBarriers = 0;
+	std::atomic<uint32_t> GraphicsCounters::sImageBarriers = 0;
+	std::atomic<uint32_t> GraphicsCounters::sQueueSubmits = 0;
+
+	void GraphicsCounters::AddDescriptorUpdate()
+	{
+		sDescriptorUpdates.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void GraphicsCounters::AddUpload(uint64_t size)
+	{
+		sUploads.fetch_add(1, std::memory_order_relaxed);
+		sUploadBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void GraphicsCounters::AddBarrier(uint32_t imageBarriers)
+	{
+		sBarriers.fetch_add(1, std::memory_order_relaxed);
+		sImageBarriers.fetch_add(imageBarriers, std::memory_order_relaxed);
+	}
+
+	void GraphicsCounters::AddQueueSubmit()
+	{
+		sQueueSubmits.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	GraphicsCounterValues GraphicsCounters::Flush()
+	{
+		GraphicsCounterValues values;
+		values.DescriptorUpdates = sDescriptorUpdates.exchange(0, std::memory_order_relaxed);
+		values.Uploads = sUploads.exchange(0, std::memory_order_relaxed);
+		values.UploadBytes = sUploadBytes.exchange(0, std::memory_order_relaxed);
+		values.Barriers = sBarriers.exchange(0, std::memory_order_relaxed);
+		values.ImageBarriers = sImageBarriers.exchange(0, std::memory_order_relaxed);
+		values.QueueSubmits = sQueueSubmits.exchange(0, std::memory_order_relaxed);
+		return values;
+	}
+}
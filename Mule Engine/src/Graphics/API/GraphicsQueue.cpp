@@ -8,14 +8,14 @@
 
 namespace Mule
 {
-	Ref<GraphicsQueue> GraphicsQueue::Create()
+	Ref<GraphicsQueue> GraphicsQueue::Create(QueueType type)
 	{
 		GraphicsAPI API = GraphicsContext::Get().GetAPI();
 
 		switch (API)
 		{
 		case GraphicsAPI::None: return nullptr;
-		case GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanQueue>();
+		case GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanQueue>(type);
 		}
 
 		return nullptr;
@@ -0,0 +1,28 @@
+#include "Graphics/API/StorageBuffer.h"
+
+#include "Graphics/API/GraphicsContext.h"
+
+// API
+#include "Graphics/API/Vulkan/Buffer/VulkanStorageBuffer.h"
+
+namespace Mule
+{
+	Ref<StorageBuffer> StorageBuffer::Create(uint32_t size, BufferFlags flags)
+	{
+		GraphicsAPI API = GraphicsContext::Get().GetAPI();
+
+		switch (API)
+		{
+		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanStorageBuffer>(size, flags);
+		case Mule::GraphicsAPI::None:
+		default:
+			return nullptr;
+		}
+	}
+
+	StorageBuffer::StorageBuffer(uint32_t size)
+		:
+		mSize(size)
+	{
+	}
+}
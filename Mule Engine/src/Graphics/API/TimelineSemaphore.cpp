@@ -16,5 +16,7 @@ namespace Mule
 		default:
 			break;
 		}
+
+		return nullptr;
 	}
 }
\ No newline at end of file
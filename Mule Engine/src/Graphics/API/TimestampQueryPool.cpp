@@ -0,0 +1,28 @@
+#include "Graphics/API/TimestampQueryPool.h"
+
+#include "Graphics/API/GraphicsContext.h"
+
+// API
+#include "Graphics/API/Vulkan/Query/VulkanTimestampQueryPool.h"
+
+namespace Mule
+{
+	Ref<TimestampQueryPool> TimestampQueryPool::Create(uint32_t count, QueueType queue)
+	{
+		GraphicsAPI API = GraphicsContext::Get().GetAPI();
+
+		switch (API)
+		{
+		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanTimestampQueryPool>(count, queue);
+		case Mule::GraphicsAPI::None:
+		default:
+			return nullptr;
+		}
+	}
+
+	TimestampQueryPool::TimestampQueryPool(uint32_t count)
+		:
+		mCount(count)
+	{
+	}
+}
@@ -7,26 +7,26 @@
 
 namespace Mule
 {
-	Ref<UniformBuffer> UniformBuffer::Create(const Buffer& buffer)
+	Ref<UniformBuffer> UniformBuffer::Create(const Buffer& buffer, BufferFlags flags)
 	{
 		GraphicsAPI API = GraphicsContext::Get().GetAPI();
 
 		switch (API)
 		{
-		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanUniformBuffer>(buffer);
+		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanUniformBuffer>(buffer, flags);
 		case Mule::GraphicsAPI::None:
 		default:
 			nullptr;
 		}
 	}
 
-	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size)
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, BufferFlags flags)
 	{
 		GraphicsAPI API = GraphicsContext::Get().GetAPI();
 
 		switch (API)
 		{
-		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanUniformBuffer>(size);
+		case Mule::GraphicsAPI::Vulkan: return MakeRef<Vulkan::VulkanUniformBuffer>(size, flags);
 		case Mule::GraphicsAPI::None:
 		default:
 			nullptr;
@@ -8,7 +8,7 @@
 
 namespace Mule::Vulkan
 {
-	IVulkanBuffer::IVulkanBuffer(uint32_t size, VkBufferUsageFlags usageFlags, VkQueueFlagBits requestedQueueType, VkMemoryPropertyFlags memoryProperties)
+	IVulkanBuffer::IVulkanBuffer(uint32_t size, VkBufferUsageFlags usageFlags, VkQueueFlagBits requestedQueueType, VkMemoryPropertyFlags memoryProperties, bool sharedQueues)
 		:
 		mSize(size),
 		mBuffer(VK_NULL_HANDLE),
@@ -17,16 +17,19 @@ namespace Mule::Vulkan
 	{
 		VulkanContext& context = VulkanContext::Get();
 		VkDevice device = context.GetDevice();
-		uint32_t queueFamilyIndex = context.GetQueueFamilyIndex();
+		// Buffers the render graph hands to both queues are concurrent, it only transfers textures. Concurrent sharing can
+		// cost bandwidth, so vertex, index and staging buffers stay exclusive
+		std::vector<uint32_t> queueFamilyIndices = context.GetQueueFamilyIndices();
+		bool exclusive = !sharedQueues || queueFamilyIndices.size() == 1;
 
 		VkBufferCreateInfo info{};
 		info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 		info.pNext = nullptr;
-		info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		info.sharingMode = exclusive ? VK_SHARING_MODE_EXCLUSIVE : VK_SHARING_MODE_CONCURRENT;
 		info.size = size;
 		info.usage = usageFlags;
-		info.queueFamilyIndexCount = 1;
-		info.pQueueFamilyIndices = &queueFamilyIndex;
+		info.queueFamilyIndexCount = exclusive ? 1 : static_cast<uint32_t>(queueFamilyIndices.size());
+		info.pQueueFamilyIndices = queueFamilyIndices.data();
 
 		VkResult result = vkCreateBuffer(device, &info, nullptr, &mBuffer);
 
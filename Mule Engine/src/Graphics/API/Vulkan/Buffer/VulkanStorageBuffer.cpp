@@ -0,0 +1,65 @@
+#include "Graphics/API/Vulkan/Buffer/VulkanStorageBuffer.h"
+
+#include "Graphics/API/GraphicsCounters.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace Mule::Vulkan
+{
+	VulkanStorageBuffer::VulkanStorageBuffer(uint32_t size, BufferFlags flags)
+		:
+		StorageBuffer(size),
+		mBuffer(CreateBuffer(size, flags)),
+		mFlags(flags)
+	{
+	}
+
+	void VulkanStorageBuffer::SetData(const Buffer& buffer, uint32_t offset)
+	{
+		if (offset + buffer.GetSize() > mSize)
+		{
+			SPDLOG_ERROR("Storage buffer write out of range, offset: {}, size: {}, buffer size: {}", offset, buffer.GetSize(), mSize);
+			return;
+		}
+
+		uint8_t* dst = (uint8_t*)mBuffer->GetMappedPtr();
+		memcpy(dst + offset, buffer.GetData(), buffer.GetSize());
+		GraphicsCounters::AddUpload(buffer.GetSize());
+	}
+
+	void VulkanStorageBuffer::ReadData(const Buffer& buffer, uint32_t offset) const
+	{
+		if (offset + buffer.GetSize() > mSize)
+		{
+			SPDLOG_ERROR("Storage buffer read out of range, offset: {}, size: {}, buffer size: {}", offset, buffer.GetSize(), mSize);
+			return;
+		}
+
+		const uint8_t* src = (const uint8_t*)mBuffer->GetMappedPtr();
+		memcpy(buffer.GetData(), src + offset, buffer.GetSize());
+	}
+
+	bool VulkanStorageBuffer::Reserve(uint32_t size)
+	{
+		if (size <= mSize)
+			return false;
+
+		// Grow geometrically so a steadily increasing object count doesn't recreate the buffer every frame
+		mSize = std::max(size, mSize * 2);
+		mBuffer = CreateBuffer(mSize, mFlags);
+
+		return true;
+	}
+
+	std::unique_ptr<IVulkanBuffer> VulkanStorageBuffer::CreateBuffer(uint32_t size, BufferFlags flags)
+	{
+		return std::make_unique<IVulkanBuffer>(
+			std::max(size, 16u),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+			VK_QUEUE_GRAPHICS_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+			(flags & BufferFlags::SharedQueues) == BufferFlags::SharedQueues);
+	}
+}
@@ -3,27 +3,31 @@
 #include "Graphics/API/Vulkan/Buffer/VulkanStagingBuffer.h"
 #include "Graphics/API/Vulkan/VulkanContext.h"
 
+#include "Graphics/API/GraphicsCounters.h"
+
 namespace Mule::Vulkan
 {
-	VulkanUniformBuffer::VulkanUniformBuffer(const Buffer& buffer)
+	VulkanUniformBuffer::VulkanUniformBuffer(const Buffer& buffer, BufferFlags flags)
 		:
 		UniformBuffer(buffer.GetSize()),
 		IVulkanBuffer(
 			buffer.GetSize(),
 			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 			VK_QUEUE_GRAPHICS_BIT,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+			(flags & BufferFlags::SharedQueues) == BufferFlags::SharedQueues)
 	{
 		SetData(buffer);
 	}
-	VulkanUniformBuffer::VulkanUniformBuffer(uint32_t size)
+	VulkanUniformBuffer::VulkanUniformBuffer(uint32_t size, BufferFlags flags)
 		:
 		UniformBuffer(size),
 		IVulkanBuffer(
 			size,
 			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 			VK_QUEUE_GRAPHICS_BIT,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+			(flags & BufferFlags::SharedQueues) == BufferFlags::SharedQueues)
 	{
 	}
 
@@ -31,6 +35,7 @@ namespace Mule::Vulkan
 	{
 		uint8_t* ptr = (uint8_t*)buffer.GetData();
 		memcpy(mMappedPtr, ptr + offset, buffer.GetSize());
+		GraphicsCounters::AddUpload(buffer.GetSize());
 	}
 
 }
\ No newline at end of file
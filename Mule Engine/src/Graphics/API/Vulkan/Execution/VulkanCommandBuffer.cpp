@@ -9,24 +9,88 @@
 #include "Graphics/API/Vulkan/Pipeline/VulkanComputePipeline.h"
 #include "Graphics/API/Vulkan/Pipeline/VulkanGraphicsPipeline.h"
 #include "Graphics/API/Vulkan/Buffer/VulkanUniformBuffer.h"
+#include "Graphics/API/Vulkan/Buffer/VulkanStorageBuffer.h"
 #include "Graphics/API/Vulkan/Texture/IVulkanTexture.h"
 #include "Graphics/API/Vulkan/Buffer/IVulkanBuffer.h"
 #include "Graphics/API/Vulkan/VulkanDescriptorSet.h"
 #include "Graphics/API/Vulkan/Buffer/VulkanIndexBuffer.h"
 #include "Graphics/API/Vulkan/Buffer/VulkanVertexBuffer.h"
 #include "Graphics/API/Vulkan/Buffer/VulkanStagingBuffer.h"
+#include "Graphics/API/Vulkan/Query/VulkanTimestampQueryPool.h"
 
 #include "Graphics/API/Vulkan/VulkanTypeConversion.h"
+#include "Graphics/API/GraphicsCounters.h"
 
 #include <Volk/volk.h>
 
 #include <vector>
+#include <algorithm>
 
 namespace Mule::Vulkan
 {
-	VulkanCommandBuffer::VulkanCommandBuffer(VkCommandPool commandPool)
+	// Every stage and access an image in this layout can be used with by the graph
+	static void GetLayoutScope(VkImageLayout layout, VkPipelineStageFlags2& stages, VkAccessFlags2& access)
+	{
+		switch (layout)
+		{
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+			stages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+			access = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+			break;
+
+		case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL:
+			stages = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+			access = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			break;
+
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+			stages = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+			access = VK_ACCESS_2_SHADER_READ_BIT;
+			break;
+
+		case VK_IMAGE_LAYOUT_GENERAL:
+			stages = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+			access = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+			break;
+
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+			stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+			access = VK_ACCESS_2_TRANSFER_READ_BIT;
+			break;
+
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+			stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+			access = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+			break;
+
+		default:
+			stages = VK_PIPELINE_STAGE_2_NONE;
+			access = VK_ACCESS_2_NONE;
+			break;
+		}
+	}
+
+	// Compute queues only support the compute and transfer stages, shader stages of a graphics pipeline become the compute stage
+	static VkPipelineStageFlags2 GetQueueStages(QueueType queue, VkPipelineStageFlags2 stages)
+	{
+		if (queue != QueueType::Compute)
+			return stages;
+
+		constexpr VkPipelineStageFlags2 supported = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT
+			| VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+		constexpr VkPipelineStageFlags2 shaderStages = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+
+		VkPipelineStageFlags2 queueStages = stages & supported;
+		if (stages & shaderStages)
+			queueStages |= VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+		return queueStages;
+	}
+
+	VulkanCommandBuffer::VulkanCommandBuffer(VkCommandPool commandPool, VkCommandBufferLevel level, QueueType queueType)
 		:
-		mCommandPool(commandPool)
+		mCommandPool(commandPool),
+		mQueueType(queueType)
 	{
 		VulkanContext& context = VulkanContext::Get();
 		VkDevice device = context.GetDevice();
@@ -35,7 +99,7 @@ namespace Mule::Vulkan
 			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
 			.pNext = nullptr,
 			.commandPool = mCommandPool,
-			.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			.level = level,
 			.commandBufferCount = 1
 		};
 
@@ -106,6 +170,8 @@ namespace Mule::Vulkan
 			1, &barrier
 		);
 
+		GraphicsCounters::AddBarrier(1);
+
 		VkRenderingAttachmentInfo colorAttachment{
 			.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
 			.imageView = context.GetCurrentSwapchainColorImageView(),
@@ -193,6 +259,8 @@ namespace Mule::Vulkan
 			0, nullptr,
 			1, &barrier
 		);
+
+		GraphicsCounters::AddBarrier(1);
 	}
 
 	void VulkanCommandBuffer::BeginRendering(WeakRef<Framebuffer> framebuffer, WeakRef<GraphicsPipeline> shader, const std::vector<WeakRef<ShaderResourceGroup>>& groups)
@@ -420,7 +488,7 @@ namespace Mule::Vulkan
 		vkCmdEndRenderingKHR(mCommandBuffer);
 	}
 
-	void VulkanCommandBuffer::BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment)
+	void VulkanCommandBuffer::BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, bool secondaryContents, glm::uvec2 renderArea)
 	{
 		uint32_t layerCount = 1;
 		uint32_t width = 0;
@@ -470,6 +538,12 @@ namespace Mule::Vulkan
 			height = vkDepthAttachment->GetHeight();
 		}
 
+		if (renderArea.x > 0 && renderArea.y > 0)
+		{
+			width = std::min(width, renderArea.x);
+			height = std::min(height, renderArea.y);
+		}
+
 		VkRect2D rect{};
 		rect.offset.x = 0;
 		rect.offset.y = 0;
@@ -486,10 +560,104 @@ namespace Mule::Vulkan
 		info.pStencilAttachment = nullptr;
 		info.pNext = nullptr;
 		info.viewMask = 0;
-		info.flags = 0;
+		info.flags = secondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
 
 		vkCmdBeginRenderingKHR(mCommandBuffer, &info);
 
+		// Dynamic state is not inherited, secondaries set their own in BeginSecondary
+		if (!secondaryContents)
+			SetRenderArea(width, height);
+	}
+
+	void VulkanCommandBuffer::BeginSecondary(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, glm::uvec2 renderArea)
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		std::vector<VkFormat> colorFormats;
+		VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+
+		for (auto attachment : colorAttachments)
+		{
+			colorFormats.push_back(GetVulkanFormat(attachment.Attachment->GetFormat()));
+			width = attachment.Attachment->GetWidth();
+			height = attachment.Attachment->GetHeight();
+		}
+
+		if (depthAttachment.Attachment)
+		{
+			depthFormat = GetVulkanFormat(depthAttachment.Attachment->GetFormat());
+			width = depthAttachment.Attachment->GetWidth();
+			height = depthAttachment.Attachment->GetHeight();
+		}
+
+		if (renderArea.x > 0 && renderArea.y > 0)
+		{
+			width = std::min(width, renderArea.x);
+			height = std::min(height, renderArea.y);
+		}
+
+		VkCommandBufferInheritanceRenderingInfo renderingInfo{};
+		renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+		renderingInfo.colorAttachmentCount = colorFormats.size();
+		renderingInfo.pColorAttachmentFormats = colorFormats.data();
+		renderingInfo.depthAttachmentFormat = depthFormat;
+		renderingInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+		renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+		renderingInfo.viewMask = 0;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext = &renderingInfo;
+		inheritanceInfo.renderPass = VK_NULL_HANDLE;
+		inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		vkBeginCommandBuffer(mCommandBuffer, &beginInfo);
+
+		SetRenderArea(width, height);
+	}
+
+	void VulkanCommandBuffer::ExecuteSecondary(const std::vector<Ref<CommandBuffer>>& commandBuffers)
+	{
+		if (commandBuffers.empty())
+			return;
+
+		std::vector<VkCommandBuffer> handles(commandBuffers.size());
+		for (uint32_t i = 0; i < commandBuffers.size(); i++)
+		{
+			WeakRef<VulkanCommandBuffer> commandBuffer = commandBuffers[i];
+			handles[i] = commandBuffer->GetHandle();
+		}
+
+		vkCmdExecuteCommands(mCommandBuffer, handles.size(), handles.data());
+	}
+
+	void VulkanCommandBuffer::ResetQueries(WeakRef<TimestampQueryPool> queryPool)
+	{
+		WeakRef<VulkanTimestampQueryPool> vulkanQueryPool = queryPool;
+		vkCmdResetQueryPool(mCommandBuffer, vulkanQueryPool->GetHandle(), 0, vulkanQueryPool->GetCount());
+		vulkanQueryPool->SetRecorded();
+	}
+
+	void VulkanCommandBuffer::WriteTimestamp(WeakRef<TimestampQueryPool> queryPool, uint32_t query)
+	{
+		WeakRef<VulkanTimestampQueryPool> vulkanQueryPool = queryPool;
+		vkCmdWriteTimestamp(mCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, vulkanQueryPool->GetHandle(), query);
+	}
+
+	void VulkanCommandBuffer::SetRenderArea(uint32_t width, uint32_t height)
+	{
+		VkRect2D rect{};
+		rect.offset.x = 0;
+		rect.offset.y = 0;
+		rect.extent.width = width;
+		rect.extent.height = height;
+
 		VkViewport viewport{};
 		viewport.x = 0;
 		viewport.y = height;
@@ -529,6 +697,22 @@ namespace Mule::Vulkan
 		}
 	}
 
+	void VulkanCommandBuffer::ClearDepthAttachmentLayer(uint32_t layer, uint32_t width, uint32_t height)
+	{
+		VkClearAttachment attachment{};
+		attachment.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		attachment.clearValue.depthStencil.depth = 1.f;
+
+		// Layers are relative to the rendering scope, which covers every layer of the attachment
+		VkClearRect rect{};
+		rect.rect.offset = { 0, 0 };
+		rect.rect.extent = { width, height };
+		rect.baseArrayLayer = layer;
+		rect.layerCount = 1;
+
+		vkCmdClearAttachments(mCommandBuffer, 1, &attachment, 1, &rect);
+	}
+
 	// TODO: this only supports 2d textures, no  cubes, or 3d images
 	void VulkanCommandBuffer::TranistionImageLayout(WeakRef<Texture> texture, ImageLayout newLayout)
 	{
@@ -731,6 +915,22 @@ namespace Mule::Vulkan
 
 			barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT; // This is a color image
 		}
+		else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newVkLayout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL)
+		{
+			srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		}
+		else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newVkLayout == VK_IMAGE_LAYOUT_GENERAL)
+		{
+			srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+		}
 		else if (oldLayout == VK_IMAGE_LAYOUT_GENERAL && newVkLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
 		{
 			srcStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;                  // General layout could have been used in various stages
@@ -756,6 +956,10 @@ namespace Mule::Vulkan
 			SPDLOG_ERROR("Invalid layout transition");
 		}
 
+		// Legacy stage bits share their values with the synchronization2 ones
+		srcStage = static_cast<VkPipelineStageFlags>(GetQueueStages(mQueueType, srcStage));
+		dstStage = static_cast<VkPipelineStageFlags>(GetQueueStages(mQueueType, dstStage));
+
 		vkCmdPipelineBarrier(
 			mCommandBuffer,
 			srcStage,
@@ -766,9 +970,74 @@ namespace Mule::Vulkan
 			1, &barrier
 		);
 
+		GraphicsCounters::AddBarrier(1);
+
 		vulkanTexture->SetImageLayout(newVkLayout);
 	}
 
+	void VulkanCommandBuffer::TransitionImageLayouts(const std::vector<TextureTransition>& transitions)
+	{
+		VulkanContext& context = VulkanContext::Get();
+
+		std::vector<VkImageMemoryBarrier2> barriers;
+		barriers.reserve(transitions.size());
+
+		for (const auto& transition : transitions)
+		{
+			WeakRef<VulkanTexture2D> vulkanTexture = transition.Texture;
+			bool ownershipTransfer = transition.Ownership != QueueOwnership::None;
+
+			// Both halves of an ownership transfer have to name the same layouts, so they are not taken from the tracked layout
+			VkImageLayout oldLayout = transition.Discard ? VK_IMAGE_LAYOUT_UNDEFINED : vulkanTexture->GetVulkanImage().Layout;
+			if (ownershipTransfer)
+				oldLayout = GetImageLayout(transition.OldLayout);
+
+			VkImageLayout newLayout = GetImageLayout(transition.NewLayout);
+
+			if (oldLayout == newLayout && !ownershipTransfer)
+				continue;
+
+			VkImageMemoryBarrier2 barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+			barrier.oldLayout = oldLayout;
+			barrier.newLayout = newLayout;
+			barrier.srcQueueFamilyIndex = ownershipTransfer ? context.GetQueueFamilyIndex(transition.SrcQueue) : VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = ownershipTransfer ? context.GetQueueFamilyIndex(transition.DstQueue) : VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = vulkanTexture->GetVulkanImage().Image;
+			barrier.subresourceRange.aspectMask = vulkanTexture->GetIsDepthTexture() ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+			barrier.subresourceRange.baseMipLevel = 0;
+			barrier.subresourceRange.levelCount = vulkanTexture->GetImageMipLevels();
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount = vulkanTexture->GetImageArrayLayers();
+
+			// A release only covers the work on the source queue and an acquire only the work on the destination queue,
+			// the timeline semaphore wait between them orders the two
+			if (transition.Ownership != QueueOwnership::Acquire)
+				GetLayoutScope(oldLayout, barrier.srcStageMask, barrier.srcAccessMask);
+
+			if (transition.Ownership != QueueOwnership::Release)
+				GetLayoutScope(newLayout, barrier.dstStageMask, barrier.dstAccessMask);
+
+			barrier.srcStageMask = GetQueueStages(mQueueType, barrier.srcStageMask);
+			barrier.dstStageMask = GetQueueStages(mQueueType, barrier.dstStageMask);
+
+			barriers.push_back(barrier);
+			vulkanTexture->SetImageLayout(newLayout);
+		}
+
+		if (barriers.empty())
+			return;
+
+		VkDependencyInfo dependencyInfo{};
+		dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+		dependencyInfo.imageMemoryBarrierCount = barriers.size();
+		dependencyInfo.pImageMemoryBarriers = barriers.data();
+
+		vkCmdPipelineBarrier2(mCommandBuffer, &dependencyInfo);
+
+		GraphicsCounters::AddBarrier(barriers.size());
+	}
+
 	void VulkanCommandBuffer::CopyTexture(WeakRef<Texture> src, WeakRef<Texture> dst, const TextureCopyInfo& copyInfo) const
 	{
 		WeakRef<VulkanTexture2D> vulkanSrc = src;
@@ -859,6 +1128,33 @@ namespace Mule::Vulkan
 		vkCmdDispatch(mCommandBuffer, workGroupsX, workGroupsY, workGroupsZ);
 	}
 
+	void VulkanCommandBuffer::ReadbackBarrier(WeakRef<StorageBuffer> buffer)
+	{
+		WeakRef<VulkanStorageBuffer> vulkanBuffer = buffer;
+
+		VkBufferMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer = vulkanBuffer->GetBuffer();
+		barrier.offset = 0;
+		barrier.size = VK_WHOLE_SIZE;
+
+		vkCmdPipelineBarrier(
+			mCommandBuffer,
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_HOST_BIT,
+			0,
+			0, nullptr,
+			1, &barrier,
+			0, nullptr
+		);
+
+		GraphicsCounters::AddBarrier(0);
+	}
+
 	void VulkanCommandBuffer::BindMesh(WeakRef<Mesh> mesh)
 	{
 		VkDeviceSize offsets = 0;
@@ -876,7 +1172,8 @@ namespace Mule::Vulkan
 
 	void VulkanCommandBuffer::DrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount)
 	{
-		vkCmdDrawIndexed(mCommandBuffer, mesh->GetIndexBuffer()->GetIndexCount(), 1, 0, 0, 0);
+		const MeshLod& lod = mesh->GetLod(0);
+		vkCmdDrawIndexed(mCommandBuffer, lod.IndexCount, instanceCount, lod.FirstIndex, 0, 0);
 	}
 
 	void VulkanCommandBuffer::BindAndDrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount)
@@ -884,6 +1181,12 @@ namespace Mule::Vulkan
 		BindMesh(mesh);
 		DrawMesh(mesh, instanceCount);
 	}
+
+	void VulkanCommandBuffer::DrawMeshIndirect(WeakRef<StorageBuffer> argumentBuffer, uint32_t offset, uint32_t drawCount)
+	{
+		WeakRef<VulkanStorageBuffer> vulkanBuffer = argumentBuffer;
+		vkCmdDrawIndexedIndirect(mCommandBuffer, vulkanBuffer->GetBuffer(), offset, drawCount, sizeof(VkDrawIndexedIndirectCommand));
+	}
 	
 	void VulkanCommandBuffer::SetViewport(uint32_t x, uint32_t width, uint32_t y, uint32_t height)
 	{
@@ -6,13 +6,14 @@
 
 namespace Mule::Vulkan
 {
-	VulkanCommandPool::VulkanCommandPool()
+	VulkanCommandPool::VulkanCommandPool(QueueType type)
 		:
-		mCommandPool(VK_NULL_HANDLE)
+		mCommandPool(VK_NULL_HANDLE),
+		mQueueType(type)
 	{
 		VulkanContext& context = VulkanContext::Get();
 		VkDevice device = context.GetDevice();
-		uint32_t queueFamilyIndex = context.GetQueueFamilyIndex();
+		uint32_t queueFamilyIndex = context.GetQueueFamilyIndex(type);
 
 		VkCommandPoolCreateInfo createInfo{
 			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -42,6 +43,11 @@ namespace Mule::Vulkan
 
 	Ref<CommandBuffer> VulkanCommandPool::CreateCommandBuffer()
 	{
-		return MakeRef<VulkanCommandBuffer>(mCommandPool);
+		return MakeRef<VulkanCommandBuffer>(mCommandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, mQueueType);
+	}
+
+	Ref<CommandBuffer> VulkanCommandPool::CreateSecondaryCommandBuffer()
+	{
+		return MakeRef<VulkanCommandBuffer>(mCommandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, mQueueType);
 	}
 }
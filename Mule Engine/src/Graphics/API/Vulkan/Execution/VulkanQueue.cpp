@@ -1,6 +1,7 @@
 #include "Graphics/API/Vulkan/Execution/VulkanQueue.h"
 
 #include "Graphics/API/Vulkan/VulkanContext.h"
+#include "Graphics/API/GraphicsCounters.h"
 
 #include "Graphics/API/Vulkan/Execution/VulkanCommandBuffer.h"
 #include "Graphics/API/Vulkan/Syncronization/VulkanFence.h"
@@ -9,11 +10,12 @@
 
 namespace Mule::Vulkan
 {
-    VulkanQueue::VulkanQueue()
+    VulkanQueue::VulkanQueue(QueueType type)
         :
+        GraphicsQueue(type),
         mQueue(VK_NULL_HANDLE)
     {
-        mQueue = VulkanContext::Get().CreateQueue();
+        mQueue = VulkanContext::Get().CreateQueue(type);
     }
 
     VulkanQueue::~VulkanQueue()
@@ -63,6 +65,7 @@ namespace Mule::Vulkan
         };
 
         vkQueueSubmit(mQueue, 1, &info, vkFence);
+        GraphicsCounters::AddQueueSubmit();
     }
 
     void VulkanQueue::Submit(Ref<CommandBuffer> commandBuffer, Ref<TimelineSemaphore> semaphore, uint64_t waitValue, uint64_t signalValue, Ref<Fence> fence)
@@ -107,6 +110,7 @@ namespace Mule::Vulkan
         }
         
         vkQueueSubmit2KHR(mQueue, 1, &submitInfo, vkFence);
+        GraphicsCounters::AddQueueSubmit();
     }
 
     void VulkanQueue::Submit(Ref<CommandBuffer> commandBuffer, Ref<TimelineSemaphore> waitSemaphore, uint64_t waitValue, Ref<TimelineSemaphore> signalSemaphore, uint64_t signalValue, Ref<Fence> fence)
@@ -152,5 +156,76 @@ namespace Mule::Vulkan
         }
 
         vkQueueSubmit2(mQueue, 1, &submitInfo, vkFence);
+        GraphicsCounters::AddQueueSubmit();
+    }
+
+    void VulkanQueue::Submit(const std::vector<QueueSubmission>& submissions, Ref<Fence> fence)
+    {
+        if (submissions.empty())
+            return;
+
+        // Sized up front, the submit infos point into these
+        std::vector<VkCommandBufferSubmitInfo> commandBufferInfos(submissions.size());
+        std::vector<std::vector<VkSemaphoreSubmitInfo>> waitInfos(submissions.size());
+        std::vector<VkSemaphoreSubmitInfo> signalInfos(submissions.size());
+        std::vector<VkSubmitInfo2> submitInfos(submissions.size());
+
+        for (uint32_t i = 0; i < submissions.size(); i++)
+        {
+            const QueueSubmission& submission = submissions[i];
+            WeakRef<VulkanCommandBuffer> vulkanCommandBuffer = submission.CommandBuffer;
+
+            commandBufferInfos[i] = {};
+            commandBufferInfos[i].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            commandBufferInfos[i].commandBuffer = vulkanCommandBuffer->GetHandle();
+            commandBufferInfos[i].deviceMask = 0;
+
+            submitInfos[i] = {};
+            submitInfos[i].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+            submitInfos[i].commandBufferInfoCount = 1;
+            submitInfos[i].pCommandBufferInfos = &commandBufferInfos[i];
+
+            for (const TimelineValue& wait : submission.Waits)
+            {
+                WeakRef<VulkanTimelineSemaphore> waitSemaphore = wait.Semaphore;
+
+                VkSemaphoreSubmitInfo waitInfo{};
+                waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+                waitInfo.semaphore = waitSemaphore->GetSemaphore();
+                waitInfo.value = wait.Value;
+                waitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                waitInfo.deviceIndex = 0;
+
+                waitInfos[i].push_back(waitInfo);
+            }
+
+            submitInfos[i].waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos[i].size());
+            submitInfos[i].pWaitSemaphoreInfos = waitInfos[i].data();
+
+            if (submission.Signal.Semaphore)
+            {
+                WeakRef<VulkanTimelineSemaphore> signalSemaphore = submission.Signal.Semaphore;
+
+                signalInfos[i] = {};
+                signalInfos[i].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+                signalInfos[i].semaphore = signalSemaphore->GetSemaphore();
+                signalInfos[i].value = submission.Signal.Value;
+                signalInfos[i].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                signalInfos[i].deviceIndex = 0;
+
+                submitInfos[i].signalSemaphoreInfoCount = 1;
+                submitInfos[i].pSignalSemaphoreInfos = &signalInfos[i];
+            }
+        }
+
+        VkFence vkFence = VK_NULL_HANDLE;
+        if (fence)
+        {
+            Ref<VulkanFence> vulkanFence = fence;
+            vkFence = vulkanFence->GetHandle();
+        }
+
+        vkQueueSubmit2(mQueue, static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), vkFence);
+        GraphicsCounters::AddQueueSubmit();
     }
 }
@@ -102,6 +102,13 @@ namespace Mule::Vulkan
 
 					ShaderResourceDescription& desc = resourceDescriptions[descriptorSets[i]->set][binding->binding];
 					desc.ArrayCount = binding->count;
+
+					// Runtime sized descriptor arrays map to the variable count binding of bindless groups
+					if (binding->count == 0 || (binding->type_description && binding->type_description->op == SpvOpTypeRuntimeArray))
+					{
+						desc.ArrayCount = 1;
+						desc.Unbounded = true;
+					}
 					desc.Binding = binding->binding;
 					desc.Type = GetResourceType(binding->descriptor_type);
 					desc.Stages = desc.Stages | stage;
@@ -234,11 +241,11 @@ namespace Mule::Vulkan
 		case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:	return ShaderResourceType::Sampler;
 		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:				return ShaderResourceType::StorageImage;
 		case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER:			return ShaderResourceType::UniformBuffer;
+		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:			return ShaderResourceType::StorageBuffer;
 		case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLER:
 		case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
 		case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
 		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
 		case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
 		case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
 		case SPV_REFLECT_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
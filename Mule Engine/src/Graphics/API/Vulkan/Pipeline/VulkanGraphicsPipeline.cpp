@@ -62,6 +62,12 @@ namespace Mule::Vulkan
 
 		IVulkanPipeline::ReflectionData data = Reflect(byteCodes);
 
+		for (auto& attachment : data.Attachments)
+		{
+			if (attachment.Location < mDescription.ColorFormats.size())
+				attachment.Format = mDescription.ColorFormats[attachment.Location];
+		}
+
 		for (const auto& layout : data.Layouts)
 		{
 			mBlueprints.push_back(layout);
@@ -101,7 +107,7 @@ namespace Mule::Vulkan
 			}
 
 			vertexBindingDesc.binding = 0;
-			vertexBindingDesc.stride = offset;
+			vertexBindingDesc.stride = mDescription.VertexLayout.GetVertexSize();
 			vertexBindingDesc.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
 			vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
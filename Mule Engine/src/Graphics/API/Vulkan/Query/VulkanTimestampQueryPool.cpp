@@ -0,0 +1,75 @@
+#include "Graphics/API/Vulkan/Query/VulkanTimestampQueryPool.h"
+
+#include "Graphics/API/Vulkan/VulkanContext.h"
+
+#include <spdlog/spdlog.h>
+
+#include <vector>
+
+namespace Mule::Vulkan
+{
+	VulkanTimestampQueryPool::VulkanTimestampQueryPool(uint32_t count, QueueType queue)
+		:
+		TimestampQueryPool(count),
+		mQueryPool(VK_NULL_HANDLE),
+		mTimestampPeriod(0.0),
+		mValidBitsMask(UINT64_MAX),
+		mRecorded(false)
+	{
+		VulkanContext& context = VulkanContext::Get();
+		VkDevice device = context.GetDevice();
+
+		VkPhysicalDeviceProperties properties{};
+		vkGetPhysicalDeviceProperties(context.GetPhysicalDevice(), &properties);
+
+		// Nanoseconds per tick
+		mTimestampPeriod = properties.limits.timestampPeriod;
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(context.GetPhysicalDevice(), &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(context.GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+		uint32_t validBits = queueFamilies[context.GetQueueFamilyIndex(queue)].timestampValidBits;
+		if (validBits == 0)
+			SPDLOG_WARN("Queue family does not support timestamps, GPU timings will read as zero");
+		else if (validBits < 64)
+			mValidBitsMask = (1ull << validBits) - 1;
+
+		VkQueryPoolCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		createInfo.queryCount = count;
+
+		VkResult result = vkCreateQueryPool(device, &createInfo, nullptr, &mQueryPool);
+		if (result != VK_SUCCESS)
+		{
+			SPDLOG_ERROR("Failed to create timestamp query pool");
+		}
+	}
+
+	VulkanTimestampQueryPool::~VulkanTimestampQueryPool()
+	{
+		VkDevice device = VulkanContext::Get().GetDevice();
+		vkDestroyQueryPool(device, mQueryPool, nullptr);
+	}
+
+	bool VulkanTimestampQueryPool::GetResults(std::vector<double>& seconds) const
+	{
+		if (!mRecorded)
+			return false;
+
+		VkDevice device = VulkanContext::Get().GetDevice();
+
+		std::vector<uint64_t> ticks(mCount);
+		VkResult result = vkGetQueryPoolResults(device, mQueryPool, 0, mCount, ticks.size() * sizeof(uint64_t), ticks.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+		if (result != VK_SUCCESS)
+			return false;
+
+		seconds.resize(mCount);
+		for (uint32_t i = 0; i < mCount; i++)
+			seconds[i] = static_cast<double>(ticks[i] & mValidBitsMask) * mTimestampPeriod * 1e-9;
+
+		return true;
+	}
+}
@@ -38,4 +38,10 @@ namespace Mule::Vulkan
 		VkDevice device = VulkanContext::Get().GetDevice();
 		vkWaitForFences(device, 1, &mFence, VK_TRUE, UINT64_MAX);
 	}
+
+	bool VulkanFence::IsSignaled() const
+	{
+		VkDevice device = VulkanContext::Get().GetDevice();
+		return vkGetFenceStatus(device, mFence) == VK_SUCCESS;
+	}
 }
\ No newline at end of file
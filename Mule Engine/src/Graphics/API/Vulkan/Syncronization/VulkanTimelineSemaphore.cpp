@@ -41,4 +41,19 @@ namespace Mule::Vulkan
 
 		return value;
 	}
+
+	void VulkanTimelineSemaphore::Wait(uint64_t value) const
+	{
+		VulkanContext& context = VulkanContext::Get();
+
+		VkSemaphoreWaitInfo waitInfo{};
+		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores = &mSemaphore;
+		waitInfo.pValues = &value;
+
+		VkResult result = vkWaitSemaphores(context.GetDevice(), &waitInfo, UINT64_MAX);
+		if (result != VK_SUCCESS)
+			SPDLOG_ERROR("Failed to wait on Timeline Semaphore");
+	}
 }
\ No newline at end of file
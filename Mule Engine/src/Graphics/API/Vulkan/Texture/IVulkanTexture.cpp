@@ -14,8 +14,10 @@ namespace Mule::Vulkan
 	{
 		VulkanContext& context = VulkanContext::Get();
 		VkDevice device = context.GetDevice();
-		uint32_t queueFamilyIndex = context.GetQueueFamilyIndex();
+		std::vector<uint32_t> queueFamilyIndices = context.GetQueueFamilyIndices();
 
+		// Images are exclusive, the render graph hands its textures between queues with ownership transfers and anything else
+		// is only sampled on the graphics queue, concurrent sharing can disable compression
 		VkImageCreateInfo info{};
 		info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		info.pNext = nullptr;
@@ -32,7 +34,7 @@ namespace Mule::Vulkan
 		info.usage = usageFlags;
 		info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		info.queueFamilyIndexCount = 1;
-		info.pQueueFamilyIndices = &queueFamilyIndex;
+		info.pQueueFamilyIndices = queueFamilyIndices.data();
 		info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
 		VkResult result = vkCreateImage(device, &info, nullptr, &mVulkanImage.Image);
@@ -46,8 +48,9 @@ namespace Mule::Vulkan
 	{
 		VulkanContext& context = VulkanContext::Get();
 		VkDevice device = context.GetDevice();
-		uint32_t queueFamilyIndex = context.GetQueueFamilyIndex();
+		std::vector<uint32_t> queueFamilyIndices = context.GetQueueFamilyIndices();
 
+		// Exclusive for the same reason as CreateImage
 		VkImageCreateInfo info{};
 		info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		info.pNext = nullptr;
@@ -64,7 +67,7 @@ namespace Mule::Vulkan
 		info.usage = usageFlags;
 		info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		info.queueFamilyIndexCount = 1;
-		info.pQueueFamilyIndices = &queueFamilyIndex;
+		info.pQueueFamilyIndices = queueFamilyIndices.data();
 		info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
 		VkResult result = vkCreateImage(device, &info, nullptr, &mVulkanImage.Image);
@@ -84,17 +87,15 @@ namespace Mule::Vulkan
 
 		uint32_t memoryTypeIndex = context.GetMemoryTypeIndex(requierments.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-		VkMemoryAllocateInfo allocInfo{};
-		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		allocInfo.allocationSize = requierments.size;
-		allocInfo.memoryTypeIndex = memoryTypeIndex;
-		allocInfo.pNext = nullptr;
+		mMemory = MakeRef<VulkanDeviceMemory>(requierments.size, memoryTypeIndex);
+		mMemorySize = requierments.size;
+		mIsAliased = false;
+		mVulkanImage.Memory = mMemory->GetMemory();
 
-		VkResult result = vkAllocateMemory(device, &allocInfo, nullptr, &mVulkanImage.Memory);
-		if (result != VK_SUCCESS)
+		if (mVulkanImage.Memory == VK_NULL_HANDLE)
 			return false;
 
-		result = vkBindImageMemory(device, mVulkanImage.Image, mVulkanImage.Memory, 0);
+		VkResult result = vkBindImageMemory(device, mVulkanImage.Image, mVulkanImage.Memory, 0);
 		if (result != VK_SUCCESS)
 			return false;
 
@@ -116,19 +117,31 @@ namespace Mule::Vulkan
 		mArrayLayers = arrayLayers;
 
 		mImageAspect = aspect;
+		mImageType = type;
+		mImageFormat = format;
+		mUsageFlags = usageFlags;
+		mViewType = viewType;
+
 		bool success = CreateImage(type, format, width, height, depth, mipLevels, arrayLayers, usageFlags);
 		success |= AllocateMemory();
-		success |= CreateView(mVulkanImage.ImageView, viewType, format, aspect, 0, mipLevels, 0, arrayLayers);
+		success |= CreateViews(format, aspect, viewType);
+
+		return success;
+	}
+
+	bool IVulkanTexture::CreateViews(VkFormat format, VkImageAspectFlags aspect, VkImageViewType viewType)
+	{
+		bool success = CreateView(mVulkanImage.ImageView, viewType, format, aspect, 0, mMipLevels, 0, mArrayLayers);
 
 		VulkanContext& context = VulkanContext::Get();
 		VkDevice device = context.GetDevice();
 
-		mTextureViews.resize(arrayLayers);
+		mTextureViews.resize(mArrayLayers);
 
-		for (uint32_t layer = 0; layer < arrayLayers; layer++)
+		for (uint32_t layer = 0; layer < mArrayLayers; layer++)
 		{
-			mTextureViews[layer].resize(mipLevels);
-			for (uint32_t level = 0; level < mipLevels; level++)
+			mTextureViews[layer].resize(mMipLevels);
+			for (uint32_t level = 0; level < mMipLevels; level++)
 			{
 				VkImageViewCreateInfo viewInfo{};
 				viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -248,7 +261,59 @@ namespace Mule::Vulkan
 
 		vkDestroyImageView(device, mVulkanImage.ImageView, nullptr);
 		vkDestroyImage(device, mVulkanImage.Image, nullptr);
-		vkFreeMemory(device, mVulkanImage.Memory, nullptr);
+	}
+
+	void IVulkanTexture::ReleaseImage()
+	{
+		VulkanContext& context = VulkanContext::Get();
+		VkDevice device = context.GetDevice();
+
+		ReleaseViews();
+		vkDestroyImageView(device, mVulkanImage.ImageView, nullptr);
+		vkDestroyImage(device, mVulkanImage.Image, nullptr);
+
+		mVulkanImage.ImageView = VK_NULL_HANDLE;
+		mVulkanImage.Image = VK_NULL_HANDLE;
+		mVulkanImage.Memory = VK_NULL_HANDLE;
+		mMemory = nullptr;
+	}
+
+	bool IVulkanTexture::AliasImageMemory(const IVulkanTexture* owner)
+	{
+		if (owner == this || (owner && owner->mMemory == mMemory) || (!owner && !mIsAliased))
+			return true;
+
+		VulkanContext& context = VulkanContext::Get();
+		VkDevice device = context.GetDevice();
+
+		ReleaseImage();
+		CreateImage(mImageType, mImageFormat, mWidth, mHeight, mDepth, mMipLevels, mArrayLayers, mUsageFlags);
+
+		VkMemoryRequirements requirements;
+		vkGetImageMemoryRequirements(device, mVulkanImage.Image, &requirements);
+
+		bool fits = owner
+			&& owner->mMemory
+			&& requirements.size <= owner->mMemory->GetSize()
+			&& (requirements.memoryTypeBits & (1u << owner->mMemory->GetMemoryTypeIndex())) != 0;
+
+		if (fits)
+		{
+			mMemory = owner->mMemory;
+			mMemorySize = requirements.size;
+			mIsAliased = true;
+			mVulkanImage.Memory = mMemory->GetMemory();
+			vkBindImageMemory(device, mVulkanImage.Image, mVulkanImage.Memory, 0);
+		}
+		else
+		{
+			AllocateMemory();
+		}
+
+		CreateViews(mImageFormat, mImageAspect, mViewType);
+		mVulkanImage.Layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		return fits || !owner;
 	}
 
 	void IVulkanTexture::SetImageLayout(VkImageLayout imageLayout)
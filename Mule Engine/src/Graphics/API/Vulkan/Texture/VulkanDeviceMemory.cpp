@@ -0,0 +1,33 @@
+#include "Graphics/API/Vulkan/Texture/VulkanDeviceMemory.h"
+
+#include "Graphics/API/Vulkan/VulkanContext.h"
+
+#include <spdlog/spdlog.h>
+
+namespace Mule::Vulkan
+{
+	VulkanDeviceMemory::VulkanDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex)
+		:
+		mMemory(VK_NULL_HANDLE),
+		mSize(size),
+		mMemoryTypeIndex(memoryTypeIndex)
+	{
+		VulkanContext& context = VulkanContext::Get();
+
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize = size;
+		allocInfo.memoryTypeIndex = memoryTypeIndex;
+		allocInfo.pNext = nullptr;
+
+		VkResult result = vkAllocateMemory(context.GetDevice(), &allocInfo, nullptr, &mMemory);
+		if (result != VK_SUCCESS)
+			SPDLOG_ERROR("Failed to allocate image memory");
+	}
+
+	VulkanDeviceMemory::~VulkanDeviceMemory()
+	{
+		VulkanContext& context = VulkanContext::Get();
+		vkFreeMemory(context.GetDevice(), mMemory, nullptr);
+	}
+}
@@ -261,11 +261,7 @@ namespace Mule::Vulkan
 		mHeight = height;
 		VulkanContext& context = VulkanContext::Get();
 
-		VulkanImage img = GetVulkanImage();
-		ReleaseViews();
-		vkDestroyImageView(context.GetDevice(), img.ImageView, nullptr);
-		vkDestroyImage(context.GetDevice(), img.Image, nullptr);
-		vkFreeMemory(context.GetDevice(), img.Memory, nullptr);
+		ReleaseImage();
 
 		VkFormat textureFormat = GetVulkanFormat(GetFormat());
 		VkImageUsageFlags usageFlags = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
@@ -466,4 +462,15 @@ namespace Mule::Vulkan
 
 		context.EndSingleTimeCommandBuffer(cmd);
 	}
+
+	uint64_t VulkanTexture2D::GetMemorySize() const
+	{
+		return GetImageMemorySize();
+	}
+
+	bool VulkanTexture2D::AliasMemory(WeakRef<Texture> owner)
+	{
+		const IVulkanTexture* vulkanOwner = owner ? dynamic_cast<const IVulkanTexture*>(owner.Get()) : nullptr;
+		return AliasImageMemory(vulkanOwner);
+	}
 }
\ No newline at end of file
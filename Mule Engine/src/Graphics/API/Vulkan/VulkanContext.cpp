@@ -7,6 +7,8 @@
 
 #include <Volk/volk.c>
 
+#include <algorithm>
+
 namespace Mule::Vulkan
 {
 	VulkanContext* VulkanContext::mVulkanContext = nullptr;
@@ -46,6 +48,7 @@ namespace Mule::Vulkan
 		mDevice(VK_NULL_HANDLE),
 		mPhysicalDevice(VK_NULL_HANDLE),
 		mSwapchain(VK_NULL_HANDLE),
+		mMaxBindlessDescriptors(0),
 		mFrameCount(2),
 		mFrameIndex(0)
 	{
@@ -224,6 +227,26 @@ namespace Mule::Vulkan
 		vkGetPhysicalDeviceProperties(mPhysicalDevice, &phyicalDeviceProperties);
 		vkGetPhysicalDeviceFeatures(mPhysicalDevice, &physicalDeviceFeatures);
 
+		VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{};
+		indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+		indexingProperties.pNext = nullptr;
+
+		VkPhysicalDeviceProperties2 physicalDeviceProperties2{};
+		physicalDeviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		physicalDeviceProperties2.pNext = &indexingProperties;
+
+		vkGetPhysicalDeviceProperties2(mPhysicalDevice, &physicalDeviceProperties2);
+
+		// Upper bound for unbounded descriptor arrays, these are update after bind bindings so the update after bind
+		// limits apply. Some drivers report UINT32_MAX so keep layouts reasonably sized
+		mMaxBindlessDescriptors = std::min({
+			indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+			indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+			indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+			1u << 20
+			});
+
 #pragma endregion
 
 #pragma region Logical Device
@@ -255,6 +278,8 @@ namespace Mule::Vulkan
 		indexingFeatures.runtimeDescriptorArray = VK_TRUE;
 		indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
 		indexingFeatures.descriptorBindingVariableDescriptorCount = VK_TRUE;
+		indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
 		indexingFeatures.pNext = &dynamicRenderingFeatures;
 
 		// Enable separate depth-stencil layouts
@@ -312,6 +337,42 @@ namespace Mule::Vulkan
 			queueCreateInfo.pNext = nullptr;
 		}
 
+		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos = { queueCreateInfo };
+
+		// A compute only family runs alongside the graphics queue, the render graph schedules compute passes onto it
+		mComputeQueueFamilyIndex = mQueueFamilyIndex;
+		for (uint32_t i = 0; i < queueFamilyCount; i++)
+		{
+			auto& familyInfo = properties[i];
+
+			bool hasGraphics = familyInfo.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+			bool hasCompute = familyInfo.queueFlags & VK_QUEUE_COMPUTE_BIT;
+
+			if (hasGraphics || !hasCompute)
+				continue;
+
+			mComputeQueueFamilyIndex = i;
+
+			float* priorities = new float[familyInfo.queueCount];
+			for (int j = 0; j < familyInfo.queueCount; j++)
+			{
+				priorities[j] = 1.f;
+				mFreeComputeQueueIndices.push(j);
+			}
+
+			VkDeviceQueueCreateInfo computeQueueCreateInfo{};
+			computeQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			computeQueueCreateInfo.flags = 0;
+			computeQueueCreateInfo.queueFamilyIndex = i;
+			computeQueueCreateInfo.pQueuePriorities = priorities;
+			computeQueueCreateInfo.queueCount = familyInfo.queueCount;
+			computeQueueCreateInfo.pNext = nullptr;
+
+			queueCreateInfos.push_back(computeQueueCreateInfo);
+			SPDLOG_INFO("Using queue family {} for async compute", i);
+			break;
+		}
+
 
 		std::vector<const char*> logicalDeviceExtensions = {
 			"VK_KHR_swapchain",
@@ -326,6 +387,23 @@ namespace Mule::Vulkan
 			"VK_KHR_synchronization2",
 		};
 
+		// Optional, lets vertex shaders pick the layer they render to so shadow cascades can skip the geometry shader
+		uint32_t availableExtensionCount = 0;
+		vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &availableExtensionCount, nullptr);
+		std::vector<VkExtensionProperties> availableExtensions(availableExtensionCount);
+		vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &availableExtensionCount, availableExtensions.data());
+
+		for (const auto& extension : availableExtensions)
+		{
+			if (std::string(extension.extensionName) == VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME)
+				mVertexLayerOutput = true;
+		}
+
+		if (mVertexLayerOutput)
+			logicalDeviceExtensions.push_back(VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME);
+		else
+			SPDLOG_INFO("{} is not supported, shadow cascades use a geometry shader", VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME);
+
 		VkDeviceCreateInfo deviceCreateInfo{};
 		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 		deviceCreateInfo.enabledLayerCount; // Depreceated
@@ -333,8 +411,8 @@ namespace Mule::Vulkan
 		deviceCreateInfo.flags = 0;
 		deviceCreateInfo.enabledExtensionCount = logicalDeviceExtensions.size();
 		deviceCreateInfo.ppEnabledExtensionNames = logicalDeviceExtensions.data();
-		deviceCreateInfo.queueCreateInfoCount = 1;
-		deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+		deviceCreateInfo.queueCreateInfoCount = queueCreateInfos.size();
+		deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
 		deviceCreateInfo.pNext = &deviceFeatures2;
 
 		result = vkCreateDevice(mPhysicalDevice, &deviceCreateInfo, nullptr, &mDevice);
@@ -349,7 +427,8 @@ namespace Mule::Vulkan
 		}
 
 		// We need to release the dynamically allocated priorities for each queue
-		delete[] queueCreateInfo.pQueuePriorities;
+		for (const auto& info : queueCreateInfos)
+			delete[] info.pQueuePriorities;
 
 		volkLoadDevice(mDevice);
 
@@ -403,7 +482,7 @@ namespace Mule::Vulkan
 
 		descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		descriptorPoolInfo.maxSets = 1000 * poolSizes.size();
-		descriptorPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		descriptorPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
 		descriptorPoolInfo.poolSizeCount = poolSizes.size();
 		descriptorPoolInfo.pPoolSizes = poolSizes.data();
 		descriptorPoolInfo.pNext = nullptr;
@@ -1024,22 +1103,34 @@ namespace Mule::Vulkan
 		return mFrameData[mFrameIndex].ColorImage;
 	}
 
-	uint32_t VulkanContext::GetQueueFamilyIndex() const
+	uint32_t VulkanContext::GetQueueFamilyIndex(QueueType type) const
 	{
-		return mQueueFamilyIndex;
+		return type == QueueType::Compute ? mComputeQueueFamilyIndex : mQueueFamilyIndex;
 	}
 
-	VkQueue VulkanContext::CreateQueue()
+	std::vector<uint32_t> VulkanContext::GetQueueFamilyIndices() const
 	{
-		assert(!mFreeQueueIndices.empty() && "Vulkan device out of queues");
+		if (HasAsyncCompute())
+			return { mQueueFamilyIndex, mComputeQueueFamilyIndex };
 
-		uint32_t queueIndex = mFreeQueueIndices.top();
-		mFreeQueueIndices.pop();
+		return { mQueueFamilyIndex };
+	}
+
+	VkQueue VulkanContext::CreateQueue(QueueType type)
+	{
+		if (!HasAsyncCompute())
+			type = QueueType::Graphics;
+
+		std::stack<uint32_t>& freeIndices = type == QueueType::Compute ? mFreeComputeQueueIndices : mFreeQueueIndices;
+		assert(!freeIndices.empty() && "Vulkan device out of queues");
+
+		uint32_t queueIndex = freeIndices.top();
+		freeIndices.pop();
 
 		VkQueue queue;
-		vkGetDeviceQueue(mDevice, mQueueFamilyIndex, queueIndex, &queue);
+		vkGetDeviceQueue(mDevice, GetQueueFamilyIndex(type), queueIndex, &queue);
 
-		mAllocatedQueueIndices[queue] = queueIndex;
+		mAllocatedQueueIndices[queue] = { type, queueIndex };
 
 		return queue;
 	}
@@ -1048,8 +1139,12 @@ namespace Mule::Vulkan
 	{
 		assert(mAllocatedQueueIndices.find(queue) != mAllocatedQueueIndices.end() && "Trying to free non-existent vulkan queue");
 
-		uint32_t queueIndex = mAllocatedQueueIndices[queue];
-		mFreeQueueIndices.push(queueIndex);
+		auto [type, queueIndex] = mAllocatedQueueIndices[queue];
+		if (type == QueueType::Compute)
+			mFreeComputeQueueIndices.push(queueIndex);
+		else
+			mFreeQueueIndices.push(queueIndex);
+
 		mAllocatedQueueIndices.erase(queue);
 	}
 }
\ No newline at end of file
@@ -3,49 +3,98 @@
 #include "Graphics/API/Vulkan/VulkanContext.h"
 #include "Graphics/API/Vulkan/VulkanDescriptorSetLayout.h"
 #include "Graphics/API/Vulkan/Buffer/VulkanUniformBuffer.h"
+#include "Graphics/API/Vulkan/Buffer/VulkanStorageBuffer.h"
 #include "Graphics/API/Vulkan/Texture/VulkanTextureCube.h"
 #include "Graphics/API/Vulkan/Texture/VulkanSampler.h"
 
 #include "Graphics/API/Vulkan/VulkanTypeConversion.h"
 
+#include "Graphics/API/GraphicsCounters.h"
+
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace Mule::Vulkan
 {
 	VulkanDescriptorSet::VulkanDescriptorSet(Ref<ShaderResourceBlueprint> blueprint)
 		:
-		mDescriptorSet(VK_NULL_HANDLE)
+		mDescriptorSet(VK_NULL_HANDLE),
+		mVariableCount(0)
 	{
 		VulkanContext& context = VulkanContext::Get();
-		VkDevice device = context.GetDevice();
 		mDescriptorPool = context.GetDescriptorPool();
 
 		mBlueprint = blueprint;
 		Ref<VulkanDescriptorSetLayout> layout = blueprint;
-		VkDescriptorSetLayout vkLayout = layout->GetLayout();		
+
+		mVariableCount = layout->GetVariableCount();
+		mDescriptorSet = Allocate(mVariableCount);
+	}
+
+	VulkanDescriptorSet::~VulkanDescriptorSet()
+	{
+		VulkanContext& context = VulkanContext::Get();
+		VkDevice device = context.GetDevice();
+
+		vkFreeDescriptorSets(device, mDescriptorPool, 1, &mDescriptorSet);
+	}
+
+	bool VulkanDescriptorSet::Reserve(uint32_t arrayCount)
+	{
+		if (mVariableCount == 0 || arrayCount <= mVariableCount)
+			return false;
+
+		uint32_t maxCount = VulkanContext::Get().GetMaxBindlessDescriptors();
+		if (arrayCount > maxCount)
+		{
+			SPDLOG_ERROR("Descriptor array count {} exceeds the device limit {}", arrayCount, maxCount);
+			return false;
+		}
+
+		uint32_t variableCount = std::min(std::max(arrayCount, mVariableCount * 2), maxCount);
+		VkDescriptorSet descriptorSet = Allocate(variableCount);
+		if (descriptorSet == VK_NULL_HANDLE)
+			return false;
+
+		VkDevice device = VulkanContext::Get().GetDevice();
+		vkFreeDescriptorSets(device, mDescriptorPool, 1, &mDescriptorSet);
+
+		mDescriptorSet = descriptorSet;
+		mVariableCount = variableCount;
+
+		return true;
+	}
+
+	VkDescriptorSet VulkanDescriptorSet::Allocate(uint32_t variableCount)
+	{
+		VkDevice device = VulkanContext::Get().GetDevice();
+		Ref<VulkanDescriptorSetLayout> layout = mBlueprint;
+		VkDescriptorSetLayout vkLayout = layout->GetLayout();
+
+		VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo{};
+		variableCountInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+		variableCountInfo.pNext = nullptr;
+		variableCountInfo.descriptorSetCount = 1;
+		variableCountInfo.pDescriptorCounts = &variableCount;
 
 		VkDescriptorSetAllocateInfo allocInfo{};
 
 		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		allocInfo.pNext = nullptr;
+		allocInfo.pNext = variableCount > 0 ? &variableCountInfo : nullptr;
 		allocInfo.descriptorPool = mDescriptorPool;
 		allocInfo.descriptorSetCount = 1;
 		allocInfo.pSetLayouts = &vkLayout;
 
-		VkResult result = vkAllocateDescriptorSets(device, &allocInfo, &mDescriptorSet);
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkResult result = vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet);
 		if (result != VK_SUCCESS)
 		{
 			SPDLOG_ERROR("Failed to allocate descriptor set");
-			return;
+			return VK_NULL_HANDLE;
 		}
-	}
 
-	VulkanDescriptorSet::~VulkanDescriptorSet()
-	{
-		VulkanContext& context = VulkanContext::Get();
-		VkDevice device = context.GetDevice();
-
-		vkFreeDescriptorSets(device, mDescriptorPool, 1, &mDescriptorSet);
+		return descriptorSet;
 	}
 
 	void VulkanDescriptorSet::Update(uint32_t binding, DescriptorType type, ImageLayout layout, WeakRef<Texture> texture, uint32_t arrayIndex, Ref<Sampler> sampler)
@@ -80,6 +129,7 @@ namespace Mule::Vulkan
 		write.pTexelBufferView = nullptr;
 
 		vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+		GraphicsCounters::AddDescriptorUpdate();
 	}
 
 	void VulkanDescriptorSet::Update(uint32_t binding, DescriptorType type, ImageLayout layout, WeakRef<TextureView> texture, uint32_t arrayIndex, Ref<Sampler> sampler)
@@ -114,6 +164,7 @@ namespace Mule::Vulkan
 		write.pTexelBufferView = nullptr;
 
 		vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+		GraphicsCounters::AddDescriptorUpdate();
 	}
 
 	void VulkanDescriptorSet::Update(uint32_t binding, WeakRef<UniformBuffer> buffer, uint32_t arrayIndex)
@@ -140,5 +191,33 @@ namespace Mule::Vulkan
 		write.pTexelBufferView = nullptr;
 
 		vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+		GraphicsCounters::AddDescriptorUpdate();
+	}
+
+	void VulkanDescriptorSet::Update(uint32_t binding, WeakRef<StorageBuffer> buffer, uint32_t arrayIndex)
+	{
+		VulkanContext& context = VulkanContext::Get();
+		VkDevice device = context.GetDevice();
+		WeakRef<VulkanStorageBuffer> vkBuffer = buffer;
+
+		VkDescriptorBufferInfo bufferInfo{};
+		bufferInfo.buffer = vkBuffer->GetBuffer();
+		bufferInfo.offset = 0;
+		bufferInfo.range = buffer->GetSize();
+
+		VkWriteDescriptorSet write{};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.pNext = nullptr;
+		write.dstSet = mDescriptorSet;
+		write.dstBinding = binding;
+		write.dstArrayElement = arrayIndex;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pImageInfo = nullptr;
+		write.pBufferInfo = &bufferInfo;
+		write.pTexelBufferView = nullptr;
+
+		vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+		GraphicsCounters::AddDescriptorUpdate();
 	}
 }
\ No newline at end of file
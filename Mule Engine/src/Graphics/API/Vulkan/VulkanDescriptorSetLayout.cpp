@@ -5,32 +5,56 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace Mule::Vulkan
 {
 	VulkanDescriptorSetLayout::VulkanDescriptorSetLayout(const std::vector<ShaderResourceDescription>& resources)
 		:
-		mLayout(VK_NULL_HANDLE)
+		mLayout(VK_NULL_HANDLE),
+		mResources(resources)
 	{
-		VkDevice device = VulkanContext::Get().GetDevice();
+		VulkanContext& context = VulkanContext::Get();
+		VkDevice device = context.GetDevice();
 
 		std::vector<VkDescriptorSetLayoutBinding> vkLayouts;
+		std::vector<VkDescriptorBindingFlags> bindingFlags;
+		bool hasUnbounded = false;
 		for (const auto& resource : resources)
 		{
 			VkDescriptorSetLayoutBinding layoutBinding{
 				.binding = resource.Binding,
 				.descriptorType = GetResourceType(resource.Type),
-				.descriptorCount = resource.ArrayCount,
+				.descriptorCount = resource.Unbounded ? context.GetMaxBindlessDescriptors() : resource.ArrayCount,
 				.stageFlags = GetShaderStage(resource.Stages),
 				.pImmutableSamplers = nullptr,
 			};
 			vkLayouts.push_back(layoutBinding);
+
+			VkDescriptorBindingFlags flags = 0;
+			if (resource.Unbounded)
+			{
+				// Slots that no pending command buffer reads can be written while earlier frames are still in flight
+				flags = VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT
+					| VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+					| VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+					| VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+				hasUnbounded = true;
+			}
+			bindingFlags.push_back(flags);
 		}
 
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+		bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlagsInfo.pNext = nullptr;
+		bindingFlagsInfo.bindingCount = bindingFlags.size();
+		bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
 		VkDescriptorSetLayoutCreateInfo createInfo{};
 
 		createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		createInfo.pNext = nullptr;
-		createInfo.flags = 0;
+		createInfo.pNext = hasUnbounded ? &bindingFlagsInfo : nullptr;
+		createInfo.flags = hasUnbounded ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT : 0;
 		createInfo.bindingCount = vkLayouts.size();
 		createInfo.pBindings = vkLayouts.data();
 
@@ -42,6 +66,17 @@ namespace Mule::Vulkan
 		}
 	}
 
+	uint32_t VulkanDescriptorSetLayout::GetVariableCount() const
+	{
+		for (const auto& resource : mResources)
+		{
+			if (resource.Unbounded)
+				return std::min(resource.ArrayCount, VulkanContext::Get().GetMaxBindlessDescriptors());
+		}
+
+		return 0;
+	}
+
 	VulkanDescriptorSetLayout::~VulkanDescriptorSetLayout()
 	{
 		VkDevice device = VulkanContext::Get().GetDevice();
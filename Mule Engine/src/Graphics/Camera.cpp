@@ -1,4 +1,5 @@
 #include "Graphics/Camera.h"
+#include "Graphics/Renderer/RenderView.h"
 
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/matrix_clip_space.hpp>
@@ -6,6 +7,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <algorithm>
+#include <cmath>
 
 #include <array>
 
@@ -146,7 +148,7 @@ namespace Mule
 		UpdateView();
 	}
 
-	Camera::CascadeSplits Camera::GenerateLightSpaceCascades(uint32_t count, const glm::vec3& direction) const
+	Camera::CascadeSplits Camera::GenerateLightSpaceCascades(const std::vector<const RenderView*>& views, uint32_t count, const glm::vec3& direction, uint32_t resolution)
 	{
 		const float cascadeSplitLambda = 0.95;
 
@@ -155,102 +157,116 @@ namespace Mule
 		cascadeData.SplitDistances.resize(count);
 		cascadeData.Count = count;
 
-		std::vector<float> cascadeSplits(count);
-		
-		float nearClip = mNearPlane;
-		float farClip = mFarPlane;
-		float clipRange = farClip - nearClip;
-
-		float minZ = nearClip;
-		float maxZ = nearClip + clipRange;
-
-		float range = maxZ - minZ;
-		float ratio = maxZ / minZ;
-
-		// Calculate split depths based on view camera frustum
-		// Based on method presented in https://developer.nvidia.com/gpugems/GPUGems3/gpugems3_ch10.html
-		for (uint32_t i = 0; i < count; i++) {
-			float p = (i + 1) / static_cast<float>(count);
-			float log = minZ * std::pow(ratio, p);
-			float uniform = minZ + range * p;
-			float d = cascadeSplitLambda * (log - uniform) + uniform;
-			cascadeSplits[i] = (d - nearClip) / clipRange;
+		if (views.empty())
+			return cascadeData;
+
+		// Split depths of every camera, based on method presented in https://developer.nvidia.com/gpugems/GPUGems3/gpugems3_ch10.html
+		std::vector<float> cascadeSplits(views.size() * count);
+		for (uint32_t c = 0; c < views.size(); c++)
+		{
+			float nearClip = views[c]->NearPlane;
+			float farClip = views[c]->FarPlane;
+			float clipRange = farClip - nearClip;
+
+			float minZ = nearClip;
+			float maxZ = nearClip + clipRange;
+
+			float range = maxZ - minZ;
+			float ratio = maxZ / minZ;
+
+			for (uint32_t i = 0; i < count; i++) {
+				float p = (i + 1) / static_cast<float>(count);
+				float log = minZ * std::pow(ratio, p);
+				float uniform = minZ + range * p;
+				float d = cascadeSplitLambda * (log - uniform) + uniform;
+				cascadeSplits[c * count + i] = (d - nearClip) / clipRange;
+			}
 		}
 
+		// The light view only rotates with the light, cascade centers are snapped to whole texels in it so a cascade
+		// keeps the same matrix until its center moves a full texel and shadow edges do not crawl as the camera moves
+		glm::vec3 lightDir = glm::normalize(direction);
+		glm::vec3 lightUp = std::abs(lightDir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), lightDir, lightUp);
+
 		// Calculate orthographic projection matrix for each cascade
-		float lastSplitDist = 0.0;
 		for (uint32_t i = 0; i < count; i++) {
-			float splitDist = cascadeSplits[i];
-
-			glm::vec3 frustumCorners[8] = {
-				glm::vec3(-1.0f,  1.0f, 0.0f),
-				glm::vec3(1.0f,  1.0f, 0.0f),
-				glm::vec3(1.0f, -1.0f, 0.0f),
-				glm::vec3(-1.0f, -1.0f, 0.0f),
-				glm::vec3(-1.0f,  1.0f,  1.0f),
-				glm::vec3(1.0f,  1.0f,  1.0f),
-				glm::vec3(1.0f, -1.0f,  1.0f),
-				glm::vec3(-1.0f, -1.0f,  1.0f),
-			};
-
-			// Project frustum corners into world space
-			glm::mat4 invCam = glm::inverse(mProj * mView);
-			for (uint32_t j = 0; j < 8; j++) {
-				glm::vec4 invCorner = invCam * glm::vec4(frustumCorners[j], 1.0f);
-				frustumCorners[j] = invCorner / invCorner.w;
-			}
-
-			for (uint32_t j = 0; j < 4; j++) {
-				glm::vec3 dist = frustumCorners[j + 4] - frustumCorners[j];
-				frustumCorners[j + 4] = frustumCorners[j] + (dist * splitDist);
-				frustumCorners[j] = frustumCorners[j] + (dist * lastSplitDist);
-			}
-
-			// Get frustum center
-			glm::vec3 frustumCenter = glm::vec3(0.0f);
-			for (uint32_t j = 0; j < 8; j++) {
-				frustumCenter += frustumCorners[j];
+			glm::vec3 cascadeCenter = glm::vec3(0.0f);
+			float cascadeRadius = -1.0f;
+
+			for (uint32_t c = 0; c < views.size(); c++)
+			{
+				float splitDist = cascadeSplits[c * count + i];
+				float lastSplitDist = i == 0 ? 0.0f : cascadeSplits[c * count + i - 1];
+
+				glm::vec3 frustumCorners[8] = {
+					glm::vec3(-1.0f,  1.0f, 0.0f),
+					glm::vec3(1.0f,  1.0f, 0.0f),
+					glm::vec3(1.0f, -1.0f, 0.0f),
+					glm::vec3(-1.0f, -1.0f, 0.0f),
+					glm::vec3(-1.0f,  1.0f,  1.0f),
+					glm::vec3(1.0f,  1.0f,  1.0f),
+					glm::vec3(1.0f, -1.0f,  1.0f),
+					glm::vec3(-1.0f, -1.0f,  1.0f),
+				};
+
+				// Project frustum corners into world space
+				glm::mat4 invCam = glm::inverse(views[c]->ViewProj);
+				for (uint32_t j = 0; j < 8; j++) {
+					glm::vec4 invCorner = invCam * glm::vec4(frustumCorners[j], 1.0f);
+					frustumCorners[j] = invCorner / invCorner.w;
+				}
+
+				for (uint32_t j = 0; j < 4; j++) {
+					glm::vec3 dist = frustumCorners[j + 4] - frustumCorners[j];
+					frustumCorners[j + 4] = frustumCorners[j] + (dist * splitDist);
+					frustumCorners[j] = frustumCorners[j] + (dist * lastSplitDist);
+				}
+
+				// Get frustum center
+				glm::vec3 frustumCenter = glm::vec3(0.0f);
+				for (uint32_t j = 0; j < 8; j++) {
+					frustumCenter += frustumCorners[j];
+				}
+				frustumCenter /= 8.0f;
+
+				// The bounding sphere keeps the cascade size fixed as the camera rotates
+				float radius = 0.0f;
+				for (uint32_t j = 0; j < 8; j++) {
+					float distance = glm::length(frustumCorners[j] - frustumCenter);
+					radius = glm::max(radius, distance);
+				}
+
+				// Grow the cascade sphere until it also holds the slice of this camera
+				float centerDistance = glm::length(frustumCenter - cascadeCenter);
+				if (cascadeRadius < 0.0f || centerDistance + cascadeRadius <= radius)
+				{
+					cascadeCenter = frustumCenter;
+					cascadeRadius = radius;
+				}
+				else if (centerDistance + radius > cascadeRadius)
+				{
+					float mergedRadius = (centerDistance + cascadeRadius + radius) * 0.5f;
+					cascadeCenter += (frustumCenter - cascadeCenter) * ((mergedRadius - cascadeRadius) / centerDistance);
+					cascadeRadius = mergedRadius;
+				}
 			}
-			frustumCenter /= 8.0f;
 
-			float radius = 0.0f;
-			for (uint32_t j = 0; j < 8; j++) {
-				float distance = glm::length(frustumCorners[j] - frustumCenter);
-				radius = glm::max(radius, distance);
-			}
-			radius = std::ceil(radius * 16.0f) / 16.0f;
+			float radius = std::ceil(cascadeRadius * 16.0f) / 16.0f;
 
-			glm::vec3 maxExtents = glm::vec3(radius);
-			glm::vec3 minExtents = -maxExtents;
+			float texelSize = 2.0f * radius / resolution;
+			glm::vec3 lightSpaceCenter = glm::vec3(lightRotation * glm::vec4(cascadeCenter, 1.0f));
+			lightSpaceCenter = glm::floor(lightSpaceCenter / texelSize) * texelSize;
 
-			glm::vec3 lightDir = glm::normalize(direction);
-			glm::mat4 lightViewMatrix = glm::lookAt(frustumCenter - lightDir * -minExtents.z, frustumCenter, glm::vec3(0.0f, 1.0f, 0.0f));
-			glm::mat4 lightOrthoMatrix = glm::ortho(minExtents.x, maxExtents.x, minExtents.y, maxExtents.y, 0.0f, maxExtents.z - minExtents.z);
+			// Eye on the sphere towards the light, looking down the light direction
+			glm::mat4 lightViewMatrix = glm::translate(glm::mat4(1.0f), -lightSpaceCenter - glm::vec3(0.0f, 0.0f, radius)) * lightRotation;
+			glm::mat4 lightOrthoMatrix = glm::ortho(-radius, radius, -radius, radius, 0.0f, 2.0f * radius);
 
 			glm::mat4 lightViewProj = lightOrthoMatrix * lightViewMatrix;
 
-			// 2. Transform origin (0, 0, 0) to light space to find texel alignment
-			glm::vec4 shadowOrigin = lightViewProj * glm::vec4(0.0f);
-			shadowOrigin *= (float)2048.f / 2.0f;
-			
-			// 3. Round to nearest texel
-			glm::vec4 roundedOrigin = glm::round(shadowOrigin);
-			
-			// 4. Compute offset and apply it back
-			glm::vec4 offset = (roundedOrigin - shadowOrigin) * 2.0f / (float)2048.f;
-			offset.z = 0.0f;
-			offset.w = 0.0f;
-			
-			glm::mat4 texelSnapOffset = glm::translate(glm::mat4(1.0f), glm::vec3(offset));
-			
-			// 5. Apply to final matrix
-			lightViewProj = texelSnapOffset * lightViewProj;
-
-			// Store the final matrix
+			// Store the final matrix, split distances are those of the first camera
 			cascadeData.LightSpaceMatrices[i] = lightViewProj;
-			cascadeData.SplitDistances[i] = (mNearPlane + splitDist * clipRange) * -1.0f;
-			
-			lastSplitDist = cascadeSplits[i];
+			cascadeData.SplitDistances[i] = (views[0]->NearPlane + cascadeSplits[i] * (views[0]->FarPlane - views[0]->NearPlane)) * -1.0f;
 		}
 
 		return cascadeData;
@@ -260,4 +276,9 @@ namespace Mule
 	{
 		return mResourceRegistry->GetColorOutput();
 	}
+
+	glm::vec2 Camera::GetColorOutputUV() const
+	{
+		return mResourceRegistry->GetColorOutputUV();
+	}
 }
\ No newline at end of file
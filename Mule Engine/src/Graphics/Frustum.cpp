@@ -0,0 +1,54 @@
+#include "Graphics/Frustum.h"
+
+#include <algorithm>
+
+namespace Mule
+{
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		glm::vec4 row0 = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+		glm::vec4 row1 = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+		glm::vec4 row2 = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+		glm::vec4 row3 = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+		Planes[0] = row3 + row0; // Left
+		Planes[1] = row3 - row0; // Right
+		Planes[2] = row3 + row1; // Bottom
+		Planes[3] = row3 - row1; // Top
+		Planes[4] = row2;        // Near
+		Planes[5] = row3 - row2; // Far
+
+		for (glm::vec4& plane : Planes)
+		{
+			float length = glm::length(glm::vec3(plane));
+			if (length > 0.f)
+				plane /= length;
+		}
+	}
+
+	bool Frustum::IntersectsSphere(const glm::vec4& sphere) const
+	{
+		glm::vec3 center = glm::vec3(sphere);
+
+		for (const glm::vec4& plane : Planes)
+		{
+			if (glm::dot(glm::vec3(plane), center) + plane.w < -sphere.w)
+				return false;
+		}
+
+		return true;
+	}
+
+	glm::vec4 TransformBoundingSphere(const glm::mat4& transform, const glm::vec4& sphere)
+	{
+		glm::vec3 center = glm::vec3(transform * glm::vec4(glm::vec3(sphere), 1.f));
+
+		float scale = std::max({
+			glm::length(glm::vec3(transform[0])),
+			glm::length(glm::vec3(transform[1])),
+			glm::length(glm::vec3(transform[2]))
+			});
+
+		return glm::vec4(center, sphere.w * scale);
+	}
+}
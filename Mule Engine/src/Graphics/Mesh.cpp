@@ -11,6 +11,7 @@ namespace Mule
 		mIndexBuffer(indexBuffer),
 		mDefaultMaterialHandle(defaultMaterialHandle)
 	{
+		mLods.push_back({ 0, mIndexBuffer ? mIndexBuffer->GetIndexCount() : 0 });
 	}
 	
 	Ref<Mesh> Mesh::Create(const std::string& name, Ref<VertexBuffer> vertexBuffer, Ref<IndexBuffer> indexBuffer, AssetHandle defaultMaterialHandle)
@@ -23,4 +24,24 @@ namespace Mule
 
 	}
 
+	void Mesh::SetBounds(const glm::vec3& min, const glm::vec3& max)
+	{
+		mBoundsMin = min;
+		mBoundsMax = max;
+
+		glm::vec3 center = (min + max) * 0.5f;
+		mBoundingSphere = glm::vec4(center, glm::length(max - center));
+	}
+
+	void Mesh::SetLods(const std::vector<MeshLod>& lods)
+	{
+		if (lods.empty())
+		{
+			SPDLOG_WARN("Mesh {} needs at least one level of detail", Name());
+			return;
+		}
+
+		mLods = lods;
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "Graphics/MeshSimplifier.h"
+
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+
+namespace Mule
+{
+	namespace
+	{
+		// Symmetric 4x4 error quadric, only the 10 unique coefficients are stored
+		struct Quadric
+		{
+			double A[10] = {};
+
+			static Quadric FromPlane(const glm::dvec3& normal, double d, double weight)
+			{
+				Quadric q;
+				q.A[0] = normal.x * normal.x * weight;
+				q.A[1] = normal.x * normal.y * weight;
+				q.A[2] = normal.x * normal.z * weight;
+				q.A[3] = normal.x * d * weight;
+				q.A[4] = normal.y * normal.y * weight;
+				q.A[5] = normal.y * normal.z * weight;
+				q.A[6] = normal.y * d * weight;
+				q.A[7] = normal.z * normal.z * weight;
+				q.A[8] = normal.z * d * weight;
+				q.A[9] = d * d * weight;
+				return q;
+			}
+
+			Quadric& operator+=(const Quadric& other)
+			{
+				for (uint32_t i = 0; i < 10; i++)
+					A[i] += other.A[i];
+				return *this;
+			}
+
+			double Evaluate(const glm::vec3& p) const
+			{
+				double x = p.x, y = p.y, z = p.z;
+				return A[0] * x * x + 2.0 * A[1] * x * y + 2.0 * A[2] * x * z + 2.0 * A[3] * x
+					+ A[4] * y * y + 2.0 * A[5] * y * z + 2.0 * A[6] * y
+					+ A[7] * z * z + 2.0 * A[8] * z
+					+ A[9];
+			}
+		};
+
+		struct Collapse
+		{
+			double Cost;
+			uint32_t From;
+			uint32_t To;
+			uint32_t FromVersion;
+			uint32_t ToVersion;
+
+			bool operator>(const Collapse& other) const { return Cost > other.Cost; }
+		};
+
+		constexpr double sBoundaryWeight = 1000.0;
+
+		uint64_t EdgeKey(uint32_t a, uint32_t b)
+		{
+			return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+		}
+	}
+
+	std::vector<uint32_t> SimplifyMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, uint32_t targetIndexCount)
+	{
+		if (indices.size() <= targetIndexCount || indices.size() < 3)
+			return indices;
+
+		uint32_t vertexCount = static_cast<uint32_t>(positions.size());
+		uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+		std::vector<uint32_t> triangles(indices.begin(), indices.begin() + triangleCount * 3);
+		std::vector<bool> removed(triangleCount, false);
+		std::vector<Quadric> quadrics(vertexCount);
+		std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+		std::unordered_map<uint64_t, uint32_t> edgeUse;
+
+		uint32_t liveIndexCount = 0;
+
+		for (uint32_t t = 0; t < triangleCount; t++)
+		{
+			uint32_t i0 = triangles[t * 3 + 0];
+			uint32_t i1 = triangles[t * 3 + 1];
+			uint32_t i2 = triangles[t * 3 + 2];
+
+			if (i0 == i1 || i1 == i2 || i0 == i2)
+			{
+				removed[t] = true;
+				continue;
+			}
+
+			glm::dvec3 p0 = positions[i0];
+			glm::dvec3 normal = glm::cross(glm::dvec3(positions[i1]) - p0, glm::dvec3(positions[i2]) - p0);
+			double length = glm::length(normal);
+
+			if (length > 0.0)
+			{
+				normal /= length;
+				Quadric q = Quadric::FromPlane(normal, -glm::dot(normal, p0), length * 0.5);
+				quadrics[i0] += q;
+				quadrics[i1] += q;
+				quadrics[i2] += q;
+			}
+
+			for (uint32_t e = 0; e < 3; e++)
+			{
+				vertexTriangles[triangles[t * 3 + e]].push_back(t);
+				edgeUse[EdgeKey(triangles[t * 3 + e], triangles[t * 3 + (e + 1) % 3])]++;
+			}
+
+			liveIndexCount += 3;
+		}
+
+		// Open edges get a plane perpendicular to their triangle so sliding along the border is expensive
+		for (uint32_t t = 0; t < triangleCount; t++)
+		{
+			if (removed[t])
+				continue;
+
+			glm::dvec3 p0 = positions[triangles[t * 3 + 0]];
+			glm::dvec3 faceNormal = glm::cross(glm::dvec3(positions[triangles[t * 3 + 1]]) - p0, glm::dvec3(positions[triangles[t * 3 + 2]]) - p0);
+			if (glm::length(faceNormal) == 0.0)
+				continue;
+
+			faceNormal = glm::normalize(faceNormal);
+
+			for (uint32_t e = 0; e < 3; e++)
+			{
+				uint32_t a = triangles[t * 3 + e];
+				uint32_t b = triangles[t * 3 + (e + 1) % 3];
+
+				if (edgeUse[EdgeKey(a, b)] != 1)
+					continue;
+
+				glm::dvec3 edge = glm::dvec3(positions[b]) - glm::dvec3(positions[a]);
+				glm::dvec3 normal = glm::cross(edge, faceNormal);
+				double length = glm::length(normal);
+				if (length == 0.0)
+					continue;
+
+				normal /= length;
+				Quadric q = Quadric::FromPlane(normal, -glm::dot(normal, glm::dvec3(positions[a])), glm::dot(edge, edge) * sBoundaryWeight);
+				quadrics[a] += q;
+				quadrics[b] += q;
+			}
+		}
+
+		std::vector<uint32_t> versions(vertexCount, 0);
+		std::vector<bool> collapsed(vertexCount, false);
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+		auto pushEdge = [&](uint32_t a, uint32_t b) {
+			Quadric q = quadrics[a];
+			q += quadrics[b];
+
+			double costToB = q.Evaluate(positions[b]);
+			double costToA = q.Evaluate(positions[a]);
+
+			if (costToB <= costToA)
+				heap.push({ costToB, a, b, versions[a], versions[b] });
+			else
+				heap.push({ costToA, b, a, versions[b], versions[a] });
+			};
+
+		for (const auto& [key, uses] : edgeUse)
+		{
+			pushEdge(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & 0xFFFFFFFF));
+		}
+
+		std::vector<uint32_t> neighbours;
+
+		while (liveIndexCount > targetIndexCount && !heap.empty())
+		{
+			Collapse collapse = heap.top();
+			heap.pop();
+
+			uint32_t from = collapse.From;
+			uint32_t to = collapse.To;
+
+			if (collapsed[from] || collapsed[to] || versions[from] != collapse.FromVersion || versions[to] != collapse.ToVersion)
+				continue;
+
+			// Reject collapses that would flip a triangle that survives the collapse
+			bool flips = false;
+			for (uint32_t t : vertexTriangles[from])
+			{
+				if (removed[t])
+					continue;
+
+				uint32_t* tri = &triangles[t * 3];
+				if (tri[0] == to || tri[1] == to || tri[2] == to)
+					continue;
+
+				glm::vec3 p[3] = { positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+				glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					if (tri[k] == from)
+						p[k] = positions[to];
+				}
+
+				glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+				if (glm::dot(before, after) <= 0.f)
+				{
+					flips = true;
+					break;
+				}
+			}
+
+			if (flips)
+				continue;
+
+			for (uint32_t t : vertexTriangles[from])
+			{
+				if (removed[t])
+					continue;
+
+				uint32_t* tri = &triangles[t * 3];
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					if (tri[k] == from)
+						tri[k] = to;
+				}
+
+				if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+				{
+					removed[t] = true;
+					liveIndexCount -= 3;
+				}
+				else
+				{
+					vertexTriangles[to].push_back(t);
+				}
+			}
+
+			collapsed[from] = true;
+			vertexTriangles[from].clear();
+			quadrics[to] += quadrics[from];
+			versions[to]++;
+
+			auto& toTriangles = vertexTriangles[to];
+			toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&](uint32_t t) { return removed[t]; }), toTriangles.end());
+
+			neighbours.clear();
+			for (uint32_t t : toTriangles)
+			{
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					if (triangles[t * 3 + k] != to)
+						neighbours.push_back(triangles[t * 3 + k]);
+				}
+			}
+
+			std::sort(neighbours.begin(), neighbours.end());
+			neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+			for (uint32_t neighbour : neighbours)
+				pushEdge(to, neighbour);
+		}
+
+		std::vector<uint32_t> result;
+		result.reserve(liveIndexCount);
+
+		for (uint32_t t = 0; t < triangleCount; t++)
+		{
+			if (removed[t])
+				continue;
+
+			result.push_back(triangles[t * 3 + 0]);
+			result.push_back(triangles[t * 3 + 1]);
+			result.push_back(triangles[t * 3 + 2]);
+		}
+
+		return result;
+	}
+
+	void BuildLodChain(
+		const std::vector<glm::vec3>& positions,
+		const std::vector<uint32_t>& indices,
+		uint32_t maxLevels,
+		float reduction,
+		uint32_t minTriangleCount,
+		std::vector<uint32_t>& outIndices,
+		std::vector<MeshLod>& outLods)
+	{
+		outIndices = indices;
+		outLods.clear();
+		outLods.push_back({ 0, static_cast<uint32_t>(indices.size()) });
+
+		std::vector<uint32_t> previous = indices;
+
+		for (uint32_t level = 1; level < maxLevels; level++)
+		{
+			uint32_t targetIndexCount = static_cast<uint32_t>(previous.size() / 3 * reduction) * 3;
+			if (targetIndexCount / 3 < minTriangleCount)
+				break;
+
+			std::vector<uint32_t> lod = SimplifyMesh(positions, previous, targetIndexCount);
+
+			// Heavily constrained meshes stop shrinking, a level that saves less than 10% isnt worth the memory
+			if (lod.empty() || lod.size() > previous.size() * 9 / 10)
+				break;
+
+			outLods.push_back({ static_cast<uint32_t>(outIndices.size()), static_cast<uint32_t>(lod.size()) });
+			outIndices.insert(outIndices.end(), lod.begin(), lod.end());
+			previous = std::move(lod);
+		}
+	}
+}
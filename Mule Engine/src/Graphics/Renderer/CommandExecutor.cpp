@@ -5,14 +5,15 @@ namespace Mule::CommandExecutor
 	void ExecuteClearFramebufferCommand(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex);
 	void ExecuteTransitionLayoutCommand(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex);
 	void ExecuteBeginRenderingCommand(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex);
+	void ResolveAttachments(const BeginRenderingCommand& beginCommand, const ResourceRegistry& registry, uint32_t frameIndex, std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment& depthAttachment, glm::uvec2& renderArea);
 	void ExecuteEndRenderingCommand(Ref<CommandBuffer> cmd);
 	void ExecuteBindGraphicsPipeline(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex);
 	void ExecuteBindComputePipeline(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex);
 	void ExecuteClearRenderTarget(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex);
 
-	void Execute(Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex)
+	void Execute(Ref<CommandBuffer> cmd, const std::vector<RenderCommand>& commands, const ResourceRegistry& registry, uint32_t frameIndex)
 	{
-		for (const RenderCommand& command : commandList.GetCommands())
+		for (const RenderCommand& command : commands)
 		{
 			switch (command.GetType())
 			{
@@ -60,16 +61,38 @@ namespace Mule::CommandExecutor
 	void ExecuteTransitionLayoutCommand(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex)
 	{
 		const TransitionLayoutCommand& transitionCommand = command.GetCommand<TransitionLayoutCommand>();
-		auto texture = registry.GetResource<Texture>(transitionCommand.TextureHandle, frameIndex);
-		cmd->TranistionImageLayout(texture, transitionCommand.NewLayout);
+
+		std::vector<TextureTransition> transitions;
+		transitions.reserve(transitionCommand.Transitions.size());
+
+		for (const auto& transition : transitionCommand.Transitions)
+		{
+			Ref<Texture> texture = registry.GetResource<Texture>(transition.TextureHandle, frameIndex);
+
+			TextureTransition textureTransition;
+			textureTransition.Texture = texture;
+			textureTransition.NewLayout = transition.NewLayout;
+			textureTransition.Discard = transition.Discard;
+			textureTransition.Ownership = transition.Ownership;
+			textureTransition.SrcQueue = transition.SrcQueue;
+			textureTransition.DstQueue = transition.DstQueue;
+			textureTransition.OldLayout = transition.OldLayout;
+			transitions.push_back(textureTransition);
+		}
+
+		cmd->TransitionImageLayouts(transitions);
 	}
 	
-	void ExecuteBeginRenderingCommand(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex)
+	void ResolveAttachments(const BeginRenderingCommand& beginCommand, const ResourceRegistry& registry, uint32_t frameIndex, std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment& depthAttachment, glm::uvec2& renderArea)
 	{
-		const BeginRenderingCommand& beginCommand = command.GetCommand<BeginRenderingCommand>();
+		// Attachments sized to the view are only valid up to the registry's extent, see ResourceRegistry::GetExtent
+		renderArea = glm::uvec2(UINT32_MAX);
+		auto clampRenderArea = [&](ResourceHandle handle) {
+			auto [width, height] = registry.GetExtent(handle, frameIndex);
+			renderArea = glm::min(renderArea, glm::uvec2(width, height));
+			};
 
-		std::vector<BeginRenderingAttachment> colorAttachments(beginCommand.ColorAttachments.size());
-		BeginRenderingAttachment depthAttachment;
+		colorAttachments.resize(beginCommand.ColorAttachments.size());
 
 		for (uint32_t i = 0; i < beginCommand.ColorAttachments.size(); i++)
 		{
@@ -79,20 +102,51 @@ namespace Mule::CommandExecutor
 				registry.GetResource<Texture>(attachment.AttachmentHandle, frameIndex),
 				attachment.ClearOnLoad
 			};
+
+			clampRenderArea(attachment.AttachmentHandle);
 		}
 
 		if (beginCommand.DepthAttachment.AttachmentHandle)
 		{
 			depthAttachment.Attachment = registry.GetResource<Texture>(beginCommand.DepthAttachment.AttachmentHandle, frameIndex);
 			depthAttachment.ClearOnLoad = beginCommand.DepthAttachment.ClearOnLoad;
+
+			clampRenderArea(beginCommand.DepthAttachment.AttachmentHandle);
 		}
 
+		if (renderArea.x == UINT32_MAX)
+			renderArea = glm::uvec2(0);
+	}
+
+	void ExecuteBeginRenderingCommand(Ref<CommandBuffer> cmd, const RenderCommand& command, const ResourceRegistry& registry, uint32_t frameIndex)
+	{
+		const BeginRenderingCommand& beginCommand = command.GetCommand<BeginRenderingCommand>();
+
+		std::vector<BeginRenderingAttachment> colorAttachments;
+		BeginRenderingAttachment depthAttachment;
+		glm::uvec2 renderArea;
+		ResolveAttachments(beginCommand, registry, frameIndex, colorAttachments, depthAttachment, renderArea);
+
 		cmd->BeginRendering(
 			colorAttachments,
-			depthAttachment
+			depthAttachment,
+			beginCommand.SecondaryContents,
+			renderArea
 		);
 	}
 
+	void BeginSecondary(Ref<CommandBuffer> cmd, const RenderCommand& beginRendering, const ResourceRegistry& registry, uint32_t frameIndex)
+	{
+		const BeginRenderingCommand& beginCommand = beginRendering.GetCommand<BeginRenderingCommand>();
+
+		std::vector<BeginRenderingAttachment> colorAttachments;
+		BeginRenderingAttachment depthAttachment;
+		glm::uvec2 renderArea;
+		ResolveAttachments(beginCommand, registry, frameIndex, colorAttachments, depthAttachment, renderArea);
+
+		cmd->BeginSecondary(colorAttachments, depthAttachment, renderArea);
+	}
+
 	void ExecuteEndRenderingCommand(Ref<CommandBuffer> cmd)
 	{
 		cmd->EndRendering();
@@ -0,0 +1,52 @@
+#include "Graphics/Renderer/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mule
+{
+	constexpr double sSmoothing = 0.1;
+
+	// The scale holds while the smoothed time is in [sLowerBand, 1] of the target, outside of it the scale steers
+	// towards the middle of the band
+	constexpr double sLowerBand = 0.85;
+	constexpr double sBandCenter = 0.925;
+
+	// Fraction of the way to the wanted scale moved per frame, going down is faster so a spike is dealt with quickly
+	constexpr float sScaleDownRate = 0.5f;
+	constexpr float sScaleUpRate = 0.1f;
+
+	void DynamicResolution::SetSettings(const DynamicResolutionSettings& settings)
+	{
+		mSettings = settings;
+		mSettings.MinScale = std::clamp(mSettings.MinScale, 0.1f, 1.f);
+		mSettings.MaxScale = std::clamp(mSettings.MaxScale, mSettings.MinScale, 1.f);
+		mScale = std::clamp(mScale, mSettings.MinScale, mSettings.MaxScale);
+	}
+
+	float DynamicResolution::Update(double gpuTime)
+	{
+		if (!mSettings.Enabled || gpuTime <= 0.0 || mSettings.TargetGPUTime <= 0.0)
+			return mScale;
+
+		mSmoothedTime = mSmoothedTime > 0.0 ? mSmoothedTime + (gpuTime - mSmoothedTime) * sSmoothing : gpuTime;
+
+		double load = mSmoothedTime / mSettings.TargetGPUTime;
+		if (load >= sLowerBand && load <= 1.0)
+			return mScale;
+
+		float wantedScale = mScale * static_cast<float>(std::sqrt(sBandCenter / load));
+		wantedScale = std::clamp(wantedScale, mSettings.MinScale, mSettings.MaxScale);
+
+		float rate = wantedScale < mScale ? sScaleDownRate : sScaleUpRate;
+		float scale = mScale + (wantedScale - mScale) * rate;
+
+		// Frames at the new scale only reach the timings frames in flight later, the history is moved to the new scale
+		// right away so the controller does not keep correcting for a load it already dealt with
+		double pixelRatio = (scale / mScale) * (scale / mScale);
+		mSmoothedTime *= pixelRatio;
+		mScale = scale;
+
+		return mScale;
+	}
+}
@@ -0,0 +1,125 @@
+#include "Graphics/Renderer/HiZ.h"
+
+#include <algorithm>
+
+namespace Mule
+{
+	void DownsampleDepth(const float* depth, uint32_t depthWidth, uint32_t depthHeight, uint32_t width, uint32_t height, float* out)
+	{
+		for (uint32_t y = 0; y < height; y++)
+		{
+			uint32_t beginY = y * depthHeight / height;
+			uint32_t endY = std::max(((y + 1) * depthHeight + height - 1) / height, beginY + 1);
+
+			for (uint32_t x = 0; x < width; x++)
+			{
+				uint32_t beginX = x * depthWidth / width;
+				uint32_t endX = std::max(((x + 1) * depthWidth + width - 1) / width, beginX + 1);
+
+				float maxDepth = 0.f;
+				for (uint32_t sy = beginY; sy < std::min(endY, depthHeight); sy++)
+				{
+					for (uint32_t sx = beginX; sx < std::min(endX, depthWidth); sx++)
+						maxDepth = std::max(maxDepth, depth[sy * depthWidth + sx]);
+				}
+
+				out[y * width + x] = maxDepth;
+			}
+		}
+	}
+
+	void BuildHiZPyramid(const float* baseDepth, uint32_t width, uint32_t height, HiZPyramid& pyramid)
+	{
+		pyramid.Sizes.clear();
+		pyramid.Offsets.clear();
+
+		uint32_t total = 0;
+		for (glm::uvec2 size(width, height);; size = glm::uvec2((size.x + 1) / 2, (size.y + 1) / 2))
+		{
+			pyramid.Sizes.push_back(size);
+			pyramid.Offsets.push_back(total);
+			total += size.x * size.y;
+
+			if (size.x == 1 && size.y == 1)
+				break;
+		}
+
+		pyramid.Depth.resize(total);
+		std::copy(baseDepth, baseDepth + width * height, pyramid.Depth.begin());
+
+		for (uint32_t level = 1; level < pyramid.GetLevelCount(); level++)
+		{
+			glm::uvec2 src = pyramid.Sizes[level - 1];
+			glm::uvec2 dst = pyramid.Sizes[level];
+
+			for (uint32_t y = 0; y < dst.y; y++)
+			{
+				for (uint32_t x = 0; x < dst.x; x++)
+				{
+					uint32_t x1 = std::min(x * 2 + 1, src.x - 1);
+					uint32_t y1 = std::min(y * 2 + 1, src.y - 1);
+
+					float maxDepth = std::max(
+						std::max(pyramid.Load(level - 1, x * 2, y * 2), pyramid.Load(level - 1, x1, y * 2)),
+						std::max(pyramid.Load(level - 1, x * 2, y1), pyramid.Load(level - 1, x1, y1)));
+
+					pyramid.Depth[pyramid.Offsets[level] + y * dst.x + x] = maxDepth;
+				}
+			}
+		}
+	}
+
+	bool IsOccluded(const HiZPyramid& pyramid, const glm::mat4& viewProjection, const glm::vec4& worldSphere)
+	{
+		if (pyramid.GetLevelCount() == 0)
+			return false;
+
+		glm::vec3 center = glm::vec3(worldSphere);
+		float radius = worldSphere.w;
+
+		glm::vec2 ndcMin = glm::vec2(1.f);
+		glm::vec2 ndcMax = glm::vec2(-1.f);
+		float nearestDepth = 1.f;
+
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			glm::vec3 corner = center + glm::vec3(
+				(i & 1) ? radius : -radius,
+				(i & 2) ? radius : -radius,
+				(i & 4) ? radius : -radius);
+
+			glm::vec4 clip = viewProjection * glm::vec4(corner, 1.f);
+			if (clip.w <= 1e-5f)
+				return false;
+
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			ndcMin = glm::min(ndcMin, glm::vec2(ndc));
+			ndcMax = glm::max(ndcMax, glm::vec2(ndc));
+			nearestDepth = std::min(nearestDepth, ndc.z);
+		}
+
+		if (ndcMin.x < -1.f || ndcMin.y < -1.f || ndcMax.x > 1.f || ndcMax.y > 1.f)
+			return false;
+
+		// Viewports are flipped so ndc y = 1 is the top row
+		glm::uvec2 size = pyramid.Sizes[0];
+		uint32_t x0 = std::min(static_cast<uint32_t>((ndcMin.x * 0.5f + 0.5f) * size.x), size.x - 1);
+		uint32_t x1 = std::min(static_cast<uint32_t>((ndcMax.x * 0.5f + 0.5f) * size.x), size.x - 1);
+		uint32_t y0 = std::min(static_cast<uint32_t>((0.5f - ndcMax.y * 0.5f) * size.y), size.y - 1);
+		uint32_t y1 = std::min(static_cast<uint32_t>((0.5f - ndcMin.y * 0.5f) * size.y), size.y - 1);
+
+		// Coarsest level where the rectangle still touches at most 2x2 texels
+		uint32_t level = 0;
+		while (level + 1 < pyramid.GetLevelCount() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+			level++;
+
+		float maxDepth = 0.f;
+		for (uint32_t y = y0 >> level; y <= (y1 >> level); y++)
+		{
+			for (uint32_t x = x0 >> level; x <= (x1 >> level); x++)
+				maxDepth = std::max(maxDepth, pyramid.Load(level, x, y));
+		}
+
+		return nearestDepth > maxDepth;
+	}
+}
@@ -0,0 +1,47 @@
+#include "Graphics/Renderer/IndirectDrawList.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Mule
+{
+	void BuildIndirectDrawList(std::vector<IndirectDrawItem>& items, IndirectDrawList& drawList)
+	{
+		drawList.Clear();
+		AppendIndirectDrawList(items, drawList);
+	}
+
+	void AppendIndirectDrawList(std::vector<IndirectDrawItem>& items, IndirectDrawList& drawList)
+	{
+		size_t firstCommand = drawList.Commands.size();
+
+		std::sort(items.begin(), items.end(), [](const IndirectDrawItem& lhs, const IndirectDrawItem& rhs) {
+			if (lhs.Mesh.Get() != rhs.Mesh.Get())
+				return std::less<Mesh*>()(lhs.Mesh.Get(), rhs.Mesh.Get());
+
+			return lhs.FirstIndex < rhs.FirstIndex;
+			});
+
+		for (const IndirectDrawItem& item : items)
+		{
+			uint32_t instanceIndex = static_cast<uint32_t>(drawList.InstanceObjectIndices.size());
+			drawList.InstanceObjectIndices.push_back(item.ObjectIndex);
+
+			if (drawList.Meshes.size() > firstCommand && drawList.Meshes.back().Get() == item.Mesh.Get() && drawList.Commands.back().FirstIndex == item.FirstIndex)
+			{
+				drawList.Commands.back().InstanceCount++;
+				continue;
+			}
+
+			GPU::DrawIndexedIndirectCommand command{};
+			command.IndexCount = item.IndexCount;
+			command.InstanceCount = 1;
+			command.FirstIndex = item.FirstIndex;
+			command.VertexOffset = 0;
+			command.FirstInstance = instanceIndex;
+
+			drawList.Commands.push_back(command);
+			drawList.Meshes.push_back(item.Mesh);
+		}
+	}
+}
@@ -0,0 +1,208 @@
+#include "Graphics/Renderer/LightClusters.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Mule
+{
+	namespace
+	{
+		uint32_t GetDepthSlice(float depth, const GPU::LightClusterInfo& info)
+		{
+			float slice = std::log(std::max(depth, info.NearPlane)) * info.SliceScale - info.SliceBias;
+			return (uint32_t)std::clamp(slice, 0.f, (float)(LIGHT_CLUSTER_Z - 1));
+		}
+
+		// Returns false if the sphere does not overlap the view
+		bool GetClusterBounds(const glm::mat4& view, const glm::mat4& proj, const GPU::LightClusterInfo& info,
+			const glm::vec3& center, float radius, glm::uvec3& clusterMin, glm::uvec3& clusterMax)
+		{
+			if (radius <= 0.f)
+				return false;
+
+			glm::vec3 viewCenter = view * glm::vec4(center, 1.f);
+
+			// The camera looks down -Z
+			float minDepth = -viewCenter.z - radius;
+			float maxDepth = -viewCenter.z + radius;
+
+			if (maxDepth < info.NearPlane || minDepth > info.FarPlane)
+				return false;
+
+			clusterMin.z = GetDepthSlice(minDepth, info);
+			clusterMax.z = GetDepthSlice(maxDepth, info);
+
+			// Spheres crossing the near plane can't be projected, they cover the whole screen
+			if (minDepth <= info.NearPlane)
+			{
+				clusterMin.x = 0;
+				clusterMin.y = 0;
+				clusterMax.x = LIGHT_CLUSTER_X - 1;
+				clusterMax.y = LIGHT_CLUSTER_Y - 1;
+				return true;
+			}
+
+			// The projected corners of the spheres bounding box conservatively bound the sphere on screen
+			glm::vec2 ndcMin = glm::vec2(FLT_MAX);
+			glm::vec2 ndcMax = glm::vec2(-FLT_MAX);
+			for (uint32_t i = 0; i < 8; i++)
+			{
+				glm::vec3 corner = viewCenter + glm::vec3(
+					(i & 1) ? radius : -radius,
+					(i & 2) ? radius : -radius,
+					(i & 4) ? radius : -radius);
+
+				glm::vec4 clip = proj * glm::vec4(corner, 1.f);
+				glm::vec2 ndc = glm::vec2(clip) / clip.w;
+
+				ndcMin = glm::min(ndcMin, ndc);
+				ndcMax = glm::max(ndcMax, ndc);
+			}
+
+			if (ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f)
+				return false;
+
+			ndcMin = glm::clamp(ndcMin, glm::vec2(-1.f), glm::vec2(1.f));
+			ndcMax = glm::clamp(ndcMax, glm::vec2(-1.f), glm::vec2(1.f));
+
+			// Viewports are flipped so +Y in NDC is the top row of the image
+			float minX = (ndcMin.x * 0.5f + 0.5f) * LIGHT_CLUSTER_X;
+			float maxX = (ndcMax.x * 0.5f + 0.5f) * LIGHT_CLUSTER_X;
+			float minY = (0.5f - ndcMax.y * 0.5f) * LIGHT_CLUSTER_Y;
+			float maxY = (0.5f - ndcMin.y * 0.5f) * LIGHT_CLUSTER_Y;
+
+			clusterMin.x = std::min((uint32_t)minX, LIGHT_CLUSTER_X - 1);
+			clusterMax.x = std::min((uint32_t)maxX, LIGHT_CLUSTER_X - 1);
+			clusterMin.y = std::min((uint32_t)minY, LIGHT_CLUSTER_Y - 1);
+			clusterMax.y = std::min((uint32_t)maxY, LIGHT_CLUSTER_Y - 1);
+
+			return true;
+		}
+
+		// Tightest sphere around the lights cone, wide cones are bounded by their cap
+		void GetSpotLightBounds(const GPU::SpotLight& light, glm::vec3& center, float& radius)
+		{
+			float cosAngle = std::cos(light.HalfAngle);
+			glm::vec3 direction = glm::normalize(light.Direction);
+
+			if (light.HalfAngle > glm::quarter_pi<float>())
+			{
+				center = light.Position + direction * cosAngle * light.Range;
+				radius = std::sin(light.HalfAngle) * light.Range;
+			}
+			else
+			{
+				radius = light.Range / (2.f * cosAngle);
+				center = light.Position + direction * radius;
+			}
+		}
+
+		uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z)
+		{
+			return x + y * LIGHT_CLUSTER_X + z * LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y;
+		}
+
+		template<typename Func>
+		void ForEachCluster(const glm::uvec3& clusterMin, const glm::uvec3& clusterMax, Func&& func)
+		{
+			for (uint32_t z = clusterMin.z; z <= clusterMax.z; z++)
+				for (uint32_t y = clusterMin.y; y <= clusterMax.y; y++)
+					for (uint32_t x = clusterMin.x; x <= clusterMax.x; x++)
+						func(GetClusterIndex(x, y, z));
+		}
+	}
+
+	void BuildLightClusters(const glm::mat4& view, const glm::mat4& proj, float nearPlane, float farPlane,
+		const std::vector<GPU::PointLight>& pointLights,
+		const std::vector<GPU::SpotLight>& spotLights,
+		LightClusterList& clusterList)
+	{
+		GPU::LightClusterInfo& info = clusterList.Info;
+		info.GridSize = glm::uvec4(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y, LIGHT_CLUSTER_Z, LIGHT_CLUSTER_COUNT);
+		info.NearPlane = nearPlane;
+		info.FarPlane = farPlane;
+		info.SliceScale = (float)LIGHT_CLUSTER_Z / std::log(farPlane / nearPlane);
+		info.SliceBias = (float)LIGHT_CLUSTER_Z * std::log(nearPlane) / std::log(farPlane / nearPlane);
+
+		clusterList.Clusters.assign(LIGHT_CLUSTER_COUNT, GPU::LightCluster{});
+		clusterList.LightIndices.clear();
+
+		const uint32_t invalid = UINT32_MAX;
+
+		// Count the lights per cluster
+		clusterList.PointLightMin.resize(pointLights.size());
+		clusterList.PointLightMax.resize(pointLights.size());
+		for (uint32_t i = 0; i < pointLights.size(); i++)
+		{
+			const GPU::PointLight& light = pointLights[i];
+			glm::uvec3& clusterMin = clusterList.PointLightMin[i];
+			glm::uvec3& clusterMax = clusterList.PointLightMax[i];
+
+			if (!GetClusterBounds(view, proj, info, light.Position, light.Range, clusterMin, clusterMax))
+			{
+				clusterMin.x = invalid;
+				continue;
+			}
+
+			ForEachCluster(clusterMin, clusterMax, [&](uint32_t index) { clusterList.Clusters[index].PointLightCount++; });
+		}
+
+		clusterList.SpotLightMin.resize(spotLights.size());
+		clusterList.SpotLightMax.resize(spotLights.size());
+		for (uint32_t i = 0; i < spotLights.size(); i++)
+		{
+			glm::vec3 center;
+			float radius;
+			GetSpotLightBounds(spotLights[i], center, radius);
+
+			glm::uvec3& clusterMin = clusterList.SpotLightMin[i];
+			glm::uvec3& clusterMax = clusterList.SpotLightMax[i];
+
+			if (!GetClusterBounds(view, proj, info, center, radius, clusterMin, clusterMax))
+			{
+				clusterMin.x = invalid;
+				continue;
+			}
+
+			ForEachCluster(clusterMin, clusterMax, [&](uint32_t index) { clusterList.Clusters[index].SpotLightCount++; });
+		}
+
+		// Offsets, the counts are reused as write cursors and end up restored once every light is written.
+		// Point lights are written first so a clusters spot lights start after its final point light count
+		uint32_t offset = 0;
+		for (GPU::LightCluster& cluster : clusterList.Clusters)
+		{
+			cluster.Offset = offset;
+			offset += cluster.PointLightCount + cluster.SpotLightCount;
+			cluster.PointLightCount = 0;
+			cluster.SpotLightCount = 0;
+		}
+
+		clusterList.LightIndices.resize(offset);
+
+		for (uint32_t i = 0; i < pointLights.size(); i++)
+		{
+			if (clusterList.PointLightMin[i].x == invalid)
+				continue;
+
+			ForEachCluster(clusterList.PointLightMin[i], clusterList.PointLightMax[i], [&](uint32_t index) {
+				GPU::LightCluster& cluster = clusterList.Clusters[index];
+				clusterList.LightIndices[cluster.Offset + cluster.PointLightCount++] = i;
+				});
+		}
+
+		for (uint32_t i = 0; i < spotLights.size(); i++)
+		{
+			if (clusterList.SpotLightMin[i].x == invalid)
+				continue;
+
+			ForEachCluster(clusterList.SpotLightMin[i], clusterList.SpotLightMax[i], [&](uint32_t index) {
+				GPU::LightCluster& cluster = clusterList.Clusters[index];
+				clusterList.LightIndices[cluster.Offset + cluster.PointLightCount + cluster.SpotLightCount++] = i;
+				});
+		}
+	}
+}
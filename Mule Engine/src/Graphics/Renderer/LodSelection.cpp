@@ -0,0 +1,52 @@
+#include "Graphics/Renderer/LodSelection.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Mule
+{
+	constexpr float sLodBaseScreenSize = 0.5f;
+
+	float GetLodScreenSize(uint32_t lod)
+	{
+		if (lod == 0)
+			return INFINITY;
+
+		return sLodBaseScreenSize * std::ldexp(1.f, -static_cast<int>(lod - 1));
+	}
+
+	float ComputeScreenSize(const glm::vec4& worldSphere, const glm::vec3& cameraPosition, float projectionScale)
+	{
+		float distance = glm::length(glm::vec3(worldSphere) - cameraPosition);
+
+		// Inside the sphere, treat it as filling the screen
+		if (distance <= worldSphere.w)
+			return 1.f;
+
+		return worldSphere.w * std::abs(projectionScale) / distance;
+	}
+
+	uint32_t SelectLod(float screenSize, uint32_t lodCount, uint32_t previousLod, float hysteresis)
+	{
+		if (lodCount <= 1)
+			return 0;
+
+		uint32_t lod = 0;
+		if (previousLod < lodCount)
+		{
+			lod = previousLod;
+		}
+		else
+		{
+			hysteresis = 0.f;
+		}
+
+		while (lod + 1 < lodCount && screenSize < GetLodScreenSize(lod + 1) * (1.f - hysteresis))
+			lod++;
+
+		while (lod > 0 && screenSize > GetLodScreenSize(lod) * (1.f + hysteresis))
+			lod--;
+
+		return lod;
+	}
+}
@@ -0,0 +1,126 @@
+#include "Graphics/Renderer/ObjectTable.h"
+
+#include <assert.h>
+#include <cstring>
+
+namespace Mule
+{
+	ObjectTable::ObjectTable(uint32_t framesInFlight)
+		:
+		mFramesInFlight(framesInFlight)
+	{
+		assert(framesInFlight <= 8 && "Pending mask only supports 8 frames in flight");
+		mPendingUploads.resize(mFramesInFlight);
+	}
+
+	uint32_t ObjectTable::Update(const void* world, uint64_t objectId, const GPU::ObjectData& data)
+	{
+		std::unordered_map<uint64_t, uint32_t>& indices = mIndices[world];
+
+		auto iter = indices.find(objectId);
+		if (iter != indices.end())
+		{
+			uint32_t index = iter->second;
+			if (memcmp(&mObjects[index], &data, sizeof(GPU::ObjectData)) != 0)
+			{
+				memcpy(&mObjects[index], &data, sizeof(GPU::ObjectData));
+				MarkPending(index);
+			}
+			return index;
+		}
+
+		uint32_t index = 0;
+		if (!mFreeIndices.empty())
+		{
+			index = mFreeIndices.front();
+			mFreeIndices.pop();
+			memcpy(&mObjects[index], &data, sizeof(GPU::ObjectData));
+		}
+		else
+		{
+			index = static_cast<uint32_t>(mObjects.size());
+			mObjects.emplace_back();
+			memcpy(&mObjects[index], &data, sizeof(GPU::ObjectData));
+			mPendingMask.push_back(0);
+		}
+
+		indices[objectId] = index;
+		MarkPending(index);
+
+		return index;
+	}
+
+	void ObjectTable::Remove(const void* world, uint64_t objectId)
+	{
+		auto worldIter = mIndices.find(world);
+		if (worldIter == mIndices.end())
+			return;
+
+		auto iter = worldIter->second.find(objectId);
+		if (iter == worldIter->second.end())
+			return;
+
+		mFreeIndices.push(iter->second);
+		worldIter->second.erase(iter);
+	}
+
+	void ObjectTable::RemoveWorld(const void* world)
+	{
+		auto worldIter = mIndices.find(world);
+		if (worldIter == mIndices.end())
+			return;
+
+		for (const auto& [objectId, index] : worldIter->second)
+			mFreeIndices.push(index);
+
+		mIndices.erase(worldIter);
+	}
+
+	uint32_t ObjectTable::QueryIndex(const void* world, uint64_t objectId) const
+	{
+		auto worldIter = mIndices.find(world);
+		if (worldIter == mIndices.end())
+			return UINT32_MAX;
+
+		auto iter = worldIter->second.find(objectId);
+		if (iter == worldIter->second.end())
+			return UINT32_MAX;
+		return iter->second;
+	}
+
+	void ObjectTable::ClearPendingUploads(uint32_t frameIndex)
+	{
+		uint8_t bit = 1 << frameIndex;
+		for (uint32_t index : mPendingUploads[frameIndex])
+			mPendingMask[index] &= ~bit;
+
+		mPendingUploads[frameIndex].clear();
+	}
+
+	void ObjectTable::InvalidateFrame(uint32_t frameIndex)
+	{
+		uint8_t bit = 1 << frameIndex;
+		std::vector<uint32_t>& pending = mPendingUploads[frameIndex];
+		for (uint32_t i = 0; i < mObjects.size(); i++)
+		{
+			if ((mPendingMask[i] & bit) == 0)
+			{
+				mPendingMask[i] |= bit;
+				pending.push_back(i);
+			}
+		}
+	}
+
+	void ObjectTable::MarkPending(uint32_t index)
+	{
+		for (uint32_t i = 0; i < mFramesInFlight; i++)
+		{
+			uint8_t bit = 1 << i;
+			if (mPendingMask[index] & bit)
+				continue;
+
+			mPendingMask[index] |= bit;
+			mPendingUploads[i].push_back(index);
+		}
+	}
+}
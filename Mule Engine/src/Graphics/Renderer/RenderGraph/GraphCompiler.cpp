@@ -0,0 +1,134 @@
+#include "Graphics/Renderer/RenderGraph/GraphCompiler.h"
+
+#include <unordered_set>
+#include <queue>
+
+namespace Mule
+{
+	std::vector<uint32_t> SortPasses(const std::vector<PassDeclaration>& passes)
+	{
+		uint32_t passCount = passes.size();
+
+		// Nodes [0, passCount) are passes, the rest are resources in order of first use
+		std::unordered_map<ResourceHandle, uint32_t> resourceNodes;
+		std::vector<std::vector<uint32_t>> edges(passCount);
+
+		for (uint32_t i = 0; i < passCount; i++)
+		{
+			for (const auto& [handle, usage] : passes[i].Usage)
+			{
+				auto [iter, inserted] = resourceNodes.try_emplace(handle, passCount + resourceNodes.size());
+				if (inserted)
+					edges.emplace_back();
+
+				if (usage.Access == ResourceAccess::Write)
+					edges[i].push_back(iter->second);
+				else
+					edges[iter->second].push_back(i);
+			}
+
+			for (uint32_t dependency : passes[i].Dependencies)
+				edges[dependency].push_back(i);
+		}
+
+		std::vector<uint32_t> inDegree(edges.size(), 0);
+		for (const auto& nodeEdges : edges)
+		{
+			for (uint32_t to : nodeEdges)
+				inDegree[to]++;
+		}
+
+		// Lowest node first keeps independent passes in the order they were given
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+		for (uint32_t node = 0; node < edges.size(); node++)
+		{
+			if (inDegree[node] == 0)
+				ready.push(node);
+		}
+
+		std::vector<uint32_t> order;
+		order.reserve(passCount);
+
+		uint32_t visited = 0;
+		while (!ready.empty())
+		{
+			uint32_t node = ready.top();
+			ready.pop();
+			visited++;
+
+			if (node < passCount)
+				order.push_back(node);
+
+			for (uint32_t to : edges[node])
+			{
+				if (--inDegree[to] == 0)
+					ready.push(to);
+			}
+		}
+
+		if (visited != edges.size())
+			return {};
+
+		return order;
+	}
+
+	std::vector<bool> FindLivePasses(const std::vector<PassDeclaration>& passes, ResourceHandle outputHandle)
+	{
+		std::vector<bool> live(passes.size(), false);
+		std::vector<uint32_t> stack;
+
+		std::unordered_map<ResourceHandle, std::vector<uint32_t>> writers;
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			for (const auto& [handle, usage] : passes[i].Usage)
+			{
+				if (usage.Access == ResourceAccess::Write)
+					writers[handle].push_back(i);
+
+				if (handle == outputHandle && usage.Access == ResourceAccess::Write)
+					live[i] = true;
+			}
+
+			if (passes[i].SideEffects)
+				live[i] = true;
+
+			if (live[i])
+				stack.push_back(i);
+		}
+
+		// Writes count as uses too since passes draw on top of what earlier passes wrote. Every writer counts, not just the
+		// ones before the user, since a texture read before it is written carries over from the previous frame
+		std::unordered_set<ResourceHandle> visited;
+		auto markLive = [&](uint32_t pass) {
+			if (!live[pass])
+			{
+				live[pass] = true;
+				stack.push_back(pass);
+			}
+			};
+
+		while (!stack.empty())
+		{
+			uint32_t pass = stack.back();
+			stack.pop_back();
+
+			for (uint32_t dependency : passes[pass].Dependencies)
+				markLive(dependency);
+
+			for (const auto& [handle, usage] : passes[pass].Usage)
+			{
+				if (!visited.insert(handle).second)
+					continue;
+
+				auto iter = writers.find(handle);
+				if (iter == writers.end())
+					continue;
+
+				for (uint32_t writer : iter->second)
+					markLive(writer);
+			}
+		}
+
+		return live;
+	}
+}
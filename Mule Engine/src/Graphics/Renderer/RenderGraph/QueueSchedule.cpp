@@ -0,0 +1,225 @@
+#include "Graphics/Renderer/RenderGraph/QueueSchedule.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_set>
+
+namespace Mule
+{
+	static bool IsTexture(ResourceHandle handle)
+	{
+		return handle.Type == ResourceType::RenderTarget || handle.Type == ResourceType::DepthAttachment;
+	}
+
+	// Whether a pass that stays on the graphics queue can run alongside passIndex before the graphics queue has to wait for it.
+	// A later pass has to wait when it uses a texture the pass or one of its waiters used, since textures change owner between
+	// queues, or when either side writes a buffer they share. Shared passes do not count, they only run for the first view of
+	// a world
+	static bool HasGraphicsOverlap(const std::vector<QueueSchedulePass>& passes, uint32_t passIndex, const std::vector<bool>& movable)
+	{
+		std::vector<bool> waits(passes.size(), false);
+		waits[passIndex] = true;
+
+		std::unordered_set<ResourceHandle> usedTextures;
+		std::unordered_set<ResourceHandle> readBuffers;
+		std::unordered_set<ResourceHandle> writtenBuffers;
+
+		auto addUsage = [&](uint32_t pass) {
+			for (const auto& [handle, usage] : passes[pass].Usage)
+			{
+				if (IsTexture(handle))
+					usedTextures.insert(handle);
+				else if (usage.Access == ResourceAccess::Write)
+					writtenBuffers.insert(handle);
+				else
+					readBuffers.insert(handle);
+			}
+			};
+
+		addUsage(passIndex);
+
+		for (uint32_t i = passIndex + 1; i < passes.size(); i++)
+		{
+			bool wait = std::any_of(passes[i].Dependencies.begin(), passes[i].Dependencies.end(), [&](uint32_t dependency) { return waits[dependency]; });
+			for (const auto& [handle, usage] : passes[i].Usage)
+			{
+				if (wait)
+					break;
+
+				if (IsTexture(handle))
+					wait = usedTextures.contains(handle);
+				else
+					wait = writtenBuffers.contains(handle) || (usage.Access == ResourceAccess::Write && readBuffers.contains(handle));
+			}
+
+			// Nothing behind the first waiting pass on the graphics queue runs before the pass finishes
+			if (wait && !movable[i])
+				return false;
+
+			if (wait)
+			{
+				waits[i] = true;
+				addUsage(i);
+				continue;
+			}
+
+			if (!movable[i] && !passes[i].Shared)
+				return true;
+		}
+
+		return false;
+	}
+
+	std::vector<QueueType> AssignQueues(const std::vector<QueueSchedulePass>& passes, ResourceHandle outputHandle, bool asyncCompute)
+	{
+		std::vector<QueueType> queues(passes.size(), QueueType::Graphics);
+
+		if (!asyncCompute)
+			return queues;
+
+		std::unordered_set<ResourceHandle> usedTextures;
+		std::unordered_set<ResourceHandle> readFirstTextures;
+		std::unordered_set<ResourceHandle> sharedResources;
+
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			for (const auto& [handle, usage] : passes[i].Usage)
+			{
+				if (IsTexture(handle) && usedTextures.insert(handle).second && usage.Access != ResourceAccess::Write)
+					readFirstTextures.insert(handle);
+
+				if (passes[i].Shared && usage.Access == ResourceAccess::Write)
+					sharedResources.insert(handle);
+			}
+		}
+
+		std::vector<bool> movable(passes.size(), false);
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			if (passes[i].Type != PassType::Compute || passes[i].Shared)
+				continue;
+
+			bool pinned = std::any_of(passes[i].Usage.begin(), passes[i].Usage.end(), [&](const auto& entry) {
+				const auto& [handle, usage] = entry;
+				bool writesDepth = handle.Type == ResourceType::DepthAttachment && usage.Access == ResourceAccess::Write;
+				return writesDepth || handle == outputHandle || readFirstTextures.contains(handle) || sharedResources.contains(handle);
+				});
+
+			movable[i] = !pinned;
+		}
+
+		// Moving a pass costs the ownership transfers of its textures and a wait on the graphics queue, which only pays off
+		// if graphics work runs in the meantime
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			if (movable[i] && HasGraphicsOverlap(passes, i, movable))
+				queues[i] = QueueType::Compute;
+		}
+
+		return queues;
+	}
+
+	QueueSchedule ScheduleQueues(const std::vector<QueueSchedulePass>& passes)
+	{
+		QueueSchedule schedule;
+		schedule.Passes.resize(passes.size());
+
+		for (uint32_t i = 0; i < passes.size(); i++)
+			schedule.Passes[i].Queue = passes[i].Queue;
+
+		std::unordered_map<ResourceHandle, uint32_t> lastUsers;
+		std::unordered_map<ResourceHandle, uint32_t> lastWriters;
+
+		// Latest user of each buffer on each queue, a write has to wait on the reads of both queues since the last write
+		std::unordered_map<ResourceHandle, std::array<uint32_t, 2>> lastQueueUsers;
+
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			PassQueue& pass = schedule.Passes[i];
+
+			auto dependOn = [&](uint32_t other) {
+				if (schedule.Passes[other].Queue == pass.Queue)
+					return;
+
+				if (pass.WaitPass == UINT32_MAX || other > pass.WaitPass)
+					pass.WaitPass = other;
+				};
+
+			for (const auto& [handle, usage] : passes[i].Usage)
+			{
+				bool write = usage.Access == ResourceAccess::Write;
+
+				if (IsTexture(handle))
+				{
+					// Textures are exclusive to one queue family, every change of queue is an ownership transfer
+					auto lastUser = lastUsers.find(handle);
+					if (lastUser != lastUsers.end())
+					{
+						dependOn(lastUser->second);
+
+						if (schedule.Passes[lastUser->second].Queue != pass.Queue)
+							schedule.Transfers.push_back({ handle, lastUser->second, i });
+					}
+				}
+				else
+				{
+					// Buffers are shared by both queues, reads only wait on writes and writes on every earlier use
+					if (write)
+					{
+						auto iter = lastQueueUsers.find(handle);
+						if (iter != lastQueueUsers.end())
+						{
+							for (uint32_t user : iter->second)
+							{
+								if (user != UINT32_MAX)
+									dependOn(user);
+							}
+						}
+					}
+					else
+					{
+						auto iter = lastWriters.find(handle);
+						if (iter != lastWriters.end())
+							dependOn(iter->second);
+					}
+
+					auto [users, inserted] = lastQueueUsers.try_emplace(handle, std::array<uint32_t, 2>{ UINT32_MAX, UINT32_MAX });
+					users->second[static_cast<uint32_t>(pass.Queue)] = i;
+				}
+
+				lastUsers[handle] = i;
+				if (write)
+					lastWriters[handle] = i;
+			}
+
+			for (uint32_t dependency : passes[i].Dependencies)
+				dependOn(dependency);
+		}
+
+		// Usage maps are unordered, names keep transfers into the same pass in a stable order
+		std::sort(schedule.Transfers.begin(), schedule.Transfers.end(), [](const QueueTransfer& lhs, const QueueTransfer& rhs) {
+			if (lhs.AcquirePass != rhs.AcquirePass)
+				return lhs.AcquirePass < rhs.AcquirePass;
+			return lhs.Handle.Name < rhs.Handle.Name;
+			});
+
+		return schedule;
+	}
+
+	QueueSubmission BuildQueueSubmission(const QueueSchedule& schedule, uint32_t passIndex, Ref<CommandBuffer> commandBuffer, QueueTimeline& timeline)
+	{
+		const PassQueue& passQueue = schedule.Passes[passIndex];
+		uint32_t queue = static_cast<uint32_t>(passQueue.Queue);
+
+		QueueSubmission submission;
+		submission.CommandBuffer = commandBuffer;
+		submission.Waits.push_back({ timeline.Semaphores[queue], timeline.Values[queue] });
+		if (passQueue.WaitPass != UINT32_MAX)
+			submission.Waits.push_back({ timeline.Semaphores[1 - queue], timeline.PassValues[passQueue.WaitPass] });
+
+		submission.Signal = { timeline.Semaphores[queue], ++timeline.Values[queue] };
+		timeline.PassValues[passIndex] = timeline.Values[queue];
+
+		return submission;
+	}
+}
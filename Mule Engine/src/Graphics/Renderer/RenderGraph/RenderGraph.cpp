@@ -1,7 +1,9 @@
 #include "Graphics/Renderer/RenderGraph/RenderGraph.h"
 #include "Graphics/Renderer/RenderGraph/RenderPass.h"
+#include "Graphics/Renderer/RenderGraph/GraphCompiler.h"
 
 #include "Graphics/Renderer/Renderer.h"
+#include "Graphics/API/GraphicsContext.h"
 
 #include "ECS/Scene.h"
 
@@ -11,6 +13,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
 
 namespace Mule
 {
@@ -19,6 +22,9 @@ namespace Mule
 		mIsBaked(false)
 	{
 		mQueue = GraphicsQueue::Create();
+
+		if (GraphicsContext::Get().SupportsAsyncCompute())
+			mComputeQueue = GraphicsQueue::Create(QueueType::Compute);
 	}
 
 	RenderGraph::~RenderGraph()
@@ -30,136 +36,483 @@ namespace Mule
 	{
 		assert(mIsBaked && "Render Graph must be baked before calling InitializeRegistry()");
 
+		// Set first so the output is never aliased
+		registry.SetOutputHandle(mOutputHandle);
+
 		for (auto pass : mPasses)
 		{
 			pass->InitRegistry(registry);
 		}
 
-		if (mSetupCallback)
+		for (uint32_t i = 0; i < registry.GetFramesInFlight(); i++)
 		{
-			for (uint32_t i = 0; i < registry.GetFramesInFlight(); i++)
-			{
+			AliasTransientResources(registry, i);
+
+			if (mSetupCallback)
 				mSetupCallback(registry, i);
-			}
 		}
+
+		SPDLOG_INFO("Transient aliasing saved {:.2f}MB", registry.GetAliasedMemorySaved() / (1024.0 * 1024.0));
 	}
 
-	// TODO: currently were clearing render targets every time there written to, we only want to do this once when its first written to
-	void RenderGraph::Bake()
+	void RenderGraph::AliasTransientResources(ResourceRegistry& registry, uint32_t frameIndex)
 	{
-		std::vector<Ref<RenderPass>> passesToCompile = mPasses;
-		mPasses.clear();
-		
-		// List of Edges (A -> B)
-		std::vector<std::pair<uint32_t, uint32_t>> edges;
-		std::unordered_map<uint32_t, std::vector<uint32_t>> graph;
-		std::unordered_map<uint32_t, uint32_t> inDegree;
-		std::unordered_set<uint32_t> nodes;
-		std::unordered_map<std::string, uint32_t> namedIndices;
+		std::vector<ResourceLifetime> transients;
+		std::vector<uint64_t> sizes;
+		std::vector<Ref<Texture>> textures;
 
-		for (uint32_t i = 0; i < passesToCompile.size(); i++) {
-			nodes.insert(i);
-			if (inDegree.find(i) == inDegree.end())
-				inDegree[i] = 0;
+		for (const auto& lifetime : mResourceLifetimes)
+		{
+			bool isTexture = lifetime.Handle.Type == ResourceType::RenderTarget || lifetime.Handle.Type == ResourceType::DepthAttachment;
+			if (!isTexture || !lifetime.WrittenFirst || lifetime.Handle == registry.GetColorOutputHandle() || mSharedResources.contains(lifetime.Handle))
+				continue;
 
-			namedIndices[passesToCompile[i]->GetName()] = i;
+			bool usedOnCompute = false;
+			for (uint32_t pass = lifetime.FirstPass; pass <= lifetime.LastPass; pass++)
+			{
+				if (mPasses[pass]->GetQueue() == QueueType::Compute && mPasses[pass]->GetResourceUsage().contains(lifetime.Handle))
+					usedOnCompute = true;
+			}
+
+			if (usedOnCompute)
+				continue;
+
+			Ref<Texture> texture = registry.GetResource<Texture>(lifetime.Handle, frameIndex);
+			if (texture->GetMemorySize() == 0)
+				continue;
+
+			transients.push_back(lifetime);
+			sizes.push_back(texture->GetMemorySize());
+			textures.push_back(texture);
 		}
 
-		// Build Dependency Graph
-		for (uint32_t i = 0; i < passesToCompile.size() - 1; i++)
+		uint64_t saved = 0;
+		std::unordered_map<ResourceHandle, uint32_t> groups;
+		uint32_t groupCount = 0;
+
+		for (const auto& slot : AssignAliasSlots(transients, sizes))
 		{
-			for (uint32_t j = i + 1; j < passesToCompile.size(); j++)
+			Ref<Texture> owner = textures[slot.Members[0]];
+			owner->AliasMemory(nullptr);
+
+			for (uint32_t i = 1; i < slot.Members.size(); i++)
 			{
-				auto passA = passesToCompile[i];
-				auto passB = passesToCompile[j];
+				uint32_t member = slot.Members[i];
+				if (!textures[member]->AliasMemory(owner))
+					continue;
+
+				saved += sizes[member];
+				groups[transients[member].Handle] = groupCount;
+				groups[transients[slot.Members[0]].Handle] = groupCount;
+			}
+
+			if (groups.contains(transients[slot.Members[0]].Handle))
+				groupCount++;
+		}
+
+		registry.SetAliasedMemorySaved(frameIndex, saved);
+		registry.SetAliasGroups(frameIndex, std::move(groups));
+	}
 
-				auto depsA = passA->GetResourceUsage();
-				auto depsB = passB->GetResourceUsage();
+	void RenderGraph::Bake()
+	{
+		// Passes created since the last sort need a new order, enabling or disabling passes keeps the current one valid
+		if (mSortedPassCount != mPasses.size())
+		{
+			std::unordered_map<std::string, uint32_t> namedIndices;
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+				namedIndices[mPasses[i]->GetName()] = i;
 
+			std::vector<PassDeclaration> declarations(mPasses.size());
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+			{
+				declarations[i].Usage = mPasses[i]->GetResourceUsage();
 
-				for (auto resA : depsA)
+				for (const auto& dependency : mPasses[i]->GetDependencies())
 				{
-					for (auto resB : depsB)
-					{
-						ResourceHandle resAHandle = resA.first;
-						ResourceHandle resBHandle = resB.first;
+					assert(namedIndices.find(dependency) != namedIndices.end() && "Dependency does not exist");
+					declarations[i].Dependencies.push_back(namedIndices[dependency]);
+				}
+			}
 
-						ResourceAccess resAAccess = resA.second.Access;
-						ResourceAccess resBAccess = resB.second.Access;
+			std::vector<uint32_t> order = SortPasses(declarations);
+			if (order.size() != mPasses.size())
+			{
+				SPDLOG_ERROR("failed to compiled graph, cycle detected");
+				return;
+			}
 
-						if (resAHandle != resBHandle)
-							continue;
+			std::vector<Ref<RenderPass>> sortedPasses;
+			std::vector<uint32_t> executionIndices(mPasses.size());
+			for (uint32_t i = 0; i < order.size(); i++)
+			{
+				sortedPasses.push_back(mPasses[order[i]]);
+				executionIndices[order[i]] = i;
+			}
 
-						if (resAAccess == ResourceAccess::Read && resBAccess == ResourceAccess::Write)
-						{
-							edges.push_back({ j, i });
-						}
-						else if (resAAccess == ResourceAccess::Write && resBAccess == ResourceAccess::Read)
-						{
-							edges.push_back({ i, j });
-						}
-					}
+			mPasses = std::move(sortedPasses);
+			mSortedPassCount = mPasses.size();
+
+			mDependencies.assign(mPasses.size(), {});
+			for (uint32_t i = 0; i < order.size(); i++)
+			{
+				for (uint32_t dependency : declarations[order[i]].Dependencies)
+					mDependencies[i].push_back(executionIndices[dependency]);
+			}
+
+			// Lifetimes and queues cover disabled passes too, so toggling a pass never changes what registries were set up with
+			std::vector<std::unordered_map<ResourceHandle, ResourceUsage>> passUsage;
+			for (auto pass : mPasses)
+				passUsage.push_back(pass->GetResourceUsage());
+
+			mResourceLifetimes = ComputeResourceLifetimes(passUsage);
+
+			mLifetimeIndices.clear();
+			for (uint32_t i = 0; i < mResourceLifetimes.size(); i++)
+				mLifetimeIndices[mResourceLifetimes[i].Handle] = i;
+
+			// Shared writes keep their lifetimes, the first view of a world culls and clears them like any other texture
+			mSharedResources.clear();
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+			{
+				if (!mPasses[i]->IsShared())
+					continue;
+
+				for (const auto& [handle, usage] : passUsage[i])
+				{
+					if (usage.Access == ResourceAccess::Write)
+						mSharedResources.insert(handle);
 				}
 			}
+
+			for (const auto& handle : mPersistentResources)
+			{
+				auto iter = mLifetimeIndices.find(handle);
+				if (iter != mLifetimeIndices.end())
+					mResourceLifetimes[iter->second].WrittenFirst = false;
+			}
+
+			std::vector<QueueSchedulePass> schedulePasses(mPasses.size());
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+			{
+				schedulePasses[i].Type = mPasses[i]->GetPassType();
+				schedulePasses[i].Shared = mPasses[i]->IsShared();
+				schedulePasses[i].Usage = passUsage[i];
+			}
+
+			std::vector<QueueType> queues = AssignQueues(schedulePasses, mOutputHandle, mComputeQueue != nullptr);
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+			{
+				mPasses[i]->SetQueue(queues[i]);
+				if (queues[i] == QueueType::Compute)
+					SPDLOG_INFO("{} runs on the async compute queue", mPasses[i]->GetName());
+			}
+
+			// Passes that consume commands are culled on frames where they have none, each gets a bit of the plan key
+			mCullBits.assign(mPasses.size(), UINT32_MAX);
+			mCullBitCount = 0;
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+			{
+				if (mPasses[i]->ConsumesCommands())
+					mCullBits[i] = mCullBitCount++;
+			}
+
+			SPDLOG_INFO("RenderGraph Compiled");
 		}
 
-		for (auto pass : passesToCompile)
+		// Disabled passes are left out entirely, so nothing keeps the passes feeding them alive
+		std::vector<PassDeclaration> declarations(mPasses.size());
+		for (uint32_t i = 0; i < mPasses.size(); i++)
 		{
-			uint32_t to = namedIndices[pass->GetName()];
-			for (auto dep : pass->GetDependencies())
-			{
-				assert(namedIndices.find(dep) != namedIndices.end() && "Dependency does not exist");
-				uint32_t from = namedIndices[dep];
+			if (!mPasses[i]->IsEnabled())
+				continue;
 
-				edges.push_back({ from, to });
+			declarations[i].Usage = mPasses[i]->GetResourceUsage();
+			declarations[i].SideEffects = mPasses[i]->HasSideEffects();
+
+			for (uint32_t dependency : mDependencies[i])
+			{
+				if (mPasses[dependency]->IsEnabled())
+					declarations[i].Dependencies.push_back(dependency);
 			}
 		}
 
-		for (const auto& edge : edges) {
-			uint32_t from = edge.first;
-			uint32_t to = edge.second;
-			graph[from].push_back(to);
-			inDegree[to]++;
-			nodes.insert(from);
-			nodes.insert(to);
+		std::vector<bool> live = FindLivePasses(declarations, mOutputHandle);
+
+		mRunnable.assign(mPasses.size(), false);
+		for (uint32_t i = 0; i < mPasses.size(); i++)
+		{
+			mRunnable[i] = live[i] && mPasses[i]->IsEnabled();
+
+			if (mPasses[i]->IsEnabled() && !live[i])
+				SPDLOG_INFO("{} culled, nothing it writes reaches the output", mPasses[i]->GetName());
 		}
 
-		std::queue<uint32_t> q;
-		for (uint32_t node : nodes) {
-			if (inDegree[node] == 0) {
-				q.push(node);
+		mPlans.clear();
+		FindOrBuildPlan({ std::vector<bool>(mCullBitCount, false), false });
+
+		mIsBaked = true;
+		mNeedsRebake = false;
+	}
+
+	void RenderGraph::SetPassEnabled(WeakRef<RenderPass> pass, bool enabled)
+	{
+		if (pass->IsEnabled() == enabled)
+			return;
+
+		pass->SetEnabled(enabled);
+		mNeedsRebake = true;
+	}
+
+	bool RenderGraph::CanCullPass(uint32_t passIndex, const std::vector<bool>& running) const
+	{
+		for (const auto& [handle, usage] : mPasses[passIndex]->GetResourceUsage())
+		{
+			if (usage.Access != ResourceAccess::Write)
+				continue;
+
+			// Readers of a persistent texture get what was last written into it either way
+			if (mPersistentResources.contains(handle))
+				continue;
+
+			bool isTexture = handle.Type == ResourceType::RenderTarget || handle.Type == ResourceType::DepthAttachment;
+			const ResourceLifetime& lifetime = mResourceLifetimes[mLifetimeIndices.at(handle)];
+
+			// Whatever the pass would have written into a buffer or a texture kept from the last frame is still read
+			if (!isTexture || !lifetime.WrittenFirst)
+			{
+				for (uint32_t i = lifetime.FirstPass; i <= lifetime.LastPass; i++)
+				{
+					if (i != passIndex && running[i] && mPasses[i]->GetResourceUsage().contains(handle))
+						return false;
+				}
+
+				continue;
+			}
+
+			bool writtenBefore = false;
+			for (uint32_t i = lifetime.FirstPass; i < passIndex; i++)
+			{
+				auto iter = mPasses[i]->GetResourceUsage().find(handle);
+				if (running[i] && iter != mPasses[i]->GetResourceUsage().end() && iter->second.Access == ResourceAccess::Write)
+					writtenBefore = true;
+			}
+
+			if (writtenBefore)
+				continue;
+
+			// The next pass to use the texture clears it instead, a reader does so with a transfer clear which only the
+			// graphics queue can do for depth, so compute queue readers keep the pass running
+			for (uint32_t i = passIndex + 1; i <= lifetime.LastPass; i++)
+			{
+				auto iter = mPasses[i]->GetResourceUsage().find(handle);
+				if (!running[i] || iter == mPasses[i]->GetResourceUsage().end())
+					continue;
+
+				if (iter->second.Access != ResourceAccess::Write && mPasses[i]->GetQueue() != QueueType::Graphics)
+					return false;
+
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	const RenderGraph::ExecutionPlan& RenderGraph::FindOrBuildPlan(const PlanKey& key)
+	{
+		auto planIter = mPlans.find(key);
+		if (planIter == mPlans.end())
+		{
+			if (mPlans.size() >= sMaxCachedPlans)
+			{
+				auto leastRecent = std::min_element(mPlans.begin(), mPlans.end(), [](const auto& lhs, const auto& rhs) {
+					return lhs.second.LastUse < rhs.second.LastUse;
+					});
+				mPlans.erase(leastRecent);
 			}
+
+			planIter = mPlans.emplace(key, CachedPlan{ BuildPlan(key), 0 }).first;
 		}
 
-		while (!q.empty()) {
-			uint32_t current = q.front();
-			q.pop();
-			mPasses.push_back(passesToCompile[current]);
+		planIter->second.LastUse = ++mPlanUseCount;
+		return planIter->second.Plan;
+	}
+
+	RenderGraph::ExecutionPlan RenderGraph::BuildPlan(const PlanKey& key) const
+	{
+		bool skipShared = key.SkipShared;
 
-			for (uint32_t neighbor : graph[current]) {
-				inDegree[neighbor]--;
-				if (inDegree[neighbor] == 0) {
-					q.push(neighbor);
+		std::vector<bool> running = mRunnable;
+		for (uint32_t i = 0; i < mPasses.size(); i++)
+		{
+			if (mCullBits[i] < key.Culled.size() && key.Culled[mCullBits[i]])
+				running[i] = false;
+
+			if (skipShared && mPasses[i]->IsShared())
+				running[i] = false;
+		}
+
+		// Keeping a pass running can take away what let another one be culled, so repeat until nothing changes.
+		// Skipped shared passes already ran for an earlier view
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (uint32_t i = 0; i < mPasses.size(); i++)
+			{
+				if (skipShared && mPasses[i]->IsShared())
+					continue;
+
+				if (mRunnable[i] && !running[i] && !CanCullPass(i, running))
+				{
+					running[i] = true;
+					changed = true;
 				}
 			}
 		}
 
-		if (mPasses.size() != nodes.size()) {
-			SPDLOG_ERROR("failed to compiled graph, cycle detected");
-			return;
+		ExecutionPlan plan;
+
+		std::vector<uint32_t> planIndices(mPasses.size(), UINT32_MAX);
+		for (uint32_t i = 0; i < mPasses.size(); i++)
+		{
+			if (!running[i])
+				continue;
+
+			planIndices[i] = plan.Passes.size();
+			plan.Passes.push_back(i);
 		}
 
-		SPDLOG_INFO("RenderGraph Compiled");
+		plan.Commands.resize(plan.Passes.size());
 
-		std::unordered_set<ResourceHandle> frameBufferClears;
+		std::unordered_set<ResourceHandle> writtenFirst;
+		for (const auto& lifetime : mResourceLifetimes)
+		{
+			if (lifetime.WrittenFirst)
+				writtenFirst.insert(lifetime.Handle);
+		}
 
-		std::unordered_set<ResourceHandle> clearedRenderTargets;
+		// Later views of a world read what its first view left in the shared resources, they are neither cleared nor discarded
+		if (skipShared)
+		{
+			for (const auto& handle : mSharedResources)
+				writtenFirst.erase(handle);
+		}
 
-		for (auto pass : mPasses)
+		// Textures whose first writer was culled are cleared by the first pass reading them, the schedule treats that as a write
+		std::vector<std::unordered_set<ResourceHandle>> readerClears(plan.Passes.size());
+		std::vector<QueueSchedulePass> schedulePasses(plan.Passes.size());
 		{
+			std::unordered_set<ResourceHandle> written;
+			for (uint32_t passIndex = 0; passIndex < plan.Passes.size(); passIndex++)
+			{
+				uint32_t graphIndex = plan.Passes[passIndex];
+				QueueSchedulePass& schedulePass = schedulePasses[passIndex];
+				schedulePass.Type = mPasses[graphIndex]->GetPassType();
+				schedulePass.Queue = mPasses[graphIndex]->GetQueue();
+				schedulePass.Usage = mPasses[graphIndex]->GetResourceUsage();
+
+				for (uint32_t dependency : mDependencies[graphIndex])
+				{
+					if (planIndices[dependency] != UINT32_MAX)
+						schedulePass.Dependencies.push_back(planIndices[dependency]);
+				}
+
+				for (auto& [handle, usage] : schedulePass.Usage)
+				{
+					bool isTexture = handle.Type == ResourceType::RenderTarget || handle.Type == ResourceType::DepthAttachment;
+					if (!isTexture)
+						continue;
+
+					if (usage.Access != ResourceAccess::Write && writtenFirst.contains(handle) && !written.contains(handle))
+					{
+						readerClears[passIndex].insert(handle);
+						usage.Access = ResourceAccess::Write;
+					}
+
+					written.insert(handle);
+				}
+			}
+		}
+
+		plan.Schedule = ScheduleQueues(schedulePasses);
+
+		// Textures each pass acquires from the other queue, keyed to the pass releasing them
+		std::vector<std::unordered_map<ResourceHandle, uint32_t>> acquires(plan.Passes.size());
+		std::vector<std::vector<LayoutTransition>> releases(plan.Passes.size());
+
+		for (const auto& transfer : plan.Schedule.Transfers)
+			acquires[transfer.AcquirePass][transfer.Handle] = transfer.ReleasePass;
+
+		// Persistent textures are never cleared, their first write loads the contents from the last Execute
+		std::unordered_set<ResourceHandle> clearedRenderTargets(mPersistentResources.begin(), mPersistentResources.end());
+
+		// Layout every texture is left in by the passes baked so far, first uses are always emitted since the
+		// layout a texture starts the frame in is only known at record time
+		std::unordered_map<ResourceHandle, ImageLayout> layouts;
+
+		// Transitions that belong to the boundary before the next pass
+		std::vector<LayoutTransition> pendingTransitions;
+
+		uint32_t outputLastPass = UINT32_MAX;
+		for (uint32_t passIndex = 0; passIndex < plan.Passes.size(); passIndex++)
+		{
+			if (mPasses[plan.Passes[passIndex]]->GetResourceUsage().contains(mOutputHandle))
+				outputLastPass = passIndex;
+		}
+
+		for (uint32_t passIndex = 0; passIndex < plan.Passes.size(); passIndex++)
+		{
+			Ref<RenderPass> pass = mPasses[plan.Passes[passIndex]];
+			PassCommands& commands = plan.Commands[passIndex];
+
 			std::vector<BeginRenderingCommandAttachment> colorAttachments;
 			BeginRenderingCommandAttachment depthAttachment;
 
+			std::vector<LayoutTransition> transitions = std::move(pendingTransitions);
+			pendingTransitions.clear();
+
+			std::vector<RenderCommand> clears;
+
+			auto transition = [&](ResourceHandle handle, ImageLayout layout, bool discard) {
+				// Textures kept across executes may still be read by work submitted before this, transitioning from their
+				// current layout makes that work finish before they are overwritten
+				discard = discard && writtenFirst.contains(handle);
+
+				// Discarded contents need no transfer, the first barrier on the new queue takes ownership from an undefined layout
+				auto acquire = acquires[passIndex].find(handle);
+				if (acquire != acquires[passIndex].end())
+				{
+					uint32_t releasePass = acquire->second;
+					acquires[passIndex].erase(acquire);
+
+					if (!discard)
+					{
+						LayoutTransition handoff{ handle, layout };
+						handoff.SrcQueue = plan.Schedule.Passes[releasePass].Queue;
+						handoff.DstQueue = plan.Schedule.Passes[passIndex].Queue;
+						handoff.OldLayout = layouts[handle];
+
+						handoff.Ownership = QueueOwnership::Release;
+						releases[releasePass].push_back(handoff);
+
+						handoff.Ownership = QueueOwnership::Acquire;
+						transitions.push_back(handoff);
+
+						layouts[handle] = layout;
+						return;
+					}
+				}
+
+				auto iter = layouts.find(handle);
+				if (!discard && iter != layouts.end() && iter->second == layout)
+					return;
+
+				layouts[handle] = layout;
+				transitions.push_back({ handle, layout, discard });
+				};
+
 			// Handle -> binding index
 			std::vector<std::pair<ResourceHandle, uint32_t>> SRGHandles;
 
@@ -174,8 +527,7 @@ namespace Mule
 					{
 						if (handle.Type == ResourceType::RenderTarget)
 						{
-							pass->AddPreDrawCommand(TransitionLayoutCommand(handle, ImageLayout::ColorAttachment));
-
+							// The first write clears, so the old contents can be discarded in case the memory is aliased
 							bool clear = false;
 							if (!clearedRenderTargets.contains(handle))
 							{
@@ -183,12 +535,12 @@ namespace Mule
 								clearedRenderTargets.insert(handle);
 							}
 
+							transition(handle, ImageLayout::ColorAttachment, clear);
+
 							colorAttachments.push_back({ handle, clear, usage.Index });
 						}
 						else if (handle.Type == ResourceType::DepthAttachment)
 						{
-							pass->AddPreDrawCommand(TransitionLayoutCommand(handle, ImageLayout::DepthAttachment));
-
 							bool clear = false;
 							if (!clearedRenderTargets.contains(handle))
 							{
@@ -196,6 +548,8 @@ namespace Mule
 								clearedRenderTargets.insert(handle);
 							}
 
+							transition(handle, ImageLayout::DepthAttachment, clear);
+
 							depthAttachment = { handle, clear };
 						}
 					}					
@@ -206,11 +560,12 @@ namespace Mule
 					{
 						if (handle.Type == ResourceType::RenderTarget || handle.Type == ResourceType::DepthAttachment)
 						{
-							pass->AddPreDrawCommand(TransitionLayoutCommand(handle, ImageLayout::General));
+							bool clear = !clearedRenderTargets.contains(handle);
+							transition(handle, ImageLayout::General, clear);
 
-							if (!clearedRenderTargets.contains(handle))
+							if (clear)
 							{
-								pass->AddPreDrawCommand(ClearRenderTargetCommand(handle));
+								clears.push_back(ClearRenderTargetCommand(handle));
 								clearedRenderTargets.insert(handle);
 							}
 						}
@@ -225,8 +580,53 @@ namespace Mule
 				if (access == ResourceAccess::Read)
 				{
 					if (handle.Type == ResourceType::RenderTarget || handle.Type == ResourceType::DepthAttachment)
-						pass->AddPreDrawCommand(TransitionLayoutCommand(handle, ImageLayout::ShaderReadOnly));
+					{
+						bool clear = readerClears[passIndex].contains(handle);
+						transition(handle, ImageLayout::ShaderReadOnly, clear);
+
+						if (clear)
+						{
+							clears.push_back(ClearRenderTargetCommand(handle));
+							clearedRenderTargets.insert(handle);
+						}
+					}
 				}
+				else if (access == ResourceAccess::DepthTest)
+				{
+					assert(passType == PassType::Graphics && handle.Type == ResourceType::DepthAttachment && "Only graphics passes can depth test against a depth attachment");
+
+					// Loaded and tested against, the pipeline leaves depth writes off
+					bool clear = readerClears[passIndex].contains(handle);
+					transition(handle, ImageLayout::DepthAttachment, clear);
+
+					if (clear)
+					{
+						clears.push_back(ClearRenderTargetCommand(handle));
+						clearedRenderTargets.insert(handle);
+					}
+
+					depthAttachment = { handle, false };
+				}
+			}
+
+			if (!transitions.empty())
+				commands.PreDraw.push_back(TransitionLayoutCommand(transitions));
+
+			for (const auto& clear : clears)
+				commands.PreDraw.push_back(clear);
+
+			// Whatever samples the output after the graph expects it to be shader read only. The transition is batched with the next
+			// pass unless that pass runs on the other queue, which does not own the output
+			if (passIndex == outputLastPass && layouts[mOutputHandle] != ImageLayout::ShaderReadOnly)
+			{
+				layouts[mOutputHandle] = ImageLayout::ShaderReadOnly;
+
+				bool lastPass = passIndex + 1 == plan.Passes.size();
+				bool nextOnSameQueue = !lastPass && plan.Schedule.Passes[passIndex + 1].Queue == plan.Schedule.Passes[passIndex].Queue;
+				if (nextOnSameQueue || lastPass)
+					pendingTransitions.push_back({ mOutputHandle, ImageLayout::ShaderReadOnly });
+				else
+					commands.PostDraw.push_back(TransitionLayoutCommand({ { mOutputHandle, ImageLayout::ShaderReadOnly } }));
 			}
 
 			std::sort(SRGHandles.begin(), SRGHandles.end(), [](const std::pair<ResourceHandle, uint32_t>& lhs, const std::pair<ResourceHandle, uint32_t>& rhs) {
@@ -243,35 +643,63 @@ namespace Mule
 					return lhs.index < rhs.index;
 					});
 
-				pass->AddPreDrawCommand(BeginRenderingCommand(
+				bool ranged = pass->IsRecordedInRanges();
+
+				commands.PreDraw.push_back(BeginRenderingCommand(
 					colorAttachments,
-					depthAttachment
+					depthAttachment,
+					ranged
 				));
 
-				pass->AddPreDrawCommand(BindGraphicsPipelineCommand(
-					pass->GetGraphicsPipeline(),
+				WeakRef<GraphicsPipeline> pipeline = pass->GetGraphicsPipeline();
+				bool depthPrimed = depthAttachment.AttachmentHandle && !depthAttachment.ClearOnLoad;
+				if (depthPrimed && pass->GetPrimedDepthPipeline())
+					pipeline = pass->GetPrimedDepthPipeline();
+
+				BindGraphicsPipelineCommand bindPipeline(
+					pipeline,
 					SRGHandlesSorted
-				));
+				);
+
+				if (ranged)
+					commands.Range.push_back(bindPipeline);
+				else
+					commands.PreDraw.push_back(bindPipeline);
 
-				pass->AddPostDrawCommand(EndRenderingCommand());
+				commands.PostDraw.push_back(EndRenderingCommand());
 			}
 			else if (passType == PassType::Compute)
 			{
-				pass->AddPreDrawCommand(BindComputePipelineCommand(
+				assert(!pass->IsRecordedInRanges() && "Only graphics passes can be recorded in draw ranges");
+
+				commands.PreDraw.push_back(BindComputePipelineCommand(
 					pass->GetComputePipeline(),
 					SRGHandlesSorted
 				));
 			}
 		}
 
-		mIsBaked = true;
+		if (!pendingTransitions.empty())
+			plan.Commands.back().PostDraw.push_back(TransitionLayoutCommand(pendingTransitions));
+
+		// Releases go after everything the pass records, by the time the acquiring pass is baked the release pass is long done
+		for (uint32_t i = 0; i < plan.Passes.size(); i++)
+		{
+			if (!releases[i].empty())
+				plan.Commands[i].PostDraw.push_back(TransitionLayoutCommand(releases[i]));
+		}
+
+		return plan;
 	}
 
-	void RenderGraph::Execute(const CommandList& commands, const Camera& camera, uint32_t frameIndex)
+	void RenderGraph::Execute(const CommandList& commands, const RenderView& view, uint32_t frameIndex, RenderStats* stats)
 	{
 		assert(mIsBaked && "Render Graph must be baked before calling Execute");
 
-		Ref<ResourceRegistry> registry = camera.GetRegistry();
+		if (mNeedsRebake)
+			Bake();
+
+		Ref<ResourceRegistry> registry = view.Registry;
 
 		if (!registry)
 		{
@@ -279,46 +707,407 @@ namespace Mule
 			return;
 		}
 
-		//registry->SetFrameIndex(frameIndex);
+		// The color output shown by tools is the one of the frame index rendered last
+		registry->SetFrameIndex(frameIndex);
+
+		bool runShared = mRunSharedPasses;
+		mRunSharedPasses = false;
 		
+		// A registry executed twice before a flush would otherwise wait below on values that were never submitted
+		if (std::find(mPendingRegistries.begin(), mPendingRegistries.end(), registry.Get()) != mPendingRegistries.end())
+			Flush();
+
+		// Command buffers, secondaries and timestamps of this frame index are reused below
+		registry->WaitForFrame(frameIndex);
 
-		Ref<TimelineSemaphore> semaphore = registry->GetSemaphore(frameIndex);
-		uint64_t semaphoreValue = semaphore->GetValue();
+		// Indexed by QueueType, each queue signals its own semaphore and waits on the other one where the schedule asks for it
+		QueueTimeline timeline;
+		timeline.Semaphores[0] = registry->GetSemaphore(frameIndex, QueueType::Graphics);
+		timeline.Semaphores[1] = registry->GetSemaphore(frameIndex, QueueType::Compute);
+		timeline.Values[0] = registry->GetSubmittedValue(frameIndex, QueueType::Graphics);
+		timeline.Values[1] = registry->GetSubmittedValue(frameIndex, QueueType::Compute);
 
 		if (registry->IsResizeRequested(frameIndex))
 		{
-			registry->WaitForFences(frameIndex);
-
 			auto [width, height] = registry->GetResizeDimensions(frameIndex);
+			auto [allocatedWidth, allocatedHeight] = registry->GetAllocatedDimensions(frameIndex);
+
+			// Textures only grow, rounded up so dragging a window larger does not reallocate on every step
+			if (width > allocatedWidth || height > allocatedHeight)
+			{
+				allocatedWidth = std::max(allocatedWidth, (width + sResizeGranularity - 1) / sResizeGranularity * sResizeGranularity);
+				allocatedHeight = std::max(allocatedHeight, (height + sResizeGranularity - 1) / sResizeGranularity * sResizeGranularity);
+
+				if (mResizeCallback)
+					mResizeCallback(view, frameIndex, allocatedWidth, allocatedHeight);
+
+				// Resizing gives every texture its own memory again, descriptors are rebound once they are aliased
+				AliasTransientResources(*registry, frameIndex);
 
-			if (mResizeCallback)
-				mResizeCallback(camera, frameIndex, width, height);
+				if (mSetupCallback)
+					mSetupCallback(*registry, frameIndex);
+
+				registry->SetAllocatedDimensions(frameIndex, allocatedWidth, allocatedHeight);
+			}
 
 			registry->SetResizeHandled(frameIndex);
 		}
 
+		registry->UpdateRenderExtent(frameIndex);
+
+		Timer timer;
+		timer.Start();
+
 		if (mPreExecutionCallback)
-			mPreExecutionCallback(camera, commands, frameIndex);
+			mPreExecutionCallback(view, commands, frameIndex, runShared);
+
+		timer.Stop();
+
+		if (stats)
+		{
+			stats->CPUPrepareTime += timer.Query();
+			stats->ViewCount++;
+			stats->AliasedMemorySaved += registry->GetAliasedMemorySaved();
+
+			if (stats->RenderPassStats.size() != mPasses.size())
+			{
+				stats->RenderPassStats.resize(mPasses.size());
+				for (uint32_t i = 0; i < mPasses.size(); i++)
+					stats->RenderPassStats[i].Name = mPasses[i]->GetName();
+			}
+		}
+
+		Timer executionTimer;
+		executionTimer.Start();
+
+		std::vector<std::vector<DrawRange>> passRanges(mPasses.size());
+		PlanKey planKey = { std::vector<bool>(mCullBitCount, false), !runShared };
 
 		for (uint32_t i = 0; i < mPasses.size(); i++)
 		{
-			Ref<RenderPass> pass = mPasses[i];
+			passRanges[i] = mPasses[i]->GetDrawRanges(commands);
+
+			if (mCullBits[i] == UINT32_MAX)
+				continue;
+
+			bool idle = mPasses[i]->IsRecordedInRanges() ? passRanges[i].empty() : !mPasses[i]->HasCommandsToRecord(commands);
+			planKey.Culled[mCullBits[i]] = idle;
+		}
+
+		// Each combination of idle passes is baked the first time it comes up and kept while it keeps coming up
+		const ExecutionPlan& plan = FindOrBuildPlan(planKey);
+		mLastPlanKey = std::move(planKey);
+
+		if (stats)
+			stats->CulledPasses += mPasses.size() - plan.Passes.size();
+
+		// Draw ranges of every pass are recorded in parallel into secondaries, the primaries are then recorded
+		// and queued in graph order since they carry the layout transitions which are tracked at record time
+		struct RangeJob
+		{
+			uint32_t PlanPass;
+			uint32_t Slot;
+			DrawRange Range;
+		};
+
+		std::vector<RangeJob> rangeJobs;
+
+		for (uint32_t i = 0; i < plan.Passes.size(); i++)
+		{
+			const std::vector<DrawRange>& ranges = passRanges[plan.Passes[i]];
+			for (uint32_t slot = 0; slot < ranges.size(); slot++)
+			{
+				rangeJobs.push_back({ i, slot, ranges[slot] });
+			}
+		}
 
-			Ref<CommandBuffer> commandBuffer = pass->Execute(commands, *registry, frameIndex);
-			Ref<Fence> fence = pass->GetFence(*registry, frameIndex);
+		auto recordRange = [&](uint32_t jobIndex) {
+			const RangeJob& job = rangeJobs[jobIndex];
+			mPasses[plan.Passes[job.PlanPass]]->RecordRange(commands, plan.Commands[job.PlanPass], *registry, frameIndex, job.Slot, job.Range);
+			};
 
-			if (i == mPasses.size() - 1)
+		if (mJobSystem && rangeJobs.size() > 1)
+		{
+			mJobSystem->ParallelFor(rangeJobs.size(), recordRange);
+		}
+		else
+		{
+			for (uint32_t i = 0; i < rangeJobs.size(); i++)
+				recordRange(i);
+		}
+
+		timeline.PassValues.assign(plan.Passes.size(), 0);
+
+		for (uint32_t i = 0; i < plan.Passes.size(); i++)
+		{
+			uint32_t graphIndex = plan.Passes[i];
+			Ref<RenderPass> pass = mPasses[graphIndex];
+
+			// Read before the pass records again, its query reset discards the timestamps of the last submission
+			if (stats)
 			{
-				auto renderTargetHandle = registry->GetColorOutputHandle();
-				auto renderTarget = registry->GetResource<Texture>(renderTargetHandle, frameIndex);
-				commandBuffer->TranistionImageLayout(renderTarget, ImageLayout::ShaderReadOnly);
+				stats->RenderPassStats[graphIndex].GPUExecutionTime += pass->GetGPUTime(*registry, frameIndex);
+				stats->RenderPassStats[graphIndex].AsyncCompute = pass->GetQueue() == QueueType::Compute;
 			}
 
+			timer.Start();
+			Ref<CommandBuffer> commandBuffer = pass->Execute(commands, plan.Commands[i], *registry, frameIndex, passRanges[graphIndex].size());
 			commandBuffer->End();
 
-			mQueue->Submit(commandBuffer, semaphore, semaphoreValue, semaphoreValue + 1u, fence);
-			semaphoreValue++;
+			timer.Stop();
+			if (stats)
+				stats->RenderPassStats[graphIndex].CPUExecutionTime += timer.Query();
+
+			// Each pass still waits on the one before it on its queue, only the driver call is shared
+			const PassQueue& passQueue = plan.Schedule.Passes[i];
+			QueueSubmission submission = BuildQueueSubmission(plan.Schedule, i, commandBuffer, timeline);
+
+			// Shared passes only run on the graphics queue, its first submission of a new world holds them back
+			if (passQueue.Queue == QueueType::Graphics && !mSharedResourceWaits.empty())
+			{
+				submission.Waits.insert(submission.Waits.end(), mSharedResourceWaits.begin(), mSharedResourceWaits.end());
+				mSharedResourceWaits.clear();
+			}
+
+			if (passQueue.Queue == QueueType::Compute)
+				mPendingComputeSubmissions.push_back(submission);
+			else
+				mPendingSubmissions.push_back(submission);
 		}
+
+		registry->SetSubmittedValue(frameIndex, QueueType::Graphics, timeline.Values[0]);
+		registry->SetSubmittedValue(frameIndex, QueueType::Compute, timeline.Values[1]);
+		mPendingRegistries.push_back(registry.Get());
+
+		// Any pass of the view may read the shared resources, so the next world waits for the last value of both queues
+		mSharedResourceUsers.push_back({ timeline.Semaphores[0], timeline.Values[0] });
+		mSharedResourceUsers.push_back({ timeline.Semaphores[1], timeline.Values[1] });
+
+		executionTimer.Stop();
+		if (stats)
+			stats->CPUExecutionTime += executionTimer.Query();
+	}
+
+	void RenderGraph::BeginFrame()
+	{
+		mRunSharedPasses = true;
+		mSharedResourceUsers.clear();
+		mSharedResourceWaits.clear();
+	}
+
+	void RenderGraph::BeginWorld()
+	{
+		mRunSharedPasses = true;
+		mSharedResourceWaits.insert(mSharedResourceWaits.end(), mSharedResourceUsers.begin(), mSharedResourceUsers.end());
+		mSharedResourceUsers.clear();
+	}
+
+	void RenderGraph::Flush()
+	{
+		mQueue->Submit(mPendingSubmissions);
+		mPendingSubmissions.clear();
+
+		// Timeline waits may be submitted before their signal, so the graphics batch can wait on compute work submitted after it
+		if (!mPendingComputeSubmissions.empty())
+		{
+			mComputeQueue->Submit(mPendingComputeSubmissions);
+			mPendingComputeSubmissions.clear();
+		}
+
+		mPendingRegistries.clear();
+	}
+
+	static const char* GetLayoutName(ImageLayout layout)
+	{
+		switch (layout)
+		{
+		case ImageLayout::TransferSrc: return "TransferSrc";
+		case ImageLayout::TransferDst: return "TransferDst";
+		case ImageLayout::ColorAttachment: return "ColorAttachment";
+		case ImageLayout::DepthAttachment: return "DepthAttachment";
+		case ImageLayout::ShaderReadOnly: return "ShaderReadOnly";
+		case ImageLayout::General: return "General";
+		default: return "Undefined";
+		}
+	}
+
+	static const char* GetResourceTypeName(ResourceType type)
+	{
+		switch (type)
+		{
+		case ResourceType::UniformBuffer: return "UniformBuffer";
+		case ResourceType::StorageBuffer: return "StorageBuffer";
+		case ResourceType::ShaderResourceGroup: return "ShaderResourceGroup";
+		case ResourceType::Texture: return "Texture";
+		case ResourceType::CommandBuffer: return "CommandBuffer";
+		case ResourceType::Fence: return "Fence";
+		case ResourceType::TimelineSemaphore: return "TimelineSemaphore";
+		case ResourceType::CommandAllocator: return "CommandAllocator";
+		case ResourceType::RenderTarget: return "RenderTarget";
+		case ResourceType::DepthAttachment: return "DepthAttachment";
+		case ResourceType::Sampler: return "Sampler";
+		case ResourceType::TimestampQueryPool: return "TimestampQueryPool";
+		default: return "Unknown";
+		}
+	}
+
+	RenderGraphDump RenderGraph::Dump(const RenderStats* stats, const ResourceRegistry* registry, uint32_t frameIndex) const
+	{
+		RenderGraphDump dump;
+
+		if (!mIsBaked)
+			return dump;
+
+		// Rebaking drops the cached plans, the last one is baked again rather than left out
+		ExecutionPlan rebuilt;
+		const ExecutionPlan* plan = nullptr;
+
+		auto planIter = mPlans.find(mLastPlanKey);
+		if (planIter != mPlans.end())
+		{
+			plan = &planIter->second.Plan;
+		}
+		else
+		{
+			rebuilt = BuildPlan(mLastPlanKey);
+			plan = &rebuilt;
+		}
+
+		bool hasTimings = stats && stats->RenderPassStats.size() == mPasses.size();
+
+		// Usage maps are unordered, sorting by name keeps dumps of the same graph identical
+		std::vector<std::vector<std::pair<ResourceHandle, ResourceUsage>>> passUsage(mPasses.size());
+
+		dump.Passes.resize(mPasses.size());
+		for (uint32_t i = 0; i < mPasses.size(); i++)
+		{
+			Ref<RenderPass> pass = mPasses[i];
+			DumpPass& passDump = dump.Passes[i];
+
+			passDump.Name = pass->GetName();
+			passDump.Type = pass->GetPassType() == PassType::Compute ? "Compute" : "Graphics";
+			passDump.Queue = pass->GetQueue() == QueueType::Compute ? "Compute" : "Graphics";
+			passDump.Enabled = pass->IsEnabled();
+			passDump.Shared = pass->IsShared();
+
+			if (hasTimings)
+			{
+				passDump.CPUTime = stats->RenderPassStats[i].CPUExecutionTime;
+				passDump.GPUTime = stats->RenderPassStats[i].GPUExecutionTime;
+			}
+
+			passUsage[i].assign(pass->GetResourceUsage().begin(), pass->GetResourceUsage().end());
+			std::sort(passUsage[i].begin(), passUsage[i].end(), [](const auto& lhs, const auto& rhs) {
+				return lhs.first.Name < rhs.first.Name;
+				});
+
+			for (const auto& [handle, usage] : passUsage[i])
+				passDump.Resources.push_back({ handle.Name, usage.Access == ResourceAccess::Write });
+		}
+
+		for (uint32_t planPass = 0; planPass < plan->Passes.size(); planPass++)
+		{
+			DumpPass& passDump = dump.Passes[plan->Passes[planPass]];
+			passDump.Running = true;
+
+			uint32_t waitPass = plan->Schedule.Passes[planPass].WaitPass;
+			if (waitPass != UINT32_MAX)
+				passDump.WaitPass = plan->Passes[waitPass];
+
+			auto addCommands = [&](const std::vector<RenderCommand>& commands, bool afterDraw) {
+				for (const auto& command : commands)
+				{
+					if (command.GetType() == RenderCommandType::TransitionLayout)
+					{
+						for (const auto& transition : command.GetCommand<TransitionLayoutCommand>().Transitions)
+						{
+							DumpBarrier barrier;
+							barrier.Resource = transition.TextureHandle.Name;
+							barrier.Layout = GetLayoutName(transition.NewLayout);
+							barrier.Discard = transition.Discard;
+							barrier.AfterDraw = afterDraw;
+
+							if (transition.Ownership == QueueOwnership::Release)
+								barrier.Ownership = "Release";
+							else if (transition.Ownership == QueueOwnership::Acquire)
+								barrier.Ownership = "Acquire";
+
+							passDump.Barriers.push_back(barrier);
+						}
+					}
+					else if (command.GetType() == RenderCommandType::ClearRenderTarget)
+					{
+						passDump.Clears.push_back(command.GetCommand<ClearRenderTargetCommand>().ClearTarget.Name);
+					}
+					else if (command.GetType() == RenderCommandType::BeginRendering)
+					{
+						const auto& beginRendering = command.GetCommand<BeginRenderingCommand>();
+						for (const auto& attachment : beginRendering.ColorAttachments)
+						{
+							if (attachment.ClearOnLoad)
+								passDump.Clears.push_back(attachment.AttachmentHandle.Name);
+						}
+
+						if (beginRendering.DepthAttachment.ClearOnLoad)
+							passDump.Clears.push_back(beginRendering.DepthAttachment.AttachmentHandle.Name);
+					}
+				}
+				};
+
+			addCommands(plan->Commands[planPass].PreDraw, false);
+			addCommands(plan->Commands[planPass].PostDraw, true);
+		}
+
+		// Every use waits on the last running pass that wrote the resource
+		std::unordered_map<ResourceHandle, uint32_t> lastWriters;
+		for (uint32_t graphIndex : plan->Passes)
+		{
+			for (const auto& [handle, usage] : passUsage[graphIndex])
+			{
+				auto writer = lastWriters.find(handle);
+				if (writer != lastWriters.end())
+					dump.Edges.push_back({ writer->second, graphIndex, handle.Name });
+			}
+
+			for (const auto& [handle, usage] : passUsage[graphIndex])
+			{
+				if (usage.Access == ResourceAccess::Write)
+					lastWriters[handle] = graphIndex;
+			}
+
+			for (uint32_t dependency : mDependencies[graphIndex])
+			{
+				if (dump.Passes[dependency].Running)
+					dump.Edges.push_back({ dependency, graphIndex, "" });
+			}
+		}
+
+		for (const auto& lifetime : mResourceLifetimes)
+		{
+			DumpResource resource;
+			resource.Name = lifetime.Handle.Name;
+			resource.Type = GetResourceTypeName(lifetime.Handle.Type);
+			resource.FirstPass = lifetime.FirstPass;
+			resource.LastPass = lifetime.LastPass;
+			resource.WrittenFirst = lifetime.WrittenFirst;
+
+			bool isTexture = lifetime.Handle.Type == ResourceType::RenderTarget || lifetime.Handle.Type == ResourceType::DepthAttachment;
+			if (registry && isTexture)
+			{
+				const auto& groups = registry->GetAliasGroups(frameIndex);
+				auto group = groups.find(lifetime.Handle);
+				if (group != groups.end())
+					resource.AliasGroup = group->second;
+
+				Ref<Texture> texture = registry->GetResource<Texture>(lifetime.Handle, frameIndex);
+				if (texture)
+					resource.Size = texture->GetMemorySize();
+			}
+
+			dump.Resources.push_back(resource);
+		}
+
+		return dump;
 	}
 
 	WeakRef<RenderPass> RenderGraph::CreatePass(const std::string& name, PassType type)
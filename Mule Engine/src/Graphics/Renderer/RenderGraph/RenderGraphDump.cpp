@@ -0,0 +1,178 @@
+#include "Graphics/Renderer/RenderGraph/RenderGraphDump.h"
+
+#include <format>
+#include <map>
+
+namespace Mule
+{
+	static std::string EscapeString(const std::string& str)
+	{
+		std::string escaped;
+		for (char c : str)
+		{
+			switch (c)
+			{
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+					escaped += std::format("\\u{:04x}", static_cast<uint32_t>(c));
+				else
+					escaped += c;
+				break;
+			}
+		}
+
+		return escaped;
+	}
+
+	static std::string Quote(const std::string& str)
+	{
+		return "\"" + EscapeString(str) + "\"";
+	}
+
+	static std::string Milliseconds(double seconds)
+	{
+		return std::format("{:.3f}", seconds * 1000.0);
+	}
+
+	std::string ToGraphviz(const RenderGraphDump& dump)
+	{
+		std::string dot = "digraph RenderGraph {\n\trankdir=LR;\n\tnode [shape=box, fontname=\"Helvetica\"];\n\n";
+
+		for (uint32_t i = 0; i < dump.Passes.size(); i++)
+		{
+			const DumpPass& pass = dump.Passes[i];
+
+			std::string label = std::format("{}\n{} on {} queue\nCPU {}ms GPU {}ms", pass.Name, pass.Type, pass.Queue, Milliseconds(pass.CPUTime), Milliseconds(pass.GPUTime));
+			for (const auto& barrier : pass.Barriers)
+			{
+				label += std::format("\n{} {} -> {}", barrier.AfterDraw ? "post" : "pre", barrier.Resource, barrier.Layout);
+				if (!barrier.Ownership.empty())
+					label += " (" + barrier.Ownership + ")";
+				if (barrier.Discard)
+					label += " discard";
+			}
+
+			for (const auto& clear : pass.Clears)
+				label += "\nclear " + clear;
+
+			std::string style = pass.Running ? "solid" : "dashed";
+			std::string color = pass.Queue == "Compute" ? "darkorange" : "black";
+			dot += std::format("\tpass{} [label={}, style={}, color={}];\n", i, Quote(label), style, color);
+		}
+
+		dot += "\n";
+
+		for (const auto& edge : dump.Edges)
+		{
+			if (edge.Resource.empty())
+				dot += std::format("\tpass{} -> pass{} [style=dashed];\n", edge.From, edge.To);
+			else
+				dot += std::format("\tpass{} -> pass{} [label={}];\n", edge.From, edge.To, Quote(edge.Resource));
+		}
+
+		for (uint32_t i = 0; i < dump.Passes.size(); i++)
+		{
+			uint32_t waitPass = dump.Passes[i].WaitPass;
+			if (waitPass != UINT32_MAX)
+				dot += std::format("\tpass{} -> pass{} [style=dotted, color=red, label=\"wait\"];\n", waitPass, i);
+		}
+
+		std::map<uint32_t, std::vector<std::string>> aliasGroups;
+		for (const auto& resource : dump.Resources)
+		{
+			if (resource.AliasGroup != UINT32_MAX)
+				aliasGroups[resource.AliasGroup].push_back(resource.Name);
+		}
+
+		for (const auto& [group, members] : aliasGroups)
+		{
+			std::string label = std::format("Alias group {}", group);
+			for (const auto& member : members)
+				label += "\n" + member;
+
+			dot += std::format("\talias{} [label={}, shape=note];\n", group, Quote(label));
+		}
+
+		dot += "}\n";
+		return dot;
+	}
+
+	std::string ToJson(const RenderGraphDump& dump)
+	{
+		std::string json = "{\n\t\"passes\": [";
+
+		for (uint32_t i = 0; i < dump.Passes.size(); i++)
+		{
+			const DumpPass& pass = dump.Passes[i];
+
+			json += i == 0 ? "\n" : ",\n";
+			json += std::format("\t\t{{ \"name\": {}, \"type\": {}, \"queue\": {}, \"enabled\": {}, \"shared\": {}, \"running\": {}, \"cpuMs\": {}, \"gpuMs\": {}",
+				Quote(pass.Name), Quote(pass.Type), Quote(pass.Queue), pass.Enabled, pass.Shared, pass.Running, Milliseconds(pass.CPUTime), Milliseconds(pass.GPUTime));
+
+			if (pass.WaitPass != UINT32_MAX)
+				json += std::format(", \"waitPass\": {}", pass.WaitPass);
+
+			json += ", \"resources\": [";
+			for (uint32_t j = 0; j < pass.Resources.size(); j++)
+			{
+				json += std::format("{}{{ \"name\": {}, \"access\": \"{}\" }}", j == 0 ? "" : ", ", Quote(pass.Resources[j].Name), pass.Resources[j].Write ? "write" : "read");
+			}
+
+			json += "], \"barriers\": [";
+			for (uint32_t j = 0; j < pass.Barriers.size(); j++)
+			{
+				const DumpBarrier& barrier = pass.Barriers[j];
+				json += std::format("{}{{ \"resource\": {}, \"layout\": {}, \"discard\": {}, \"afterDraw\": {}",
+					j == 0 ? "" : ", ", Quote(barrier.Resource), Quote(barrier.Layout), barrier.Discard, barrier.AfterDraw);
+
+				if (!barrier.Ownership.empty())
+					json += ", \"ownership\": " + Quote(barrier.Ownership);
+
+				json += " }";
+			}
+
+			json += "], \"clears\": [";
+			for (uint32_t j = 0; j < pass.Clears.size(); j++)
+				json += (j == 0 ? "" : ", ") + Quote(pass.Clears[j]);
+
+			json += "] }";
+		}
+
+		json += "\n\t],\n\t\"resources\": [";
+
+		for (uint32_t i = 0; i < dump.Resources.size(); i++)
+		{
+			const DumpResource& resource = dump.Resources[i];
+
+			json += i == 0 ? "\n" : ",\n";
+			json += std::format("\t\t{{ \"name\": {}, \"type\": {}, \"firstPass\": {}, \"lastPass\": {}, \"writtenFirst\": {}, \"size\": {}",
+				Quote(resource.Name), Quote(resource.Type), resource.FirstPass, resource.LastPass, resource.WrittenFirst, resource.Size);
+
+			if (resource.AliasGroup != UINT32_MAX)
+				json += std::format(", \"aliasGroup\": {}", resource.AliasGroup);
+
+			json += " }";
+		}
+
+		json += "\n\t],\n\t\"edges\": [";
+
+		for (uint32_t i = 0; i < dump.Edges.size(); i++)
+		{
+			const DumpEdge& edge = dump.Edges[i];
+
+			json += i == 0 ? "\n" : ",\n";
+			json += std::format("\t\t{{ \"from\": {}, \"to\": {}", edge.From, edge.To);
+			if (!edge.Resource.empty())
+				json += ", \"resource\": " + Quote(edge.Resource);
+
+			json += " }";
+		}
+
+		json += "\n\t]\n}\n";
+		return json;
+	}
+}
@@ -2,34 +2,63 @@
 #include "Graphics/Renderer/CommandExecutor.h"
 
 #include <assert.h>
+#include <algorithm>
 
 namespace Mule
 {
+	std::vector<DrawRange> SplitDrawRange(uint32_t drawCount, uint32_t minDrawsPerRange, uint32_t maxRanges)
+	{
+		std::vector<DrawRange> ranges;
+
+		if (drawCount == 0 || maxRanges == 0)
+			return ranges;
+
+		minDrawsPerRange = std::max(minDrawsPerRange, 1u);
+		uint32_t rangeCount = std::clamp(drawCount / minDrawsPerRange, 1u, maxRanges);
+
+		// Spread the remainder over the first ranges so no two ranges differ by more than one draw
+		uint32_t baseCount = drawCount / rangeCount;
+		uint32_t remainder = drawCount % rangeCount;
+
+		uint32_t first = 0;
+		for (uint32_t i = 0; i < rangeCount; i++)
+		{
+			uint32_t count = baseCount + (i < remainder ? 1 : 0);
+			ranges.push_back({ first, count });
+			first += count;
+		}
+
+		return ranges;
+	}
+
 	RenderPass::RenderPass(const std::string& name, PassType type)
 		:
 		mName(name),
 		mPassType(type)
 	{
-		mFenceName = name + ".Fence";
 		mCmdName = name + ".Cmd";
-		mFenceHandle = ResourceHandle(mFenceName, ResourceType::Fence);
+		mTimestampName = name + ".Timestamps";
 		mCommandBufferHandle = ResourceHandle(mCmdName, ResourceType::CommandBuffer);
-	}
+		mTimestampHandle = ResourceHandle(mTimestampName, ResourceType::TimestampQueryPool);
 
-	void RenderPass::InitRegistry(ResourceRegistry& registry)
-	{
-		registry.AddFence(mFenceName);
-		registry.AddCommandBuffer(mCmdName);
+		for (uint32_t i = 0; i < sMaxDrawRanges; i++)
+		{
+			mSecondaryCommandBufferHandles.push_back(ResourceHandle(mCmdName + ".Range" + std::to_string(i), ResourceType::CommandBuffer));
+		}
 	}
 
-	void RenderPass::AddPreDrawCommand(const RenderCommand& command)
+	void RenderPass::InitRegistry(ResourceRegistry& registry)
 	{
-		mPreDrawCommandList.AddCommand(command);
-	}
+		registry.AddCommandBuffer(mCmdName, mQueue);
+		registry.AddTimestampQueryPool(mTimestampName, 2, mQueue);
 
-	void RenderPass::AddPostDrawCommand(const RenderCommand& command)
-	{
-		mPostDrawCommandList.AddCommand(command);
+		if (IsRecordedInRanges())
+		{
+			for (const ResourceHandle& handle : mSecondaryCommandBufferHandles)
+			{
+				registry.AddSecondaryCommandBuffer(handle.Name);
+			}
+		}
 	}
 
 	void RenderPass::AddDependency(const std::string& passDependency)
@@ -37,33 +66,93 @@ namespace Mule
 		mDependencies.push_back(passDependency);
 	}
 
-	Ref<CommandBuffer> RenderPass::Execute(const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex)
+	Ref<CommandBuffer> RenderPass::Execute(const CommandList& commandList, const PassCommands& commands, const ResourceRegistry& registry, uint32_t frameIndex, uint32_t rangeCount)
 	{
 		Ref<CommandBuffer> cmd = registry.GetResource<CommandBuffer>(mCommandBufferHandle, frameIndex);
-		Ref<Fence> fence = registry.GetResource<Fence>(mFenceHandle, frameIndex);
-
-		fence->Wait();
-		fence->Reset();
+		Ref<TimestampQueryPool> timestamps = registry.GetResource<TimestampQueryPool>(mTimestampHandle, frameIndex);
 
 		cmd->Reset();
 		cmd->Begin();
+		cmd->ResetQueries(timestamps);
+		cmd->WriteTimestamp(timestamps, 0);
+
+		CommandExecutor::Execute(cmd, commands.PreDraw, registry, frameIndex);
 
-		CommandExecutor::Execute(cmd, mPreDrawCommandList, registry, frameIndex);
+		if (IsRecordedInRanges())
+		{
+			std::vector<Ref<CommandBuffer>> secondaries(rangeCount);
+			for (uint32_t i = 0; i < rangeCount; i++)
+			{
+				secondaries[i] = registry.GetResource<CommandBuffer>(mSecondaryCommandBufferHandles[i], frameIndex);
+			}
 
-		if (mExecutionCallback)
+			cmd->ExecuteSecondary(secondaries);
+		}
+		else if (mExecutionCallback && HasCommandsToRecord(commandList))
 		{
 			mExecutionCallback(cmd, commandList, registry, frameIndex);
 		}
 
-		CommandExecutor::Execute(cmd, mPostDrawCommandList, registry, frameIndex);
+		CommandExecutor::Execute(cmd, commands.PostDraw, registry, frameIndex);
+
+		cmd->WriteTimestamp(timestamps, 1);
 
 		return cmd;
 	}
 
-	Ref<Fence> RenderPass::GetFence(const ResourceRegistry& registry, uint32_t frameIndex)
+	// Safe to call for different slots from different threads, each slot owns its command buffer and allocator
+	void RenderPass::RecordRange(const CommandList& commandList, const PassCommands& commands, const ResourceRegistry& registry, uint32_t frameIndex, uint32_t slot, DrawRange range)
 	{
-		Ref<Fence> fence = registry.GetResource<Fence>(mFenceHandle, frameIndex);
-		return fence;
+		assert(slot < mSecondaryCommandBufferHandles.size() && "Draw range slot out of bounds");
+
+		Ref<CommandBuffer> cmd = registry.GetResource<CommandBuffer>(mSecondaryCommandBufferHandles[slot], frameIndex);
+
+		auto beginRendering = std::find_if(commands.PreDraw.begin(), commands.PreDraw.end(), [](const RenderCommand& command) {
+			return command.GetType() == RenderCommandType::BeginRendering;
+			});
+
+		assert(beginRendering != commands.PreDraw.end() && "Ranged passes must begin rendering before recording draws");
+
+		cmd->Reset();
+		CommandExecutor::BeginSecondary(cmd, *beginRendering, registry, frameIndex);
+		CommandExecutor::Execute(cmd, commands.Range, registry, frameIndex);
+		mRangeCallback(cmd, commandList, registry, frameIndex, range);
+		cmd->End();
+	}
+
+	std::vector<DrawRange> RenderPass::GetDrawRanges(const CommandList& commandList) const
+	{
+		if (!IsRecordedInRanges() || !HasCommandsToRecord(commandList))
+			return {};
+
+		uint32_t drawCount = mDrawCountCallback ? mDrawCountCallback(commandList) : 0;
+		return SplitDrawRange(drawCount, sMinDrawsPerRange, sMaxDrawRanges);
+	}
+
+	bool RenderPass::HasCommandsToRecord(const CommandList& commandList) const
+	{
+		// Passes that dont consume commands (fullscreen compute etc) always record
+		if (mCommandTypes.empty())
+			return true;
+
+		for (RenderCommandType type : mCommandTypes)
+		{
+			if (!commandList.IsEmpty(type))
+				return true;
+		}
+
+		return false;
+	}
+
+	double RenderPass::GetGPUTime(const ResourceRegistry& registry, uint32_t frameIndex) const
+	{
+		Ref<TimestampQueryPool> timestamps = registry.GetResource<TimestampQueryPool>(mTimestampHandle, frameIndex);
+
+		std::vector<double> results;
+		if (!timestamps->GetResults(results))
+			return 0.0;
+
+		return results[1] - results[0];
 	}
 
 	void RenderPass::AddResource(ResourceHandle handle, ResourceAccess access, uint32_t index)
@@ -81,6 +170,12 @@ namespace Mule
 		mExecutionCallback = callback;
 	}
 
+	void RenderPass::SetRangeExecutionCallback(std::function<uint32_t(const CommandList&)> drawCount, std::function<void(Ref<CommandBuffer>, const CommandList&, const ResourceRegistry&, uint32_t, DrawRange)> callback)
+	{
+		mDrawCountCallback = drawCount;
+		mRangeCallback = callback;
+	}
+
 	void RenderPass::SetPipeline(WeakRef<GraphicsPipeline> pipeline)
 	{
 		mGraphicsPipeline = pipeline;
@@ -18,7 +18,13 @@ namespace Mule
 		return ResourceHandle(name, ResourceType::UniformBuffer);
 	}
 
-	ResourceHandle ResourceBuilder::CreateTexture2D(const std::string& name, TextureFormat format, TextureFlags flags)
+	ResourceHandle ResourceBuilder::CreateStorageBuffer(const std::string& name, uint32_t bufferSize)
+	{
+		mStorageBufferBlueprints[name] = StorageBufferBlueprint{ bufferSize };
+		return ResourceHandle(name, ResourceType::StorageBuffer);
+	}
+
+	ResourceHandle ResourceBuilder::CreateTexture2D(const std::string& name, TextureFormat format, TextureFlags flags, bool displaySized)
 	{
 		ResourceType type = ResourceType::Texture;
 		if ((flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget)
@@ -26,11 +32,11 @@ namespace Mule
 		else if ((flags & TextureFlags::DepthAttachment) == TextureFlags::DepthAttachment)
 			type = ResourceType::DepthAttachment;
 
-		mTexture2DBlueprints[name] = Texture2DBlueprint {format, flags, type};
+		mTexture2DBlueprints[name] = Texture2DBlueprint {format, flags, type, displaySized};
 		return ResourceHandle(name, type);
 	}
 
-	ResourceHandle ResourceBuilder::CreateTexture2DArray(const std::string& name, uint32_t layers, TextureFormat format, TextureFlags flags)
+	ResourceHandle ResourceBuilder::CreateTexture2DArray(const std::string& name, uint32_t width, uint32_t height, uint32_t layers, TextureFormat format, TextureFlags flags)
 	{
 		ResourceType type = ResourceType::Texture;
 		if ((flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget)
@@ -38,7 +44,7 @@ namespace Mule
 		else if ((flags & TextureFlags::DepthAttachment) == TextureFlags::DepthAttachment)
 			type = ResourceType::DepthAttachment;
 
-		mTexture2DArrayBlueprints[name] = Texture2DArrayBlueprint{ layers, format, flags, type };
+		mTexture2DArrayBlueprints[name] = Texture2DArrayBlueprint{ width, height, layers, format, flags, type };
 		return ResourceHandle(name, type);
 	}
 
@@ -0,0 +1,89 @@
+#include "Graphics/Renderer/RenderGraph/ResourceLifetime.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Mule
+{
+	std::vector<ResourceLifetime> ComputeResourceLifetimes(const std::vector<std::unordered_map<ResourceHandle, ResourceUsage>>& passUsage)
+	{
+		std::vector<ResourceLifetime> lifetimes;
+		std::unordered_map<ResourceHandle, uint32_t> indices;
+
+		for (uint32_t pass = 0; pass < passUsage.size(); pass++)
+		{
+			for (const auto& [handle, usage] : passUsage[pass])
+			{
+				auto iter = indices.find(handle);
+				if (iter == indices.end())
+				{
+					ResourceLifetime lifetime;
+					lifetime.Handle = handle;
+					lifetime.FirstPass = pass;
+					lifetime.LastPass = pass;
+					lifetime.WrittenFirst = usage.Access == ResourceAccess::Write;
+
+					indices[handle] = lifetimes.size();
+					lifetimes.push_back(lifetime);
+				}
+				else
+				{
+					lifetimes[iter->second].LastPass = pass;
+				}
+			}
+		}
+
+		// Usage maps are unordered, names keep resources first used by the same pass in a stable order
+		std::sort(lifetimes.begin(), lifetimes.end(), [](const ResourceLifetime& lhs, const ResourceLifetime& rhs) {
+			if (lhs.FirstPass != rhs.FirstPass)
+				return lhs.FirstPass < rhs.FirstPass;
+			return lhs.Handle.Name < rhs.Handle.Name;
+			});
+
+		return lifetimes;
+	}
+
+	bool LifetimesOverlap(const ResourceLifetime& lhs, const ResourceLifetime& rhs)
+	{
+		return lhs.FirstPass <= rhs.LastPass && rhs.FirstPass <= lhs.LastPass;
+	}
+
+	std::vector<AliasSlot> AssignAliasSlots(const std::vector<ResourceLifetime>& lifetimes, const std::vector<uint64_t>& sizes)
+	{
+		assert(lifetimes.size() == sizes.size() && "Every lifetime needs a size");
+
+		std::vector<uint32_t> order(lifetimes.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+			return sizes[lhs] > sizes[rhs];
+			});
+
+		std::vector<AliasSlot> slots;
+		for (uint32_t index : order)
+		{
+			AliasSlot* target = nullptr;
+			for (auto& slot : slots)
+			{
+				bool overlaps = std::any_of(slot.Members.begin(), slot.Members.end(), [&](uint32_t member) {
+					return LifetimesOverlap(lifetimes[member], lifetimes[index]);
+					});
+
+				if (!overlaps)
+				{
+					target = &slot;
+					break;
+				}
+			}
+
+			if (!target)
+			{
+				target = &slots.emplace_back();
+				target->Size = sizes[index];
+			}
+
+			target->Members.push_back(index);
+		}
+
+		return slots;
+	}
+}
@@ -1,32 +1,46 @@
 #include "Graphics/Renderer/RenderGraph/ResourceRegistry.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
 namespace Mule
 {
+	static std::atomic<uint64_t> sNextRegistryId = 0;
+
 	ResourceRegistry::ResourceRegistry(uint32_t framesInFlight, const ResourceBuilder& builder)
 		:
+		mId(sNextRegistryId++),
 		mFramesInFlight(framesInFlight),
 		mFrameIndex(0),
 		mOutputHandleLayer(0)
 	{
 		mResizeRequests.resize(mFramesInFlight);
+		mAliasedMemorySaved.resize(mFramesInFlight, 0);
+		mAliasGroups.resize(mFramesInFlight);
+		mSubmittedValues.resize(mFramesInFlight, { 0, 0 });
 
 		InFlightResource commandAllocator(mFramesInFlight);
 		InFlightResource timelineSemaphore(mFramesInFlight);
+		InFlightResource computeTimelineSemaphore(mFramesInFlight);
 
 		for (uint32_t i = 0; i < mFramesInFlight; i++)
 		{
 			commandAllocator.Resources[i] = CommandAllocator::Create();
 			timelineSemaphore.Resources[i] = TimelineSemaphore::Create();
+			computeTimelineSemaphore.Resources[i] = TimelineSemaphore::Create();
 			mResizeRequests[i].Handled = false;
-			mResizeRequests[i].Width = 800;
-			mResizeRequests[i].Height = 600;
+			mResizeRequests[i].ResizeWidth = mResizeRequests[i].Width = mResizeRequests[i].RenderWidth = mResizeRequests[i].AllocatedWidth = 800;
+			mResizeRequests[i].ResizeHeight = mResizeRequests[i].Height = mResizeRequests[i].RenderHeight = mResizeRequests[i].AllocatedHeight = 600;
 		}
 
 		mCommandAllocatorHandle = ResourceHandle("CommandAllocator", ResourceType::CommandAllocator);
 		mTimelineSemaphoreHandle = ResourceHandle("TimelineSemaphore", ResourceType::TimelineSemaphore);
+		mComputeTimelineSemaphoreHandle = ResourceHandle("ComputeTimelineSemaphore", ResourceType::TimelineSemaphore);
 
 		mResources[mCommandAllocatorHandle] = commandAllocator;
 		mResources[mTimelineSemaphoreHandle] = timelineSemaphore;
+		mResources[mComputeTimelineSemaphoreHandle] = computeTimelineSemaphore;
 
 		for (const auto& [name, samplerBlueprint] : builder.GetSamplerBlueprints())
 		{
@@ -48,7 +62,7 @@ namespace Mule
 			InFlightResource UBIFR(mFramesInFlight);
 			for (uint32_t i = 0; i < mFramesInFlight; i++)
 			{
-				UBIFR.Resources[i] = UniformBuffer::Create(UBBlueprint.Size);
+				UBIFR.Resources[i] = UniformBuffer::Create(UBBlueprint.Size, BufferFlags::SharedQueues);
 			}
 
 			ResourceHandle handle = ResourceHandle(name, ResourceType::UniformBuffer);
@@ -56,6 +70,19 @@ namespace Mule
 			mResourceHandles.push_back(handle);
 		}
 
+		for (const auto& [name, SBBlueprint] : builder.GetStorageBufferBlueprints())
+		{
+			InFlightResource SBIFR(mFramesInFlight);
+			for (uint32_t i = 0; i < mFramesInFlight; i++)
+			{
+				SBIFR.Resources[i] = StorageBuffer::Create(SBBlueprint.Size, BufferFlags::SharedQueues);
+			}
+
+			ResourceHandle handle = ResourceHandle(name, ResourceType::StorageBuffer);
+			mResources[handle] = SBIFR;
+			mResourceHandles.push_back(handle);
+		}
+
 		for (const auto& [name, TextureBlueprints] : builder.GetTextureBlueprints())
 		{
 			InFlightResource TextureIFR(mFramesInFlight);
@@ -67,6 +94,7 @@ namespace Mule
 			ResourceHandle handle = ResourceHandle(name, TextureBlueprints.Type);
 			mResources[handle] = TextureIFR;
 			mResourceHandles.push_back(handle);
+			mViewTextures[handle] = TextureBlueprints.DisplaySized;
 		}
 
 		for (const auto& [name, TextureBlueprints] : builder.GetTexture2DArrayBlueprints())
@@ -74,7 +102,7 @@ namespace Mule
 			InFlightResource TextureIFR(mFramesInFlight);
 			for (uint32_t i = 0; i < mFramesInFlight; i++)
 			{
-				TextureIFR.Resources[i] = (Ref<Texture>)Texture2DArray::Create(name, {}, 800, 600, TextureBlueprints.Layers, TextureBlueprints.Format, TextureBlueprints.Flags);
+				TextureIFR.Resources[i] = (Ref<Texture>)Texture2DArray::Create(name, {}, TextureBlueprints.Width, TextureBlueprints.Height, TextureBlueprints.Layers, TextureBlueprints.Format, TextureBlueprints.Flags);
 			}
 
 			ResourceHandle handle = ResourceHandle(name, TextureBlueprints.Type);
@@ -126,24 +154,79 @@ namespace Mule
 		return handle;
 	}
 
-	ResourceHandle ResourceRegistry::AddCommandBuffer(const std::string& name)
+	ResourceHandle ResourceRegistry::AddCommandBuffer(const std::string& name, QueueType queue)
+	{
+		InFlightResource commandBuffer(mFramesInFlight);
+
+		if (queue == QueueType::Graphics)
+		{
+			for (uint32_t i = 0; i < mFramesInFlight; i++)
+			{
+				auto commandAllocator = GetResource<CommandAllocator>(mCommandAllocatorHandle, i);
+				commandBuffer.Resources[i] = commandAllocator->CreateCommandBuffer();
+			}
+		}
+		else
+		{
+			// Few passes run on the compute queue, they get an allocator of that queue family each
+			InFlightResource commandAllocator(mFramesInFlight);
+			for (uint32_t i = 0; i < mFramesInFlight; i++)
+			{
+				Ref<CommandAllocator> allocator = CommandAllocator::Create(queue);
+				commandAllocator.Resources[i] = allocator;
+				commandBuffer.Resources[i] = allocator->CreateCommandBuffer();
+			}
+
+			mResources[ResourceHandle(name + ".Allocator", ResourceType::CommandAllocator)] = commandAllocator;
+		}
+
+		ResourceHandle handle = ResourceHandle(name, ResourceType::CommandBuffer);
+
+		mResources[handle] = commandBuffer;
+		mResourceHandles.push_back(handle);
+
+		return handle;
+	}
+
+	ResourceHandle ResourceRegistry::AddSecondaryCommandBuffer(const std::string& name)
 	{
+		InFlightResource commandAllocator(mFramesInFlight);
 		InFlightResource commandBuffer(mFramesInFlight);
 
 		for (uint32_t i = 0; i < mFramesInFlight; i++)
 		{
-			auto commandAllocator = GetResource<CommandAllocator>(mCommandAllocatorHandle, i);
-			commandBuffer.Resources[i] = commandAllocator->CreateCommandBuffer();
+			Ref<CommandAllocator> allocator = CommandAllocator::Create();
+			commandAllocator.Resources[i] = allocator;
+			commandBuffer.Resources[i] = allocator->CreateSecondaryCommandBuffer();
 		}
 
+		ResourceHandle allocatorHandle = ResourceHandle(name + ".Allocator", ResourceType::CommandAllocator);
 		ResourceHandle handle = ResourceHandle(name, ResourceType::CommandBuffer);
 
+		mResources[allocatorHandle] = commandAllocator;
 		mResources[handle] = commandBuffer;
 		mResourceHandles.push_back(handle);
 
 		return handle;
 	}
 
+	ResourceHandle ResourceRegistry::AddTimestampQueryPool(const std::string& name, uint32_t count, QueueType queue)
+	{
+		InFlightResource queryPool(mFramesInFlight);
+
+		for (uint32_t i = 0; i < mFramesInFlight; i++)
+		{
+			queryPool.Resources[i] = TimestampQueryPool::Create(count, queue);
+		}
+
+		ResourceHandle handle = ResourceHandle(name, ResourceType::TimestampQueryPool);
+
+		mResources[handle] = queryPool;
+		mResourceHandles.push_back(handle);
+
+		return handle;
+	}
+
 	WeakRef<TextureView> ResourceRegistry::GetColorOutput() const
 	{
 		if (mOutputHandle)
@@ -155,6 +238,17 @@ namespace Mule
 		return nullptr;
 	}
 
+	glm::vec2 ResourceRegistry::GetColorOutputUV() const
+	{
+		if (!mOutputHandle)
+			return glm::vec2(1.f);
+
+		auto image = GetResource<Texture>(mOutputHandle, mFrameIndex);
+		auto [width, height] = GetExtent(mOutputHandle, mFrameIndex);
+
+		return glm::vec2(width / (float)image->GetWidth(), height / (float)image->GetHeight());
+	}
+
 	void ResourceRegistry::SetOutputHandle(ResourceHandle outputHandle, uint32_t layer)
 	{
 		assert(outputHandle.Type != ResourceType::RenderTarget || outputHandle.Type != ResourceType::DepthAttachment && "Output must be a texture 2d");
@@ -163,22 +257,38 @@ namespace Mule
 		mOutputHandleLayer = layer;
 	}
 
-	void ResourceRegistry::CopyRegistryResources(ResourceRegistry& registry)
+	void ResourceRegistry::CopyRegistryResources(const ResourceRegistry& registry)
 	{
-		for (auto& [handle, res] : registry.mResources)
+		for (const auto& handle : registry.mResourceHandles)
 		{
-			mResources[handle] = res;
+			mResources[handle] = registry.mResources.at(handle);
 			mResourceHandles.push_back(handle);
 		}
 	}
 
-	void ResourceRegistry::WaitForFences(uint32_t frameIndex)
+	void ResourceRegistry::WaitForFrame(uint32_t frameIndex)
 	{
 		for (auto fenceResource : mFences)
 		{
 			auto fence = std::get<Ref<Fence>>(fenceResource.Resources[frameIndex]);
 			fence->Wait();
 		}
+
+		GetSemaphore(frameIndex, QueueType::Graphics)->Wait(GetSubmittedValue(frameIndex, QueueType::Graphics));
+		GetSemaphore(frameIndex, QueueType::Compute)->Wait(GetSubmittedValue(frameIndex, QueueType::Compute));
+	}
+
+	bool ResourceRegistry::IsFrameComplete(uint32_t frameIndex) const
+	{
+		for (const auto& fenceResource : mFences)
+		{
+			auto fence = std::get<Ref<Fence>>(fenceResource.Resources[frameIndex]);
+			if (!fence->IsSignaled())
+				return false;
+		}
+
+		return GetSemaphore(frameIndex, QueueType::Graphics)->GetValue() >= GetSubmittedValue(frameIndex, QueueType::Graphics)
+			&& GetSemaphore(frameIndex, QueueType::Compute)->GetValue() >= GetSubmittedValue(frameIndex, QueueType::Compute);
 	}
 
 	void ResourceRegistry::Resize(uint32_t width, uint32_t height)
@@ -208,11 +318,48 @@ namespace Mule
 		return { mResizeRequests[frameIndex].ResizeWidth, mResizeRequests[frameIndex].ResizeHeight };
 	}
 
-	Ref<TimelineSemaphore> ResourceRegistry::GetSemaphore(uint32_t frameIndex) const
+	std::pair<uint32_t, uint32_t> ResourceRegistry::GetAllocatedDimensions(uint32_t frameIndex) const
+	{
+		return { mResizeRequests[frameIndex].AllocatedWidth, mResizeRequests[frameIndex].AllocatedHeight };
+	}
+
+	void ResourceRegistry::SetAllocatedDimensions(uint32_t frameIndex, uint32_t width, uint32_t height)
 	{
-		return GetResource<TimelineSemaphore>(mTimelineSemaphoreHandle, frameIndex);
+		mResizeRequests[frameIndex].AllocatedWidth = width;
+		mResizeRequests[frameIndex].AllocatedHeight = height;
+	}
+
+	void ResourceRegistry::SetRenderScale(float scale)
+	{
+		mRenderScale = std::clamp(scale, 0.1f, 1.f);
+	}
+
+	void ResourceRegistry::UpdateRenderExtent(uint32_t frameIndex)
+	{
+		ResizeRequest& request = mResizeRequests[frameIndex];
+		request.RenderWidth = std::clamp(static_cast<uint32_t>(std::ceil(request.Width * mRenderScale)), 1u, std::max(request.AllocatedWidth, 1u));
+		request.RenderHeight = std::clamp(static_cast<uint32_t>(std::ceil(request.Height * mRenderScale)), 1u, std::max(request.AllocatedHeight, 1u));
+	}
+
+	Ref<TimelineSemaphore> ResourceRegistry::GetSemaphore(uint32_t frameIndex, QueueType queue) const
+	{
+		return GetResource<TimelineSemaphore>(queue == QueueType::Compute ? mComputeTimelineSemaphoreHandle : mTimelineSemaphoreHandle, frameIndex);
 	}
 	
+	void ResourceRegistry::SetAliasedMemorySaved(uint32_t frameIndex, uint64_t bytes)
+	{
+		mAliasedMemorySaved[frameIndex] = bytes;
+	}
+
+	uint64_t ResourceRegistry::GetAliasedMemorySaved() const
+	{
+		uint64_t bytes = 0;
+		for (uint64_t saved : mAliasedMemorySaved)
+			bytes += saved;
+
+		return bytes;
+	}
+
 	uint32_t ResourceRegistry::GetWidth(uint32_t frameIndex) const
 	{
 		return mResizeRequests[frameIndex].Width;
@@ -223,4 +370,30 @@ namespace Mule
 		return mResizeRequests[frameIndex].Height;
 	}
 
+	uint32_t ResourceRegistry::GetRenderWidth(uint32_t frameIndex) const
+	{
+		return mResizeRequests[frameIndex].RenderWidth;
+	}
+
+	uint32_t ResourceRegistry::GetRenderHeight(uint32_t frameIndex) const
+	{
+		return mResizeRequests[frameIndex].RenderHeight;
+	}
+
+	std::pair<uint32_t, uint32_t> ResourceRegistry::GetExtent(ResourceHandle handle, uint32_t frameIndex) const
+	{
+		auto iter = mViewTextures.find(handle);
+		if (iter == mViewTextures.end())
+		{
+			auto texture = GetResource<Texture>(handle, frameIndex);
+			return { texture->GetWidth(), texture->GetHeight() };
+		}
+
+		const ResizeRequest& request = mResizeRequests[frameIndex];
+		if (iter->second)
+			return { request.Width, request.Height };
+
+		return { request.RenderWidth, request.RenderHeight };
+	}
+
 }
@@ -1,29 +1,45 @@
 
 #include "Graphics/Renderer/Renderer.h"
+#include "Graphics/Frustum.h"
+#include "Graphics/Renderer/LodSelection.h"
 
 #include "Graphics/GPUObjects.h"
 #include "Graphics/ShaderFactory.h"
 
 #include "Graphics/API/Texture2DArray.h" 
+#include "Graphics/API/GraphicsCounters.h"
+#include "Graphics/API/GraphicsContext.h"
 
 #include "ScopedBuffer.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <functional>
 
 namespace Mule
 {
 	Renderer* Renderer::sRenderer = nullptr;
 
-	Renderer::Renderer()
+	Renderer::Renderer(uint32_t framesInFlight)
 		:
-		mFramesInFlight(2),
-		mFrameIndex(0)
+		mRecordBufferIndex(0),
+		mFramesInFlight(std::clamp(framesInFlight, 1u, sMaxFramesInFlight)),
+		mFrameIndex(0),
+		mObjectTable(mFramesInFlight),
+		mStaticShadowCache(mFramesInFlight, sShadowCascadeCount)
 	{
-		mResourceUpdates.resize(mFramesInFlight);
+		if (mFramesInFlight != framesInFlight)
+			SPDLOG_WARN("{} frames in flight is not supported, using {}", framesInFlight, mFramesInFlight);
+
+		mPendingTextureWrites.resize(mFramesInFlight);
+		mPendingMaterialWrites.resize(mFramesInFlight);
+		mFrameRegistries.resize(mFramesInFlight);
 	}
 
-	void Renderer::Init()
+	void Renderer::Init(WeakRef<JobSystem> jobSystem, uint32_t framesInFlight)
 	{
 		assert(!sRenderer && "Renderer has already been initialized");
-		sRenderer = new Renderer();
+		sRenderer = new Renderer(framesInFlight);
 
 		uint8_t whiteImageData[] = {
 			255, 255, 255, 255,		255, 255, 255, 255,
@@ -69,17 +85,18 @@ namespace Mule
 
 		sRenderer->mBindlessMaterialSRGHandle = ResourceHandle("Bindless.Material.SRG", ResourceType::ShaderResourceGroup);
 		sRenderer->mBindlessTextureSRGHandle = ResourceHandle("Bindless.Texture.SRG", ResourceType::ShaderResourceGroup);
-		sRenderer->mBindlessMaterialBufferHandle = ResourceHandle("Bindless.Material.Buffer", ResourceType::UniformBuffer);
+		sRenderer->mBindlessMaterialBufferHandle = ResourceHandle("Bindless.Material.Buffer", ResourceType::StorageBuffer);
 
 		for (uint32_t i = 0; i < sRenderer->mFramesInFlight; i++)
 		{
-			sRenderer->mBindlessMaterialBuffer.push_back(UniformBuffer::Create(sizeof(GPU::Material) * 800));
+			sRenderer->mBindlessMaterialBuffer.push_back(StorageBuffer::Create(sizeof(GPU::Material) * 800, BufferFlags::SharedQueues));
 			sRenderer->mBindlessMaterialSRG.push_back(ShaderResourceGroup::Create({
-				ShaderResourceDescription(0, ShaderResourceType::UniformBuffer, ShaderStage::Fragment)
+				ShaderResourceDescription(0, ShaderResourceType::StorageBuffer, ShaderStage::Fragment)
 				}));
 
+			// Both tables grow on demand in UpdateBindlessResources
 			sRenderer->mBindlessTextureSRG.push_back(ShaderResourceGroup::Create({
-				ShaderResourceDescription(0, ShaderResourceType::Sampler, ShaderStage::Fragment, 4096)
+				ShaderResourceDescription(0, ShaderResourceType::Sampler, ShaderStage::Fragment, 4096, true)
 				}));
 
 			auto bindlessMaterialSRG = sRenderer->mBindlessMaterialSRG[i];
@@ -88,6 +105,22 @@ namespace Mule
 			bindlessMaterialSRG->Update(0, bindlessMaterialBuffer);
 		}
 
+		sRenderer->mObjectBufferHandle = ResourceHandle("Object.Buffer", ResourceType::StorageBuffer);
+		sRenderer->mObjectSRGHandle = ResourceHandle("Object.SRG", ResourceType::ShaderResourceGroup);
+
+		for (uint32_t i = 0; i < sRenderer->mFramesInFlight; i++)
+		{
+			auto objectBuffer = StorageBuffer::Create(sizeof(GPU::ObjectData) * 1024, BufferFlags::SharedQueues);
+			auto objectSRG = ShaderResourceGroup::Create({
+				ShaderResourceDescription(0, ShaderResourceType::StorageBuffer, ShaderStage::Vertex)
+				});
+
+			objectSRG->Update(0, objectBuffer);
+
+			sRenderer->mObjectBuffers.push_back(objectBuffer);
+			sRenderer->mObjectSRG.push_back(objectSRG);
+		}
+
 		ShaderFactory::Init();
 		ShaderFactory& shaderFactory = ShaderFactory::Get();
 
@@ -109,8 +142,29 @@ namespace Mule
 			geometryPipeline.DepthFormat = TextureFormat::D_32F;
 			geometryPipeline.EnableDepthTest = true;
 			geometryPipeline.EnableDepthWrite = true;
+			geometryPipeline.ColorFormats = { TextureFormat::RGBA_8U_SRGB, TextureFormat::RG_16SN, TextureFormat::RGBA_8U };
 			shaderFactory.RegisterGraphicsPipeline("Geometry", geometryPipeline);
 
+			// Used once the depth pre-pass has written every visible surface
+			GraphicsPipelineDescription geometryDepthEqualPipeline = geometryPipeline;
+			geometryDepthEqualPipeline.EnableDepthWrite = false;
+			geometryDepthEqualPipeline.DepthFunc = DepthFunc::Equal;
+			shaderFactory.RegisterGraphicsPipeline("GeometryDepthEqual", geometryDepthEqualPipeline);
+
+			VertexLayout positionVertexLayout;
+			positionVertexLayout.AddAttribute(AttributeType::Vec3)
+				.AddPadding(defaultVertexLayout.GetVertexSize() - GetAttributeSize(AttributeType::Vec3));
+
+			GraphicsPipelineDescription depthPrePassPipeline{};
+			depthPrePassPipeline.Filepath = "../Assets/Shaders/Graphics/DepthPrePassShader.glsl";
+			depthPrePassPipeline.FilleMode = FillMode::Solid;
+			depthPrePassPipeline.CullMode = CullMode::Back;
+			depthPrePassPipeline.VertexLayout = positionVertexLayout;
+			depthPrePassPipeline.DepthFormat = TextureFormat::D_32F;
+			depthPrePassPipeline.EnableDepthTest = true;
+			depthPrePassPipeline.EnableDepthWrite = true;
+			shaderFactory.RegisterGraphicsPipeline("DepthPrePass", depthPrePassPipeline);
+
 
 			GraphicsPipelineDescription environmentMapPipeline{};
 			environmentMapPipeline.Filepath = "../Assets/Shaders/Graphics/EnvironmentMapShader.glsl";
@@ -133,6 +187,11 @@ namespace Mule
 			shadowDepthPipeline.EnableDepthWrite = true;
 			shadowDepthPipeline.DepthFunc = DepthFunc::LessEqual;
 			shaderFactory.RegisterGraphicsPipeline("ShadowDepth", shadowDepthPipeline);
+
+			GraphicsPipelineDescription shadowDepthLayeredPipeline = shadowDepthPipeline;
+			shadowDepthLayeredPipeline.Filepath = "../Assets/Shaders/Graphics/ShadowDepthLayeredShader.glsl";
+			shadowDepthLayeredPipeline.VertexLayout = positionVertexLayout;
+			shaderFactory.RegisterGraphicsPipeline("ShadowDepthLayered", shadowDepthLayeredPipeline);
 		}
 
 		// Compute Pipelines
@@ -152,16 +211,26 @@ namespace Mule
 			ComputePipelineDescription deferredLightingCompute{};
 			deferredLightingCompute.Filepath = "../Assets/Shaders/Compute/DeferredLightingPass.glsl";
 			shaderFactory.RegisterComputePipeline("DeferredLighting", deferredLightingCompute);
+
+			ComputePipelineDescription hiZDownsampleCompute{};
+			hiZDownsampleCompute.Filepath = "../Assets/Shaders/Compute/HiZDownsample.glsl";
+			shaderFactory.RegisterComputePipeline("HiZDownsample", hiZDownsampleCompute);
+
+			ComputePipelineDescription upscaleCompute{};
+			upscaleCompute.Filepath = "../Assets/Shaders/Compute/Upscale.glsl";
+			shaderFactory.RegisterComputePipeline("Upscale", upscaleCompute);
 		}
 
 
 		sRenderer->BuildGraph();
+		sRenderer->mRenderGraph->SetJobSystem(jobSystem);
 	}
 
 	void Renderer::Shutdown()
 	{
 		assert(sRenderer && "Renderer has not been initialized");
 		delete sRenderer;
+		sRenderer = nullptr;
 	}
 
 	Renderer& Renderer::Get()
@@ -173,102 +242,274 @@ namespace Mule
 	Ref<ResourceRegistry> Renderer::CreateResourceRegistry()
 	{
 		Ref<ResourceRegistry> registry = MakeRef<ResourceRegistry>(mFramesInFlight, mResourceBuilder);
+		registry->CopyRegistryResources(*mSharedRegistry);
 
 		mRenderGraph->InitializeRegistry(*registry);
 
 		registry->InsertResources(mBindlessMaterialSRGHandle, mBindlessMaterialSRG);
 		registry->InsertResources(mBindlessTextureSRGHandle, mBindlessTextureSRG);
-
-		registry->SetOutputHandle(ResourceHandle("MainOutput", ResourceType::RenderTarget));
+		registry->InsertResources(mObjectSRGHandle, mObjectSRG);
 
 		return registry;
 	}
 
-	void Renderer::Submit(const Camera& camera, const CommandList& commandList)
+	RenderRequestHandle Renderer::BeginRequest(WeakRef<Camera> camera, const void* world)
 	{
 		std::lock_guard<std::mutex> lock(mMutex);
 
-		mRenderRequests.push_back({
-			.Camera = camera,
-			.Commands = commandList,
-		});		
+		RenderRequestBuffer& buffer = mRequestBuffers[mRecordBufferIndex];
+
+		if (buffer.Count == buffer.Requests.size())
+			buffer.Requests.push_back(MakeRef<RenderRequest>());
+
+		Ref<RenderRequest> request = buffer.Requests[buffer.Count];
+		request->SourceCamera = camera;
+		request->World = world;
+		request->Recording = true;
+		request->Submitted = false;
+		request->Commands.Flush();
+
+		return { mRecordBufferIndex, buffer.Count++, buffer.Generation };
 	}
 
-	void Renderer::Render()
+	CommandList& Renderer::GetCommandList(RenderRequestHandle handle)
 	{
+		assert(handle && "Invalid render request handle");
+
+		// Other threads may grow the request vector, requests themselves are heap allocated so the reference stays valid
 		std::lock_guard<std::mutex> lock(mMutex);
+		assert(mRequestBuffers[handle.Buffer].Generation == handle.Generation && "Render request recorded across a call to Render");
+		return mRequestBuffers[handle.Buffer].Requests[handle.Index]->Commands;
+	}
 
-		if (BindlessResourcesNeedUpdate())
+	bool Renderer::Submit(RenderRequestHandle handle)
+	{
+		assert(handle && "Invalid render request handle");
+		
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		// Render already took the requests of this buffer, the slot may belong to a newer request by now
+		if (mRequestBuffers[handle.Buffer].Generation != handle.Generation)
+		{
+			SPDLOG_WARN("Render request submitted after the call to Render it was recorded for, it is dropped");
+			return false;
+		}
+
+		Ref<RenderRequest> request = mRequestBuffers[handle.Buffer].Requests[handle.Index];
+		request->Recording = false;
+		if (!request->SourceCamera)
+			return false;
+
+		request->View = RenderView(*request->SourceCamera);
+		request->SourceCamera = nullptr;
+		request->Submitted = true;
+
+		return request->View.Registry != nullptr;
+	}
+
+	void Renderer::Render()
+	{
+		// The submitted requests are taken under the lock, anything submitted later to this buffer is dropped
+		std::vector<Ref<RenderRequest>>& requests = mRenderRequests;
+		requests.clear();
 		{
-			for (auto renderRequest : mRenderRequests)
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			RenderRequestBuffer& requestBuffer = mRequestBuffers[mRecordBufferIndex];
+			for (uint32_t i = 0; i < requestBuffer.Count; i++)
 			{
-				auto registry = renderRequest.Camera.GetRegistry();
-				if (!registry)
-					continue;
-				registry->WaitForFences(mFrameIndex);
+				const Ref<RenderRequest>& request = requestBuffer.Requests[i];
+				if (request->Submitted && request->View.Registry)
+					requests.push_back(request);
+
+				if (request->Recording)
+					SPDLOG_WARN("Render request still recording when Render was called, it is dropped");
+
+				request->Recording = false;
+				request->Submitted = false;
 			}
 
+			requestBuffer.Generation++;
+			mRecordBufferIndex = (mRecordBufferIndex + 1) % sRequestBufferCount;
+			mRequestBuffers[mRecordBufferIndex].Count = 0;
+		}
+
+		std::vector<PassStats> passStats = std::move(mFrameStats.RenderPassStats);
+		mFrameStats = RenderStats();
+		mFrameStats.FramesInFlight = mFramesInFlight;
+		mFrameStats.RenderPassStats = std::move(passStats);
+		for (PassStats& pass : mFrameStats.RenderPassStats)
+		{
+			pass.CPUExecutionTime = 0.0;
+			pass.GPUExecutionTime = 0.0;
+		}
+
+		// Frame pacing, the object buffer, bindless tables and shared resources of this frame index are rewritten below,
+		// so every view that used them the last time this frame index came around has to be done with them
+		Timer waitTimer;
+		waitTimer.Start();
+
+		for (const Ref<RenderRequest>& request : requests)
+			request->View.Registry->WaitForFrame(mFrameIndex);
+
+		std::vector<Ref<ResourceRegistry>>& frameRegistries = mFrameRegistries[mFrameIndex];
+		for (const auto& registry : frameRegistries)
+			registry->WaitForFrame(mFrameIndex);
+
+		frameRegistries.clear();
+
+		waitTimer.Stop();
+		mFrameStats.CPUWaitTime = waitTimer.Query();
+
+		if (BindlessResourcesNeedUpdate())
 			UpdateBindlessResources();
+
+		for (const Ref<RenderRequest>& request : requests)
+		{
+			auto registry = request->View.Registry;
+			if (std::find(frameRegistries.begin(), frameRegistries.end(), registry) == frameRegistries.end())
+				frameRegistries.push_back(registry);
 		}
 
-		for (auto renderRequest : mRenderRequests)
+		UpdateObjects(requests);
+
+		// Views of the same world execute back to back so the first of them runs the shared passes for the rest
+		std::stable_sort(requests.begin(), requests.end(), [](const Ref<RenderRequest>& lhs, const Ref<RenderRequest>& rhs) {
+			return std::less<const void*>()(lhs->World, rhs->World);
+			});
+
+		// Timestamps trail the CPU by the frames in flight, the latest GPU time known is the one in the last stats.
+		// The queues run side by side, so the busier of the two bounds the frame
+		double graphicsTime = 0.0;
+		double computeTime = 0.0;
+		for (const PassStats& pass : mStats.RenderPassStats)
+			(pass.AsyncCompute ? computeTime : graphicsTime) += pass.GPUExecutionTime;
+
+		double gpuTime = std::max(graphicsTime, computeTime);
+
+		// Enabling passes rebakes the graph, so the shadow path only changes between frames
+		if (mShadowVertexLayerPass)
 		{
-			mRenderGraph->Execute(renderRequest.Commands, renderRequest.Camera, mFrameIndex);
+			mRenderGraph->SetPassEnabled(mShadowVertexLayerPass, mVertexShadowLayers);
+			mRenderGraph->SetPassEnabled(mShadowGeometryLayerPass, !mVertexShadowLayers);
 		}
 
-		mRenderRequests.clear();
+		bool dynamicResolution = mDynamicResolution.GetSettings().Enabled;
+		float renderScale = mDynamicResolution.Update(gpuTime);
+		mFrameStats.RenderScale = dynamicResolution ? renderScale : 1.f;
+
+		for (uint32_t i = 0; i < requests.size(); i++)
+		{
+			const Ref<RenderRequest>& request = requests[i];
 
-		mFrameIndex ^= 1;
+			// Shared resources hold one world at a time, the shared passes of the next world wait on the GPU for the last one
+			if (i == 0)
+				mRenderGraph->BeginFrame();
+			else if (request->World != requests[i - 1]->World)
+				mRenderGraph->BeginWorld();
+
+			if (i == 0 || request->World != requests[i - 1]->World)
+			{
+				mWorldViews.clear();
+				for (uint32_t j = i; j < requests.size() && requests[j]->World == request->World; j++)
+					mWorldViews.push_back(&requests[j]->View);
+			}
+
+			// Full scale once dynamic resolution is off, registries otherwise keep the last scale it picked
+			request->View.Registry->SetRenderScale(dynamicResolution ? renderScale : 1.f);
+
+			mExecutingWorld = request->World;
+			mRenderGraph->Execute(request->Commands, request->View, mFrameIndex, &mFrameStats);
+
+			// The registry is kept alive by the frame registries until its frame completes
+			request->View.Registry = nullptr;
+		}
+
+		// Every view of the frame goes to the driver at once
+		mRenderGraph->Flush();
+
+		GraphicsCounterValues counters = GraphicsCounters::Flush();
+		mFrameStats.DescriptorUpdates = counters.DescriptorUpdates;
+		mFrameStats.Uploads = counters.Uploads;
+		mFrameStats.UploadBytes = counters.UploadBytes;
+		mFrameStats.Barriers = counters.Barriers;
+		mFrameStats.ImageBarriers = counters.ImageBarriers;
+		mFrameStats.QueueSubmits = counters.QueueSubmits;
+		mStats = mFrameStats;
+
+		std::erase_if(mLodHistory, [&](const auto& entry) { return entry.second.LastFrame != mFrameNumber; });
+		std::erase_if(mHiZViews, [&](const auto& entry) { return entry.second.LastFrame != mFrameNumber; });
+
+		mFrameIndex = (mFrameIndex + 1) % mFramesInFlight;
+		mFrameNumber++;
 	}
 
-	void Renderer::AddTexture(WeakRef<Texture> texture)
+	RenderGraphDump Renderer::DumpRenderGraph() const
+	{
+		uint32_t frameIndex = (mFrameIndex + mFramesInFlight - 1) % mFramesInFlight;
+		const std::vector<Ref<ResourceRegistry>>& registries = mFrameRegistries[frameIndex];
+		const ResourceRegistry* registry = registries.empty() ? nullptr : registries.back().Get();
+
+		return mRenderGraph->Dump(&mStats, registry, frameIndex);
+	}
+
+	void Renderer::RemoveObject(const void* world, uint64_t objectId)
 	{
 		std::lock_guard<std::mutex> lock(mResourceMutex);
+		mObjectRemovals.emplace_back(world, objectId);
+	}
 
-		for (uint32_t i = 0; i < mFramesInFlight; i++)
+	void Renderer::RemoveWorld(const void* world)
+	{
 		{
-			mResourceUpdates[i].AddTextures.push_back(texture);
+			// A new world may be created at the same address before the next call to Render, its objects must not be
+			// confused with the ones of a request this world left behind
+			std::lock_guard<std::mutex> lock(mMutex);
+			RenderRequestBuffer& buffer = mRequestBuffers[mRecordBufferIndex];
+			for (uint32_t i = 0; i < buffer.Count; i++)
+			{
+				if (buffer.Requests[i]->World == world)
+					buffer.Requests[i]->Submitted = false;
+			}
 		}
+
+		std::lock_guard<std::mutex> lock(mResourceMutex);
+		mWorldRemovals.push_back(world);
+	}
+
+	void Renderer::AddTexture(WeakRef<Texture> texture)
+	{
+		std::lock_guard<std::mutex> lock(mResourceMutex);
+
+		mResourceUpdates.AddTextures.push_back(texture);
 	}
 
 	void Renderer::RemoveTexture(WeakRef<Texture> texture)
 	{
 		std::lock_guard<std::mutex> lock(mResourceMutex);
 
-		for (uint32_t i = 0; i < mFramesInFlight; i++)
-		{
-			mResourceUpdates[i].RemoveTextures.push_back(texture);
-		}
+		mResourceUpdates.RemoveTextures.push_back(texture);
 	}
 
 	void Renderer::AddMaterial(WeakRef<Material> material)
 	{
 		std::lock_guard<std::mutex> lock(mResourceMutex);
 
-		for (uint32_t i = 0; i < mFramesInFlight; i++)
-		{
-			mResourceUpdates[i].AddMaterials.push_back(material);
-		}
+		mResourceUpdates.AddMaterials.push_back(material);
 	}
 
 	void Renderer::UpdateMaterial(WeakRef<Material> material)
 	{
 		std::lock_guard<std::mutex> lock(mResourceMutex);
 
-		for (uint32_t i = 0; i < mFramesInFlight; i++)
-		{
-			mResourceUpdates[i].UpdateMaterials.push_back(material);
-		}
+		mResourceUpdates.UpdateMaterials.push_back(material);
 	}
 
 	void Renderer::RemoveMaterial(WeakRef<Material> material)
 	{
 		std::lock_guard<std::mutex> lock(mResourceMutex);
 
-		for (uint32_t i = 0; i < mFramesInFlight; i++)
-		{
-			mResourceUpdates[i].RemoveMaterials.push_back(material);
-		}
+		mResourceUpdates.RemoveMaterials.push_back(material);
 	}
 
 	void Renderer::BuildGraph()
@@ -283,22 +524,36 @@ namespace Mule
 
 		ResourceHandle shadowDepthSampler = mResourceBuilder.CreateSampler("Sampler.Shadow.Depth", depthSamplerDesc);
 
+		SamplerDescription upscaleSamplerDesc{};
+		upscaleSamplerDesc.AddressModeU = SamplerAddressMode::ClampToEdge;
+		upscaleSamplerDesc.AddressModeV = SamplerAddressMode::ClampToEdge;
+		upscaleSamplerDesc.AddressModeW = SamplerAddressMode::ClampToEdge;
+
+		ResourceHandle upscaleSampler = mResourceBuilder.CreateSampler("Sampler.Upscale", upscaleSamplerDesc);
+
 		// Uniform Buffers
 		ResourceHandle cameraBuffer = mResourceBuilder.CreateUniformBuffer("Buffer.Camera", sizeof(GPU::Camera));
 		ResourceHandle directionalLightBuffer = mResourceBuilder.CreateUniformBuffer("Buffer.DirectionalLight", sizeof(GPU::DirectionalLight));
-		ResourceHandle pointLightBuffer = mResourceBuilder.CreateUniformBuffer("Buffer.PointLight", sizeof(GPU::PointLightArray));
-		ResourceHandle spotLightBuffer = mResourceBuilder.CreateUniformBuffer("Buffer.SpotLights", sizeof(GPU::SpotLightArray));
-		ResourceHandle shadowDepthLightCameras = mResourceBuilder.CreateUniformBuffer("Buffer.Depth.LightCameras", sizeof(GPU::CascadedShadowLightMatrices));
+		ResourceHandle lightClusterInfoBuffer = mResourceBuilder.CreateUniformBuffer("Buffer.LightClusterInfo", sizeof(GPU::LightClusterInfo));
+
+		// Storage Buffers
+		ResourceHandle gBufferDrawArgs = mResourceBuilder.CreateStorageBuffer("Buffer.GBuffer.DrawArgs", sizeof(GPU::DrawIndexedIndirectCommand) * 256);
+		ResourceHandle gBufferInstances = mResourceBuilder.CreateStorageBuffer("Buffer.GBuffer.Instances", sizeof(uint32_t) * 1024);
+		ResourceHandle pointLightBuffer = mResourceBuilder.CreateStorageBuffer("Buffer.PointLights", sizeof(GPU::PointLight) * 64);
+		ResourceHandle spotLightBuffer = mResourceBuilder.CreateStorageBuffer("Buffer.SpotLights", sizeof(GPU::SpotLight) * 64);
+		ResourceHandle lightClusterBuffer = mResourceBuilder.CreateStorageBuffer("Buffer.LightClusters", sizeof(GPU::LightCluster) * LIGHT_CLUSTER_COUNT);
+		ResourceHandle lightIndexBuffer = mResourceBuilder.CreateStorageBuffer("Buffer.LightIndices", sizeof(uint32_t) * 4096);
+		ResourceHandle hiZBuffer = mResourceBuilder.CreateStorageBuffer("Buffer.HiZ", sizeof(float) * HIZ_WIDTH * HIZ_HEIGHT);
 
 		// Render Targets
-		ResourceHandle gBufferAlbedo = mResourceBuilder.CreateTexture2D("GBuffer.Albedo", TextureFormat::RGBA_32F, TextureFlags::RenderTarget);
-		ResourceHandle gBufferPosition = mResourceBuilder.CreateTexture2D("GBuffer.Position", TextureFormat::RGBA_32F, TextureFlags::RenderTarget);
-		ResourceHandle gBufferNormal = mResourceBuilder.CreateTexture2D("GBuffer.Normal", TextureFormat::RGBA_32F, TextureFlags::RenderTarget);
-		ResourceHandle gBufferPBRFactor = mResourceBuilder.CreateTexture2D("GBuffer.PBRFactor", TextureFormat::RGBA_32F, TextureFlags::RenderTarget);
+		// World position is rebuilt from depth and normals are octahedral encoded, see DeferredLightingPass.glsl
+		ResourceHandle gBufferAlbedo = mResourceBuilder.CreateTexture2D("GBuffer.Albedo", TextureFormat::RGBA_8U_SRGB, TextureFlags::RenderTarget);
+		ResourceHandle gBufferNormal = mResourceBuilder.CreateTexture2D("GBuffer.Normal", TextureFormat::RG_16SN, TextureFlags::RenderTarget);
+		ResourceHandle gBufferPBRFactor = mResourceBuilder.CreateTexture2D("GBuffer.PBRFactor", TextureFormat::RGBA_8U, TextureFlags::RenderTarget);
 		ResourceHandle gBufferDepth = mResourceBuilder.CreateTexture2D("GBuffer.Depth", TextureFormat::D_32F, TextureFlags::DepthAttachment);
-		ResourceHandle shadowDepthTexture = mResourceBuilder.CreateTexture2DArray("Shadow.Depth", 4, TextureFormat::D_32F, TextureFlags::DepthAttachment);
 
 		ResourceHandle mainOutput = mResourceBuilder.CreateTexture2D("MainOutput", TextureFormat::RGBA_32F, TextureFlags::RenderTarget | TextureFlags::StorageImage);
+		ResourceHandle displayOutput = mResourceBuilder.CreateTexture2D("DisplayOutput", TextureFormat::RGBA_32F, TextureFlags::RenderTarget | TextureFlags::StorageImage, true);
 
 		// Shader ResourceGroups
 		ResourceHandle cameraShaderResourceGroup = mResourceBuilder.CreateSRG("SRG.Camera", {
@@ -307,8 +562,11 @@ namespace Mule
 
 		ResourceHandle lightShaderResourceGroup = mResourceBuilder.CreateSRG("SRG.Lighting", {
 			ShaderResourceDescription(0, ShaderResourceType::UniformBuffer, ShaderStage::Compute), // Directional Light Buffer
-			ShaderResourceDescription(1, ShaderResourceType::UniformBuffer, ShaderStage::Compute), // Point Light Buffer
-			ShaderResourceDescription(2, ShaderResourceType::UniformBuffer, ShaderStage::Compute), // Spot Light Buffer
+			ShaderResourceDescription(1, ShaderResourceType::StorageBuffer, ShaderStage::Compute), // Point Light Buffer
+			ShaderResourceDescription(2, ShaderResourceType::StorageBuffer, ShaderStage::Compute), // Spot Light Buffer
+			ShaderResourceDescription(3, ShaderResourceType::UniformBuffer, ShaderStage::Compute), // Light Cluster Info
+			ShaderResourceDescription(4, ShaderResourceType::StorageBuffer, ShaderStage::Compute), // Light Clusters
+			ShaderResourceDescription(5, ShaderResourceType::StorageBuffer, ShaderStage::Compute), // Light Indices
 			});
 
 		ResourceHandle lightingGBufferShaderResourceGroup = mResourceBuilder.CreateSRG("SRG.Lighting.GBuffer", {
@@ -327,13 +585,24 @@ namespace Mule
 			ShaderResourceDescription(0, ShaderResourceType::Sampler, ShaderStage::Fragment),
 			});
 
-		ResourceHandle shadowDepthLightSpaceMatrices = mResourceBuilder.CreateSRG("SRG.Depth.LightCameras", {
-			ShaderResourceDescription(0, ShaderResourceType::UniformBuffer, ShaderStage::Geometry),
+		ResourceHandle lightingPassShadowSRG = mResourceBuilder.CreateSRG("SRG.Lighting.Shadow", {
+			ShaderResourceDescription(0, ShaderResourceType::Sampler, ShaderStage::Compute),
+			ShaderResourceDescription(1, ShaderResourceType::UniformBuffer, ShaderStage::Compute),
+			ShaderResourceDescription(2, ShaderResourceType::Sampler, ShaderStage::Compute)
 			});
 
-		ResourceHandle lightingPassShadowSRG = mResourceBuilder.CreateSRG("SRG.Lighting.Shadow", {
+		ResourceHandle gBufferInstanceSRG = mResourceBuilder.CreateSRG("SRG.GBuffer.Instances", {
+			ShaderResourceDescription(0, ShaderResourceType::StorageBuffer, ShaderStage::Vertex),
+			});
+
+		ResourceHandle upscaleShaderResourceGroup = mResourceBuilder.CreateSRG("SRG.Upscale", {
+			ShaderResourceDescription(0, ShaderResourceType::StorageImage, ShaderStage::Compute),
+			ShaderResourceDescription(1, ShaderResourceType::Sampler, ShaderStage::Compute),
+			});
+
+		ResourceHandle hiZShaderResourceGroup = mResourceBuilder.CreateSRG("SRG.HiZ", {
 			ShaderResourceDescription(0, ShaderResourceType::Sampler, ShaderStage::Compute),
-			ShaderResourceDescription(1, ShaderResourceType::UniformBuffer, ShaderStage::Compute)
+			ShaderResourceDescription(1, ShaderResourceType::StorageBuffer, ShaderStage::Compute),
 			});
 
 		ResourceHandle lihgtingPassIBLSRG = mResourceBuilder.CreateSRG("SRG.lighting.IBL", {
@@ -342,56 +611,125 @@ namespace Mule
 			ShaderResourceDescription(2, ShaderResourceType::Sampler, ShaderStage::Compute),
 			});
 
+		// Shadow pass inputs are written from the CPU, so each view keeps its own even though only the first view of a world draws shadows
+		ResourceHandle shadowDepthLightCameras = mResourceBuilder.CreateUniformBuffer("Buffer.Depth.LightCameras", sizeof(GPU::CascadedShadowLightMatrices));
+		ResourceHandle shadowDrawArgs = mResourceBuilder.CreateStorageBuffer("Buffer.Shadow.DrawArgs", sizeof(GPU::DrawIndexedIndirectCommand) * 256);
+		ResourceHandle shadowInstances = mResourceBuilder.CreateStorageBuffer("Buffer.Shadow.Instances", sizeof(uint32_t) * 1024);
+		ResourceHandle staticShadowDrawArgs = mResourceBuilder.CreateStorageBuffer("Buffer.StaticShadow.DrawArgs", sizeof(GPU::DrawIndexedIndirectCommand) * 256);
+		ResourceHandle staticShadowInstances = mResourceBuilder.CreateStorageBuffer("Buffer.StaticShadow.Instances", sizeof(uint32_t) * 1024);
+
+		ResourceHandle shadowDepthLightSpaceMatrices = mResourceBuilder.CreateSRG("SRG.Depth.LightCameras", {
+			ShaderResourceDescription(0, ShaderResourceType::UniformBuffer, ShaderStage::Geometry),
+			});
+
+		ResourceHandle shadowDepthLayeredLightSpaceMatrices = mResourceBuilder.CreateSRG("SRG.Depth.LightCameras.Vertex", {
+			ShaderResourceDescription(0, ShaderResourceType::UniformBuffer, ShaderStage::Vertex),
+			});
+
+		ResourceHandle shadowInstanceSRG = mResourceBuilder.CreateSRG("SRG.Shadow.Instances", {
+			ShaderResourceDescription(0, ShaderResourceType::StorageBuffer, ShaderStage::Vertex),
+			});
+
+		ResourceHandle staticShadowInstanceSRG = mResourceBuilder.CreateSRG("SRG.StaticShadow.Instances", {
+			ShaderResourceDescription(0, ShaderResourceType::StorageBuffer, ShaderStage::Vertex),
+			});
+
+		// Shared Resources, shadows are rendered for the first view of each world and sampled by the rest. Only the GPU writes
+		// them, so the next world waits for them on the GPU, see RenderGraph::BeginWorld
+		ResourceHandle shadowDepthTexture = mSharedResourceBuilder.CreateTexture2DArray("Shadow.Depth", sShadowMapSize, sShadowMapSize, sShadowCascadeCount, TextureFormat::D_32F, TextureFlags::DepthAttachment);
+
+		// Static casters are kept in their own layers across frames, see StaticShadowCache
+		ResourceHandle staticShadowDepthTexture = mSharedResourceBuilder.CreateTexture2DArray("Shadow.StaticDepth", sShadowMapSize, sShadowMapSize, sShadowCascadeCount, TextureFormat::D_32F, TextureFlags::DepthAttachment);
+
+		mSharedRegistry = MakeRef<ResourceRegistry>(mFramesInFlight, mSharedResourceBuilder);
+
+
+		// Depth Pre-Pass, views that leave it off draw nothing here so the plan without it is used
+		{
+			WeakRef<GraphicsPipeline> depthPrePassPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline("DepthPrePass");
+			WeakRef<RenderPass> depthPrePass = mRenderGraph->CreatePass("Depth Pre-Pass", PassType::Graphics);
+			depthPrePass->AddCommandType(RenderCommandType::Draw);
+			depthPrePass->AddResource(gBufferDepth, ResourceAccess::Write);
+			depthPrePass->AddResource(cameraShaderResourceGroup, ResourceAccess::Read, 0);
+			depthPrePass->AddResource(mObjectSRGHandle, ResourceAccess::Read, 1);
+			depthPrePass->AddResource(gBufferInstanceSRG, ResourceAccess::Read, 2);
+			depthPrePass->SetPipeline(depthPrePassPipeline);
+
+			depthPrePass->SetRangeExecutionCallback([this](const CommandList& commandList) {
+				return mDepthPrePass ? static_cast<uint32_t>(mGBufferDrawList.Commands.size()) : 0u;
+				},
+				[=, this](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex, DrawRange range) {
+				auto argumentBuffer = registry.GetResource<StorageBuffer>(gBufferDrawArgs, frameIndex);
+
+				for (uint32_t i = range.First; i < range.First + range.Count; i++)
+				{
+					cmd->BindMesh(mGBufferDrawList.Meshes[i]);
+					cmd->DrawMeshIndirect(argumentBuffer, i * sizeof(GPU::DrawIndexedIndirectCommand), 1);
+				}
+				});
+		}
 
 		// GBuffer Pass
 		{
 			WeakRef<GraphicsPipeline> gBufferPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline("Geometry");
+			WeakRef<GraphicsPipeline> gBufferDepthEqualPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline("GeometryDepthEqual");
 			WeakRef<RenderPass> GBufferPass = mRenderGraph->CreatePass("GBuffer Pass", PassType::Graphics);
 			GBufferPass->AddCommandType(RenderCommandType::Draw);
 			GBufferPass->AddResource(gBufferAlbedo, ResourceAccess::Write, 0);
-			GBufferPass->AddResource(gBufferPosition, ResourceAccess::Write, 1);
-			GBufferPass->AddResource(gBufferNormal, ResourceAccess::Write, 2);
-			GBufferPass->AddResource(gBufferPBRFactor, ResourceAccess::Write, 3);
+			GBufferPass->AddResource(gBufferNormal, ResourceAccess::Write, 1);
+			GBufferPass->AddResource(gBufferPBRFactor, ResourceAccess::Write, 2);
 			GBufferPass->AddResource(gBufferDepth, ResourceAccess::Write);
 			GBufferPass->AddResource(cameraShaderResourceGroup, ResourceAccess::Read, 0);
 			GBufferPass->AddResource(mBindlessTextureSRGHandle, ResourceAccess::Read, 1);
 			GBufferPass->AddResource(mBindlessMaterialSRGHandle, ResourceAccess::Read, 2);
+			GBufferPass->AddResource(mObjectSRGHandle, ResourceAccess::Read, 3);
+			GBufferPass->AddResource(gBufferInstanceSRG, ResourceAccess::Read, 4);
 			GBufferPass->SetPipeline(gBufferPipeline);
+			GBufferPass->SetPrimedDepthPipeline(gBufferDepthEqualPipeline);
+			GBufferPass->AddDependency("Depth Pre-Pass");
 
-			GBufferPass->SetExecutionCallback([=](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex) {
-				// This isn't necessary for this pass because we only accept one command type but it will be good to che kin the future
-				for (const auto& command : commandList.GetCommands())
-				{
-					if (command.GetType() == RenderCommandType::Draw) {
-
-						const DrawCommand& drawCommand = command.GetCommand<DrawCommand>();
-						WeakRef<Material> material = drawCommand.Material;
-						glm::mat4 transform = drawCommand.ModelMatrix;
+			GBufferPass->SetRangeExecutionCallback([this](const CommandList& commandList) {
+				return static_cast<uint32_t>(mGBufferDrawList.Commands.size());
+				},
+				[=, this](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex, DrawRange range) {
+				auto argumentBuffer = registry.GetResource<StorageBuffer>(gBufferDrawArgs, frameIndex);
 
-						if (material && material->Transparent)
-							return;
-
-						uint32_t materialIndex = 0;
-						if (drawCommand.Material)
-							materialIndex = material->GlobalIndex;
-
-						cmd->SetPushConstants(gBufferPipeline, ShaderStage::Vertex, &transform[0][0], sizeof(transform));
-						cmd->SetPushConstants(gBufferPipeline, ShaderStage::Fragment, &materialIndex, sizeof(materialIndex));
-						cmd->BindAndDrawMesh(drawCommand.Mesh, 1);
-					}
+				for (uint32_t i = range.First; i < range.First + range.Count; i++)
+				{
+					cmd->BindMesh(mGBufferDrawList.Meshes[i]);
+					cmd->DrawMeshIndirect(argumentBuffer, i * sizeof(GPU::DrawIndexedIndirectCommand), 1);
 				}
 				});
 		}
 
+		// Hi-Z Pass, reduces the depth buffer so the next time this frame index renders it can occlusion cull against it.
+		// It stays on the graphics queue, lighting reads the same depth right after it so nothing would overlap it
+		{
+			WeakRef<ComputePipeline> hiZPipeline = ShaderFactory::Get().GetOrCreateComputePipeline("HiZDownsample");
+			WeakRef<RenderPass> hiZPass = mRenderGraph->CreatePass("HiZ Pass", PassType::Compute);
+			hiZPass->AddResource(gBufferDepth, ResourceAccess::Read);
+			hiZPass->AddResource(hiZShaderResourceGroup, ResourceAccess::Read, 0);
+			hiZPass->SetPipeline(hiZPipeline);
+			hiZPass->SetHasSideEffects(true);
+			hiZPass->SetExecutionCallback([=](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex) {
+				// The depth buffer only holds the view up to the render extent
+				glm::uvec2 sizes[2] = { glm::uvec2(HIZ_WIDTH, HIZ_HEIGHT), glm::uvec2(registry.GetRenderWidth(frameIndex), registry.GetRenderHeight(frameIndex)) };
+				cmd->SetPushConstants(hiZPipeline, sizes, sizeof(sizes));
+				cmd->Execute((HIZ_WIDTH + 15) / 16, (HIZ_HEIGHT + 15) / 16, 1);
+				cmd->ReadbackBarrier(registry.GetResource<StorageBuffer>(hiZBuffer, frameIndex));
+				});
+		}
+
 		// Lighting Pass
 		{
 			WeakRef<ComputePipeline> lightingPassPipeline = ShaderFactory::Get().GetOrCreateComputePipeline("DeferredLighting");
 			WeakRef<RenderPass> compositePass = mRenderGraph->CreatePass("Composite Pass", PassType::Compute);
 			compositePass->AddResource(gBufferAlbedo, ResourceAccess::Read);
-			compositePass->AddResource(gBufferPosition, ResourceAccess::Read);
 			compositePass->AddResource(gBufferNormal, ResourceAccess::Read);
 			compositePass->AddResource(gBufferPBRFactor, ResourceAccess::Read);
+			compositePass->AddResource(gBufferDepth, ResourceAccess::Read);
 			compositePass->AddResource(shadowDepthTexture, ResourceAccess::Read);
+			compositePass->AddResource(staticShadowDepthTexture, ResourceAccess::Read);
 			compositePass->AddResource(mainOutput, ResourceAccess::Write);
 			compositePass->AddResource(lightingGBufferShaderResourceGroup, ResourceAccess::Read, 0);
 			compositePass->AddResource(lightShaderResourceGroup, ResourceAccess::Read, 1);
@@ -401,9 +739,9 @@ namespace Mule
 			compositePass->SetPipeline(lightingPassPipeline);
 			compositePass->SetExecutionCallback([=](Ref<CommandBuffer> cmd, const CommandList& command, const ResourceRegistry& registry, uint32_t frameIndex) {
 
-				uint32_t width = registry.GetWidth(frameIndex) + 15;
-				uint32_t height = registry.GetHeight(frameIndex) + 15;
-				cmd->Execute(width / 16, height / 16, 1);
+				glm::uvec2 renderSize = glm::uvec2(registry.GetRenderWidth(frameIndex), registry.GetRenderHeight(frameIndex));
+				cmd->SetPushConstants(lightingPassPipeline, &renderSize, sizeof(glm::uvec2));
+				cmd->Execute((renderSize.x + 15) / 16, (renderSize.y + 15) / 16, 1);
 				});
 		}
 
@@ -412,17 +750,15 @@ namespace Mule
 			WeakRef<GraphicsPipeline> environmentPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline("EnvironmentMap");
 			auto skyboxPass = mRenderGraph->CreatePass("Skybox", PassType::Graphics);
 			skyboxPass->AddDependency("Composite Pass");
+			skyboxPass->AddCommandType(RenderCommandType::DrawSkyBox);
 			skyboxPass->SetPipeline(environmentPipeline);
 			skyboxPass->AddResource(mainOutput, ResourceAccess::Write, 0);
-			skyboxPass->AddResource(gBufferDepth, ResourceAccess::Write); // Set this to write even though we dont so that it will get bound for testing
+			skyboxPass->AddResource(gBufferDepth, ResourceAccess::DepthTest);
 			skyboxPass->AddResource(cameraShaderResourceGroup, ResourceAccess::Read, 0);
 			skyboxPass->AddResource(skyboxEnvironmentMapShaderResourceGroup, ResourceAccess::Read, 1);
 			skyboxPass->SetExecutionCallback([=](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex) {
-				for (const auto& command : commandList.GetCommands())
+				for (const auto& command : commandList.GetCommands(RenderCommandType::DrawSkyBox))
 				{
-					if (command.GetType() != RenderCommandType::DrawSkyBox)
-						continue;
-			
 					const auto& skyBoxCommand = command.GetCommand<DrawSkyboxCommand>();
 			
 					cmd->BindAndDrawMesh(skyBoxCommand.CubeMesh, 1);
@@ -430,35 +766,243 @@ namespace Mule
 				});
 		}
 
-		// Depth Pass
+		// Upscale Pass, stretches the render extent of the main output over the display extent
 		{
+			WeakRef<ComputePipeline> upscalePipeline = ShaderFactory::Get().GetOrCreateComputePipeline("Upscale");
+			WeakRef<RenderPass> upscalePass = mRenderGraph->CreatePass("Upscale Pass", PassType::Compute);
+			upscalePass->AddResource(mainOutput, ResourceAccess::Read);
+			upscalePass->AddResource(displayOutput, ResourceAccess::Write);
+			upscalePass->AddResource(upscaleShaderResourceGroup, ResourceAccess::Read, 0);
+			upscalePass->SetPipeline(upscalePipeline);
+			upscalePass->SetExecutionCallback([=](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex) {
+				glm::uvec2 sizes[2] = {
+					glm::uvec2(registry.GetWidth(frameIndex), registry.GetHeight(frameIndex)),
+					glm::uvec2(registry.GetRenderWidth(frameIndex), registry.GetRenderHeight(frameIndex))
+				};
+
+				cmd->SetPushConstants(upscalePipeline, sizes, sizeof(sizes));
+				cmd->Execute((sizes[0].x + 15) / 16, (sizes[0].y + 15) / 16, 1);
+				});
+		}
+
+		// Depth Passes, only one of the dynamic passes is enabled. The layered pass picks the cascade layer in the vertex shader
+		// and is only built when the device allows that, see SetVertexShadowLayers
+		{
+			auto drawCascades = [=, this](WeakRef<GraphicsPipeline> pipeline, ShaderStage cascadeStage, const IndirectDrawList* drawList, const std::vector<uint32_t>* commandCascades, ResourceHandle argumentHandle) {
+				return [=, this](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex, DrawRange range) {
+					auto argumentBuffer = registry.GetResource<StorageBuffer>(argumentHandle, frameIndex);
+
+					uint32_t cascade = UINT32_MAX;
+					for (uint32_t i = range.First; i < range.First + range.Count; i++)
+					{
+						// Commands are grouped by cascade, the cascade is pushed to the stage that routes the draw to its layer
+						if ((*commandCascades)[i] != cascade)
+						{
+							cascade = (*commandCascades)[i];
+							cmd->SetPushConstants(pipeline, cascadeStage, &cascade, sizeof(uint32_t));
+						}
+
+						cmd->BindMesh(drawList->Meshes[i]);
+						cmd->DrawMeshIndirect(argumentBuffer, i * sizeof(GPU::DrawIndexedIndirectCommand), 1);
+					}
+					};
+				};
+
+			auto drawCount = [this](const CommandList& commandList) {
+				return static_cast<uint32_t>(mShadowDrawList.Commands.size());
+				};
+
 			WeakRef<GraphicsPipeline> depthPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline("ShadowDepth");
 			WeakRef<RenderPass> depthPass = mRenderGraph->CreatePass("Depth", PassType::Graphics);
 			depthPass->SetPipeline(depthPipeline);
+			depthPass->SetShared(true);
+			depthPass->AddCommandType(RenderCommandType::Draw);
 			depthPass->AddResource(shadowDepthLightSpaceMatrices, ResourceAccess::Read, 0);
+			depthPass->AddResource(mObjectSRGHandle, ResourceAccess::Read, 1);
+			depthPass->AddResource(shadowInstanceSRG, ResourceAccess::Read, 2);
 			depthPass->AddResource(shadowDepthTexture, ResourceAccess::Write, 0);
-			depthPass->SetExecutionCallback([=](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex) {
-				
-				for (const auto& command : commandList.GetCommands())
-				{
-					if (command.GetType() != RenderCommandType::Draw)
-						continue;
+			depthPass->SetRangeExecutionCallback(drawCount, drawCascades(depthPipeline, ShaderStage::Geometry, &mShadowDrawList, &mShadowCommandCascades, shadowDrawArgs));
+			mShadowGeometryLayerPass = depthPass;
 
-					const auto& drawCommand = command.GetCommand<DrawCommand>();
+			if (GraphicsContext::Get().SupportsVertexLayerOutput())
+			{
+				WeakRef<GraphicsPipeline> depthLayeredPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline("ShadowDepthLayered");
+				WeakRef<RenderPass> depthLayeredPass = mRenderGraph->CreatePass("Depth Layered", PassType::Graphics);
+				depthLayeredPass->SetPipeline(depthLayeredPipeline);
+				depthLayeredPass->SetShared(true);
+				depthLayeredPass->AddCommandType(RenderCommandType::Draw);
+				depthLayeredPass->AddResource(shadowDepthLayeredLightSpaceMatrices, ResourceAccess::Read, 0);
+				depthLayeredPass->AddResource(mObjectSRGHandle, ResourceAccess::Read, 1);
+				depthLayeredPass->AddResource(shadowInstanceSRG, ResourceAccess::Read, 2);
+				depthLayeredPass->AddResource(shadowDepthTexture, ResourceAccess::Write, 0);
+				depthLayeredPass->SetRangeExecutionCallback(drawCount, drawCascades(depthLayeredPipeline, ShaderStage::Vertex, &mShadowDrawList, &mShadowCommandCascades, shadowDrawArgs));
+				mShadowVertexLayerPass = depthLayeredPass;
+
+				mVertexShadowLayers = true;
+				mRenderGraph->SetPassEnabled(mShadowGeometryLayerPass, false);
+			}
 
-					glm::mat4 transform = drawCommand.ModelMatrix;
-					cmd->SetPushConstants(depthPipeline, ShaderStage::Vertex, &transform[0][0], sizeof(transform));
-					cmd->BindAndDrawMesh(drawCommand.Mesh, 1);
+			// Static casters only go into the cascades that went stale. Their layers persist between frames and are sampled
+			// along with the dynamic ones, redrawing them is rare enough that the layered pipeline is used whenever it exists
+			bool vertexLayers = GraphicsContext::Get().SupportsVertexLayerOutput();
+			WeakRef<GraphicsPipeline> staticDepthPipeline = ShaderFactory::Get().GetOrCreateGraphicsPipeline(vertexLayers ? "ShadowDepthLayered" : "ShadowDepth");
+			ShaderStage staticCascadeStage = vertexLayers ? ShaderStage::Vertex : ShaderStage::Geometry;
+
+			auto drawStaticCascades = drawCascades(staticDepthPipeline, staticCascadeStage, &mStaticShadowDrawList, &mStaticShadowCommandCascades, staticShadowDrawArgs);
+
+			// A stale layer can be left with nothing to draw, so a pass with stale layers always records at least one range
+			auto staticDrawCount = [this](const CommandList& commandList) {
+				if (mStaleStaticCascades.empty())
+					return 0u;
+
+				return std::max(static_cast<uint32_t>(mStaticShadowDrawList.Commands.size()), 1u);
+				};
+
+			WeakRef<RenderPass> staticDepthPass = mRenderGraph->CreatePass("Static Depth", PassType::Graphics);
+			staticDepthPass->SetPipeline(staticDepthPipeline);
+			staticDepthPass->SetShared(true);
+			staticDepthPass->AddCommandType(RenderCommandType::Draw);
+			staticDepthPass->AddResource(vertexLayers ? shadowDepthLayeredLightSpaceMatrices : shadowDepthLightSpaceMatrices, ResourceAccess::Read, 0);
+			staticDepthPass->AddResource(mObjectSRGHandle, ResourceAccess::Read, 1);
+			staticDepthPass->AddResource(staticShadowInstanceSRG, ResourceAccess::Read, 2);
+			staticDepthPass->AddResource(staticShadowDepthTexture, ResourceAccess::Write, 0);
+			staticDepthPass->SetRangeExecutionCallback(staticDrawCount, [=, this](Ref<CommandBuffer> cmd, const CommandList& commandList, const ResourceRegistry& registry, uint32_t frameIndex, DrawRange range) {
+				// Ranges replay in order, so the first one clears the stale layers before anything is drawn into them
+				if (range.First == 0)
+				{
+					for (uint32_t cascade : mStaleStaticCascades)
+						cmd->ClearDepthAttachmentLayer(cascade, sShadowMapSize, sShadowMapSize);
 				}
+
+				uint32_t commandCount = static_cast<uint32_t>(mStaticShadowDrawList.Commands.size());
+				range.Count = std::min(range.Count, commandCount - std::min(range.First, commandCount));
+				drawStaticCascades(cmd, commandList, registry, frameIndex, range);
 				});
+
+			mRenderGraph->SetPersistent(staticShadowDepthTexture);
 		}
 				
+		mRenderGraph->SetOutputHandle(displayOutput);
 		mRenderGraph->Bake();
 
 		// Callbacks
 
-		mRenderGraph->SetPreExecutionCallback([=](const Camera& camera, const CommandList& commandList, uint32_t frameIndex) {
-			auto registry = camera.GetRegistry();
+		mRenderGraph->SetPreExecutionCallback([=, this](const RenderView& view, const CommandList& commandList, uint32_t frameIndex, bool sharedPasses) {
+			auto registry = view.Registry;
+
+			// Indirect draws, object data was already uploaded for every view in UpdateObjects
+			mGBufferDrawItems.clear();
+			mShadowCasters.clear();
+			mStaticShadowCasters.clear();
+			mDepthPrePass = view.DepthPrePass;
+
+			LodHistory& viewLodHistory = mLodHistory[registry->GetId()];
+			viewLodHistory.LastFrame = mFrameNumber;
+			auto& lodHistory = viewLodHistory.Levels;
+			float projectionScale = view.Proj[1][1];
+
+			// Frame pacing already waited on this frame index so its Hi-Z buffer holds the depth of the last time it rendered
+			HiZView& hiZ = mHiZViews[registry->GetId()];
+			hiZ.LastFrame = mFrameNumber;
+			if (hiZ.FrameRendered.empty())
+			{
+				hiZ.FrameViewProjections.resize(mFramesInFlight);
+				hiZ.FrameRendered.resize(mFramesInFlight, false);
+			}
+
+			if (hiZ.FrameRendered[frameIndex])
+			{
+				mHiZReadback.resize(HIZ_WIDTH * HIZ_HEIGHT);
+				auto hiZStorage = registry->GetResource<StorageBuffer>(hiZBuffer, frameIndex);
+				hiZStorage->ReadData(Buffer(mHiZReadback.data(), mHiZReadback.size() * sizeof(float)));
+
+				BuildHiZPyramid(mHiZReadback.data(), HIZ_WIDTH, HIZ_HEIGHT, hiZ.Pyramid);
+				hiZ.ViewProjection = hiZ.FrameViewProjections[frameIndex];
+				hiZ.Valid = true;
+			}
+
+			hiZ.FrameViewProjections[frameIndex] = view.ViewProj;
+			hiZ.FrameRendered[frameIndex] = true;
+
+			Frustum cameraFrustum(view.ViewProj);
+
+			for (const auto& command : commandList.GetCommands(RenderCommandType::Draw))
+			{
+				const DrawCommand& drawCommand = command.GetCommand<DrawCommand>();
+				if (!drawCommand.Mesh)
+					continue;
+
+				uint32_t objectIndex = mObjectTable.QueryIndex(mExecutingWorld, drawCommand.ObjectId);
+				if (objectIndex == UINT32_MAX)
+					continue;
+
+				const GPU::ObjectData& object = mObjectTable.GetObjects()[objectIndex];
+				glm::vec4 worldSphere = TransformBoundingSphere(object.Transform, object.BoundingSphere);
+
+				// Shadows reuse the level picked for this view so casters match what is on screen
+				uint32_t lodLevel = 0;
+				uint32_t lodCount = drawCommand.Mesh->GetLodCount();
+				if (lodCount > 1)
+				{
+					float screenSize = ComputeScreenSize(worldSphere, view.Position, projectionScale);
+
+					auto history = lodHistory.find(drawCommand.ObjectId);
+					lodLevel = SelectLod(screenSize, lodCount, history != lodHistory.end() ? history->second : UINT32_MAX);
+					lodHistory[drawCommand.ObjectId] = lodLevel;
+				}
+
+				const MeshLod& lod = drawCommand.Mesh->GetLod(lodLevel);
+				IndirectDrawItem item{ drawCommand.Mesh, lod.IndexCount, objectIndex, lod.FirstIndex };
+
+				if (drawCommand.CastsShadows && sharedPasses)
+					(drawCommand.Static ? mStaticShadowCasters : mShadowCasters).push_back(item);
+
+				if (drawCommand.Material && drawCommand.Material->Transparent)
+					continue;
+
+				if (!cameraFrustum.IntersectsSphere(worldSphere))
+					continue;
+
+				// Tested against the depth this view rendered last time this frame index came around, objects that were
+				// hidden then and have since come into view appear a frame late
+				if (hiZ.Valid && IsOccluded(hiZ.Pyramid, hiZ.ViewProjection, worldSphere))
+					continue;
+
+				mGBufferDrawItems.push_back(item);
+			}
+
+			BuildIndirectDrawList(mGBufferDrawItems, mGBufferDrawList);
+
+			auto uploadDrawList = [&](IndirectDrawList& drawList, ResourceHandle argumentHandle, ResourceHandle instanceHandle, ResourceHandle instanceSRGHandle) {
+				if (drawList.Commands.empty())
+					return;
+
+				auto argumentBuffer = registry->GetResource<StorageBuffer>(argumentHandle, frameIndex);
+				auto instanceBuffer = registry->GetResource<StorageBuffer>(instanceHandle, frameIndex);
+
+				uint32_t argumentSize = drawList.Commands.size() * sizeof(GPU::DrawIndexedIndirectCommand);
+				uint32_t instanceSize = drawList.InstanceObjectIndices.size() * sizeof(uint32_t);
+
+				argumentBuffer->Reserve(argumentSize);
+				if (instanceBuffer->Reserve(instanceSize))
+				{
+					auto instanceSRG = registry->GetResource<ShaderResourceGroup>(instanceSRGHandle, frameIndex);
+					instanceSRG->Update(0, instanceBuffer);
+				}
+
+				argumentBuffer->SetData(Buffer(drawList.Commands.data(), argumentSize));
+				instanceBuffer->SetData(Buffer(drawList.InstanceObjectIndices.data(), instanceSize));
+				};
+
+			uploadDrawList(mGBufferDrawList, gBufferDrawArgs, gBufferInstances, gBufferInstanceSRG);
+
+			auto countDraws = [&](const IndirectDrawList& drawList) {
+				mFrameStats.DrawCount += drawList.Commands.size();
+				for (const auto& drawCommand : drawList.Commands)
+					mFrameStats.TriangleCount += static_cast<uint64_t>(drawCommand.IndexCount / 3) * drawCommand.InstanceCount;
+				};
+
+			countDraws(mGBufferDrawList);
 			
 			auto skyboxSRG = registry->GetResource<ShaderResourceGroup>(skyboxEnvironmentMapShaderResourceGroup, frameIndex);
 
@@ -466,124 +1010,202 @@ namespace Mule
 			
 			ScopedBuffer cameraBuffer = ScopedBuffer(sizeof(GPU::Camera));
 			GPU::Camera* cameraBufferPtr = cameraBuffer.As<GPU::Camera>();
-			cameraBufferPtr->ViewProjection = camera.GetViewProj();
-			cameraBufferPtr->View = camera.GetView();
-			cameraBufferPtr->Proj = camera.GetProj();
-			cameraBufferPtr->Position = camera.GetPosition();
-			cameraBufferPtr->ViewDirection = camera.GetForwardDir();
+			cameraBufferPtr->ViewProjection = view.ViewProj;
+			cameraBufferPtr->View = view.View;
+			cameraBufferPtr->Proj = view.Proj;
+			cameraBufferPtr->Position = view.Position;
+			cameraBufferPtr->ViewDirection = view.ForwardDir;
+			cameraBufferPtr->InverseViewProjection = glm::inverse(cameraBufferPtr->ViewProjection);
 			
 			cameraUB->SetData(cameraBuffer);
 
 			ScopedBuffer directionalLightData(sizeof(GPU::DirectionalLight));
-			ScopedBuffer pointLightData(sizeof(GPU::PointLightArray));
-			ScopedBuffer spotLightData(sizeof(GPU::SpotLightArray));
-
 			memset(directionalLightData.GetData(), 0, sizeof(GPU::DirectionalLight));
-			memset(pointLightData.GetData(), 0, sizeof(GPU::PointLightArray));
-			memset(spotLightData.GetData(), 0, sizeof(GPU::SpotLightArray));
 
 			auto directionalLightUB = registry->GetResource<UniformBuffer>(directionalLightBuffer, frameIndex);
-			auto pointLightUB = registry->GetResource<UniformBuffer>(pointLightBuffer, frameIndex);
-			auto spotLightUB = registry->GetResource<UniformBuffer>(spotLightBuffer, frameIndex);
 
-			glm::vec3 directionalLightDirection;
-			for (const auto& command : commandList.GetCommands())
+			glm::vec3 directionalLightDirection = glm::vec3(0.f, -1.f, 0.f);
+			bool hasDirectionalLight = false;
+			for (const auto& command : commandList.GetCommands(RenderCommandType::DrawDirectionalLight))
 			{
-				switch (command.GetType())
-				{
-				case RenderCommandType::DrawDirectionalLight:
-				{
-					const auto& directionalLight = command.GetCommand<DrawDirectionalLightCommand>();
-					GPU::DirectionalLight* ptr = directionalLightData.As<GPU::DirectionalLight>();
-					ptr->Direction = directionalLight.Direction;
-					ptr->Color = directionalLight.Color;
-					ptr->Intensity = directionalLight.Intensity;
-					directionalLightDirection = directionalLight.Direction;
-				}
-					break;
-				case RenderCommandType::DrawPointLight:
-				{
-					const auto& pointLight = command.GetCommand<DrawPointLightCommand>();
-					GPU::PointLightArray* ptr = pointLightData.As<GPU::PointLightArray>();
-					ptr->Lights[ptr->Count].Position = pointLight.Position;
-					ptr->Lights[ptr->Count].Color = pointLight.Color;
-					ptr->Lights[ptr->Count].Intensity = pointLight.Intensity;
-					ptr->Count++;
-				}
-					break;
-				case RenderCommandType::DrawSpotLight:
-				{
-					const auto& spotLight = command.GetCommand<DrawSpotLightCommand>();
-					GPU::SpotLightArray* ptr = spotLightData.As<GPU::SpotLightArray>();
-					ptr->Lights[ptr->Count].Color = spotLight.Color;
-					ptr->Lights[ptr->Count].Position = spotLight.Position;
-					ptr->Lights[ptr->Count].Direction = spotLight.Direction;
-					ptr->Lights[ptr->Count].HalfAngle = spotLight.HalfAngle;
-					ptr->Lights[ptr->Count].Intensity = spotLight.Intensity;
-					ptr->Lights[ptr->Count].FallOff = spotLight.FallOff;
-					ptr->Count++;
-				}
-					break;
+				hasDirectionalLight = true;
+				const auto& directionalLight = command.GetCommand<DrawDirectionalLightCommand>();
+				GPU::DirectionalLight* ptr = directionalLightData.As<GPU::DirectionalLight>();
+				ptr->Direction = directionalLight.Direction;
+				ptr->Color = directionalLight.Color;
+				ptr->Intensity = directionalLight.Intensity;
+				directionalLightDirection = directionalLight.Direction;
+			}
 
-				case RenderCommandType::DrawSkyBox:
-				{
-					const auto& skyBoxCommand = command.GetCommand<DrawSkyboxCommand>();
-					skyboxSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.SkyBox);
+			mPointLights.clear();
+			for (const auto& command : commandList.GetCommands(RenderCommandType::DrawPointLight))
+			{
+				const auto& pointLight = command.GetCommand<DrawPointLightCommand>();
+				GPU::PointLight& light = mPointLights.emplace_back();
+				light.Position = pointLight.Position;
+				light.Color = pointLight.Color;
+				light.Intensity = pointLight.Intensity;
+				light.Range = pointLight.Range;
+			}
 
-					auto lightpassIBLSRG = registry->GetResource<ShaderResourceGroup>(lihgtingPassIBLSRG, frameIndex);
-					lightpassIBLSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.DiffuseIBL);
-					lightpassIBLSRG->Update(1, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.PreFilterIBL);
-					lightpassIBLSRG->Update(2, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.BRDF);
-				}
-					break;
-				}
+			mSpotLights.clear();
+			for (const auto& command : commandList.GetCommands(RenderCommandType::DrawSpotLight))
+			{
+				const auto& spotLight = command.GetCommand<DrawSpotLightCommand>();
+				GPU::SpotLight& light = mSpotLights.emplace_back();
+				light.Color = spotLight.Color;
+				light.Position = spotLight.Position;
+				light.Direction = spotLight.Direction;
+				light.HalfAngle = spotLight.HalfAngle;
+				light.Intensity = spotLight.Intensity;
+				light.FallOff = spotLight.FallOff;
+				light.Range = spotLight.Range;
+			}
+
+			BuildLightClusters(view.View, view.Proj, view.NearPlane, view.FarPlane, mPointLights, mSpotLights, mLightClusters);
+
+			auto lightSRG = registry->GetResource<ShaderResourceGroup>(lightShaderResourceGroup, frameIndex);
+			auto uploadLightData = [&](ResourceHandle bufferHandle, uint32_t binding, const void* data, uint32_t size) {
+				if (size == 0)
+					return;
+
+				auto buffer = registry->GetResource<StorageBuffer>(bufferHandle, frameIndex);
+				if (buffer->Reserve(size))
+					lightSRG->Update(binding, buffer);
+
+				buffer->SetData(Buffer((void*)data, size));
+				};
+
+			uploadLightData(pointLightBuffer, 1, mPointLights.data(), mPointLights.size() * sizeof(GPU::PointLight));
+			uploadLightData(spotLightBuffer, 2, mSpotLights.data(), mSpotLights.size() * sizeof(GPU::SpotLight));
+			uploadLightData(lightClusterBuffer, 4, mLightClusters.Clusters.data(), mLightClusters.Clusters.size() * sizeof(GPU::LightCluster));
+			uploadLightData(lightIndexBuffer, 5, mLightClusters.LightIndices.data(), mLightClusters.LightIndices.size() * sizeof(uint32_t));
+
+			auto lightClusterInfoUB = registry->GetResource<UniformBuffer>(lightClusterInfoBuffer, frameIndex);
+			lightClusterInfoUB->SetData(Buffer(&mLightClusters.Info, sizeof(GPU::LightClusterInfo)));
+
+			for (const auto& command : commandList.GetCommands(RenderCommandType::DrawSkyBox))
+			{
+				const auto& skyBoxCommand = command.GetCommand<DrawSkyboxCommand>();
+				skyboxSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.SkyBox);
+
+				mFrameStats.DrawCount++;
+				mFrameStats.TriangleCount += skyBoxCommand.CubeMesh->GetTriangleCount();
+
+				auto lightpassIBLSRG = registry->GetResource<ShaderResourceGroup>(lihgtingPassIBLSRG, frameIndex);
+				lightpassIBLSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.DiffuseIBL);
+				lightpassIBLSRG->Update(1, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.PreFilterIBL);
+				lightpassIBLSRG->Update(2, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)skyBoxCommand.BRDF);
 			}
 
 			directionalLightUB->SetData(directionalLightData);
-			pointLightUB->SetData(pointLightData);
-			spotLightUB->SetData(spotLightData);
 
+			// The first view of the world fits the cascades to all of its views, the later ones sample them from their own copy
+			auto shadowDepthLightCameraUB = registry->GetResource<UniformBuffer>(shadowDepthLightCameras, frameIndex);
+			if (!sharedPasses)
+			{
+				shadowDepthLightCameraUB->SetData(Buffer(&mShadowLightCameras, sizeof(GPU::CascadedShadowLightMatrices)));
+				return;
+			}
 
-			ScopedBuffer lightCameraBuffer(sizeof(GPU::CascadedShadowLightMatrices));
-			memset(lightCameraBuffer.GetData(), 0, sizeof(GPU::CascadedShadowLightMatrices));
-			GPU::CascadedShadowLightMatrices* lightCameraPtr = lightCameraBuffer.As<GPU::CascadedShadowLightMatrices>();
+			mShadowLightCameras = GPU::CascadedShadowLightMatrices{};
 			
-			Camera::CascadeSplits cascades = camera.GenerateLightSpaceCascades(4, directionalLightDirection);
+			Camera::CascadeSplits cascades = Camera::GenerateLightSpaceCascades(mWorldViews, sShadowCascadeCount, directionalLightDirection, sShadowMapSize);
 			for (uint32_t i = 0; i < cascades.Count; i++)
 			{
-				lightCameraPtr->LightSpaceMatrices[i] = cascades.LightSpaceMatrices[i];
-				lightCameraPtr->CascadeSplits[i].x = cascades.SplitDistances[i];
+				mShadowLightCameras.LightSpaceMatrices[i] = cascades.LightSpaceMatrices[i];
+				mShadowLightCameras.CascadeSplits[i].x = cascades.SplitDistances[i];
 			}
-			lightCameraPtr->CascadeCount = cascades.Count;
+			mShadowLightCameras.CascadeCount = cascades.Count;
 
-			auto shadowDepthLightCameraUB = registry->GetResource<UniformBuffer>(shadowDepthLightCameras, frameIndex);
-			shadowDepthLightCameraUB->SetData(lightCameraBuffer);
+			shadowDepthLightCameraUB->SetData(Buffer(&mShadowLightCameras, sizeof(GPU::CascadedShadowLightMatrices)));
+
+			// Shadow casters are culled against each cascade volume and drawn once per cascade they touch. Static casters are
+			// only drawn into cascades whose static layer went stale for this frame index
+			mShadowDrawList.Clear();
+			mShadowCommandCascades.clear();
+			mStaticShadowDrawList.Clear();
+			mStaticShadowCommandCascades.clear();
+			mStaleStaticCascades.clear();
+
+			if (!hasDirectionalLight)
+			{
+				mShadowCasters.clear();
+				mStaticShadowCasters.clear();
+			}
+
+			const auto& objects = mObjectTable.GetObjects();
+			auto computeCasterSpheres = [&](const std::vector<IndirectDrawItem>& casters, std::vector<glm::vec4>& spheres) {
+				spheres.resize(casters.size());
+				for (uint32_t i = 0; i < casters.size(); i++)
+				{
+					const GPU::ObjectData& object = objects[casters[i].ObjectIndex];
+					spheres[i] = TransformBoundingSphere(object.Transform, object.BoundingSphere);
+				}
+				};
+
+			computeCasterSpheres(mShadowCasters, mShadowCasterSpheres);
+			computeCasterSpheres(mStaticShadowCasters, mStaticShadowCasterSpheres);
+
+			for (uint32_t cascade = 0; cascade < cascades.Count; cascade++)
+			{
+				Frustum cascadeFrustum(cascades.LightSpaceMatrices[cascade]);
+
+				mShadowDrawItems.clear();
+				for (uint32_t i = 0; i < mShadowCasters.size(); i++)
+				{
+					if (cascadeFrustum.IntersectsSphere(mShadowCasterSpheres[i]))
+						mShadowDrawItems.push_back(mShadowCasters[i]);
+				}
+
+				AppendIndirectDrawList(mShadowDrawItems, mShadowDrawList);
+				mShadowCommandCascades.resize(mShadowDrawList.Commands.size(), cascade);
+
+				mShadowDrawItems.clear();
+				mStaticCasterHashes.clear();
+				for (uint32_t i = 0; i < mStaticShadowCasters.size(); i++)
+				{
+					if (!cascadeFrustum.IntersectsSphere(mStaticShadowCasterSpheres[i]))
+						continue;
+
+					const IndirectDrawItem& caster = mStaticShadowCasters[i];
+					mStaticCasterHashes.push_back(HashShadowCaster(caster, objects[caster.ObjectIndex].Transform));
+					mShadowDrawItems.push_back(caster);
+				}
+
+				// The static layers are shared, so a layer last drawn for another world is stale too
+				uint64_t casterHash = CombineShadowCasterHashes(mStaticCasterHashes);
+				if (!mStaticShadowCache.Update(mExecutingWorld, frameIndex, cascade, cascades.LightSpaceMatrices[cascade], casterHash))
+					continue;
+
+				mStaleStaticCascades.push_back(cascade);
+				AppendIndirectDrawList(mShadowDrawItems, mStaticShadowDrawList);
+				mStaticShadowCommandCascades.resize(mStaticShadowDrawList.Commands.size(), cascade);
+			}
+
+			uploadDrawList(mShadowDrawList, shadowDrawArgs, shadowInstances, shadowInstanceSRG);
+			uploadDrawList(mStaticShadowDrawList, staticShadowDrawArgs, staticShadowInstances, staticShadowInstanceSRG);
+			countDraws(mShadowDrawList);
+			countDraws(mStaticShadowDrawList);
 
 			});
 
-		mRenderGraph->SetResizeCallback([=](const Camera& camera, uint32_t frameIndex, uint32_t width, uint32_t height) {
-			const ResourceRegistry& registry = *camera.GetRegistry();
+		mRenderGraph->SetResizeCallback([=](const RenderView& view, uint32_t frameIndex, uint32_t width, uint32_t height) {
+			const ResourceRegistry& registry = *view.Registry;
 
+			Ref<Texture2D> gDisplayOutput = registry.GetResource<Texture>(displayOutput, frameIndex);
 			Ref<Texture2D> gMainOutput = registry.GetResource<Texture>(mainOutput, frameIndex);
 			Ref<Texture2D> gAlbedo = registry.GetResource<Texture>(gBufferAlbedo, frameIndex);
-			Ref<Texture2D> gPosition = registry.GetResource<Texture>(gBufferPosition, frameIndex);
 			Ref<Texture2D> gNormal = registry.GetResource<Texture>(gBufferNormal, frameIndex);
 			Ref<Texture2D> gPBR = registry.GetResource<Texture>(gBufferPBRFactor, frameIndex);
 			Ref<Texture2D> gDepth = registry.GetResource<Texture>(gBufferDepth, frameIndex);
 
+			gDisplayOutput->Resize(width, height);
 			gMainOutput->Resize(width, height);
 			gAlbedo->Resize(width, height);
-			gPosition->Resize(width, height);
 			gNormal->Resize(width, height);
 			gPBR->Resize(width, height);
 			gDepth->Resize(width, height);
-
-			auto lightingGBufferSRG = registry.GetResource<ShaderResourceGroup>(lightingGBufferShaderResourceGroup, frameIndex);
-			lightingGBufferSRG->Update(0, DescriptorType::StorageImage, ImageLayout::General, (WeakRef<Texture>)gMainOutput);
-			lightingGBufferSRG->Update(1, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gAlbedo);
-			lightingGBufferSRG->Update(2, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gPosition);
-			lightingGBufferSRG->Update(3, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gNormal);
-			lightingGBufferSRG->Update(4, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gPBR);
 			});
 
 		mRenderGraph->SetRegistrySetupCallback([=](const ResourceRegistry& registry, uint32_t frameIndex) {
@@ -598,42 +1220,66 @@ namespace Mule
 			// Lighting Pass Setup
 			auto lightSRG = registry.GetResource<ShaderResourceGroup>(lightShaderResourceGroup, frameIndex);
 			auto directionalLightUB = registry.GetResource<UniformBuffer>(directionalLightBuffer, frameIndex);
-			auto pointLightUB = registry.GetResource<UniformBuffer>(pointLightBuffer, frameIndex);
-			auto spotLightUB = registry.GetResource<UniformBuffer>(spotLightBuffer, frameIndex);
+			auto lightClusterInfoUB = registry.GetResource<UniformBuffer>(lightClusterInfoBuffer, frameIndex);
 
 			lightSRG->Update(0, directionalLightUB);
-			lightSRG->Update(1, pointLightUB);
-			lightSRG->Update(2, spotLightUB);
+			lightSRG->Update(1, registry.GetResource<StorageBuffer>(pointLightBuffer, frameIndex));
+			lightSRG->Update(2, registry.GetResource<StorageBuffer>(spotLightBuffer, frameIndex));
+			lightSRG->Update(3, lightClusterInfoUB);
+			lightSRG->Update(4, registry.GetResource<StorageBuffer>(lightClusterBuffer, frameIndex));
+			lightSRG->Update(5, registry.GetResource<StorageBuffer>(lightIndexBuffer, frameIndex));
 
 			auto lightingGBufferSRG = registry.GetResource<ShaderResourceGroup>(lightingGBufferShaderResourceGroup, frameIndex);
 			auto gMainOutput = registry.GetResource<Texture>(mainOutput, frameIndex);
 			auto gAlbedo = registry.GetResource<Texture>(gBufferAlbedo, frameIndex);
-			auto gPosition = registry.GetResource<Texture>(gBufferPosition, frameIndex);
 			auto gNormal = registry.GetResource<Texture>(gBufferNormal, frameIndex);
 			auto gPBR = registry.GetResource<Texture>(gBufferPBRFactor, frameIndex);
+			auto gDepth = registry.GetResource<Texture>(gBufferDepth, frameIndex);
 			
 			lightingGBufferSRG->Update(0, DescriptorType::StorageImage, ImageLayout::General, (WeakRef<Texture>)gMainOutput);
 			lightingGBufferSRG->Update(1, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gAlbedo);
-			lightingGBufferSRG->Update(2, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gPosition);
+			lightingGBufferSRG->Update(2, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gDepth);
 			lightingGBufferSRG->Update(3, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gNormal);
 			lightingGBufferSRG->Update(4, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gPBR);
 
 			auto lightingCameraSRG = registry.GetResource<ShaderResourceGroup>(lightingCameraShaderResourceGroup, frameIndex);
 			lightingCameraSRG->Update(0, cameraUB);
-			
 
-			// Shadow Mapping
-			auto lightCameraSRG = registry.GetResource<ShaderResourceGroup>(shadowDepthLightSpaceMatrices, frameIndex);
+			// Upscale
+			auto upscaleSRG = registry.GetResource<ShaderResourceGroup>(upscaleShaderResourceGroup, frameIndex);
+			auto gDisplayOutput = registry.GetResource<Texture>(displayOutput, frameIndex);
+			upscaleSRG->Update(0, DescriptorType::StorageImage, ImageLayout::General, (WeakRef<Texture>)gDisplayOutput);
+			upscaleSRG->Update(1, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gMainOutput, 0, registry.GetResource<Sampler>(upscaleSampler, frameIndex));
+
+			// Indirect Draws
+			auto gBufferInstanceBuffer = registry.GetResource<StorageBuffer>(gBufferInstances, frameIndex);
+			registry.GetResource<ShaderResourceGroup>(gBufferInstanceSRG, frameIndex)->Update(0, gBufferInstanceBuffer);
+
+			// Shadow Mapping, the depth textures are shared and the rest belongs to the view
 			auto lightCameraBuffer = registry.GetResource<UniformBuffer>(shadowDepthLightCameras, frameIndex);
-			lightCameraSRG->Update(0, lightCameraBuffer);
+			registry.GetResource<ShaderResourceGroup>(shadowDepthLightSpaceMatrices, frameIndex)->Update(0, lightCameraBuffer);
+			registry.GetResource<ShaderResourceGroup>(shadowDepthLayeredLightSpaceMatrices, frameIndex)->Update(0, lightCameraBuffer);
+
+			auto shadowInstanceBuffer = registry.GetResource<StorageBuffer>(shadowInstances, frameIndex);
+			registry.GetResource<ShaderResourceGroup>(shadowInstanceSRG, frameIndex)->Update(0, shadowInstanceBuffer);
+
+			auto staticShadowInstanceBuffer = registry.GetResource<StorageBuffer>(staticShadowInstances, frameIndex);
+			registry.GetResource<ShaderResourceGroup>(staticShadowInstanceSRG, frameIndex)->Update(0, staticShadowInstanceBuffer);
 
 			WeakRef<Texture2DArray> shadowDepthBuffer = registry.GetResource<Texture>(shadowDepthTexture, frameIndex);
-			shadowDepthBuffer->Resize(2048, 2048);
 
 			auto depthSampler = registry.GetResource<Sampler>(shadowDepthSampler, frameIndex);
 			auto lightingShadowSRG = registry.GetResource<ShaderResourceGroup>(lightingPassShadowSRG, frameIndex);
 			lightingShadowSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)shadowDepthBuffer, 0, depthSampler);
 			lightingShadowSRG->Update(1, lightCameraBuffer);
+
+			WeakRef<Texture2DArray> staticShadowDepthBuffer = registry.GetResource<Texture>(staticShadowDepthTexture, frameIndex);
+			lightingShadowSRG->Update(2, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)staticShadowDepthBuffer, 0, depthSampler);
+
+			// Occlusion Culling
+			auto hiZSRG = registry.GetResource<ShaderResourceGroup>(hiZShaderResourceGroup, frameIndex);
+			hiZSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, (WeakRef<Texture>)gDepth, 0, depthSampler);
+			hiZSRG->Update(1, registry.GetResource<StorageBuffer>(hiZBuffer, frameIndex));
 			});
 	}
 
@@ -644,6 +1290,10 @@ namespace Mule
 		auto bindlessTextureSRG = mBindlessTextureSRG[mFrameIndex];
 		auto bindlessMaterialBuffer = mBindlessMaterialBuffer[mFrameIndex];
 
+		// Slots changed by the queued updates, every frame index writes them into its own tables once it comes around
+		std::vector<uint32_t> textureWrites;
+		std::vector<uint32_t> dirtyMaterials;
+
 		auto getTextureIndex = [&](AssetHandle handle, WeakRef<Texture> defaultTexture) {
 
 			if (handle == AssetHandle::Null())
@@ -653,14 +1303,14 @@ namespace Mule
 			if (index == UINT32_MAX)
 			{
 				index = mBindlessTextureIndices.Insert(handle, defaultTexture);
-				bindlessTextureSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, defaultTexture, index);
+				textureWrites.push_back(index);
 			}
 
 			return index;
 			};
 
 
-		BindlessResourceUpdate& resourceUpdate = mResourceUpdates[mFrameIndex];
+		BindlessResourceUpdate& resourceUpdate = mResourceUpdates;
 
 		for (auto texture : resourceUpdate.RemoveTextures)
 			mBindlessTextureIndices.Remove(texture->Handle());
@@ -673,8 +1323,10 @@ namespace Mule
 
 			if (index == UINT32_MAX)
 				index = mBindlessTextureIndices.Insert(texture->Handle(), texture);
-			
-			bindlessTextureSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, texture, index);
+			else
+				mBindlessTextureIndices.Update(index, texture);
+
+			textureWrites.push_back(index);
 		}
 
 		for (auto material : resourceUpdate.RemoveMaterials)
@@ -707,6 +1359,7 @@ namespace Mule
 			gpuMaterial.EmissiveIndex = getTextureIndex(material->EmissiveMap, mBlackTex);
 
 			mBindlessMaterialIndices.Update(index, gpuMaterial);
+			dirtyMaterials.push_back(index);
 		}
 
 		for (auto material : resourceUpdate.AddMaterials)
@@ -733,34 +1386,150 @@ namespace Mule
 				index = mBindlessMaterialIndices.Insert(material->Handle(), gpuMaterial);
 
 			material->GlobalIndex = index;
+			dirtyMaterials.push_back(index);
 		}
 
-		auto materialArray = mBindlessMaterialIndices.GetArray();
-		Buffer materialData(materialArray.data(), materialArray.size() * sizeof(GPU::Material));
-		bindlessMaterialBuffer->SetData(materialData);
-
 		resourceUpdate.AddTextures.clear();
 		resourceUpdate.RemoveTextures.clear();
 		resourceUpdate.AddMaterials.clear();
 		resourceUpdate.UpdateMaterials.clear();
 		resourceUpdate.RemoveMaterials.clear();
+
+		for (uint32_t i = 0; i < mFramesInFlight; i++)
+		{
+			mPendingTextureWrites[i].insert(mPendingTextureWrites[i].end(), textureWrites.begin(), textureWrites.end());
+			mPendingMaterialWrites[i].insert(mPendingMaterialWrites[i].end(), dirtyMaterials.begin(), dirtyMaterials.end());
+		}
+
+		textureWrites = std::move(mPendingTextureWrites[mFrameIndex]);
+		dirtyMaterials = std::move(mPendingMaterialWrites[mFrameIndex]);
+		mPendingTextureWrites[mFrameIndex].clear();
+		mPendingMaterialWrites[mFrameIndex].clear();
+
+		// Textures
+		const auto& textures = mBindlessTextureIndices.GetArray();
+		if (bindlessTextureSRG->Reserve(textures.size()))
+		{
+			// The descriptor set was reallocated so every live slot has to be written again
+			textureWrites.clear();
+			for (const auto& [handle, index] : mBindlessTextureIndices.GetIndices())
+				textureWrites.push_back(index);
+		}
+
+		std::sort(textureWrites.begin(), textureWrites.end());
+		textureWrites.erase(std::unique(textureWrites.begin(), textureWrites.end()), textureWrites.end());
+
+		for (uint32_t index : textureWrites)
+			bindlessTextureSRG->Update(0, DescriptorType::Texture, ImageLayout::ShaderReadOnly, textures[index], index);
+
+		// Materials, only the changed slots are uploaded with adjacent slots merged into a single write
+		const auto& materials = mBindlessMaterialIndices.GetArray();
+		if (bindlessMaterialBuffer->Reserve(materials.size() * sizeof(GPU::Material)))
+		{
+			mBindlessMaterialSRG[mFrameIndex]->Update(0, bindlessMaterialBuffer);
+
+			dirtyMaterials.resize(materials.size());
+			for (uint32_t i = 0; i < materials.size(); i++)
+				dirtyMaterials[i] = i;
+		}
+
+		std::sort(dirtyMaterials.begin(), dirtyMaterials.end());
+		dirtyMaterials.erase(std::unique(dirtyMaterials.begin(), dirtyMaterials.end()), dirtyMaterials.end());
+
+		for (uint32_t i = 0; i < dirtyMaterials.size();)
+		{
+			uint32_t begin = dirtyMaterials[i];
+			uint32_t end = begin + 1;
+			for (i++; i < dirtyMaterials.size() && dirtyMaterials[i] == end; i++)
+				end++;
+
+			Buffer materialData((void*)&materials[begin], (end - begin) * sizeof(GPU::Material));
+			bindlessMaterialBuffer->SetData(materialData, begin * sizeof(GPU::Material));
+		}
 	}
 	
+	void Renderer::UpdateObjects(const std::vector<Ref<RenderRequest>>& requests)
+	{
+		{
+			// A world created at the address of a removed one draws before its removal is applied, so removed worlds are
+			// released first. Requests of the removed world itself were already dropped
+			std::lock_guard<std::mutex> lock(mResourceMutex);
+			for (const void* world : mWorldRemovals)
+			{
+				mObjectTable.RemoveWorld(world);
+				mStaticShadowCache.RemoveWorld(world);
+			}
+			mWorldRemovals.clear();
+		}
+
+		// Only objects the world reported as changed are written, the slots of the rest are left as they are
+		for (const Ref<RenderRequest>& request : requests)
+		{
+			for (const auto& command : request->Commands.GetCommands(RenderCommandType::Draw))
+			{
+				const DrawCommand& drawCommand = command.GetCommand<DrawCommand>();
+				if (!drawCommand.Mesh || !drawCommand.Changed)
+					continue;
+
+				// Zero the padding as well, the table compares the data to skip uploads of objects that didn't move
+				GPU::ObjectData objectData;
+				memset(&objectData, 0, sizeof(GPU::ObjectData));
+				objectData.Transform = drawCommand.ModelMatrix;
+				objectData.BoundingSphere = drawCommand.Mesh->GetBoundingSphere();
+				objectData.MaterialIndex = drawCommand.Material && drawCommand.Material->GlobalIndex != UINT32_MAX ? drawCommand.Material->GlobalIndex : 0;
+
+				mObjectTable.Update(request->World, drawCommand.ObjectId, objectData);
+			}
+		}
+
+		{
+			// Removals are applied after updates so a draw recorded before its entity was destroyed doesn't re-insert it
+			std::lock_guard<std::mutex> lock(mResourceMutex);
+			for (const auto& [world, objectId] : mObjectRemovals)
+			{
+				mObjectTable.Remove(world, objectId);
+
+				for (auto& [view, history] : mLodHistory)
+					history.Levels.erase(objectId);
+			}
+			mObjectRemovals.clear();
+		}
+
+		Ref<StorageBuffer> objectBuffer = mObjectBuffers[mFrameIndex];
+		if (objectBuffer->Reserve(mObjectTable.GetSlotCount() * sizeof(GPU::ObjectData)))
+		{
+			mObjectSRG[mFrameIndex]->Update(0, objectBuffer);
+			mObjectTable.InvalidateFrame(mFrameIndex);
+		}
+
+		const auto& objects = mObjectTable.GetObjects();
+		for (uint32_t index : mObjectTable.GetPendingUploads(mFrameIndex))
+		{
+			Buffer objectData((void*)&objects[index], sizeof(GPU::ObjectData));
+			objectBuffer->SetData(objectData, index * sizeof(GPU::ObjectData));
+		}
+
+		mObjectTable.ClearPendingUploads(mFrameIndex);
+	}
+
 	bool Renderer::BindlessResourcesNeedUpdate()
 	{
-		if (!mResourceUpdates[mFrameIndex].AddTextures.empty())
+		if (!mPendingTextureWrites[mFrameIndex].empty() || !mPendingMaterialWrites[mFrameIndex].empty())
+			return true;
+
+		if (!mResourceUpdates.AddTextures.empty())
 			return true;
 
-		if (!mResourceUpdates[mFrameIndex].RemoveTextures.empty())
+		if (!mResourceUpdates.RemoveTextures.empty())
 			return true;
 
-		if (!mResourceUpdates[mFrameIndex].AddMaterials.empty())
+		if (!mResourceUpdates.AddMaterials.empty())
 			return true;
 
-		if (!mResourceUpdates[mFrameIndex].UpdateMaterials.empty())
+		if (!mResourceUpdates.UpdateMaterials.empty())
 			return true;
 
-		if (!mResourceUpdates[mFrameIndex].RemoveMaterials.empty())
+		if (!mResourceUpdates.RemoveMaterials.empty())
 			return true;
 
 
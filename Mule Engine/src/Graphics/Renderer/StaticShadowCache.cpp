@@ -0,0 +1,91 @@
+#include "Graphics/Renderer/StaticShadowCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Mule
+{
+	constexpr uint64_t sFnvOffsetBasis = 0xcbf29ce484222325ull;
+	constexpr uint64_t sFnvPrime = 0x100000001b3ull;
+
+	static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= sFnvPrime;
+		}
+
+		return hash;
+	}
+
+	// Finalizer of splitmix64, every input bit affects every output bit
+	static uint64_t MixHash(uint64_t hash)
+	{
+		hash ^= hash >> 30;
+		hash *= 0xbf58476d1ce4e5b9ull;
+		hash ^= hash >> 27;
+		hash *= 0x94d049bb133111ebull;
+		hash ^= hash >> 31;
+		return hash;
+	}
+
+	StaticShadowCache::StaticShadowCache(uint32_t framesInFlight, uint32_t cascadeCount)
+		:
+		mCascadeCount(cascadeCount)
+	{
+		mLayers.resize(framesInFlight * cascadeCount);
+	}
+
+	bool StaticShadowCache::Update(const void* world, uint32_t frameIndex, uint32_t cascade, const glm::mat4& lightSpaceMatrix, uint64_t casterHash)
+	{
+		Layer& layer = mLayers[frameIndex * mCascadeCount + cascade];
+
+		// Cascades are snapped to whole texels so an unchanged cascade gives back the exact same matrix
+		bool stale = !layer.Valid
+			|| layer.World != world
+			|| layer.CasterHash != casterHash
+			|| memcmp(&layer.LightSpaceMatrix, &lightSpaceMatrix, sizeof(glm::mat4)) != 0;
+
+		layer.World = world;
+		layer.LightSpaceMatrix = lightSpaceMatrix;
+		layer.CasterHash = casterHash;
+		layer.Valid = true;
+
+		return stale;
+	}
+
+	void StaticShadowCache::RemoveWorld(const void* world)
+	{
+		for (Layer& layer : mLayers)
+		{
+			if (layer.World == world)
+				layer.Valid = false;
+		}
+	}
+
+	uint64_t HashShadowCaster(const IndirectDrawItem& item, const glm::mat4& transform)
+	{
+		const Mesh* mesh = item.Mesh.Get();
+
+		uint64_t hash = sFnvOffsetBasis;
+		hash = HashBytes(hash, &mesh, sizeof(mesh));
+		hash = HashBytes(hash, &item.IndexCount, sizeof(uint32_t));
+		hash = HashBytes(hash, &item.FirstIndex, sizeof(uint32_t));
+		hash = HashBytes(hash, &transform, sizeof(glm::mat4));
+
+		return hash;
+	}
+
+	uint64_t CombineShadowCasterHashes(std::vector<uint64_t>& hashes)
+	{
+		std::sort(hashes.begin(), hashes.end());
+
+		uint64_t hash = MixHash(hashes.size());
+		for (uint64_t casterHash : hashes)
+			hash = MixHash(hash ^ casterHash);
+
+		return hash;
+	}
+}
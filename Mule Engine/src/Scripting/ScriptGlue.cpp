@@ -33,13 +33,13 @@ namespace Mule
 		{
 		case ROOT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<RootComponent>(), ptr); break;
 		case META_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<MetaComponent>(), ptr); break;
-		case TRANSFORM_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<TransformComponent>(), ptr); break;
+		case TRANSFORM_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<TransformComponent>(), ptr); e.TrackScriptWrites(); break;
 		case CAMERA_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<CameraComponent>(), ptr); break;
 		case ENVIRONMENT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<EnvironmentMapComponent>(), ptr); break;
 		case POINT_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<PointLightComponent>(), ptr); break;
 		case SPOT_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<SpotLightComponent>(), ptr); break;
 		case DIRECTIONAL_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<DirectionalLightComponent>(), ptr); break;
-		case MESH_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<MeshComponent>(), ptr); break;
+		case MESH_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<MeshComponent>(), ptr); e.TrackScriptWrites(); break;
 		case SCRIPT_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.GetComponent<SpotLightComponent>(), ptr); break;
 		case RIGID_BODY_3D_COMPONENT: GET_COMPONENT_PTR(e.GetComponent<RigidBodyComponent>(), ptr); break;
 		}
@@ -62,13 +62,13 @@ namespace Mule
 		{
 		case ROOT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<RootComponent>(), ptr); break;
 		case META_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<MetaComponent>(), ptr); break;
-		case TRANSFORM_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<TransformComponent>(), ptr); break;
+		case TRANSFORM_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<TransformComponent>(), ptr); e.TrackScriptWrites(); break;
 		case CAMERA_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<CameraComponent>(), ptr); break;
 		case ENVIRONMENT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<EnvironmentMapComponent>(), ptr); break;
 		case POINT_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<PointLightComponent>(), ptr); break;
 		case SPOT_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<SpotLightComponent>(), ptr); break;
 		case DIRECTIONAL_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<DirectionalLightComponent>(), ptr); break;
-		case MESH_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<MeshComponent>(), ptr); break;
+		case MESH_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<MeshComponent>(), ptr); e.TrackScriptWrites(); break;
 		case SCRIPT_LIGHT_COMPONENT_ID: GET_COMPONENT_PTR(e.AddComponent<SpotLightComponent>(), ptr); break;
 		}
 
@@ -0,0 +1,182 @@
+#include "Test.h"
+#include "Mocks/MockCommandBuffer.h"
+
+#include "Graphics/API/GraphicsContext.h"
+#include "Graphics/Renderer/RenderGraph/RenderPass.h"
+#include "Graphics/Renderer/RenderGraph/ResourceRegistry.h"
+#include "Graphics/Renderer/CommandList.h"
+#include "JobSystem/JobSystem.h"
+
+using namespace Mule;
+using Mule::Tests::MockCommandBuffer;
+
+namespace
+{
+	constexpr uint32_t sIndirectCommandSize = 20;
+
+	// A ranged pass that draws its range from the indirect buffer like the G-buffer pass. Without a graphics API the
+	// registry creates no device objects, the pass records into mocks inserted under its handles instead
+	struct RangedPass
+	{
+		RenderPass Pass{ "Ranged", PassType::Graphics };
+		PassCommands Commands;
+		Ref<ResourceRegistry> Registry;
+		Ref<MockCommandBuffer> Primary;
+		std::vector<Ref<MockCommandBuffer>> Secondaries;
+		std::vector<DrawRange> Ranges;
+		uint32_t DrawCount = 0;
+
+		RangedPass()
+		{
+			static bool sContextInitialized = false;
+			if (!sContextInitialized)
+			{
+				GraphicsContext::Init(GraphicsAPI::None, nullptr);
+				sContextInitialized = true;
+			}
+
+			Pass.SetRangeExecutionCallback(
+				[this](const CommandList&) { return DrawCount; },
+				[](Ref<CommandBuffer> cmd, const CommandList&, const ResourceRegistry&, uint32_t, DrawRange range) {
+					cmd->DrawMeshIndirect(nullptr, range.First * sIndirectCommandSize, range.Count);
+				});
+
+			Commands.PreDraw.push_back(BeginRenderingCommand({}, {}, true));
+			Commands.PostDraw.push_back(EndRenderingCommand());
+
+			Registry = MakeRef<ResourceRegistry>(1, ResourceBuilder());
+
+			Primary = MakeRef<MockCommandBuffer>();
+			Registry->InsertResources<CommandBuffer>(Pass.GetCommandBufferHandle(), { Primary });
+			Registry->InsertResources<TimestampQueryPool>(Pass.GetTimestampHandle(), { nullptr });
+
+			for (const ResourceHandle& handle : Pass.GetRangeCommandBufferHandles())
+			{
+				Secondaries.push_back(MakeRef<MockCommandBuffer>());
+				Registry->InsertResources<CommandBuffer>(handle, { Secondaries.back() });
+			}
+		}
+
+		// Records the ranges on the job system and replays them in the primary, the way RenderGraph::Execute does
+		void Record(JobSystem& jobSystem, uint32_t drawCount)
+		{
+			DrawCount = drawCount;
+
+			CommandList commandList;
+			Ranges = Pass.GetDrawRanges(commandList);
+
+			jobSystem.ParallelFor(Ranges.size(), [&](uint32_t slot) {
+				Pass.RecordRange(commandList, Commands, *Registry, 0, slot, Ranges[slot]);
+				});
+
+			Ref<CommandBuffer> cmd = Pass.Execute(commandList, Commands, *Registry, 0, Ranges.size());
+			cmd->End();
+		}
+	};
+}
+
+MULE_TEST(SplitDrawRangeCoversEveryDraw)
+{
+	for (uint32_t drawCount : { 1u, 63u, 64u, 65u, 128u, 511u, 512u, 513u, 10000u })
+	{
+		std::vector<DrawRange> ranges = SplitDrawRange(drawCount, 64, 8);
+
+		EXPECT(!ranges.empty());
+		EXPECT(ranges.size() <= 8);
+
+		uint32_t next = 0;
+		uint32_t smallest = UINT32_MAX;
+		uint32_t largest = 0;
+		for (const DrawRange& range : ranges)
+		{
+			EXPECT_EQ(range.First, next);
+			next += range.Count;
+			smallest = std::min(smallest, range.Count);
+			largest = std::max(largest, range.Count);
+		}
+
+		EXPECT_EQ(next, drawCount);
+		EXPECT(largest - smallest <= 1);
+
+		// Ranges only split once each of them gets the minimum
+		if (ranges.size() > 1)
+			EXPECT(smallest >= 64 || ranges.size() == 8);
+	}
+}
+
+MULE_TEST(SplitDrawRangeWithNothingToSplit)
+{
+	EXPECT(SplitDrawRange(0, 64, 8).empty());
+	EXPECT(SplitDrawRange(100, 64, 0).empty());
+	EXPECT_EQ(SplitDrawRange(100, 0, 4).size(), 4u);
+	EXPECT_EQ(SplitDrawRange(10, 64, 8).size(), 1u);
+}
+
+MULE_TEST(ParallelRangesReplayInDrawOrder)
+{
+	JobSystem jobSystem;
+	RangedPass pass;
+
+	for (uint32_t drawCount : { 1u, 100u, 4096u })
+	{
+		pass.Record(jobSystem, drawCount);
+
+		EXPECT(!pass.Ranges.empty());
+		EXPECT_EQ(pass.Primary->GetInvalidSecondaries(), 0u);
+		EXPECT(!pass.Primary->IsRecording());
+
+		for (uint32_t slot = 0; slot < pass.Ranges.size(); slot++)
+		{
+			EXPECT_EQ(pass.Secondaries[slot]->GetBeginCount(), 1u);
+			EXPECT(!pass.Secondaries[slot]->IsRecording());
+		}
+
+		// Replayed draws must be the unsplit draw, contiguous and in order
+		uint32_t next = 0;
+		for (const MockCommandBuffer::IndirectDraw& draw : pass.Primary->GetDraws())
+		{
+			EXPECT_EQ(draw.Offset, next * sIndirectCommandSize);
+			next += draw.DrawCount;
+		}
+
+		EXPECT_EQ(next, drawCount);
+	}
+}
+
+MULE_TEST(ReusedSecondariesOnlyReplayTheirLastRecording)
+{
+	JobSystem jobSystem;
+	RangedPass pass;
+
+	pass.Record(jobSystem, 1024);
+	EXPECT_EQ(pass.Ranges.size(), 8u);
+
+	// A second frame recording fewer ranges into the same slots, the slots it leaves alone still hold the first frame
+	pass.Record(jobSystem, 128);
+	EXPECT_EQ(pass.Ranges.size(), 2u);
+
+	EXPECT_EQ(pass.Primary->GetDraws().size(), 2u);
+	EXPECT_EQ(pass.Primary->GetDraws()[0].DrawCount + pass.Primary->GetDraws()[1].DrawCount, 128u);
+}
+
+MULE_TEST(PassWithoutDrawsRecordsNoRanges)
+{
+	JobSystem jobSystem;
+	RangedPass pass;
+
+	pass.Record(jobSystem, 0);
+
+	EXPECT(pass.Ranges.empty());
+	EXPECT(pass.Primary->GetDraws().empty());
+	EXPECT_EQ(pass.Secondaries[0]->GetBeginCount(), 0u);
+}
+
+MULE_BENCHMARK(RecordRangesInParallel)
+{
+	JobSystem jobSystem;
+	RangedPass pass;
+
+	Mule::Tests::Measure("Record 8 ranges of 10000 draws", 1000, [&]() {
+		pass.Record(jobSystem, 10000);
+		});
+}
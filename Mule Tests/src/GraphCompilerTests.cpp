@@ -0,0 +1,187 @@
+#include "Test.h"
+
+#include "Graphics/Renderer/RenderGraph/GraphCompiler.h"
+#include "Graphics/Renderer/RenderGraph/QueueSchedule.h"
+#include "Graphics/Renderer/RenderGraph/ResourceLifetime.h"
+
+#include <random>
+#include <string>
+
+using namespace Mule;
+
+namespace
+{
+	ResourceHandle TargetHandle(const std::string& name)
+	{
+		return ResourceHandle(name, ResourceType::RenderTarget);
+	}
+
+	std::vector<uint32_t> GetPositions(const std::vector<uint32_t>& order, size_t passCount)
+	{
+		std::vector<uint32_t> positions(passCount, UINT32_MAX);
+		for (uint32_t i = 0; i < order.size(); i++)
+			positions[order[i]] = i;
+		return positions;
+	}
+
+	// Every pass writes a few targets and reads targets written by the passes shortly before it, declared in reverse
+	std::vector<PassDeclaration> BuildChain(uint32_t passCount, uint32_t targetsPerPass)
+	{
+		std::mt19937 random(1);
+		std::vector<PassDeclaration> passes(passCount);
+
+		for (uint32_t i = 0; i < passCount; i++)
+		{
+			PassDeclaration& pass = passes[passCount - 1 - i];
+			for (uint32_t target = 0; target < targetsPerPass; target++)
+			{
+				pass.Usage[TargetHandle("R" + std::to_string(i * targetsPerPass + target))] = { ResourceAccess::Write, 0 };
+
+				if (i > 0)
+				{
+					uint32_t source = i - 1 - random() % std::min(i, 4u);
+					pass.Usage[TargetHandle("R" + std::to_string(source * targetsPerPass + target))] = { ResourceAccess::Read, 0 };
+				}
+			}
+		}
+
+		passes[0].Usage[TargetHandle("Output")] = { ResourceAccess::Write, 0 };
+		return passes;
+	}
+}
+
+MULE_TEST(SortPassesRunsWritersBeforeReaders)
+{
+	std::vector<PassDeclaration> passes(4);
+	passes[0].Usage[TargetHandle("Output")] = { ResourceAccess::Write, 0 };
+	passes[0].Usage[TargetHandle("Lit")] = { ResourceAccess::Read, 0 };
+	passes[1].Usage[TargetHandle("Lit")] = { ResourceAccess::Write, 0 };
+	passes[1].Usage[TargetHandle("GBuffer")] = { ResourceAccess::Read, 0 };
+	passes[2].Usage[TargetHandle("GBuffer")] = { ResourceAccess::Write, 0 };
+	passes[3].Usage[TargetHandle("Unrelated")] = { ResourceAccess::Write, 0 };
+
+	std::vector<uint32_t> order = SortPasses(passes);
+	EXPECT_EQ(order.size(), 4u);
+
+	std::vector<uint32_t> positions = GetPositions(order, passes.size());
+	EXPECT(positions[2] < positions[1]);
+	EXPECT(positions[1] < positions[0]);
+}
+
+MULE_TEST(SortPassesKeepsTheGivenOrderOfIndependentPasses)
+{
+	std::vector<PassDeclaration> passes(3);
+	passes[0].Usage[TargetHandle("A")] = { ResourceAccess::Write, 0 };
+	passes[1].Usage[TargetHandle("B")] = { ResourceAccess::Write, 0 };
+	passes[2].Usage[TargetHandle("C")] = { ResourceAccess::Write, 0 };
+
+	EXPECT(SortPasses(passes) == std::vector<uint32_t>({ 0, 1, 2 }));
+
+	// An explicit dependency overrides it
+	passes[0].Dependencies.push_back(2);
+	std::vector<uint32_t> positions = GetPositions(SortPasses(passes), passes.size());
+	EXPECT(positions[2] < positions[0]);
+}
+
+MULE_TEST(SortPassesDetectsCycles)
+{
+	std::vector<PassDeclaration> passes(2);
+	passes[0].Usage[TargetHandle("A")] = { ResourceAccess::Write, 0 };
+	passes[0].Usage[TargetHandle("B")] = { ResourceAccess::Read, 0 };
+	passes[1].Usage[TargetHandle("B")] = { ResourceAccess::Write, 0 };
+	passes[1].Usage[TargetHandle("A")] = { ResourceAccess::Read, 0 };
+
+	EXPECT(SortPasses(passes).empty());
+
+	// A dependency against the flow of data is a cycle too
+	passes[1].Usage.erase(TargetHandle("A"));
+	EXPECT_EQ(SortPasses(passes).size(), 2u);
+	passes[1].Dependencies.push_back(0);
+	EXPECT(SortPasses(passes).empty());
+}
+
+// The passes of the renderer around the lighting pass, the skybox draws over the lit output where depth is still clear
+MULE_TEST(SortPassesRunsTheSkyboxAfterLighting)
+{
+	ResourceHandle depth("GBuffer.Depth", ResourceType::DepthAttachment);
+
+	std::vector<PassDeclaration> passes(5);
+	passes[0].Usage[depth] = { ResourceAccess::Write, 0 }; // GBuffer
+	passes[0].Usage[TargetHandle("GBuffer.Albedo")] = { ResourceAccess::Write, 0 };
+	passes[1].Usage[depth] = { ResourceAccess::Read, 0 }; // Hi-Z
+	passes[2].Usage[TargetHandle("GBuffer.Albedo")] = { ResourceAccess::Read, 0 }; // Composite
+	passes[2].Usage[depth] = { ResourceAccess::Read, 0 };
+	passes[2].Usage[TargetHandle("MainOutput")] = { ResourceAccess::Write, 0 };
+	passes[3].Usage[TargetHandle("MainOutput")] = { ResourceAccess::Write, 0 }; // Skybox
+	passes[3].Usage[depth] = { ResourceAccess::DepthTest, 0 };
+	passes[3].Dependencies.push_back(2);
+	passes[4].Usage[TargetHandle("MainOutput")] = { ResourceAccess::Read, 0 }; // Upscale
+	passes[4].Usage[TargetHandle("Output")] = { ResourceAccess::Write, 0 };
+
+	EXPECT(SortPasses(passes) == std::vector<uint32_t>({ 0, 1, 2, 3, 4 }));
+
+	// Declaring the depth test as a write makes the skybox a writer every reader of depth has to wait on
+	passes[3].Usage[depth] = { ResourceAccess::Write, 0 };
+	EXPECT(SortPasses(passes).empty());
+}
+
+MULE_TEST(FindLivePassesKeepsWhatReachesTheOutput)
+{
+	std::vector<PassDeclaration> passes(5);
+	passes[0].Usage[TargetHandle("GBuffer")] = { ResourceAccess::Write, 0 };
+	passes[1].Usage[TargetHandle("GBuffer")] = { ResourceAccess::Read, 0 };
+	passes[1].Usage[TargetHandle("Output")] = { ResourceAccess::Write, 0 };
+	passes[2].Usage[TargetHandle("Debug")] = { ResourceAccess::Write, 0 }; // Nobody reads it
+	passes[3].Usage[TargetHandle("Readback")] = { ResourceAccess::Write, 0 };
+	passes[3].SideEffects = true;
+	passes[4].Usage[TargetHandle("Depth")] = { ResourceAccess::Write, 0 };
+	passes[0].Dependencies.push_back(4);
+
+	std::vector<bool> live = FindLivePasses(passes, TargetHandle("Output"));
+	EXPECT(live[0]);
+	EXPECT(live[1]);
+	EXPECT(!live[2]);
+	EXPECT(live[3]);
+	EXPECT(live[4]);
+}
+
+MULE_BENCHMARK(Compile500Passes)
+{
+	std::vector<PassDeclaration> passes = BuildChain(500, 8);
+
+	std::vector<uint32_t> order;
+	Mule::Tests::Measure("SortPasses 500 passes", 20, [&]() {
+		order = SortPasses(passes);
+		});
+
+	EXPECT_EQ(order.size(), passes.size());
+
+	Mule::Tests::Measure("FindLivePasses 500 passes", 20, [&]() {
+		FindLivePasses(passes, TargetHandle("Output"));
+		});
+
+	std::vector<std::unordered_map<ResourceHandle, ResourceUsage>> passUsage;
+	std::vector<QueueSchedulePass> schedulePasses(order.size());
+	for (uint32_t i = 0; i < order.size(); i++)
+	{
+		passUsage.push_back(passes[order[i]].Usage);
+		schedulePasses[i].Usage = passes[order[i]].Usage;
+		schedulePasses[i].Type = i % 3 == 0 ? PassType::Compute : PassType::Graphics;
+	}
+
+	Mule::Tests::Measure("ComputeResourceLifetimes 500 passes", 20, [&]() {
+		ComputeResourceLifetimes(passUsage);
+		});
+
+	Mule::Tests::Measure("Full compile 500 passes", 20, [&]() {
+		std::vector<uint32_t> sorted = SortPasses(passes);
+		FindLivePasses(passes, TargetHandle("Output"));
+		ComputeResourceLifetimes(passUsage);
+
+		std::vector<QueueType> queues = AssignQueues(schedulePasses, TargetHandle("Output"), true);
+		for (uint32_t i = 0; i < schedulePasses.size(); i++)
+			schedulePasses[i].Queue = queues[i];
+
+		ScheduleQueues(schedulePasses);
+		});
+}
@@ -0,0 +1,136 @@
+#include "Test.h"
+
+#include "Graphics/Renderer/HiZ.h"
+
+using namespace Mule;
+
+namespace
+{
+	// Orthographic view of x and y in [-10, 10] and depth z in [0, 10]
+	glm::mat4 MakeViewProjection()
+	{
+		glm::mat4 viewProjection(1.f);
+		viewProjection[0][0] = 0.1f;
+		viewProjection[1][1] = 0.1f;
+		viewProjection[2][2] = 0.1f;
+		return viewProjection;
+	}
+
+	// A depth buffer with a wall at depth 0.3 over its left half and nothing over the right half
+	void BuildWallPyramid(HiZPyramid& pyramid)
+	{
+		const uint32_t width = 640;
+		const uint32_t height = 480;
+
+		std::vector<float> depth(width * height, 1.f);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width / 2; x++)
+				depth[y * width + x] = 0.3f;
+		}
+
+		std::vector<float> base(HIZ_WIDTH * HIZ_HEIGHT);
+		DownsampleDepth(depth.data(), width, height, HIZ_WIDTH, HIZ_HEIGHT, base.data());
+		BuildHiZPyramid(base.data(), HIZ_WIDTH, HIZ_HEIGHT, pyramid);
+	}
+}
+
+MULE_TEST(DownsampleDepthKeepsTheFarthestDepth)
+{
+	// 4x4 down to 2x2 and to a size that does not divide evenly
+	float depth[16] = {
+		0.1f, 0.2f, 0.3f, 0.4f,
+		0.5f, 0.6f, 0.7f, 0.8f,
+		0.1f, 0.1f, 0.1f, 0.1f,
+		0.1f, 0.9f, 0.1f, 0.1f,
+	};
+
+	float out[4];
+	DownsampleDepth(depth, 4, 4, 2, 2, out);
+	EXPECT_EQ(out[0], 0.6f);
+	EXPECT_EQ(out[1], 0.8f);
+	EXPECT_EQ(out[2], 0.9f);
+	EXPECT_EQ(out[3], 0.1f);
+
+	// Every output texel covers each input texel it overlaps, so the middle column is in both halves
+	float odd[9] = {
+		0.1f, 0.5f, 0.1f,
+		0.1f, 0.1f, 0.1f,
+		0.1f, 0.1f, 0.2f,
+	};
+	DownsampleDepth(odd, 3, 3, 2, 2, out);
+	EXPECT_EQ(out[0], 0.5f);
+	EXPECT_EQ(out[1], 0.5f);
+	EXPECT_EQ(out[2], 0.1f);
+	EXPECT_EQ(out[3], 0.2f);
+}
+
+MULE_TEST(HiZPyramidLevelsRoundUp)
+{
+	std::vector<float> depth(7 * 5);
+	for (uint32_t i = 0; i < depth.size(); i++)
+		depth[i] = static_cast<float>(i) / depth.size();
+
+	HiZPyramid pyramid;
+	BuildHiZPyramid(depth.data(), 7, 5, pyramid);
+
+	EXPECT_EQ(pyramid.GetLevelCount(), 4u);
+	EXPECT(pyramid.Sizes[1] == glm::uvec2(4, 3));
+	EXPECT(pyramid.Sizes[2] == glm::uvec2(2, 2));
+	EXPECT(pyramid.Sizes[3] == glm::uvec2(1, 1));
+
+	// Every texel is the max of the texels below it, the top is the farthest depth of the image
+	EXPECT_EQ(pyramid.Load(3, 0, 0), depth.back());
+	for (uint32_t level = 1; level < pyramid.GetLevelCount(); level++)
+	{
+		glm::uvec2 size = pyramid.Sizes[level - 1];
+		for (uint32_t y = 0; y < size.y; y++)
+		{
+			for (uint32_t x = 0; x < size.x; x++)
+				EXPECT(pyramid.Load(level, x / 2, y / 2) >= pyramid.Load(level - 1, x, y));
+		}
+	}
+}
+
+MULE_TEST(HiZOccludesBehindTheWall)
+{
+	HiZPyramid pyramid;
+	BuildWallPyramid(pyramid);
+	glm::mat4 viewProjection = MakeViewProjection();
+
+	EXPECT(IsOccluded(pyramid, viewProjection, glm::vec4(-5.f, 0.f, 6.f, 1.f)));
+	EXPECT(IsOccluded(pyramid, viewProjection, glm::vec4(-5.f, 0.f, 7.f, 3.f)));
+}
+
+MULE_TEST(HiZKeepsVisibleBounds)
+{
+	HiZPyramid pyramid;
+	BuildWallPyramid(pyramid);
+	glm::mat4 viewProjection = MakeViewProjection();
+
+	EXPECT(!IsOccluded(pyramid, viewProjection, glm::vec4(-5.f, 0.f, 1.f, 0.5f))); // In front of the wall
+	EXPECT(!IsOccluded(pyramid, viewProjection, glm::vec4(5.f, 0.f, 6.f, 1.f))); // Nothing in front of it
+	EXPECT(!IsOccluded(pyramid, viewProjection, glm::vec4(0.f, 0.f, 6.f, 1.f))); // Partly behind the wall
+	EXPECT(!IsOccluded(pyramid, viewProjection, glm::vec4(-9.5f, 0.f, 6.f, 1.f))); // Leaves the screen
+	EXPECT(!IsOccluded(pyramid, viewProjection, glm::vec4(-5.f, 0.f, 0.f, 1.f))); // Crosses the near plane
+
+	HiZPyramid empty;
+	EXPECT(!IsOccluded(empty, viewProjection, glm::vec4(-5.f, 0.f, 6.f, 1.f)));
+}
+
+MULE_BENCHMARK(HiZBuildAndTest)
+{
+	HiZPyramid pyramid;
+	std::vector<float> base(HIZ_WIDTH * HIZ_HEIGHT, 0.5f);
+	Mule::Tests::Measure("BuildHiZPyramid 256x128", 1000, [&]() {
+		BuildHiZPyramid(base.data(), HIZ_WIDTH, HIZ_HEIGHT, pyramid);
+		});
+
+	BuildWallPyramid(pyramid);
+	glm::mat4 viewProjection = MakeViewProjection();
+	uint32_t occluded = 0;
+	Mule::Tests::Measure("IsOccluded 10k spheres", 100, [&]() {
+		for (uint32_t i = 0; i < 10000; i++)
+			occluded += IsOccluded(pyramid, viewProjection, glm::vec4(-9.f + (i % 180) * 0.1f, 0.f, 6.f, 0.5f));
+		});
+}
@@ -0,0 +1,179 @@
+#include "Test.h"
+
+#include "Graphics/Renderer/IndirectDrawList.h"
+#include "Graphics/Renderer/ObjectTable.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Mule;
+
+namespace
+{
+	// The draw list only compares mesh pointers, so stand ins that are never dereferenced are enough
+	uint64_t sMeshStorage[2];
+	Mesh* const sMeshA = reinterpret_cast<Mesh*>(&sMeshStorage[0]);
+	Mesh* const sMeshB = reinterpret_cast<Mesh*>(&sMeshStorage[1]);
+
+	IndirectDrawItem Item(Mesh* mesh, uint32_t firstIndex, uint32_t indexCount, uint32_t objectIndex)
+	{
+		IndirectDrawItem item;
+		item.Mesh = mesh;
+		item.FirstIndex = firstIndex;
+		item.IndexCount = indexCount;
+		item.ObjectIndex = objectIndex;
+		return item;
+	}
+
+	// Object indices the instances of a command resolve to through gl_InstanceIndex
+	std::vector<uint32_t> GetCommandObjects(const IndirectDrawList& drawList, uint32_t command)
+	{
+		const GPU::DrawIndexedIndirectCommand& args = drawList.Commands[command];
+		std::vector<uint32_t> objects(
+			drawList.InstanceObjectIndices.begin() + args.FirstInstance,
+			drawList.InstanceObjectIndices.begin() + args.FirstInstance + args.InstanceCount);
+		std::sort(objects.begin(), objects.end());
+		return objects;
+	}
+
+	GPU::ObjectData Object(float x)
+	{
+		GPU::ObjectData data{};
+		data.Transform = glm::mat4(1.f);
+		data.Transform[3][0] = x;
+		return data;
+	}
+}
+
+MULE_TEST(IndirectDrawListGroupsByMeshAndLevel)
+{
+	// Level 1 of mesh A starts at index 300
+	std::vector<IndirectDrawItem> items = {
+		Item(sMeshA, 0, 300, 0),
+		Item(sMeshB, 0, 36, 1),
+		Item(sMeshA, 300, 120, 2),
+		Item(sMeshA, 0, 300, 3),
+		Item(sMeshB, 0, 36, 4),
+		Item(sMeshA, 0, 300, 5),
+	};
+
+	IndirectDrawList drawList;
+	BuildIndirectDrawList(items, drawList);
+
+	EXPECT_EQ(drawList.Commands.size(), 3u);
+	EXPECT_EQ(drawList.Meshes.size(), drawList.Commands.size());
+	EXPECT_EQ(drawList.InstanceObjectIndices.size(), items.size());
+
+	uint32_t instances = 0;
+	for (uint32_t i = 0; i < drawList.Commands.size(); i++)
+	{
+		const GPU::DrawIndexedIndirectCommand& command = drawList.Commands[i];
+		EXPECT_EQ(command.FirstInstance, instances);
+		EXPECT_EQ(command.VertexOffset, 0);
+		instances += command.InstanceCount;
+
+		if (drawList.Meshes[i].Get() == sMeshB)
+		{
+			EXPECT_EQ(command.FirstIndex, 0u);
+			EXPECT_EQ(command.IndexCount, 36u);
+			EXPECT(GetCommandObjects(drawList, i) == std::vector<uint32_t>({ 1, 4 }));
+		}
+		else if (command.FirstIndex == 0)
+		{
+			EXPECT_EQ(command.IndexCount, 300u);
+			EXPECT(GetCommandObjects(drawList, i) == std::vector<uint32_t>({ 0, 3, 5 }));
+		}
+		else
+		{
+			EXPECT_EQ(command.FirstIndex, 300u);
+			EXPECT_EQ(command.IndexCount, 120u);
+			EXPECT(GetCommandObjects(drawList, i) == std::vector<uint32_t>({ 2 }));
+		}
+	}
+	EXPECT_EQ(instances, static_cast<uint32_t>(items.size()));
+
+	// Building again replaces the previous commands
+	std::vector<IndirectDrawItem> single = { Item(sMeshB, 0, 36, 7) };
+	BuildIndirectDrawList(single, drawList);
+	EXPECT_EQ(drawList.Commands.size(), 1u);
+	EXPECT_EQ(drawList.Commands[0].InstanceCount, 1u);
+	EXPECT_EQ(drawList.Commands[0].FirstInstance, 0u);
+	EXPECT(drawList.InstanceObjectIndices == std::vector<uint32_t>({ 7 }));
+}
+
+MULE_TEST(AppendIndirectDrawListKeepsEarlierCommands)
+{
+	IndirectDrawList drawList;
+
+	std::vector<IndirectDrawItem> first = { Item(sMeshA, 0, 300, 0), Item(sMeshA, 0, 300, 1) };
+	BuildIndirectDrawList(first, drawList);
+
+	// The same mesh and level again starts a new command instead of growing the earlier one
+	std::vector<IndirectDrawItem> second = { Item(sMeshA, 0, 300, 2) };
+	AppendIndirectDrawList(second, drawList);
+
+	EXPECT_EQ(drawList.Commands.size(), 2u);
+	EXPECT_EQ(drawList.Commands[0].InstanceCount, 2u);
+	EXPECT_EQ(drawList.Commands[1].InstanceCount, 1u);
+	EXPECT_EQ(drawList.Commands[1].FirstInstance, 2u);
+	EXPECT(GetCommandObjects(drawList, 1) == std::vector<uint32_t>({ 2 }));
+}
+
+MULE_TEST(IndirectDrawListWithNoItems)
+{
+	IndirectDrawList drawList;
+	std::vector<IndirectDrawItem> items;
+	BuildIndirectDrawList(items, drawList);
+
+	EXPECT(drawList.Commands.empty());
+	EXPECT(drawList.Meshes.empty());
+	EXPECT(drawList.InstanceObjectIndices.empty());
+}
+
+MULE_TEST(ObjectTableUploadsOnlyChangedObjects)
+{
+	int world = 0;
+	ObjectTable table(2);
+
+	uint32_t first = table.Update(&world, 1, Object(1.f));
+	uint32_t second = table.Update(&world, 2, Object(2.f));
+	EXPECT(first != second);
+	EXPECT_EQ(table.GetSlotCount(), 2u);
+	EXPECT_EQ(table.GetPendingUploads(0).size(), 2u);
+	EXPECT_EQ(table.GetPendingUploads(1).size(), 2u);
+
+	// Frame 0 uploaded, unchanged data queues nothing
+	table.ClearPendingUploads(0);
+	EXPECT_EQ(table.Update(&world, 1, Object(1.f)), first);
+	EXPECT(table.GetPendingUploads(0).empty());
+
+	// A change is queued for frame 0 again and only once for frame 1, which has not uploaded yet
+	table.Update(&world, 2, Object(3.f));
+	EXPECT(table.GetPendingUploads(0) == std::vector<uint32_t>({ second }));
+	EXPECT_EQ(table.GetPendingUploads(1).size(), 2u);
+	EXPECT_EQ(table.GetObjects()[second].Transform[3][0], 3.f);
+}
+
+MULE_TEST(ObjectTableReusesSlotsOfRemovedWorlds)
+{
+	int worldA = 0;
+	int worldB = 0;
+	ObjectTable table(1);
+
+	// The same id in two worlds gets two slots
+	uint32_t inA = table.Update(&worldA, 1, Object(1.f));
+	uint32_t inB = table.Update(&worldB, 1, Object(2.f));
+	EXPECT(inA != inB);
+	EXPECT_EQ(table.QueryIndex(&worldA, 1), inA);
+	EXPECT_EQ(table.QueryIndex(&worldB, 1), inB);
+
+	table.ClearPendingUploads(0);
+	table.RemoveWorld(&worldA);
+	EXPECT_EQ(table.QueryIndex(&worldA, 1), UINT32_MAX);
+	EXPECT_EQ(table.QueryIndex(&worldB, 1), inB);
+
+	uint32_t reused = table.Update(&worldB, 2, Object(3.f));
+	EXPECT_EQ(reused, inA);
+	EXPECT_EQ(table.GetSlotCount(), 2u);
+	EXPECT(table.GetPendingUploads(0) == std::vector<uint32_t>({ reused }));
+}
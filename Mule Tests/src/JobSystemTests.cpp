@@ -0,0 +1,124 @@
+#include "Test.h"
+
+#include "JobSystem/JobSystem.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Mule;
+
+MULE_TEST(ParallelForCallsEveryIndexOnce)
+{
+	JobSystem jobSystem;
+
+	for (uint32_t count : { 1u, 2u, 7u, 1000u })
+	{
+		std::vector<std::atomic<uint32_t>> calls(count);
+		jobSystem.ParallelFor(count, [&](uint32_t i) {
+			calls[i]++;
+			});
+
+		for (uint32_t i = 0; i < count; i++)
+			EXPECT_EQ(calls[i].load(), 1u);
+	}
+}
+
+MULE_TEST(ParallelForWithNoWorkReturns)
+{
+	JobSystem jobSystem;
+
+	bool called = false;
+	jobSystem.ParallelFor(0, [&](uint32_t) {
+		called = true;
+		});
+
+	EXPECT(!called);
+}
+
+MULE_TEST(ParallelForWaitsForEveryCall)
+{
+	JobSystem jobSystem;
+
+	// The calls outlive the index counter, ParallelFor must not return until the slow ones have finished too
+	std::atomic<uint32_t> finished = 0;
+	jobSystem.ParallelFor(16, [&](uint32_t i) {
+		if (i % 4 == 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		finished++;
+		});
+
+	EXPECT_EQ(finished.load(), 16u);
+}
+
+MULE_TEST(ParallelForCanBeCalledBackToBack)
+{
+	JobSystem jobSystem;
+
+	std::atomic<uint64_t> sum = 0;
+	for (uint32_t frame = 0; frame < 100; frame++)
+	{
+		jobSystem.ParallelFor(8, [&](uint32_t i) {
+			sum += i;
+			});
+	}
+
+	EXPECT_EQ(sum.load(), 100ull * 28ull);
+}
+
+MULE_TEST(ParallelForDoesNotWaitForQueuedJobs)
+{
+	JobSystem jobSystem;
+
+	// Every worker is stuck in a job the way a long asset load holds it, so the helpers queue behind them
+	std::atomic<bool> release = false;
+	std::atomic<uint32_t> blocked = 0;
+	for (uint32_t i = 0; i < jobSystem.GetWorkerCount(); i++)
+	{
+		jobSystem.PushJob([&]() {
+			blocked++;
+			while (!release)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			blocked--;
+			});
+	}
+
+	while (blocked != jobSystem.GetWorkerCount())
+		std::this_thread::yield();
+
+	std::vector<uint32_t> calls(64, 0);
+	jobSystem.ParallelFor(64, [&](uint32_t i) {
+		calls[i]++;
+		});
+
+	// The calling thread did all of the work while the workers were still blocked
+	EXPECT_EQ(blocked.load(), jobSystem.GetWorkerCount());
+	for (uint32_t i = 0; i < calls.size(); i++)
+		EXPECT_EQ(calls[i], 1u);
+
+	// The helpers start once the workers are released, they find nothing left to do and must not call into the old frame
+	release = true;
+	while (blocked != 0)
+		std::this_thread::yield();
+
+	std::atomic<uint32_t> later = 0;
+	jobSystem.ParallelFor(8, [&](uint32_t) {
+		later++;
+		});
+
+	EXPECT_EQ(later.load(), 8u);
+	for (uint32_t i = 0; i < calls.size(); i++)
+		EXPECT_EQ(calls[i], 1u);
+}
+
+MULE_BENCHMARK(ParallelForDispatch)
+{
+	JobSystem jobSystem;
+
+	std::atomic<uint32_t> sink = 0;
+	Mule::Tests::Measure("ParallelFor 8 empty jobs", 1000, [&]() {
+		jobSystem.ParallelFor(8, [&](uint32_t i) {
+			sink += i;
+			});
+		});
+}
@@ -0,0 +1,207 @@
+#include "Test.h"
+
+#include "Graphics/MeshSimplifier.h"
+#include "Graphics/Renderer/LodSelection.h"
+
+#include <cmath>
+#include <set>
+
+using namespace Mule;
+
+namespace
+{
+	// A bumpy heightfield of size x size quads, two triangles each
+	void BuildGrid(uint32_t size, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices)
+	{
+		positions.clear();
+		indices.clear();
+
+		for (uint32_t y = 0; y <= size; y++)
+		{
+			for (uint32_t x = 0; x <= size; x++)
+			{
+				float height = std::sin(x * 0.1f) * std::cos(y * 0.1f) * 3.f;
+				positions.push_back(glm::vec3(static_cast<float>(x), height, static_cast<float>(y)));
+			}
+		}
+
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				uint32_t a = y * (size + 1) + x;
+				uint32_t b = a + 1;
+				uint32_t c = a + size + 1;
+				uint32_t d = c + 1;
+				indices.insert(indices.end(), { a, c, b, b, c, d });
+			}
+		}
+	}
+
+	bool IsValidIndexList(const std::vector<uint32_t>& indices, uint32_t first, uint32_t count, size_t vertexCount)
+	{
+		if (count % 3 != 0 || first + count > indices.size())
+			return false;
+
+		for (uint32_t i = first; i < first + count; i += 3)
+		{
+			uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+			if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+				return false;
+
+			// Collapsed triangles must have been removed
+			if (a == b || b == c || a == c)
+				return false;
+		}
+
+		return true;
+	}
+}
+
+MULE_TEST(SimplifyMeshReachesTarget)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	BuildGrid(32, positions, indices);
+
+	uint32_t target = static_cast<uint32_t>(indices.size() / 4);
+	std::vector<uint32_t> simplified = SimplifyMesh(positions, indices, target);
+
+	EXPECT(IsValidIndexList(simplified, 0, static_cast<uint32_t>(simplified.size()), positions.size()));
+	EXPECT(simplified.size() <= target + target / 10);
+	EXPECT(simplified.size() > 0);
+}
+
+MULE_TEST(SimplifyMeshKeepsBorders)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	BuildGrid(16, positions, indices);
+
+	std::vector<uint32_t> simplified = SimplifyMesh(positions, indices, static_cast<uint32_t>(indices.size() / 4));
+
+	// The corners of an open grid can only go if the border moves
+	std::set<uint32_t> used(simplified.begin(), simplified.end());
+	uint32_t last = 16 * 17 + 16;
+	EXPECT(used.count(0) == 1);
+	EXPECT(used.count(16) == 1);
+	EXPECT(used.count(16 * 17) == 1);
+	EXPECT(used.count(last) == 1);
+}
+
+MULE_TEST(SimplifyMeshWithLargerTargetIsUnchanged)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	BuildGrid(4, positions, indices);
+
+	std::vector<uint32_t> simplified = SimplifyMesh(positions, indices, static_cast<uint32_t>(indices.size()));
+	EXPECT_EQ(simplified.size(), indices.size());
+}
+
+MULE_TEST(BuildLodChainLevelsShrink)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	BuildGrid(64, positions, indices);
+
+	std::vector<uint32_t> lodIndices;
+	std::vector<MeshLod> lods;
+	BuildLodChain(positions, indices, 5, 0.5f, 64, lodIndices, lods);
+
+	EXPECT(lods.size() > 1);
+	EXPECT(lods.size() <= 5);
+	EXPECT_EQ(lods[0].FirstIndex, 0u);
+	EXPECT_EQ(lods[0].IndexCount, static_cast<uint32_t>(indices.size()));
+
+	for (uint32_t i = 0; i < lods.size(); i++)
+	{
+		EXPECT(IsValidIndexList(lodIndices, lods[i].FirstIndex, lods[i].IndexCount, positions.size()));
+		EXPECT(lods[i].IndexCount / 3 >= 64 || i == 0);
+
+		if (i > 0)
+		{
+			EXPECT(lods[i].IndexCount < lods[i - 1].IndexCount);
+			EXPECT_EQ(lods[i].FirstIndex, lods[i - 1].FirstIndex + lods[i - 1].IndexCount);
+		}
+	}
+}
+
+MULE_TEST(BuildLodChainStopsAtMinimumTriangles)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	BuildGrid(4, positions, indices); // 32 triangles
+
+	std::vector<uint32_t> lodIndices;
+	std::vector<MeshLod> lods;
+	BuildLodChain(positions, indices, 5, 0.5f, 64, lodIndices, lods);
+
+	EXPECT_EQ(lods.size(), 1u);
+	EXPECT_EQ(lodIndices.size(), indices.size());
+}
+
+MULE_TEST(LodScreenSizesHalve)
+{
+	EXPECT(std::isinf(GetLodScreenSize(0)));
+	for (uint32_t lod = 1; lod < 6; lod++)
+		EXPECT_NEAR(GetLodScreenSize(lod + 1), GetLodScreenSize(lod) * 0.5f, 1e-6f);
+}
+
+MULE_TEST(ComputeScreenSizeFallsWithDistance)
+{
+	glm::vec4 sphere(0.f, 0.f, 0.f, 1.f);
+
+	EXPECT_EQ(ComputeScreenSize(sphere, glm::vec3(0.f, 0.f, 0.5f), 1.f), 1.f);
+	EXPECT_NEAR(ComputeScreenSize(sphere, glm::vec3(0.f, 0.f, 10.f), 1.f), 0.1f, 1e-6f);
+	EXPECT_NEAR(ComputeScreenSize(sphere, glm::vec3(0.f, 0.f, 20.f), 1.f), 0.05f, 1e-6f);
+	EXPECT_NEAR(ComputeScreenSize(sphere, glm::vec3(0.f, 0.f, 10.f), -2.f), 0.2f, 1e-6f);
+}
+
+MULE_TEST(SelectLodWithoutHistory)
+{
+	EXPECT_EQ(SelectLod(0.01f, 1, UINT32_MAX), 0u);
+	EXPECT_EQ(SelectLod(1.f, 4, UINT32_MAX), 0u);
+	EXPECT_EQ(SelectLod(0.4f, 4, UINT32_MAX), 1u);
+	EXPECT_EQ(SelectLod(0.2f, 4, UINT32_MAX), 2u);
+	EXPECT_EQ(SelectLod(0.001f, 4, UINT32_MAX), 3u);
+}
+
+MULE_TEST(SelectLodHysteresis)
+{
+	// Just past the level 1 boundary is not far enough to leave level 0 or to come back to it
+	float boundary = GetLodScreenSize(1);
+	EXPECT_EQ(SelectLod(boundary * 0.95f, 4, 0), 0u);
+	EXPECT_EQ(SelectLod(boundary * 0.85f, 4, 0), 1u);
+	EXPECT_EQ(SelectLod(boundary * 1.05f, 4, 1), 1u);
+	EXPECT_EQ(SelectLod(boundary * 1.15f, 4, 1), 0u);
+
+	// A stale history past the last level is clamped
+	EXPECT_EQ(SelectLod(0.001f, 2, 5), 1u);
+}
+
+MULE_BENCHMARK(SimplifyGrid)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	BuildGrid(200, positions, indices);
+
+	std::vector<uint32_t> lodIndices;
+	std::vector<MeshLod> lods;
+	Mule::Tests::Measure("BuildLodChain 80k triangles, 5 levels", 3, [&]() {
+		BuildLodChain(positions, indices, 5, 0.5f, 64, lodIndices, lods);
+		});
+}
+
+MULE_BENCHMARK(SelectLods)
+{
+	std::vector<float> sizes(100000);
+	for (uint32_t i = 0; i < sizes.size(); i++)
+		sizes[i] = 1.f / (1.f + i * 0.01f);
+
+	uint32_t sink = 0;
+	Mule::Tests::Measure("SelectLod 100k objects", 100, [&]() {
+		for (float size : sizes)
+			sink += SelectLod(size, 5, sink & 3);
+		});
+}
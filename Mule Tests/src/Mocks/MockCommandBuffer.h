@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Graphics/API/CommandBuffer.h"
+
+#include <vector>
+
+namespace Mule::Tests
+{
+	// Records what was recorded into it instead of talking to a device, secondaries are replayed by ExecuteSecondary
+	class MockCommandBuffer : public CommandBuffer
+	{
+	public:
+		struct IndirectDraw
+		{
+			uint32_t Offset;
+			uint32_t DrawCount;
+		};
+
+		void Reset() override { mDraws.clear(); mRecording = false; mSecondary = false; mBeginCount = 0; }
+		void Begin() override { mRecording = true; mBeginCount++; }
+		void End() override { mRecording = false; }
+
+		void BeginSwapchainRendering() override {}
+		void EndSwapchainRendering() override {}
+		void BeginRendering(WeakRef<Framebuffer> framebuffer, WeakRef<GraphicsPipeline> shader, const std::vector<WeakRef<ShaderResourceGroup>>& groups = {}) override {}
+		void ClearFrameBuffer(WeakRef<Framebuffer> framebuffer) override {}
+		void ClearTexture(WeakRef<Texture2D> texture) override {}
+		void EndRendering() override {}
+
+		void BeginRendering(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, bool secondaryContents = false, glm::uvec2 renderArea = glm::uvec2(0)) override {}
+		void BindPipeline(WeakRef<GraphicsPipeline> pipeline, const std::vector<WeakRef<ShaderResourceGroup>>& groups = {}) override {}
+		void ClearDepthAttachmentLayer(uint32_t layer, uint32_t width, uint32_t height) override {}
+
+		void TranistionImageLayout(WeakRef<Texture> texture, ImageLayout newLayout) override {}
+		void TransitionImageLayouts(const std::vector<TextureTransition>& transitions) override {}
+		void CopyTexture(WeakRef<Texture> src, WeakRef<Texture> dst, const TextureCopyInfo& copyInfo) const override {}
+		void ReadTexture(WeakRef<Texture> texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height, WeakRef<StagingBuffer> buffer) const override {}
+
+		void SetPushConstants(WeakRef<GraphicsPipeline> shader, ShaderStage stage, const void* data, uint32_t size) override {}
+
+		void BindComputePipeline(WeakRef<ComputePipeline> shader, const std::vector<WeakRef<ShaderResourceGroup>>& groups = {}) override {}
+		void SetPushConstants(WeakRef<ComputePipeline> shader, void* data, uint32_t size) override {}
+		void Execute(uint32_t workGroupsX, uint32_t workGroupsY, uint32_t workGroupsZ) override {}
+		void ReadbackBarrier(WeakRef<StorageBuffer> buffer) override {}
+
+		void BindMesh(WeakRef<Mesh> mesh) override {}
+		void DrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount = 1) override {}
+		void BindAndDrawMesh(WeakRef<Mesh> mesh, uint32_t instanceCount) override {}
+		void DrawMeshIndirect(WeakRef<StorageBuffer> argumentBuffer, uint32_t offset, uint32_t drawCount) override
+		{
+			mDraws.push_back({ offset, drawCount });
+		}
+
+		void SetViewport(uint32_t x, uint32_t width, uint32_t y, uint32_t height) override {}
+		void SetScissor(uint32_t x, uint32_t width, uint32_t y, uint32_t height) override {}
+
+		void BeginSecondary(const std::vector<BeginRenderingAttachment>& colorAttachments, BeginRenderingAttachment depthAttachment, glm::uvec2 renderArea = glm::uvec2(0)) override
+		{
+			mRecording = true;
+			mSecondary = true;
+			mBeginCount++;
+		}
+
+		void ExecuteSecondary(const std::vector<Ref<CommandBuffer>>& commandBuffers) override
+		{
+			for (const Ref<CommandBuffer>& commandBuffer : commandBuffers)
+			{
+				const MockCommandBuffer* secondary = static_cast<const MockCommandBuffer*>(commandBuffer.Get());
+				if (!secondary->mSecondary || secondary->mRecording)
+					mInvalidSecondaries++;
+
+				mDraws.insert(mDraws.end(), secondary->mDraws.begin(), secondary->mDraws.end());
+			}
+		}
+
+		void ResetQueries(WeakRef<TimestampQueryPool> queryPool) override {}
+		void WriteTimestamp(WeakRef<TimestampQueryPool> queryPool, uint32_t query) override {}
+
+		const std::vector<IndirectDraw>& GetDraws() const { return mDraws; }
+		uint32_t GetBeginCount() const { return mBeginCount; }
+		bool IsRecording() const { return mRecording; }
+
+		// Secondaries replayed while still recording or that were never begun as a secondary
+		uint32_t GetInvalidSecondaries() const { return mInvalidSecondaries; }
+
+	private:
+		std::vector<IndirectDraw> mDraws;
+		bool mRecording = false;
+		bool mSecondary = false;
+		uint32_t mBeginCount = 0;
+		uint32_t mInvalidSecondaries = 0;
+	};
+}
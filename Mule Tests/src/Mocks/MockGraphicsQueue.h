@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Graphics/API/GraphicsQueue.h"
+
+#include <assert.h>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace Mule::Tests
+{
+	class MockTimelineSemaphore : public TimelineSemaphore
+	{
+	public:
+		uint64_t GetValue() const override { return mValue; }
+		void Wait(uint64_t value) const override { assert(mValue >= value && "Mock semaphores never advance while waiting"); }
+
+		void Signal(uint64_t value) { mValue = std::max(mValue, value); }
+
+	private:
+		uint64_t mValue = 0;
+	};
+
+	// Keeps batched submissions until Step runs them, one at a time in submission order. A submission only runs once
+	// every timeline value it waits on has been signaled, like it would on a device
+	class MockGraphicsQueue : public GraphicsQueue
+	{
+	public:
+		explicit MockGraphicsQueue(QueueType type = QueueType::Graphics) : GraphicsQueue(type) {}
+
+		void Submit(Ref<CommandBuffer> commandBuffer, const std::vector<Ref<Semaphore>>& waitSemaphores, const std::vector<Ref<Semaphore>>& signalSemaphores, Ref<Fence> fence) override
+		{
+			assert(false && "The render graph only submits batches");
+		}
+
+		void Submit(Ref<CommandBuffer> commandBuffer, Ref<TimelineSemaphore> semaphore, uint64_t waitValue, uint64_t signalValue, Ref<Fence> fence = nullptr) override
+		{
+			Submit(commandBuffer, semaphore, waitValue, semaphore, signalValue, fence);
+		}
+
+		void Submit(Ref<CommandBuffer> commandBuffer, Ref<TimelineSemaphore> waitSemaphore, uint64_t waitValue, Ref<TimelineSemaphore> signalSemaphore, uint64_t signalValue, Ref<Fence> fence = nullptr) override
+		{
+			mPending.push_back({ commandBuffer, { { waitSemaphore, waitValue } }, { signalSemaphore, signalValue } });
+			mSubmitCalls++;
+		}
+
+		void Submit(const std::vector<QueueSubmission>& submissions, Ref<Fence> fence = nullptr) override
+		{
+			mPending.insert(mPending.end(), submissions.begin(), submissions.end());
+			mSubmitCalls++;
+		}
+
+		// Runs the oldest submission if its waits are met, returns false if nothing could run
+		bool Step(const std::function<void(const Ref<CommandBuffer>&)>& execute)
+		{
+			if (mPending.empty())
+				return false;
+
+			const QueueSubmission& submission = mPending.front();
+			for (const TimelineValue& wait : submission.Waits)
+			{
+				if (wait.Semaphore && wait.Semaphore->GetValue() < wait.Value)
+					return false;
+			}
+
+			execute(submission.CommandBuffer);
+
+			if (submission.Signal.Semaphore)
+				static_cast<MockTimelineSemaphore*>(submission.Signal.Semaphore.Get())->Signal(submission.Signal.Value);
+
+			mPending.pop_front();
+			return true;
+		}
+
+		bool IsIdle() const { return mPending.empty(); }
+		uint32_t GetSubmitCalls() const { return mSubmitCalls; }
+
+	private:
+		std::deque<QueueSubmission> mPending;
+		uint32_t mSubmitCalls = 0;
+	};
+
+	// Steps the queues, preferring them in the order given, until every queue is idle. Returns false if the submissions
+	// left wait on each other
+	inline bool RunQueues(const std::vector<MockGraphicsQueue*>& queues, const std::function<void(const Ref<CommandBuffer>&)>& execute)
+	{
+		while (true)
+		{
+			bool idle = true;
+			bool progress = false;
+			for (MockGraphicsQueue* queue : queues)
+			{
+				idle &= queue->IsIdle();
+				if (queue->Step(execute))
+				{
+					progress = true;
+					break;
+				}
+			}
+
+			if (idle)
+				return true;
+
+			if (!progress)
+				return false;
+		}
+	}
+}
@@ -0,0 +1,98 @@
+#include "Test.h"
+
+#include "Graphics/OctahedralNormal.h"
+
+#include <random>
+#include <vector>
+
+using namespace Mule;
+
+namespace
+{
+	constexpr float sPi = 3.14159265358979f;
+
+	// Uniform over the sphere, plus the axes and the folds of the octahedron where encodings tend to break
+	std::vector<glm::vec3> BuildNormals(uint32_t count)
+	{
+		std::vector<glm::vec3> normals = {
+			glm::vec3(1.f, 0.f, 0.f), glm::vec3(-1.f, 0.f, 0.f),
+			glm::vec3(0.f, 1.f, 0.f), glm::vec3(0.f, -1.f, 0.f),
+			glm::vec3(0.f, 0.f, 1.f), glm::vec3(0.f, 0.f, -1.f),
+			glm::normalize(glm::vec3(1.f, 1.f, 0.f)), glm::normalize(glm::vec3(-1.f, 1.f, -1.f)),
+			glm::normalize(glm::vec3(1.f, -1.f, -1.f)), glm::normalize(glm::vec3(-1.f, -1.f, 1.f))
+		};
+
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		std::uniform_real_distribution<float> angle(0.f, 2.f * sPi);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			float z = unit(random);
+			float phi = angle(random);
+			float r = std::sqrt(std::max(1.f - z * z, 0.f));
+			normals.push_back(glm::vec3(r * std::cos(phi), r * std::sin(phi), z));
+		}
+
+		return normals;
+	}
+
+	// acos of a float dot product cannot resolve the hundredths of a degree the 16 bit encoding reaches
+	float AngleDegrees(const glm::vec3& lhs, const glm::vec3& rhs)
+	{
+		glm::vec3 cross = glm::cross(lhs, rhs);
+		return std::atan2(glm::length(cross), glm::dot(lhs, rhs)) * 180.f / sPi;
+	}
+}
+
+MULE_TEST(OctahedralRoundTrip)
+{
+	float worstError = 0.f;
+	for (const glm::vec3& normal : BuildNormals(100000))
+	{
+		glm::vec2 encoded = EncodeOctahedral(normal);
+		EXPECT(std::abs(encoded.x) <= 1.f && std::abs(encoded.y) <= 1.f);
+
+		glm::vec3 decoded = DecodeOctahedral(encoded);
+		worstError = std::max(worstError, glm::length(decoded - normal));
+	}
+
+	EXPECT(worstError < 1e-5f);
+}
+
+MULE_TEST(OctahedralRoundTrip16)
+{
+	float worstError = 0.f;
+	for (const glm::vec3& normal : BuildNormals(100000))
+		worstError = std::max(worstError, AngleDegrees(UnpackOctahedral16(PackOctahedral16(normal)), normal));
+
+	EXPECT(worstError < 0.01f);
+}
+
+MULE_TEST(OctahedralRoundTrip8)
+{
+	float worstError = 0.f;
+	for (const glm::vec3& normal : BuildNormals(100000))
+		worstError = std::max(worstError, AngleDegrees(UnpackOctahedral8(PackOctahedral8(normal)), normal));
+
+	EXPECT(worstError < 1.5f);
+}
+
+MULE_TEST(SnormMatchesTheGPUConversion)
+{
+	EXPECT_EQ(PackSnorm(1.f, 16), 32767);
+	EXPECT_EQ(PackSnorm(-1.f, 16), -32767);
+	EXPECT_EQ(PackSnorm(0.f, 16), 0);
+	EXPECT_EQ(PackSnorm(2.f, 8), 127);
+	EXPECT_EQ(PackSnorm(-0.5f, 8), -64);
+
+	// Both -128 and -127 decode to -1
+	EXPECT_EQ(UnpackSnorm(-128, 8), -1.f);
+	EXPECT_EQ(UnpackSnorm(-127, 8), -1.f);
+	EXPECT_EQ(UnpackSnorm(32767, 16), 1.f);
+
+	// The low channel holds x
+	EXPECT_EQ(PackOctahedral16(glm::vec3(0.f, 0.f, 1.f)), 0u);
+	EXPECT_EQ(PackOctahedral16(glm::vec3(1.f, 0.f, 0.f)), 32767u);
+	EXPECT_EQ(PackOctahedral8(glm::vec3(0.f, 1.f, 0.f)), 127u << 8);
+}
@@ -0,0 +1,372 @@
+#include "Test.h"
+#include "Mocks/MockCommandBuffer.h"
+#include "Mocks/MockGraphicsQueue.h"
+
+#include "Graphics/Renderer/RenderGraph/QueueSchedule.h"
+
+#include <random>
+#include <string>
+
+using namespace Mule;
+using Mule::Tests::MockCommandBuffer;
+using Mule::Tests::MockGraphicsQueue;
+using Mule::Tests::MockTimelineSemaphore;
+
+namespace
+{
+	ResourceHandle TextureHandle(const std::string& name)
+	{
+		return ResourceHandle(name, ResourceType::RenderTarget);
+	}
+
+	ResourceHandle BufferHandle(const std::string& name)
+	{
+		return ResourceHandle(name, ResourceType::StorageBuffer);
+	}
+
+	// Submits every pass with BuildQueueSubmission like RenderGraph::Execute and runs the queues, returns the order the passes ran in
+	// or an empty order if the queues deadlocked
+	std::vector<uint32_t> RunSchedule(const std::vector<QueueSchedulePass>& passes, const QueueSchedule& schedule, bool computeFirst)
+	{
+		MockGraphicsQueue graphicsQueue(QueueType::Graphics);
+		MockGraphicsQueue computeQueue(QueueType::Compute);
+		QueueTimeline timeline;
+		timeline.Semaphores[0] = MakeRef<MockTimelineSemaphore>();
+		timeline.Semaphores[1] = MakeRef<MockTimelineSemaphore>();
+		timeline.PassValues.assign(passes.size(), 0);
+
+		std::vector<Ref<CommandBuffer>> commandBuffers;
+		std::vector<QueueSubmission> submissions[2];
+
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			commandBuffers.push_back(MakeRef<MockCommandBuffer>());
+
+			uint32_t queue = static_cast<uint32_t>(schedule.Passes[i].Queue);
+			submissions[queue].push_back(BuildQueueSubmission(schedule, i, commandBuffers.back(), timeline));
+		}
+
+		graphicsQueue.Submit(submissions[0]);
+		computeQueue.Submit(submissions[1]);
+
+		std::vector<uint32_t> order;
+		auto execute = [&](const Ref<CommandBuffer>& commandBuffer) {
+			for (uint32_t i = 0; i < commandBuffers.size(); i++)
+			{
+				if (commandBuffers[i] == commandBuffer)
+					order.push_back(i);
+			}
+			};
+
+		std::vector<MockGraphicsQueue*> queues = { &graphicsQueue, &computeQueue };
+		if (computeFirst)
+			std::swap(queues[0], queues[1]);
+
+		if (!RunQueues(queues, execute))
+			return {};
+
+		return order;
+	}
+
+	// Every pass must run after each earlier pass it conflicts with: any use of the same texture, since textures
+	// change owner between queues, buffer uses where either side writes, and explicit dependencies
+	void ExpectScheduleHonoursUsage(const std::vector<QueueSchedulePass>& passes, const QueueSchedule& schedule)
+	{
+		for (bool computeFirst : { false, true })
+		{
+			std::vector<uint32_t> order = RunSchedule(passes, schedule, computeFirst);
+			EXPECT_EQ(order.size(), passes.size());
+			if (order.size() != passes.size())
+				return;
+
+			std::vector<uint32_t> position(passes.size());
+			for (uint32_t i = 0; i < order.size(); i++)
+				position[order[i]] = i;
+
+			for (uint32_t later = 0; later < passes.size(); later++)
+			{
+				for (uint32_t dependency : passes[later].Dependencies)
+					EXPECT(position[dependency] < position[later]);
+
+				for (uint32_t earlier = 0; earlier < later; earlier++)
+				{
+					for (const auto& [handle, usage] : passes[later].Usage)
+					{
+						auto iter = passes[earlier].Usage.find(handle);
+						if (iter == passes[earlier].Usage.end())
+							continue;
+
+						bool texture = handle.Type == ResourceType::RenderTarget || handle.Type == ResourceType::DepthAttachment;
+						bool write = usage.Access == ResourceAccess::Write || iter->second.Access == ResourceAccess::Write;
+						if (texture || write)
+							EXPECT(position[earlier] < position[later]);
+					}
+				}
+			}
+		}
+	}
+
+	// Each texture changing queue between two consecutive users must be released by the first and acquired by the second
+	void ExpectTransfers(const std::vector<QueueSchedulePass>& passes, const QueueSchedule& schedule)
+	{
+		uint32_t expected = 0;
+		std::unordered_map<ResourceHandle, uint32_t> lastUsers;
+		for (uint32_t i = 0; i < passes.size(); i++)
+		{
+			for (const auto& [handle, usage] : passes[i].Usage)
+			{
+				if (handle.Type != ResourceType::RenderTarget && handle.Type != ResourceType::DepthAttachment)
+					continue;
+
+				auto lastUser = lastUsers.find(handle);
+				if (lastUser != lastUsers.end() && passes[lastUser->second].Queue != passes[i].Queue)
+				{
+					expected++;
+					bool found = std::any_of(schedule.Transfers.begin(), schedule.Transfers.end(), [&](const QueueTransfer& transfer) {
+						return transfer.Handle == handle && transfer.ReleasePass == lastUser->second && transfer.AcquirePass == i;
+						});
+					EXPECT(found);
+				}
+
+				lastUsers[handle] = i;
+			}
+		}
+
+		EXPECT_EQ(schedule.Transfers.size(), expected);
+		for (uint32_t i = 1; i < schedule.Transfers.size(); i++)
+			EXPECT(schedule.Transfers[i - 1].AcquirePass <= schedule.Transfers[i].AcquirePass);
+	}
+
+	// Depth pre-pass, async SSAO and a compute culling pass feeding the lighting pass
+	std::vector<QueueSchedulePass> BuildFrame()
+	{
+		std::vector<QueueSchedulePass> passes(5);
+
+		passes[0].Type = PassType::Graphics;
+		passes[0].Usage[ResourceHandle("Depth", ResourceType::DepthAttachment)] = { ResourceAccess::Write, 0 };
+
+		passes[1].Type = PassType::Compute;
+		passes[1].Usage[ResourceHandle("Depth", ResourceType::DepthAttachment)] = { ResourceAccess::Read, 0 };
+		passes[1].Usage[TextureHandle("SSAO")] = { ResourceAccess::Write, 0 };
+
+		passes[2].Type = PassType::Compute;
+		passes[2].Usage[BufferHandle("Lights")] = { ResourceAccess::Write, 0 };
+
+		passes[3].Type = PassType::Graphics;
+		passes[3].Usage[TextureHandle("GBuffer")] = { ResourceAccess::Write, 0 };
+
+		passes[4].Type = PassType::Graphics;
+		passes[4].Usage[TextureHandle("SSAO")] = { ResourceAccess::Read, 0 };
+		passes[4].Usage[BufferHandle("Lights")] = { ResourceAccess::Read, 0 };
+		passes[4].Usage[TextureHandle("GBuffer")] = { ResourceAccess::Read, 0 };
+		passes[4].Usage[TextureHandle("Output")] = { ResourceAccess::Write, 0 };
+
+		return passes;
+	}
+}
+
+MULE_TEST(AssignQueuesMovesComputeOffTheGraphicsQueue)
+{
+	std::vector<QueueSchedulePass> passes = BuildFrame();
+
+	std::vector<QueueType> queues = AssignQueues(passes, TextureHandle("Output"), true);
+	EXPECT(queues[0] == QueueType::Graphics);
+	EXPECT(queues[1] == QueueType::Compute);
+	EXPECT(queues[2] == QueueType::Compute);
+	EXPECT(queues[3] == QueueType::Graphics);
+	EXPECT(queues[4] == QueueType::Graphics);
+
+	for (QueueType queue : AssignQueues(passes, TextureHandle("Output"), false))
+		EXPECT(queue == QueueType::Graphics);
+}
+
+MULE_TEST(AssignQueuesKeepsPassesWithNothingToOverlap)
+{
+	// The renderer's frame, Hi-Z reads depth and lighting reads it next, the shadow pass only runs for the first view
+	ResourceHandle depth("Depth", ResourceType::DepthAttachment);
+	std::vector<QueueSchedulePass> passes(5);
+
+	passes[0].Type = PassType::Graphics;
+	passes[0].Usage[depth] = { ResourceAccess::Write, 0 };
+
+	passes[1].Type = PassType::Compute;
+	passes[1].Usage[depth] = { ResourceAccess::Read, 0 };
+	passes[1].Usage[BufferHandle("HiZ")] = { ResourceAccess::Read, 0 };
+
+	passes[2].Type = PassType::Graphics;
+	passes[2].Shared = true;
+	passes[2].Usage[ResourceHandle("Shadow", ResourceType::DepthAttachment)] = { ResourceAccess::Write, 0 };
+
+	passes[3].Type = PassType::Compute;
+	passes[3].Usage[depth] = { ResourceAccess::Read, 0 };
+	passes[3].Usage[ResourceHandle("Shadow", ResourceType::DepthAttachment)] = { ResourceAccess::Read, 0 };
+	passes[3].Usage[TextureHandle("Lit")] = { ResourceAccess::Write, 0 };
+
+	passes[4].Type = PassType::Graphics;
+	passes[4].Usage[TextureHandle("Lit")] = { ResourceAccess::Read, 0 };
+	passes[4].Usage[TextureHandle("Output")] = { ResourceAccess::Write, 0 };
+
+	for (QueueType queue : AssignQueues(passes, TextureHandle("Output"), true))
+		EXPECT(queue == QueueType::Graphics);
+
+	// Graphics work that does not touch depth can run alongside Hi-Z, waits through buffers count as well
+	passes.insert(passes.begin() + 2, QueueSchedulePass{});
+	passes[2].Type = PassType::Graphics;
+	passes[2].Usage[TextureHandle("Particles")] = { ResourceAccess::Write, 0 };
+	EXPECT(AssignQueues(passes, TextureHandle("Output"), true)[1] == QueueType::Compute);
+
+	passes[2].Usage[BufferHandle("HiZ")] = { ResourceAccess::Write, 0 };
+	EXPECT(AssignQueues(passes, TextureHandle("Output"), true)[1] == QueueType::Graphics);
+}
+
+MULE_TEST(AssignQueuesPinsComputePasses)
+{
+	std::vector<QueueSchedulePass> passes(4);
+
+	// Writes a depth attachment
+	passes[0].Type = PassType::Compute;
+	passes[0].Usage[ResourceHandle("Depth", ResourceType::DepthAttachment)] = { ResourceAccess::Write, 0 };
+
+	// Reads last frame's texture before anything writes it
+	passes[1].Type = PassType::Compute;
+	passes[1].Usage[TextureHandle("History")] = { ResourceAccess::Read, 0 };
+	passes[2].Type = PassType::Graphics;
+	passes[2].Usage[TextureHandle("History")] = { ResourceAccess::Write, 0 };
+
+	// Shared
+	passes[3].Type = PassType::Compute;
+	passes[3].Shared = true;
+	passes[3].Usage[BufferHandle("Shadow")] = { ResourceAccess::Write, 0 };
+
+	for (QueueType queue : AssignQueues(passes, TextureHandle("Output"), true))
+		EXPECT(queue == QueueType::Graphics);
+}
+
+MULE_TEST(ScheduleQueuesRunsAFrameInOrder)
+{
+	std::vector<QueueSchedulePass> passes = BuildFrame();
+	std::vector<QueueType> queues = AssignQueues(passes, TextureHandle("Output"), true);
+	for (uint32_t i = 0; i < passes.size(); i++)
+		passes[i].Queue = queues[i];
+
+	QueueSchedule schedule = ScheduleQueues(passes);
+
+	// SSAO waits on the depth pass, lighting on the last compute pass which covers both compute passes
+	EXPECT_EQ(schedule.Passes[0].WaitPass, UINT32_MAX);
+	EXPECT_EQ(schedule.Passes[1].WaitPass, 0u);
+	EXPECT_EQ(schedule.Passes[2].WaitPass, UINT32_MAX);
+	EXPECT_EQ(schedule.Passes[3].WaitPass, UINT32_MAX);
+	EXPECT_EQ(schedule.Passes[4].WaitPass, 2u);
+
+	ExpectScheduleHonoursUsage(passes, schedule);
+	ExpectTransfers(passes, schedule);
+}
+
+MULE_TEST(ScheduleQueuesOnOneQueueNeverWaits)
+{
+	std::vector<QueueSchedulePass> passes = BuildFrame();
+	QueueSchedule schedule = ScheduleQueues(passes);
+
+	for (const PassQueue& pass : schedule.Passes)
+	{
+		EXPECT(pass.Queue == QueueType::Graphics);
+		EXPECT_EQ(pass.WaitPass, UINT32_MAX);
+	}
+
+	EXPECT(schedule.Transfers.empty());
+	ExpectScheduleHonoursUsage(passes, schedule);
+}
+
+MULE_TEST(ScheduleQueuesOfRandomGraphs)
+{
+	std::mt19937 random(3);
+
+	for (uint32_t graph = 0; graph < 200; graph++)
+	{
+		uint32_t passCount = 2 + random() % 24;
+		std::vector<QueueSchedulePass> passes(passCount);
+
+		for (uint32_t i = 0; i < passCount; i++)
+		{
+			passes[i].Type = random() % 2 ? PassType::Compute : PassType::Graphics;
+			passes[i].Queue = random() % 2 ? QueueType::Compute : QueueType::Graphics;
+
+			uint32_t useCount = 1 + random() % 4;
+			for (uint32_t use = 0; use < useCount; use++)
+			{
+				uint32_t resource = random() % 8;
+				ResourceHandle handle = resource < 4 ? TextureHandle("T" + std::to_string(resource)) : BufferHandle("B" + std::to_string(resource));
+				passes[i].Usage[handle] = { random() % 2 ? ResourceAccess::Write : ResourceAccess::Read, 0 };
+			}
+
+			if (i > 0 && random() % 4 == 0)
+				passes[i].Dependencies.push_back(random() % i);
+		}
+
+		QueueSchedule schedule = ScheduleQueues(passes);
+		ExpectScheduleHonoursUsage(passes, schedule);
+		ExpectTransfers(passes, schedule);
+	}
+}
+
+MULE_TEST(MockQueueDetectsDeadlocks)
+{
+	// Guards the tests above, submissions waiting on each other across queues must not run
+	MockGraphicsQueue graphicsQueue(QueueType::Graphics);
+	MockGraphicsQueue computeQueue(QueueType::Compute);
+	Ref<TimelineSemaphore> graphicsSemaphore = MakeRef<MockTimelineSemaphore>();
+	Ref<TimelineSemaphore> computeSemaphore = MakeRef<MockTimelineSemaphore>();
+
+	graphicsQueue.Submit(MakeRef<MockCommandBuffer>(), computeSemaphore, 1, graphicsSemaphore, 1);
+	computeQueue.Submit(MakeRef<MockCommandBuffer>(), graphicsSemaphore, 1, computeSemaphore, 1);
+
+	uint32_t executed = 0;
+	EXPECT(!Mule::Tests::RunQueues({ &graphicsQueue, &computeQueue }, [&](const Ref<CommandBuffer>&) { executed++; }));
+	EXPECT_EQ(executed, 0u);
+}
+
+MULE_TEST(ScheduleQueuesWaitsOnReadsFromBothQueues)
+{
+	// The write must wait on the compute read even though the latest read was on its own queue
+	std::vector<QueueSchedulePass> passes(3);
+	passes[0].Queue = QueueType::Compute;
+	passes[0].Usage[BufferHandle("Lights")] = { ResourceAccess::Read, 0 };
+	passes[1].Queue = QueueType::Graphics;
+	passes[1].Usage[BufferHandle("Lights")] = { ResourceAccess::Read, 0 };
+	passes[2].Queue = QueueType::Graphics;
+	passes[2].Usage[BufferHandle("Lights")] = { ResourceAccess::Write, 0 };
+
+	QueueSchedule schedule = ScheduleQueues(passes);
+	EXPECT_EQ(schedule.Passes[1].WaitPass, UINT32_MAX);
+	EXPECT_EQ(schedule.Passes[2].WaitPass, 0u);
+	ExpectScheduleHonoursUsage(passes, schedule);
+}
+
+MULE_BENCHMARK(ScheduleQueues500Passes)
+{
+	std::mt19937 random(5);
+
+	std::vector<QueueSchedulePass> passes(500);
+	for (uint32_t i = 0; i < passes.size(); i++)
+	{
+		passes[i].Type = random() % 3 == 0 ? PassType::Compute : PassType::Graphics;
+		for (uint32_t use = 0; use < 6; use++)
+		{
+			uint32_t resource = random() % 200;
+			ResourceHandle handle = resource % 2 ? TextureHandle("T" + std::to_string(resource)) : BufferHandle("B" + std::to_string(resource));
+			passes[i].Usage[handle] = { use == 0 ? ResourceAccess::Write : ResourceAccess::Read, 0 };
+		}
+	}
+
+	std::vector<QueueType> queues = AssignQueues(passes, TextureHandle("Output"), true);
+	for (uint32_t i = 0; i < passes.size(); i++)
+		passes[i].Queue = queues[i];
+
+	Mule::Tests::Measure("AssignQueues 500 passes", 100, [&]() {
+		AssignQueues(passes, TextureHandle("Output"), true);
+		});
+
+	Mule::Tests::Measure("ScheduleQueues 500 passes", 100, [&]() {
+		ScheduleQueues(passes);
+		});
+}
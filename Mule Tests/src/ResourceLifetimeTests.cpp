@@ -0,0 +1,200 @@
+#include "Test.h"
+
+#include "Graphics/Renderer/RenderGraph/ResourceLifetime.h"
+
+#include <random>
+#include <string>
+
+using namespace Mule;
+
+namespace
+{
+	using PassUsage = std::unordered_map<ResourceHandle, ResourceUsage>;
+
+	ResourceHandle Target(const std::string& name)
+	{
+		return ResourceHandle(name, ResourceType::RenderTarget);
+	}
+
+	const ResourceLifetime* FindLifetime(const std::vector<ResourceLifetime>& lifetimes, const std::string& name)
+	{
+		for (const ResourceLifetime& lifetime : lifetimes)
+		{
+			if (lifetime.Handle.Name == name)
+				return &lifetime;
+		}
+		return nullptr;
+	}
+
+	// Every resource is in exactly one slot, no two members of a slot are alive together and the slot fits each of them
+	void ExpectValidSlots(const std::vector<ResourceLifetime>& lifetimes, const std::vector<uint64_t>& sizes, const std::vector<AliasSlot>& slots)
+	{
+		std::vector<uint32_t> seen(lifetimes.size(), 0);
+		for (const AliasSlot& slot : slots)
+		{
+			EXPECT(!slot.Members.empty());
+			for (uint32_t i = 0; i < slot.Members.size(); i++)
+			{
+				uint32_t member = slot.Members[i];
+				seen[member]++;
+				EXPECT(sizes[member] <= slot.Size);
+
+				for (uint32_t j = i + 1; j < slot.Members.size(); j++)
+					EXPECT(!LifetimesOverlap(lifetimes[member], lifetimes[slot.Members[j]]));
+			}
+		}
+
+		for (uint32_t count : seen)
+			EXPECT_EQ(count, 1u);
+	}
+}
+
+MULE_TEST(LifetimesSpanFirstToLastUse)
+{
+	// A -> B -> C chain, D is only ever read so it carries over from the frame before
+	std::vector<PassUsage> passes(4);
+	passes[0][Target("A")] = { ResourceAccess::Write, 0 };
+	passes[1][Target("A")] = { ResourceAccess::Read, 0 };
+	passes[1][Target("B")] = { ResourceAccess::Write, 0 };
+	passes[2][Target("B")] = { ResourceAccess::Read, 0 };
+	passes[2][Target("C")] = { ResourceAccess::Write, 0 };
+	passes[3][Target("C")] = { ResourceAccess::Read, 0 };
+	passes[3][Target("D")] = { ResourceAccess::Read, 0 };
+
+	std::vector<ResourceLifetime> lifetimes = ComputeResourceLifetimes(passes);
+	EXPECT_EQ(lifetimes.size(), 4u);
+
+	const ResourceLifetime* a = FindLifetime(lifetimes, "A");
+	const ResourceLifetime* b = FindLifetime(lifetimes, "B");
+	const ResourceLifetime* c = FindLifetime(lifetimes, "C");
+	const ResourceLifetime* d = FindLifetime(lifetimes, "D");
+	EXPECT(a && b && c && d);
+	if (!a || !b || !c || !d)
+		return;
+
+	EXPECT(a->FirstPass == 0 && a->LastPass == 1 && a->WrittenFirst);
+	EXPECT(b->FirstPass == 1 && b->LastPass == 2 && b->WrittenFirst);
+	EXPECT(c->FirstPass == 2 && c->LastPass == 3 && c->WrittenFirst);
+	EXPECT(d->FirstPass == 3 && d->LastPass == 3 && !d->WrittenFirst);
+
+	// Sorted by first use
+	for (uint32_t i = 1; i < lifetimes.size(); i++)
+		EXPECT(lifetimes[i - 1].FirstPass <= lifetimes[i].FirstPass);
+}
+
+MULE_TEST(LifetimesOverlapWhenSharingAPass)
+{
+	ResourceLifetime a{ Target("A"), 0, 1 };
+	ResourceLifetime b{ Target("B"), 1, 2 };
+	ResourceLifetime c{ Target("C"), 2, 3 };
+	ResourceLifetime d{ Target("D"), 0, 3 };
+
+	EXPECT(LifetimesOverlap(a, b));
+	EXPECT(LifetimesOverlap(b, a));
+	EXPECT(!LifetimesOverlap(a, c));
+	EXPECT(!LifetimesOverlap(c, a));
+	EXPECT(LifetimesOverlap(d, b));
+	EXPECT(LifetimesOverlap(a, a));
+}
+
+MULE_TEST(AliasSlotsReuseDeadResources)
+{
+	std::vector<PassUsage> passes(4);
+	passes[0][Target("A")] = { ResourceAccess::Write, 0 };
+	passes[1][Target("A")] = { ResourceAccess::Read, 0 };
+	passes[1][Target("B")] = { ResourceAccess::Write, 0 };
+	passes[2][Target("B")] = { ResourceAccess::Read, 0 };
+	passes[2][Target("C")] = { ResourceAccess::Write, 0 };
+	passes[3][Target("C")] = { ResourceAccess::Read, 0 };
+	passes[3][Target("D")] = { ResourceAccess::Write, 0 };
+
+	std::vector<ResourceLifetime> lifetimes = ComputeResourceLifetimes(passes);
+
+	std::vector<uint64_t> sizes(lifetimes.size());
+	for (uint32_t i = 0; i < lifetimes.size(); i++)
+	{
+		const std::string& name = lifetimes[i].Handle.Name;
+		sizes[i] = name == "A" ? 100 : name == "B" ? 50 : name == "C" ? 80 : 10;
+	}
+
+	std::vector<AliasSlot> slots = AssignAliasSlots(lifetimes, sizes);
+	ExpectValidSlots(lifetimes, sizes, slots);
+
+	// A and C never live together and share the largest slot, B and D share the other
+	EXPECT_EQ(slots.size(), 2u);
+	if (slots.size() == 2)
+	{
+		EXPECT_EQ(slots[0].Size, 100u);
+		EXPECT_EQ(slots[0].Members.size(), 2u);
+		EXPECT_EQ(lifetimes[slots[0].Members[0]].Handle.Name, std::string("A"));
+		EXPECT_EQ(lifetimes[slots[0].Members[1]].Handle.Name, std::string("C"));
+		EXPECT_EQ(slots[1].Size, 50u);
+	}
+}
+
+MULE_TEST(AliasSlotsOfRandomGraphs)
+{
+	std::mt19937 random(7);
+
+	for (uint32_t graph = 0; graph < 50; graph++)
+	{
+		uint32_t passCount = 2 + random() % 30;
+		std::vector<PassUsage> passes(passCount);
+
+		for (uint32_t resource = 0; resource < 40; resource++)
+		{
+			uint32_t first = random() % passCount;
+			uint32_t last = first + random() % (passCount - first);
+			ResourceHandle handle = Target("R" + std::to_string(resource));
+
+			passes[first][handle] = { ResourceAccess::Write, 0 };
+			passes[last][handle] = { first == last ? ResourceAccess::Write : ResourceAccess::Read, 0 };
+		}
+
+		std::vector<ResourceLifetime> lifetimes = ComputeResourceLifetimes(passes);
+		EXPECT_EQ(lifetimes.size(), 40u);
+
+		std::vector<uint64_t> sizes(lifetimes.size());
+		for (uint64_t& size : sizes)
+			size = 1 + random() % 1024;
+
+		ExpectValidSlots(lifetimes, sizes, AssignAliasSlots(lifetimes, sizes));
+	}
+}
+
+MULE_TEST(AliasSlotsWithNothingToAlias)
+{
+	EXPECT(AssignAliasSlots({}, {}).empty());
+	EXPECT(ComputeResourceLifetimes({}).empty());
+}
+
+MULE_BENCHMARK(LifetimesAndAliasing)
+{
+	std::mt19937 random(11);
+
+	std::vector<PassUsage> passes(500);
+	for (uint32_t pass = 0; pass < passes.size(); pass++)
+	{
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			ResourceHandle handle = Target("R" + std::to_string(pass * 4 + i));
+			passes[pass][handle] = { ResourceAccess::Write, 0 };
+
+			uint32_t last = std::min<uint32_t>(pass + 1 + random() % 8, static_cast<uint32_t>(passes.size()) - 1);
+			passes[last][handle] = { ResourceAccess::Read, 0 };
+		}
+	}
+
+	std::vector<ResourceLifetime> lifetimes;
+	Mule::Tests::Measure("ComputeResourceLifetimes 500 passes, 2000 textures", 20, [&]() {
+		lifetimes = ComputeResourceLifetimes(passes);
+		});
+
+	std::vector<uint64_t> sizes(lifetimes.size());
+	for (uint64_t& size : sizes)
+		size = 1 + random() % (1 << 20);
+
+	Mule::Tests::Measure("AssignAliasSlots 2000 textures", 20, [&]() {
+		AssignAliasSlots(lifetimes, sizes);
+		});
+}
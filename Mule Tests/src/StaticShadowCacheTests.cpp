@@ -0,0 +1,88 @@
+#include "Test.h"
+
+#include "Graphics/Renderer/StaticShadowCache.h"
+
+#include <vector>
+
+using namespace Mule;
+
+namespace
+{
+	glm::mat4 Translation(float x)
+	{
+		glm::mat4 transform(1.f);
+		transform[3][0] = x;
+		return transform;
+	}
+
+	IndirectDrawItem Caster(uint32_t indexCount)
+	{
+		IndirectDrawItem item;
+		item.IndexCount = indexCount;
+		return item;
+	}
+}
+
+MULE_TEST(CasterHashIgnoresDrawOrder)
+{
+	std::vector<uint64_t> forward = {
+		HashShadowCaster(Caster(36), Translation(1.f)),
+		HashShadowCaster(Caster(96), Translation(2.f)),
+		HashShadowCaster(Caster(12), Translation(3.f))
+	};
+
+	std::vector<uint64_t> reversed(forward.rbegin(), forward.rend());
+
+	EXPECT_EQ(CombineShadowCasterHashes(forward), CombineShadowCasterHashes(reversed));
+}
+
+MULE_TEST(CasterHashSeesSwappedTransforms)
+{
+	std::vector<uint64_t> before = { HashShadowCaster(Caster(36), Translation(1.f)), HashShadowCaster(Caster(96), Translation(2.f)) };
+	std::vector<uint64_t> after = { HashShadowCaster(Caster(36), Translation(2.f)), HashShadowCaster(Caster(96), Translation(1.f)) };
+
+	EXPECT(CombineShadowCasterHashes(before) != CombineShadowCasterHashes(after));
+}
+
+MULE_TEST(CasterHashDoesNotCollideLikeASum)
+{
+	// Each pair sums to the same value
+	std::vector<uint64_t> lhs = { 1, 4 };
+	std::vector<uint64_t> rhs = { 2, 3 };
+	EXPECT(CombineShadowCasterHashes(lhs) != CombineShadowCasterHashes(rhs));
+
+	// A caster drawn twice is not the same as no caster at all
+	std::vector<uint64_t> twice = { 7, 7 };
+	std::vector<uint64_t> none;
+	EXPECT(CombineShadowCasterHashes(twice) != CombineShadowCasterHashes(none));
+
+	std::vector<uint64_t> once = { 7 };
+	EXPECT(CombineShadowCasterHashes(twice) != CombineShadowCasterHashes(once));
+}
+
+MULE_TEST(StaticShadowCacheIsKeyedByWorld)
+{
+	StaticShadowCache cache(2, 4);
+	int worldA = 0;
+	int worldB = 0;
+	glm::mat4 lightSpace = Translation(5.f);
+
+	EXPECT(cache.Update(&worldA, 0, 1, lightSpace, 42));
+	EXPECT(!cache.Update(&worldA, 0, 1, lightSpace, 42));
+
+	// Other frame indices and cascades have their own layers
+	EXPECT(cache.Update(&worldA, 1, 1, lightSpace, 42));
+	EXPECT(cache.Update(&worldA, 0, 2, lightSpace, 42));
+
+	// Another world with the same casters and cascade still has to draw, and then so does the first one again
+	EXPECT(cache.Update(&worldB, 0, 1, lightSpace, 42));
+	EXPECT(cache.Update(&worldA, 0, 1, lightSpace, 42));
+
+	EXPECT(cache.Update(&worldA, 0, 1, lightSpace, 43));
+	EXPECT(cache.Update(&worldA, 0, 1, Translation(6.f), 43));
+	EXPECT(!cache.Update(&worldA, 0, 1, Translation(6.f), 43));
+
+	// A world created where a removed one lived does not inherit its layers
+	cache.RemoveWorld(&worldA);
+	EXPECT(cache.Update(&worldA, 0, 1, Translation(6.f), 43));
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Minimal test harness, tests run by default and benchmarks with --bench
+
+namespace Mule::Tests
+{
+	struct TestCase
+	{
+		const char* Name;
+		void (*Func)();
+		bool Benchmark;
+	};
+
+	std::vector<TestCase>& GetTestCases();
+	void ReportFailure(const char* file, int line, const char* expression);
+
+	struct TestRegistrar
+	{
+		TestRegistrar(const char* name, void (*func)(), bool benchmark)
+		{
+			GetTestCases().push_back({ name, func, benchmark });
+		}
+	};
+
+	// Runs func iterations times and prints the average time of one call
+	template<typename F>
+	void Measure(const char* name, uint32_t iterations, F&& func)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < iterations; i++)
+			func();
+		auto end = std::chrono::high_resolution_clock::now();
+
+		double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+		printf("    %-48s %10.4f ms\n", name, ms);
+	}
+}
+
+#define MULE_TEST(name) \
+	static void name(); \
+	static Mule::Tests::TestRegistrar name##Registrar(#name, &name, false); \
+	static void name()
+
+#define MULE_BENCHMARK(name) \
+	static void name(); \
+	static Mule::Tests::TestRegistrar name##Registrar(#name, &name, true); \
+	static void name()
+
+#define EXPECT(expression) \
+	do { if (!(expression)) Mule::Tests::ReportFailure(__FILE__, __LINE__, #expression); } while (0)
+
+#define EXPECT_EQ(lhs, rhs) EXPECT((lhs) == (rhs))
+#define EXPECT_NEAR(lhs, rhs, epsilon) EXPECT(std::abs((lhs) - (rhs)) <= (epsilon))
@@ -0,0 +1,58 @@
+#include "Test.h"
+
+#include <cstring>
+
+namespace Mule::Tests
+{
+	static uint32_t sFailures = 0;
+
+	std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	void ReportFailure(const char* file, int line, const char* expression)
+	{
+		printf("    %s(%d): EXPECT(%s) failed\n", file, line, expression);
+		sFailures++;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace Mule::Tests;
+
+	bool benchmarks = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--bench") == 0)
+			benchmarks = true;
+	}
+
+	uint32_t failedTests = 0;
+	uint32_t ran = 0;
+	for (const TestCase& testCase : GetTestCases())
+	{
+		if (testCase.Benchmark != benchmarks)
+			continue;
+
+		printf("[ RUN  ] %s\n", testCase.Name);
+		uint32_t failures = sFailures;
+		testCase.Func();
+		ran++;
+
+		if (sFailures != failures)
+		{
+			failedTests++;
+			printf("[ FAIL ] %s\n", testCase.Name);
+		}
+		else
+		{
+			printf("[  OK  ] %s\n", testCase.Name);
+		}
+	}
+
+	printf("%u of %u %s passed\n", ran - failedTests, ran, benchmarks ? "benchmarks" : "tests");
+	return failedTests == 0 ? 0 : 1;
+}
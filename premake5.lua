@@ -92,4 +92,5 @@ workspace "Mule"
     -- Projects
     include "Mule Editor/editor.lua"
     include "Mule Engine/mule engine.lua"
+    include "Mule Tests/tests.lua"
     include "MuleScriptEngine/MuleScriptEngine.lua"